@@ -1223,6 +1223,29 @@ elif ctx.pkg_name == 'speexdsp':
     execute_make(ctx)
     install_tree(ctx, 'include', ctx.pkg_inc_dir)
     install_files(ctx, 'lib{ctx.pkg_repo}/.libs/libspeexdsp.a', ctx.pkg_lib_dir)
+elif ctx.pkg_name == 'opus':
+    download(
+        ctx,
+        'https://downloads.xiph.org/releases/opus/opus-{ctx.pkg_ver}.tar.gz',
+        'opus-{ctx.pkg_ver}.tar.gz')
+    unpack(
+        ctx,
+        'opus-{ctx.pkg_ver}.tar.gz',
+        'opus-{ctx.pkg_ver}')
+    changedir(ctx, 'src/opus-{ctx.pkg_ver}')
+    execute(ctx, './configure --host={host} {vars} {flags} {opts}'.format(
+        host=ctx.toolchain,
+        vars=format_vars(ctx),
+        flags=format_flags(ctx, cflags='-fPIC'),
+        opts=' '.join([
+            '--disable-doc',
+            '--disable-extra-programs',
+            '--disable-shared',
+            '--enable-static',
+           ])))
+    execute_make(ctx)
+    install_tree(ctx, 'include', ctx.pkg_inc_dir)
+    install_files(ctx, '.libs/libopus.a', ctx.pkg_lib_dir)
 elif ctx.pkg_name == 'sndfile':
     download(
         ctx,
@@ -138,6 +138,7 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
     , frame_size_(frame_size_ch_ * in_spec.num_channels())
     , sinc_table_(arena)
     , sinc_table_ptr_(NULL)
+    , window_weights_(arena)
     , qt_half_window_size_(float_to_fixedpoint((float)window_size_ / scaling_))
     , qt_epsilon_(float_to_fixedpoint(5e-8f))
     , qt_frame_size_(fixedpoint_t(frame_size_ch_ << FRACT_BIT_COUNT))
@@ -145,13 +146,16 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
     , qt_dt_(0)
     , cutoff_freq_(0.9f)
     , valid_(false) {
-    roc_log(
-        LogDebug,
-        "builtin resampler: initializing:"
-        " profile=%s window_interp=%lu window_size=%lu frame_size=%lu channels_num=%lu",
-        resampler_profile_to_str(profile), (unsigned long)window_interp_,
-        (unsigned long)window_size_, (unsigned long)frame_size_,
-        (unsigned long)in_spec_.num_channels());
+    WindowKernel kernels[MaxWindowKernels];
+    window_kernel_ = kernels[get_window_kernels(kernels) - 1];
+
+    roc_log(LogDebug,
+            "builtin resampler: initializing:"
+            " profile=%s window_interp=%lu window_size=%lu frame_size=%lu"
+            " channels_num=%lu kernel=%s",
+            resampler_profile_to_str(profile), (unsigned long)window_interp_,
+            (unsigned long)window_size_, (unsigned long)frame_size_,
+            (unsigned long)in_spec_.num_channels(), window_kernel_.name);
 
     if (!check_config_()) {
         return;
@@ -165,6 +169,10 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
         return;
     }
 
+    if (!alloc_weights_()) {
+        return;
+    }
+
     valid_ = true;
 }
 
@@ -284,9 +292,7 @@ size_t BuiltinResampler::pop_output(sample_t* out_data, size_t out_size) {
             qt_sample_ += qt_one;
         }
 
-        for (size_t channel = 0; channel < in_spec_.num_channels(); ++channel) {
-            out_data[out_pos + channel] = resample_(channel);
-        }
+        resample_(out_data + out_pos);
         qt_sample_ += qt_dt_;
     }
 
@@ -312,6 +318,16 @@ bool BuiltinResampler::alloc_frames_(FrameFactory& frame_factory) {
     return true;
 }
 
+bool BuiltinResampler::alloc_weights_() {
+    // Window never spans more than one frame in each of prev, curr, and next frames.
+    if (!window_weights_.resize(frame_size_ch_ * 3)) {
+        roc_log(LogError, "builtin resampler: can't allocate window weights");
+        return false;
+    }
+
+    return true;
+}
+
 bool BuiltinResampler::check_config_() const {
     if (!in_spec_.is_valid() || !out_spec_.is_valid() || !in_spec_.is_raw()
         || !out_spec_.is_raw()) {
@@ -407,48 +423,47 @@ sample_t BuiltinResampler::sinc_(const fixedpoint_t x, const float fract_x) {
     return scaling_ > 1.0f ? result / scaling_ : result;
 }
 
-sample_t BuiltinResampler::resample_(const size_t channel_offset) {
+void BuiltinResampler::resample_(sample_t* out_data) {
     roc_panic_if_msg(qt_sinc_step_ == 0,
                      "builtin resampler:"
                      " set_scaling() must be called before any resampling could be done");
+
+    const size_t num_ch = in_spec_.num_channels();
+
     // Index of first input sample in window.
     size_t ind_begin_prev;
 
     // Window lasts till that index.
-    const size_t ind_end_prev = channelize_index(frame_size_ch_, channel_offset);
+    const size_t ind_end_prev = frame_size_ch_;
 
     size_t ind_begin_cur;
     size_t ind_end_cur;
 
-    const size_t ind_begin_next = channelize_index(0, channel_offset);
     size_t ind_end_next;
 
+    // All indices below are in terms of samples per channel. Positions of the
+    // window and sinc values are the same for all channels, so we compute each
+    // sinc value only once and apply it to all channels of the input sample.
     ind_begin_prev = (qt_sample_ >= qt_half_window_size_)
         ? frame_size_ch_
         : fixedpoint_to_size(qceil(qt_sample_ + (qt_frame_size_ - qt_half_window_size_)));
-    // ind_begin_prev is comparable with channel_len_ till we'll convert it to channalyzed
-    // presentation.
     roc_panic_if(ind_begin_prev > frame_size_ch_);
-    ind_begin_prev = channelize_index(ind_begin_prev, channel_offset);
 
     ind_begin_cur = (qt_sample_ >= qt_half_window_size_)
         ? fixedpoint_to_size(qceil(qt_sample_ - qt_half_window_size_))
         : 0;
     roc_panic_if(ind_begin_cur > frame_size_ch_);
-    ind_begin_cur = channelize_index(ind_begin_cur, channel_offset);
 
     ind_end_cur = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? frame_size_ch_ - 1
         : fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_));
     roc_panic_if(ind_end_cur > frame_size_ch_);
-    ind_end_cur = channelize_index(ind_end_cur, channel_offset);
 
     ind_end_next = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_ - qt_frame_size_))
             + 1
         : 0;
     roc_panic_if(ind_end_next > frame_size_ch_);
-    ind_end_next = channelize_index(ind_end_next, channel_offset);
 
     // Counter inside window.
     // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
@@ -465,29 +480,34 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     // Compute fractional part of time position at the beginning. It wont change during
     // the run.
     float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-    sample_t accumulator = 0;
+
+    // Weights of window samples from prev, curr, and next frames, in this order.
+    sample_t* const weights_prev = window_weights_.data();
+    sample_t* const weights_curr = weights_prev + frame_size_ch_;
+    sample_t* const weights_next = weights_curr + frame_size_ch_;
 
     size_t i;
 
     // Run through previous frame.
-    for (i = ind_begin_prev; i < ind_end_prev; i += in_spec_.num_channels()) {
-        accumulator += prev_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = ind_begin_prev; i < ind_end_prev; i++) {
+        weights_prev[i - ind_begin_prev] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur -= qt_sinc_inc;
     }
+    const size_t n_prev = ind_end_prev - ind_begin_prev;
 
     // Run through current frame through the left windows side. qt_sinc_cur is decreasing.
     i = ind_begin_cur;
 
-    accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    weights_curr[i - ind_begin_cur] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
     while (qt_sinc_cur >= qt_sinc_step_) {
-        i += in_spec_.num_channels();
+        i++;
         qt_sinc_cur -= qt_sinc_inc;
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        weights_curr[i - ind_begin_cur] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
     }
 
-    i += in_spec_.num_channels();
+    i++;
 
-    roc_panic_if(i > channelize_index(frame_size_ch_, channel_offset));
+    roc_panic_if(i > frame_size_ch_);
 
     // Crossing zero -- we just need to switch qt_sinc_cur.
     // -1 ------------ 0 ------------- +1
@@ -498,18 +518,29 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
 
     // Run through right side of the window, increasing qt_sinc_cur.
-    for (; i <= ind_end_cur; i += in_spec_.num_channels()) {
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (; i <= ind_end_cur; i++) {
+        weights_curr[i - ind_begin_cur] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur += qt_sinc_inc;
     }
+    const size_t n_curr = i - ind_begin_cur;
 
     // Next frames run.
-    for (i = ind_begin_next; i < ind_end_next; i += in_spec_.num_channels()) {
-        accumulator += next_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = 0; i < ind_end_next; i++) {
+        weights_next[i] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur += qt_sinc_inc;
     }
+    const size_t n_next = ind_end_next;
+
+    // Apply weights to all channels.
+    for (size_t ch = 0; ch < num_ch; ch++) {
+        out_data[ch] = 0;
+    }
 
-    return accumulator;
+    window_kernel_.func(out_data, prev_frame_ + ind_begin_prev * num_ch, weights_prev,
+                        n_prev, num_ch);
+    window_kernel_.func(out_data, curr_frame_ + ind_begin_cur * num_ch, weights_curr,
+                        n_curr, num_ch);
+    window_kernel_.func(out_data, next_frame_, weights_next, n_next, num_ch);
 }
 
 } // namespace audio
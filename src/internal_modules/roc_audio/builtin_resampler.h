@@ -19,6 +19,7 @@
 #include "roc_audio/resampler_config.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_audio/window_kernel.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
@@ -77,21 +78,19 @@ private:
     typedef int32_t signed_fixedpoint_t;
     typedef int64_t signed_long_fixedpoint_t;
 
-    inline size_t channelize_index(const size_t i, const size_t ch_offset) const {
-        return i * in_spec_.num_channels() + ch_offset;
-    }
-
     bool alloc_frames_(FrameFactory& frame_factory);
+    bool alloc_weights_();
 
     bool check_config_() const;
 
     bool fill_sinc_();
     sample_t sinc_(fixedpoint_t x, float fract_x);
 
-    // Computes single sample of the particular audio channel.
-    // channel_offset a serial number of the channel
-    // (e.g. left -- 0, right -- 1, etc.).
-    sample_t resample_(size_t channel_offset);
+    // Computes single output sample for all audio channels.
+    // Sinc values depend only on time position, so they are computed once
+    // per window position into window_weights_, and then window kernel
+    // applies them to all channels.
+    void resample_(sample_t* out_data);
 
     const SampleSpec in_spec_;
     const SampleSpec out_spec_;
@@ -117,6 +116,12 @@ private:
     core::Array<sample_t> sinc_table_;
     const sample_t* sinc_table_ptr_;
 
+    // sinc values for every input sample in window
+    core::Array<sample_t> window_weights_;
+
+    // fastest window kernel supported by CPU
+    WindowKernel window_kernel_;
+
     // half window len in Q8.24 in terms of input signal
     fixedpoint_t qt_half_window_size_;
     const fixedpoint_t qt_epsilon_;
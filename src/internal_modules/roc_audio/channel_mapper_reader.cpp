@@ -8,6 +8,7 @@
 
 #include "roc_audio/channel_mapper_reader.h"
 #include "roc_audio/channel_set_to_str.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
@@ -89,6 +90,8 @@ bool ChannelMapperReader::read(Frame& out_frame) {
     out_frame.set_flags(flags);
     out_frame.set_duration(out_frame.num_raw_samples() / out_spec_.num_channels());
 
+    CopyCounter::instance().add(CopyStage_ChannelMapper, out_frame.num_raw_samples());
+
     return true;
 }
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/copy_counter.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+const char* copy_stage_to_str(CopyStage stage) {
+    switch (stage) {
+    case CopyStage_Depacketizer:
+        return "depacketizer";
+    case CopyStage_ChannelMapper:
+        return "channel_mapper";
+    case CopyStage_Resampler:
+        return "resampler";
+    case CopyStage_PcmMapper:
+        return "pcm_mapper";
+    case CopyStage_Mixer:
+        return "mixer";
+    case CopyStage_SessionMixer:
+        return "session_mixer";
+    case CopyStage_Shard:
+        return "shard";
+    case CopyStage_Max:
+        break;
+    }
+
+    return "<invalid>";
+}
+
+CopyCounter::CopyCounter()
+    : enabled_(0) {
+}
+
+void CopyCounter::set_enabled(bool enabled) {
+    core::AtomicOps::store_relaxed(enabled_, (int)enabled);
+}
+
+void CopyCounter::add_(CopyStage stage, size_t n_samples) {
+    roc_panic_if_not(stage >= 0 && stage < CopyStage_Max);
+
+    copies_[stage]++;
+    samples_[stage] += n_samples;
+}
+
+size_t CopyCounter::num_copies(CopyStage stage) const {
+    roc_panic_if_not(stage >= 0 && stage < CopyStage_Max);
+
+    return copies_[stage];
+}
+
+size_t CopyCounter::num_samples(CopyStage stage) const {
+    roc_panic_if_not(stage >= 0 && stage < CopyStage_Max);
+
+    return samples_[stage];
+}
+
+void CopyCounter::reset() {
+    for (size_t n = 0; n < CopyStage_Max; n++) {
+        copies_[n] = 0;
+        samples_[n] = 0;
+    }
+}
+
+} // namespace audio
+} // namespace roc
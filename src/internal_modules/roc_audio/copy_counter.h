@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/copy_counter.h
+//! @brief Sample copy counter.
+
+#ifndef ROC_AUDIO_COPY_COUNTER_H_
+#define ROC_AUDIO_COPY_COUNTER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Pipeline stage that copies samples.
+enum CopyStage {
+    //! Payload decoded by depacketizer into frame.
+    CopyStage_Depacketizer,
+
+    //! Samples mapped between channel sets.
+    CopyStage_ChannelMapper,
+
+    //! Samples resampled.
+    CopyStage_Resampler,
+
+    //! Samples mapped between PCM formats.
+    CopyStage_PcmMapper,
+
+    //! Samples mixed from temporary buffers.
+    CopyStage_Mixer,
+
+    //! Samples copied from per-session buffer of session mixer.
+    CopyStage_SessionMixer,
+
+    //! Samples copied from per-shard buffer of receiver shard.
+    CopyStage_Shard,
+
+    //! Number of stages.
+    CopyStage_Max
+};
+
+//! Get string name of copy stage.
+const char* copy_stage_to_str(CopyStage stage);
+
+//! Sample copy counter.
+//!
+//! Every pipeline stage that writes samples into a frame from another buffer
+//! (instead of passing the frame through) reports here how many times it did
+//! it and how many samples it wrote. This allows to check how many times
+//! samples are copied on their way from packet payload to output frame.
+//!
+//! Counters are process-wide and can be updated concurrently. Counting is
+//! disabled by default, so that pipeline threads don't contend on shared
+//! counters in production; roc-recv enables it with --copy-stats option.
+class CopyCounter : public core::NonCopyable<> {
+public:
+    //! Get instance.
+    static CopyCounter& instance() {
+        return core::Singleton<CopyCounter>::instance();
+    }
+
+    //! Check if counting is enabled.
+    bool is_enabled() const {
+        return core::AtomicOps::load_relaxed(enabled_) != 0;
+    }
+
+    //! Enable or disable counting.
+    void set_enabled(bool enabled);
+
+    //! Report that stage wrote @p n_samples into a frame.
+    //! @remarks
+    //!  Does nothing if counting is disabled.
+    void add(CopyStage stage, size_t n_samples) {
+        if (is_enabled()) {
+            add_(stage, n_samples);
+        }
+    }
+
+    //! Get number of copies made by stage.
+    size_t num_copies(CopyStage stage) const;
+
+    //! Get number of samples copied by stage.
+    size_t num_samples(CopyStage stage) const;
+
+    //! Reset all counters to zero.
+    void reset();
+
+private:
+    friend class core::Singleton<CopyCounter>;
+
+    CopyCounter();
+
+    void add_(CopyStage stage, size_t n_samples);
+
+    int enabled_;
+
+    core::Atomic<size_t> copies_[CopyStage_Max];
+    core::Atomic<size_t> samples_[CopyStage_Max];
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_COPY_COUNTER_H_
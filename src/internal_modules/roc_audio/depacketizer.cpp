@@ -7,10 +7,12 @@
  */
 
 #include "roc_audio/depacketizer.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/tracer.h"
 #include "roc_status/code_to_str.h"
 
 namespace roc {
@@ -74,7 +76,13 @@ packet::stream_timestamp_t Depacketizer::next_timestamp() const {
     return stream_ts_;
 }
 
+const DepacketizerMetrics& Depacketizer::metrics() const {
+    return metrics_;
+}
+
 bool Depacketizer::read(Frame& frame) {
+    core::TraceScope trace("depacketizer");
+
     read_frame_(frame);
 
     report_stats_();
@@ -92,16 +100,24 @@ void Depacketizer::read_frame_(Frame& frame) {
 
     FrameInfo info;
 
+    frame.clear_gaps();
+
     while (buff_ptr < buff_end) {
-        buff_ptr = read_samples_(buff_ptr, buff_end, info);
+        buff_ptr = read_samples_(frame, buff_ptr, buff_end, info);
     }
 
     roc_panic_if(buff_ptr != buff_end);
     set_frame_props_(frame, info);
+
+    if (info.n_decoded_samples != 0) {
+        CopyCounter::instance().add(CopyStage_Depacketizer, info.n_decoded_samples);
+    }
 }
 
-sample_t*
-Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info) {
+sample_t* Depacketizer::read_samples_(Frame& frame,
+                                      sample_t* buff_ptr,
+                                      sample_t* buff_end,
+                                      FrameInfo& info) {
     update_packet_(info);
 
     if (packet_) {
@@ -116,7 +132,7 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
             const size_t max_samples = (size_t)(buff_end - buff_ptr);
             const size_t n_samples = std::min(mis_samples, max_samples);
 
-            buff_ptr = read_missing_samples_(buff_ptr, buff_ptr + n_samples);
+            buff_ptr = read_missing_samples_(frame, buff_ptr, buff_ptr + n_samples);
 
             //           next_capture_ts_
             //           next_timestamp
@@ -162,7 +178,7 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
         }
 
         info.n_filled_samples += n_samples;
-        return read_missing_samples_(buff_ptr, buff_end);
+        return read_missing_samples_(frame, buff_ptr, buff_end);
     }
 }
 
@@ -174,6 +190,7 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
 
     stream_ts_ += (packet::stream_timestamp_t)decoded_samples;
     packet_samples_ += (packet::stream_timestamp_t)decoded_samples;
+    metrics_.decoded_samples += decoded_samples;
 
     if (decoded_samples < requested_samples) {
         payload_decoder_.end();
@@ -183,14 +200,33 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
     return (buff_ptr + decoded_samples * sample_spec_.num_channels());
 }
 
-sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end) {
+sample_t* Depacketizer::read_missing_samples_(Frame& frame,
+                                              sample_t* buff_ptr,
+                                              sample_t* buff_end) {
     const size_t num_samples =
         (size_t)(buff_end - buff_ptr) / sample_spec_.num_channels();
 
     if (beep_) {
         write_beep(buff_ptr, num_samples * sample_spec_.num_channels());
-    } else {
+    } else if (first_packet_) {
         write_zeros(buff_ptr, num_samples * sample_spec_.num_channels());
+    } else {
+        // Let decoder restore lost samples if codec supports it.
+        const size_t concealed_samples = payload_decoder_.conceal(buff_ptr, num_samples);
+        metrics_.concealed_samples += concealed_samples;
+
+        // Report samples left silent, so that following stages could conceal
+        // them. Decoder doesn't tell which samples it restored, so partially
+        // restored ranges are not reported.
+        if (concealed_samples == 0) {
+            const size_t offset = (size_t)(buff_ptr - frame.raw_samples())
+                / sample_spec_.num_channels();
+
+            if (!frame.add_gap(offset, num_samples)) {
+                roc_log(LogTrace, "depacketizer: too many gaps in frame: offset=%lu",
+                        (unsigned long)offset);
+            }
+        }
     }
 
     stream_ts_ += (packet::stream_timestamp_t)num_samples;
@@ -199,6 +235,7 @@ sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff
         zero_samples_ += (packet::stream_timestamp_t)num_samples;
     } else {
         missing_samples_ += (packet::stream_timestamp_t)num_samples;
+        metrics_.missing_samples += num_samples;
     }
 
     return (buff_ptr + num_samples * sample_spec_.num_channels());
@@ -242,6 +279,7 @@ void Depacketizer::update_packet_(FrameInfo& info) {
                 n_dropped);
 
         info.n_dropped_packets += n_dropped;
+        metrics_.late_packets += n_dropped;
     }
 
     if (!packet_) {
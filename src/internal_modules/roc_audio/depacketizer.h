@@ -23,10 +23,38 @@
 namespace roc {
 namespace audio {
 
+//! Depacketizer metrics.
+struct DepacketizerMetrics {
+    //! Number of samples per channel decoded from packets.
+    uint64_t decoded_samples;
+
+    //! Number of samples per channel missing because packets were lost or
+    //! not received in time.
+    //! Doesn't include samples before first packet.
+    uint64_t missing_samples;
+
+    //! Number of missing samples per channel restored by decoder using
+    //! codec loss concealment, instead of filling with silence.
+    uint64_t concealed_samples;
+
+    //! Number of packets dropped because they were received too late.
+    uint64_t late_packets;
+
+    DepacketizerMetrics()
+        : decoded_samples(0)
+        , missing_samples(0)
+        , concealed_samples(0)
+        , late_packets(0) {
+    }
+};
+
 //! Depacketizer.
 //! @remarks
 //!  Reads packets from a packet reader, decodes samples from packets using a
 //!  decoder, and produces an audio stream.
+//! @remarks
+//!  Ranges of samples that were lost and not concealed by decoder are attached
+//!  to produced frames as gaps (see Frame::add_gap()).
 class Depacketizer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -55,6 +83,9 @@ public:
     //!  is_started() should return true
     packet::stream_timestamp_t next_timestamp() const;
 
+    //! Get metrics.
+    const DepacketizerMetrics& metrics() const;
+
 private:
     struct FrameInfo {
         // Number of samples decoded from packets into the frame.
@@ -79,10 +110,11 @@ private:
 
     void read_frame_(Frame& frame);
 
-    sample_t* read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
+    sample_t*
+    read_samples_(Frame& frame, sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
 
     sample_t* read_packet_samples_(sample_t* buff_ptr, sample_t* buff_end);
-    sample_t* read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end);
+    sample_t* read_missing_samples_(Frame& frame, sample_t* buff_ptr, sample_t* buff_end);
 
     void update_packet_(FrameInfo& info);
     packet::PacketPtr read_packet_();
@@ -106,6 +138,8 @@ private:
     packet::stream_timestamp_t missing_samples_;
     packet::stream_timestamp_t packet_samples_;
 
+    DepacketizerMetrics metrics_;
+
     core::RateLimiter rate_limiter_;
 
     const bool beep_;
@@ -19,7 +19,8 @@ Frame::Frame(sample_t* samples, size_t num_samples)
     , num_bytes_(num_samples * sizeof(sample_t))
     , flags_(0)
     , duration_(0)
-    , capture_timestamp_(0) {
+    , capture_timestamp_(0)
+    , num_gaps_(0) {
     if (!samples) {
         roc_panic("frame: samples buffer is null");
     }
@@ -30,7 +31,8 @@ Frame::Frame(uint8_t* bytes, size_t num_bytes)
     , num_bytes_(num_bytes)
     , flags_(0)
     , duration_(0)
-    , capture_timestamp_(0) {
+    , capture_timestamp_(0)
+    , num_gaps_(0) {
     if (!bytes) {
         roc_panic("frame: bytes buffer is null");
     }
@@ -108,6 +110,55 @@ void Frame::set_capture_timestamp(core::nanoseconds_t capture_ts) {
     capture_timestamp_ = capture_ts;
 }
 
+size_t Frame::num_gaps() const {
+    return num_gaps_;
+}
+
+size_t Frame::gap_offset(size_t index) const {
+    roc_panic_if_msg(index >= num_gaps_, "frame: gap index out of bounds: %lu",
+                     (unsigned long)index);
+
+    return gap_offsets_[index];
+}
+
+size_t Frame::gap_length(size_t index) const {
+    roc_panic_if_msg(index >= num_gaps_, "frame: gap index out of bounds: %lu",
+                     (unsigned long)index);
+
+    return gap_lengths_[index];
+}
+
+bool Frame::add_gap(size_t offset, size_t length) {
+    if (length == 0) {
+        return true;
+    }
+
+    if (num_gaps_ != 0) {
+        const size_t last_end = gap_offsets_[num_gaps_ - 1] + gap_lengths_[num_gaps_ - 1];
+
+        roc_panic_if_msg(offset < last_end, "frame: gaps should be ordered");
+
+        if (offset == last_end) {
+            gap_lengths_[num_gaps_ - 1] += length;
+            return true;
+        }
+    }
+
+    if (num_gaps_ == MaxGaps) {
+        return false;
+    }
+
+    gap_offsets_[num_gaps_] = offset;
+    gap_lengths_[num_gaps_] = length;
+    num_gaps_++;
+
+    return true;
+}
+
+void Frame::clear_gaps() {
+    num_gaps_ = 0;
+}
+
 void Frame::print() const {
     char flags_str[] = {
         !(flags_ & FlagNotRaw) ? 'r' : '.',
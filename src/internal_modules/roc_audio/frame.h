@@ -56,6 +56,9 @@ public:
         FlagPacketDrops = (1 << 3)
     };
 
+    //! Maximum number of gaps that can be attached to frame.
+    enum { MaxGaps = 4 };
+
     //! Get flags.
     unsigned flags() const;
 
@@ -98,6 +101,28 @@ public:
     //! Set unix-epoch timestamp in ns of the 1st sample.
     void set_capture_timestamp(core::nanoseconds_t capture_ts);
 
+    //! Get number of gaps in frame.
+    //! @remarks
+    //!  Gap is a range of samples that were lost and filled with silence.
+    //!  Gaps are ordered and don't overlap.
+    size_t num_gaps() const;
+
+    //! Get offset of gap from the beginning of frame, in samples per channel.
+    size_t gap_offset(size_t index) const;
+
+    //! Get length of gap, in samples per channel.
+    size_t gap_length(size_t index) const;
+
+    //! Add gap to the end of the list.
+    //! @remarks
+    //!  If gap is adjacent to the last one, they are merged.
+    //! @returns
+    //!  false if there is no more room for gaps.
+    bool add_gap(size_t offset, size_t length);
+
+    //! Remove all gaps.
+    void clear_gaps();
+
     //! Print frame to stderr.
     void print() const;
 
@@ -107,6 +132,10 @@ private:
     unsigned flags_;
     packet::stream_timestamp_t duration_;
     core::nanoseconds_t capture_timestamp_;
+
+    size_t gap_offsets_[MaxGaps];
+    size_t gap_lengths_[MaxGaps];
+    size_t num_gaps_;
 };
 
 } // namespace audio
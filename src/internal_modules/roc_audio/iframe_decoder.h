@@ -103,6 +103,24 @@ public:
     //!  This method may be called only between begin() and end() calls.
     virtual size_t shift(size_t n_samples) = 0;
 
+    //! Conceal missing samples.
+    //!
+    //! @b Parameters
+    //!  - @p samples - buffer to write concealed samples to
+    //!  - @p n_samples - number of missing samples per channel
+    //!
+    //! @remarks
+    //!  Called when samples following previously decoded samples were lost.
+    //!  If a frame was started by begin() but not read yet, missing samples
+    //!  precede it. Codecs that support loss concealment or in-band redundancy
+    //!  use it to restore samples, other codecs fill buffer with zeros.
+    //!  Doesn't affect position() and available() of current frame.
+    //!
+    //! @returns
+    //!  number of samples per channel that were concealed; the rest of
+    //!  @p n_samples are filled with zeros.
+    virtual size_t conceal(sample_t* samples, size_t n_samples) = 0;
+
     //! Finish decoding current frame.
     //!
     //! @remarks
@@ -26,8 +26,16 @@ public:
     virtual ~IFrameEncoder();
 
     //! Get encoded frame size in bytes for given number of samples per channel.
+    //! @remarks
+    //!  For codecs with variable frame size, returns maximum size.
     virtual size_t encoded_byte_count(size_t num_samples) const = 0;
 
+    //! Get supported frame length closest to given number of samples per channel.
+    //! @remarks
+    //!  Codecs that can encode frames only of specific durations round
+    //!  @p num_samples to one of them. Other codecs return @p num_samples as is.
+    virtual size_t encoded_sample_count(size_t num_samples) const = 0;
+
     //! Start encoding a new frame.
     //!
     //! @remarks
@@ -57,7 +65,10 @@ public:
     //! @remarks
     //!  After this call, the frame is fully encoded and no more samples will be
     //!  written to the frame. A new frame should be started by calling begin().
-    virtual void end() = 0;
+    //!
+    //! @returns
+    //!  number of bytes actually written to the frame.
+    virtual size_t end() = 0;
 };
 
 } // namespace audio
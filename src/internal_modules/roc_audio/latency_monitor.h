@@ -23,7 +23,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/time.h"
 #include "roc_packet/ilink_meter.h"
-#include "roc_packet/sorted_queue.h"
+#include "roc_packet/isorted_queue.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -61,7 +61,7 @@ class LatencyMonitor : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Constructor.
     LatencyMonitor(IFrameReader& frame_reader,
-                   const packet::SortedQueue& incoming_queue,
+                   const packet::ISortedQueue& incoming_queue,
                    const Depacketizer& depacketizer,
                    const packet::ILinkMeter& link_meter,
                    ResamplerReader* resampler,
@@ -78,6 +78,11 @@ public:
     //! Get metrics.
     const LatencyMetrics& metrics() const;
 
+    //! Get scaling factor currently applied to resampler.
+    //! @remarks
+    //!  Returns 1 if scaling is disabled.
+    float scaling() const;
+
     //! Read audio frame from a pipeline.
     //! @remarks
     //!  Forwards frame from underlying reader as-is.
@@ -109,12 +114,13 @@ private:
 
     IFrameReader& frame_reader_;
 
-    const packet::SortedQueue& incoming_queue_;
+    const packet::ISortedQueue& incoming_queue_;
     const Depacketizer& depacketizer_;
     const packet::ILinkMeter& link_meter_;
 
     ResamplerReader* resampler_;
     const bool enable_scaling_;
+    float scaling_;
 
     core::nanoseconds_t capture_ts_;
 
@@ -7,14 +7,85 @@
  */
 
 #include "roc_audio/mixer.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Adds N input buffers to output buffer in one pass.
+// If Overwrite is true, output buffer is not read and its old contents is ignored.
+// Number of inputs is a compile-time constant, so the inner loop is unrolled
+// and the outer loop can be vectorized by compiler.
+template <size_t N, bool Overwrite>
+void accumulate_batch(sample_t* out_data,
+                      const sample_t* const* in_data,
+                      const size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        sample_t acc = Overwrite ? 0 : out_data[n];
+        for (size_t i = 0; i < N; i++) {
+            acc += in_data[i][n];
+        }
+        out_data[n] = acc;
+    }
+}
+
+template <bool Overwrite>
+void accumulate_batch(sample_t* out_data,
+                      const sample_t* const* in_data,
+                      const size_t n_inputs,
+                      const size_t size) {
+    switch (n_inputs) {
+    case 1:
+        accumulate_batch<1, Overwrite>(out_data, in_data, size);
+        break;
+    case 2:
+        accumulate_batch<2, Overwrite>(out_data, in_data, size);
+        break;
+    case 3:
+        accumulate_batch<3, Overwrite>(out_data, in_data, size);
+        break;
+    case 4:
+        accumulate_batch<4, Overwrite>(out_data, in_data, size);
+        break;
+    default:
+        roc_panic("mixer: unexpected batch size: %lu", (unsigned long)n_inputs);
+    }
+}
+
+// Accumulates batch of inputs into output buffer.
+// First batch overwrites output buffer, following batches are added to it.
+void mix_batch(sample_t* out_data,
+               const sample_t* const* in_data,
+               const size_t n_inputs,
+               const size_t size,
+               bool& out_initialized) {
+    if (out_initialized) {
+        accumulate_batch<false>(out_data, in_data, n_inputs, size);
+    } else {
+        accumulate_batch<true>(out_data, in_data, n_inputs, size);
+        out_initialized = true;
+    }
+}
+
+// Clamps samples to allowed range, branchless.
+void saturate(sample_t* data, const size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        sample_t s = data[n];
+        s = s > Sample_Max ? Sample_Max : s;
+        s = s < Sample_Min ? Sample_Min : s;
+        data[n] = s;
+    }
+}
+
+} // namespace
+
 Mixer::Mixer(FrameFactory& frame_factory,
              const SampleSpec& sample_spec,
              bool enable_timestamps)
@@ -25,13 +96,15 @@ Mixer::Mixer(FrameFactory& frame_factory,
                      "mixer: required valid sample spec with raw format: %s",
                      sample_spec_to_str(sample_spec_).c_str());
 
-    temp_buf_ = frame_factory.new_raw_buffer();
-    if (!temp_buf_) {
-        roc_log(LogError, "mixer: can't allocate temporary buffer");
-        return;
-    }
+    for (size_t i = 0; i < MaxBatch; i++) {
+        temp_bufs_[i] = frame_factory.new_raw_buffer();
+        if (!temp_bufs_[i]) {
+            roc_log(LogError, "mixer: can't allocate temporary buffer");
+            return;
+        }
 
-    temp_buf_.reslice(0, temp_buf_.capacity());
+        temp_bufs_[i].reslice(0, temp_bufs_[i].capacity());
+    }
 
     valid_ = true;
 }
@@ -55,6 +128,8 @@ void Mixer::remove_input(IFrameReader& reader) {
 bool Mixer::read(Frame& frame) {
     roc_panic_if(!valid_);
 
+    core::TraceScope trace("mixer");
+
     // Optimization for single reader case.
     if (readers_.size() == 1) {
         if (!readers_.front()->read(frame)) {
@@ -70,7 +145,7 @@ bool Mixer::read(Frame& frame) {
         return true;
     }
 
-    const size_t max_read = temp_buf_.size();
+    const size_t max_read = temp_bufs_[0].size();
 
     sample_t* samples = frame.raw_samples();
     size_t n_samples = frame.num_raw_samples();
@@ -79,7 +154,7 @@ bool Mixer::read(Frame& frame) {
     core::nanoseconds_t capture_ts = 0;
 
     while (n_samples != 0) {
-        // Read size is limited with the size of temporary buffer which
+        // Read size is limited with the size of temporary buffers which
         // we retrieved from pool. Usually it's big enough, but we still
         // handle situation when requested read is larger.
         size_t n_read = n_samples;
@@ -113,23 +188,25 @@ void Mixer::read_(sample_t* out_data,
     double cts_sum = 0;
     size_t cts_count = 0;
 
-    // Zeroize output frame.
-    memset(out_data, 0, out_size * sizeof(sample_t));
+    const sample_t* batch[MaxBatch];
+    size_t batch_size = 0;
+
+    // Until first batch is mixed, output buffer is not initialized.
+    bool out_initialized = false;
 
     for (IFrameReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
-        sample_t* temp_data = temp_buf_.data();
+        sample_t* temp_data = temp_bufs_[batch_size].data();
 
         Frame temp_frame(temp_data, out_size);
         if (!rp->read(temp_frame)) {
             continue;
         }
 
-        for (size_t n = 0; n < out_size; n++) {
-            out_data[n] += temp_data[n];
+        batch[batch_size++] = temp_data;
 
-            // Saturate on overflow.
-            out_data[n] = std::min(out_data[n], Sample_Max);
-            out_data[n] = std::max(out_data[n], Sample_Min);
+        if (batch_size == MaxBatch) {
+            mix_batch(out_data, batch, batch_size, out_size, out_initialized);
+            batch_size = 0;
         }
 
         // Accumulate flags from all mixed frames.
@@ -150,6 +227,21 @@ void Mixer::read_(sample_t* out_data,
         }
     }
 
+    if (batch_size != 0) {
+        mix_batch(out_data, batch, batch_size, out_size, out_initialized);
+    }
+
+    if (out_initialized) {
+        // Saturate on overflow.
+        // Intermediate sums are not clamped, so we do it once for all inputs.
+        saturate(out_data, out_size);
+
+        CopyCounter::instance().add(CopyStage_Mixer, out_size);
+    } else {
+        // No inputs were read.
+        memset(out_data, 0, out_size * sizeof(sample_t));
+    }
+
     if (cts_count != 0) {
         // Compute average timestamp.
         // Don't forget to compensate everything that we subtracted above.
@@ -39,6 +39,10 @@ namespace audio {
 //!  5, 7, 9, ...
 //! @endcode
 //!
+//! Inputs are read into temporary buffers and accumulated in batches, several
+//! inputs per pass over output buffer. Output is saturated once, after all
+//! inputs are accumulated.
+//!
 //! If timestamps are enabled, mixer computes capture timestamp of output
 //! frame as the average capture timestamps of all mixed input frames.
 //! This makes sense only when all inputs are synchronized and their
@@ -46,7 +50,7 @@ namespace audio {
 class Mixer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
-    //! @p buffer_factory is used to allocate a temporary buffer for mixing.
+    //! @p frame_factory is used to allocate temporary buffers for mixing.
     //! @p enable_timestamps defines whether to enable calculation of capture timestamps.
     Mixer(FrameFactory& frame_factory,
           const SampleSpec& sample_spec,
@@ -68,13 +72,16 @@ public:
     virtual bool read(Frame& frame);
 
 private:
+    // How many inputs are accumulated per one pass over output buffer.
+    enum { MaxBatch = 4 };
+
     void read_(sample_t* out_data,
                size_t out_size,
                unsigned& out_flags,
                core::nanoseconds_t& out_cts);
 
     core::List<IFrameReader, core::NoOwnership> readers_;
-    core::Slice<sample_t> temp_buf_;
+    core::Slice<sample_t> temp_bufs_[MaxBatch];
 
     const SampleSpec sample_spec_;
     const bool enable_timestamps_;
@@ -15,6 +15,14 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+enum { SilenceBufSize = 1024 };
+
+const sample_t silence_buf[SilenceBufSize] = { 0 };
+
+} // namespace
+
 Packetizer::Packetizer(packet::IWriter& writer,
                        packet::IComposer& composer,
                        packet::ISequencer& sequencer,
@@ -47,7 +55,18 @@ Packetizer::Packetizer(packet::IWriter& writer,
         return;
     }
 
-    samples_per_packet_ = sample_spec.ns_2_stream_timestamp(packet_length);
+    samples_per_packet_ = payload_encoder.encoded_sample_count(
+        sample_spec.ns_2_stream_timestamp(packet_length));
+
+    if (samples_per_packet_ != sample_spec.ns_2_stream_timestamp(packet_length)) {
+        roc_log(LogInfo,
+                "packetizer: packet length adjusted to one supported by encoder:"
+                " requested=%.3fms actual=%.3fms",
+                (double)packet_length / core::Millisecond,
+                (double)sample_spec.samples_per_chan_2_ns(samples_per_packet_)
+                    / core::Millisecond);
+    }
+
     payload_size_ = payload_encoder.encoded_byte_count(samples_per_packet_);
 
     roc_log(
@@ -131,20 +150,26 @@ bool Packetizer::begin_packet_() {
 }
 
 void Packetizer::end_packet_() {
-    // How much bytes we've written into packet payload.
-    const size_t written_payload_size = payload_encoder_.encoded_byte_count(packet_pos_);
-    roc_panic_if_not(written_payload_size <= payload_size_);
+    // If packet is incomplete and encoder can't encode partial frame
+    // of this size, fill the rest of packet with silence, so that
+    // encoded duration matches packet duration.
+    if (packet_pos_ < samples_per_packet_
+        && payload_encoder_.encoded_sample_count(packet_pos_) != packet_pos_) {
+        pad_samples_();
+    }
 
     // Finish encoding samples into packet.
-    payload_encoder_.end();
+    // Returns how much bytes we've written into packet payload.
+    const size_t written_payload_size = payload_encoder_.end();
+    roc_panic_if_not(written_payload_size <= payload_size_);
 
     // Fill protocol-specific fields.
     sequencer_.next(*packet_, packet_cts_, (packet::stream_timestamp_t)packet_pos_);
 
     // Apply padding if needed.
-    if (packet_pos_ < samples_per_packet_) {
-        pad_packet_(written_payload_size);
-    }
+    // Padding is needed if packet is incomplete, or if encoder produced
+    // frame smaller than maximum size.
+    pad_packet_(written_payload_size);
 
     const status::StatusCode code = writer_.write(packet_);
     // TODO(gh-183): forward status
@@ -158,6 +183,20 @@ void Packetizer::end_packet_() {
     packet_cts_ = 0;
 }
 
+void Packetizer::pad_samples_() {
+    const size_t max_chunk = SilenceBufSize / sample_spec_.num_channels();
+    roc_panic_if_not(max_chunk > 0);
+
+    while (packet_pos_ < samples_per_packet_) {
+        const size_t n_requested = std::min(max_chunk, samples_per_packet_ - packet_pos_);
+
+        const size_t n_encoded = payload_encoder_.write(silence_buf, n_requested);
+        roc_panic_if_not(n_encoded == n_requested);
+
+        packet_pos_ += n_encoded;
+    }
+}
+
 void Packetizer::pad_packet_(size_t written_payload_size) {
     if (written_payload_size == payload_size_) {
         return;
@@ -81,13 +81,15 @@ public:
 
     //! Flush buffered packet, if any.
     //! @remarks
-    //!  Packet is padded to match fixed size.
+    //!  Packet is padded to match fixed size. If encoder can't encode
+    //!  partial packet as is, missing samples are filled with silence.
     void flush();
 
 private:
     bool begin_packet_();
     void end_packet_();
 
+    void pad_samples_();
     void pad_packet_(size_t written_payload_size);
 
     packet::PacketPtr create_packet_();
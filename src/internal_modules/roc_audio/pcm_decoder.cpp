@@ -101,6 +101,13 @@ size_t PcmDecoder::shift(size_t n_samples) {
     return n_samples;
 }
 
+size_t PcmDecoder::conceal(sample_t* samples, size_t n_samples) {
+    // PCM has no redundancy to restore lost samples from.
+    memset(samples, 0, n_samples * n_chans_ * sizeof(sample_t));
+
+    return 0;
+}
+
 void PcmDecoder::end() {
     if (!frame_data_) {
         roc_panic("pcm decoder: unpaired begin/end");
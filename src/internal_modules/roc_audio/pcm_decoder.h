@@ -49,6 +49,9 @@ public:
     //! Shift samples from current frame.
     virtual size_t shift(size_t n_samples);
 
+    //! Conceal missing samples.
+    virtual size_t conceal(sample_t* samples, size_t n_samples);
+
     //! Finish decoding current frame.
     virtual void end();
 
@@ -28,6 +28,10 @@ size_t PcmEncoder::encoded_byte_count(size_t num_samples) const {
     return pcm_mapper_.output_byte_count(num_samples * n_chans_);
 }
 
+size_t PcmEncoder::encoded_sample_count(size_t num_samples) const {
+    return num_samples;
+}
+
 void PcmEncoder::begin(void* frame_data, size_t frame_size) {
     roc_panic_if_not(frame_data);
 
@@ -58,14 +62,18 @@ size_t PcmEncoder::write(const sample_t* samples, size_t n_samples) {
     return n_mapped_samples;
 }
 
-void PcmEncoder::end() {
+size_t PcmEncoder::end() {
     if (!frame_data_) {
         roc_panic("pcm encoder: unpaired begin/end");
     }
 
+    const size_t frame_byte_count = (frame_bit_off_ + 7) / 8;
+
     frame_data_ = NULL;
     frame_byte_size_ = 0;
     frame_bit_off_ = 0;
+
+    return frame_byte_count;
 }
 
 } // namespace audio
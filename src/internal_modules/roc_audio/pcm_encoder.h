@@ -32,6 +32,9 @@ public:
     //! Get encoded frame size in bytes for given number of samples per channel.
     virtual size_t encoded_byte_count(size_t num_samples) const;
 
+    //! Get supported frame length closest to given number of samples per channel.
+    virtual size_t encoded_sample_count(size_t num_samples) const;
+
     //! Start encoding a new frame.
     virtual void begin(void* frame, size_t frame_size);
 
@@ -39,7 +42,7 @@ public:
     virtual size_t write(const sample_t* samples, size_t n_samples);
 
     //! Finish encoding frame.
-    virtual void end();
+    virtual size_t end();
 
 private:
     PcmMapper pcm_mapper_;
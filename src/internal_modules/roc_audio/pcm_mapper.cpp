@@ -13,12 +13,104 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Specialized mapping functions for common byte-aligned format pairs.
+// Unlike generic functions, they don't handle bit offsets, and process
+// samples in simple branchless loops, which compiler can vectorize.
+// Results are identical to generic functions.
+
+template <bool IsLittle> inline int16_t read_sint16(const uint8_t* p) {
+    return IsLittle ? int16_t(uint16_t(p[0] | (p[1] << 8)))
+                    : int16_t(uint16_t((p[0] << 8) | p[1]));
+}
+
+template <bool IsLittle> inline void write_sint16(uint8_t* p, int16_t v) {
+    const uint16_t u = uint16_t(v);
+    p[IsLittle ? 0 : 1] = uint8_t(u & 0xff);
+    p[IsLittle ? 1 : 0] = uint8_t(u >> 8);
+}
+
+template <bool IsLittle> inline int32_t read_sint24(const uint8_t* p) {
+    // Place 24 bits into high bits, and then shift back to sign-extend.
+    const uint32_t u = IsLittle
+        ? (uint32_t(p[2]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[0]) << 8)
+        : (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8);
+    return int32_t(u) >> 8;
+}
+
+template <bool IsLittle> inline void write_sint24(uint8_t* p, int32_t v) {
+    const uint32_t u = uint32_t(v);
+    p[IsLittle ? 0 : 2] = uint8_t(u & 0xff);
+    p[1] = uint8_t((u >> 8) & 0xff);
+    p[IsLittle ? 2 : 0] = uint8_t((u >> 16) & 0xff);
+}
+
+// Scaling by power of two is exact in float, so there is no need to use double.
+const float SInt16_Scale = 32768.0f;
+const float SInt24_Scale = 8388608.0f;
+
+template <bool IsLittle>
+void map_sint16_to_float32(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+    float* out = (float*)out_data;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = float(read_sint16<IsLittle>(in_data + n * 2)) * (1.0f / SInt16_Scale);
+    }
+}
+
+template <bool IsLittle>
+void map_float32_to_sint16(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+    const float* in = (const float*)in_data;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        float f = in[n] * SInt16_Scale;
+        // Clip, then truncate towards zero.
+        f = f < -SInt16_Scale ? -SInt16_Scale : f;
+        f = f > SInt16_Scale - 1 ? SInt16_Scale - 1 : f;
+        write_sint16<IsLittle>(out_data + n * 2, int16_t(f));
+    }
+}
+
+template <bool IsLittle>
+void map_sint24_to_float32(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+    float* out = (float*)out_data;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = float(read_sint24<IsLittle>(in_data + n * 3)) * (1.0f / SInt24_Scale);
+    }
+}
+
+template <bool IsLittle>
+void map_float32_to_sint24(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+    const float* in = (const float*)in_data;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        float f = in[n] * SInt24_Scale;
+        // Clip, then truncate towards zero.
+        f = f < -SInt24_Scale ? -SInt24_Scale : f;
+        f = f > SInt24_Scale - 1 ? SInt24_Scale - 1 : f;
+        write_sint24<IsLittle>(out_data + n * 3, int32_t(f));
+    }
+}
+
+// Float side of fast mapping is accessed directly and should be aligned.
+bool is_aligned(const uint8_t* data, const PcmTraits& traits) {
+    if (traits.is_integer) {
+        return true;
+    }
+    return (uintptr_t)data % (traits.bit_width / 8) == 0;
+}
+
+} // namespace
+
 PcmMapper::PcmMapper(PcmFormat input_fmt, PcmFormat output_fmt)
     : input_fmt_(input_fmt)
     , output_fmt_(output_fmt)
     , input_traits_(pcm_format_traits(input_fmt))
     , output_traits_(pcm_format_traits(output_fmt))
-    , map_func_(pcm_format_mapfn(input_fmt, output_fmt)) {
+    , map_func_(pcm_format_mapfn(input_fmt, output_fmt))
+    , fast_map_func_(select_fast_map_(input_traits_, output_traits_)) {
     if (!input_traits_.is_valid) {
         roc_panic("pcm mapper: input format is not a pcm format");
     }
@@ -82,7 +174,18 @@ size_t PcmMapper::map(const void* in_data,
     n_samples =
         std::min(n_samples, (out_byte_size * 8 - out_bit_off) / output_traits_.bit_width);
 
-    if (n_samples != 0) {
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (can_fast_map_((const uint8_t*)in_data, in_bit_off, (const uint8_t*)out_data,
+                      out_bit_off)) {
+        fast_map_func_((const uint8_t*)in_data + in_bit_off / 8,
+                       (uint8_t*)out_data + out_bit_off / 8, n_samples);
+
+        in_bit_off += n_samples * input_traits_.bit_width;
+        out_bit_off += n_samples * output_traits_.bit_width;
+    } else {
         map_func_((const uint8_t*)in_data, in_bit_off, (uint8_t*)out_data, out_bit_off,
                   n_samples);
     }
@@ -90,5 +193,58 @@ size_t PcmMapper::map(const void* in_data,
     return n_samples;
 }
 
+PcmMapper::FastMapFn PcmMapper::select_fast_map_(const PcmTraits& in_traits,
+                                                 const PcmTraits& out_traits) {
+    const PcmFormat float_fmt = pcm_format_traits(PcmFormat_Float32).canon_id;
+
+    if (out_traits.canon_id == float_fmt) {
+        switch (in_traits.canon_id) {
+        case PcmFormat_SInt16_Be:
+            return &map_sint16_to_float32<false>;
+        case PcmFormat_SInt16_Le:
+            return &map_sint16_to_float32<true>;
+        case PcmFormat_SInt24_Be:
+            return &map_sint24_to_float32<false>;
+        case PcmFormat_SInt24_Le:
+            return &map_sint24_to_float32<true>;
+        default:
+            break;
+        }
+    }
+
+    if (in_traits.canon_id == float_fmt) {
+        switch (out_traits.canon_id) {
+        case PcmFormat_SInt16_Be:
+            return &map_float32_to_sint16<false>;
+        case PcmFormat_SInt16_Le:
+            return &map_float32_to_sint16<true>;
+        case PcmFormat_SInt24_Be:
+            return &map_float32_to_sint24<false>;
+        case PcmFormat_SInt24_Le:
+            return &map_float32_to_sint24<true>;
+        default:
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+bool PcmMapper::can_fast_map_(const uint8_t* in_data,
+                              size_t in_bit_off,
+                              const uint8_t* out_data,
+                              size_t out_bit_off) const {
+    if (!fast_map_func_) {
+        return false;
+    }
+
+    if (in_bit_off % 8 != 0 || out_bit_off % 8 != 0) {
+        return false;
+    }
+
+    return is_aligned(in_data + in_bit_off / 8, input_traits_)
+        && is_aligned(out_data + out_bit_off / 8, output_traits_);
+}
+
 } // namespace audio
 } // namespace roc
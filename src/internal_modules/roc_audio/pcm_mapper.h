@@ -21,6 +21,11 @@ namespace audio {
 
 //! PCM format mapper.
 //! Convert between PCM formats.
+//!
+//! Most format pairs are handled by generic mapping functions, which support
+//! arbitrary bit offsets. For a few common pairs (16-bit and 24-bit signed
+//! integers of either endian to and from native 32-bit float), mapper has
+//! specialized functions, which are used when input and output are byte-aligned.
 class PcmMapper : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -75,6 +80,16 @@ public:
                size_t n_samples);
 
 private:
+    typedef void (*FastMapFn)(const uint8_t* in_data, uint8_t* out_data, size_t n_samples);
+
+    static FastMapFn select_fast_map_(const PcmTraits& in_traits,
+                                      const PcmTraits& out_traits);
+
+    bool can_fast_map_(const uint8_t* in_data,
+                       size_t in_bit_off,
+                       const uint8_t* out_data,
+                       size_t out_bit_off) const;
+
     const PcmFormat input_fmt_;
     const PcmFormat output_fmt_;
 
@@ -82,6 +97,7 @@ private:
     const PcmTraits output_traits_;
 
     PcmMapFn map_func_;
+    FastMapFn fast_map_func_;
 };
 
 } // namespace audio
@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/pcm_mapper_reader.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_audio/sample_format.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
@@ -109,6 +110,8 @@ bool PcmMapperReader::read(Frame& out_frame) {
     out_frame.set_flags(out_flags);
     out_frame.set_duration(out_sample_count);
 
+    CopyCounter::instance().add(CopyStage_PcmMapper, out_sample_count * num_ch_);
+
     return true;
 }
 
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/plc_reader.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Pitch search is first done with this resolution, and then refined.
+const size_t SearchRate = 8000;
+
+} // namespace
+
+void PlcConfig::deduce_defaults() {
+    if (min_pitch_period == 0) {
+        min_pitch_period = 2500 * core::Microsecond;
+    }
+
+    if (max_pitch_period == 0) {
+        max_pitch_period = 15 * core::Millisecond;
+    }
+
+    if (fade_duration == 0) {
+        fade_duration = 2500 * core::Microsecond;
+    }
+
+    if (max_duration == 0) {
+        max_duration = 60 * core::Millisecond;
+    }
+}
+
+PlcReader::PlcReader(IFrameReader& reader,
+                     const SampleSpec& sample_spec,
+                     const PlcConfig& config,
+                     core::IArena& arena)
+    : reader_(reader)
+    , n_chans_(sample_spec.num_channels())
+    , min_pitch_(0)
+    , max_pitch_(0)
+    , fade_len_(0)
+    , max_len_(0)
+    , search_stride_(0)
+    , history_(arena)
+    , history_len_(0)
+    , history_pos_(0)
+    , history_size_(0)
+    , pitch_buf_(arena)
+    , pitch_mono_(arena)
+    , pitch_period_(0)
+    , in_gap_(false)
+    , synth_pos_(0)
+    , fade_remaining_(0)
+    , valid_(false) {
+    if (!sample_spec.is_valid() || !sample_spec.is_raw()) {
+        roc_log(LogError, "plc reader: invalid sample spec: %s",
+                sample_spec_to_str(sample_spec).c_str());
+        return;
+    }
+
+    min_pitch_ = std::max(sample_spec.ns_2_samples_per_chan(config.min_pitch_period),
+                          (size_t)1);
+    max_pitch_ = sample_spec.ns_2_samples_per_chan(config.max_pitch_period);
+    fade_len_ = config.fade_duration > 0
+        ? sample_spec.ns_2_samples_per_chan(config.fade_duration)
+        : 0;
+    max_len_ = sample_spec.ns_2_samples_per_chan(config.max_duration);
+    search_stride_ = std::max(sample_spec.sample_rate() / SearchRate, (size_t)1);
+
+    if (min_pitch_ > max_pitch_ || max_len_ == 0) {
+        roc_log(LogError,
+                "plc reader: invalid config:"
+                " min_pitch=%lu max_pitch=%lu max_len=%lu",
+                (unsigned long)min_pitch_, (unsigned long)max_pitch_,
+                (unsigned long)max_len_);
+        return;
+    }
+
+    // History should be large enough to compare last max_pitch_ samples
+    // with max_pitch_ samples preceding them.
+    history_len_ = max_pitch_ * 2;
+
+    if (!history_.resize(history_len_ * n_chans_)
+        || !pitch_buf_.resize(history_len_ * n_chans_)
+        || !pitch_mono_.resize(history_len_)) {
+        roc_log(LogError, "plc reader: can't allocate history");
+        return;
+    }
+
+    roc_log(LogDebug,
+            "plc reader: initializing:"
+            " min_pitch=%lu max_pitch=%lu fade_len=%lu max_len=%lu",
+            (unsigned long)min_pitch_, (unsigned long)max_pitch_,
+            (unsigned long)fade_len_, (unsigned long)max_len_);
+
+    valid_ = true;
+}
+
+bool PlcReader::is_valid() const {
+    return valid_;
+}
+
+const PlcMetrics& PlcReader::metrics() const {
+    return metrics_;
+}
+
+bool PlcReader::read(Frame& frame) {
+    roc_panic_if(!is_valid());
+
+    if (!reader_.read(frame)) {
+        return false;
+    }
+
+    if (frame.num_gaps() == 0 && !in_gap_ && fade_remaining_ == 0) {
+        // Fast path, nothing was lost.
+        append_history_(frame.raw_samples(), frame.num_raw_samples() / n_chans_);
+        return true;
+    }
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    const size_t n_concealed = conceal_frame_(frame);
+
+    if (n_concealed != 0) {
+        const core::nanoseconds_t elapsed =
+            core::timestamp(core::ClockMonotonic) - start_time;
+
+        metrics_.concealed_frames++;
+        metrics_.concealed_samples += n_concealed;
+        metrics_.conceal_time += elapsed;
+        metrics_.max_conceal_time = std::max(metrics_.max_conceal_time, elapsed);
+    }
+
+    return true;
+}
+
+size_t PlcReader::conceal_frame_(const Frame& frame) {
+    sample_t* samples = frame.raw_samples();
+    const size_t n_samples = frame.num_raw_samples() / n_chans_;
+
+    size_t n_concealed = 0;
+    size_t pos = 0;
+
+    for (size_t n = 0; n < frame.num_gaps(); n++) {
+        const size_t gap_begin = std::min(frame.gap_offset(n), n_samples);
+        const size_t gap_end =
+            std::min(frame.gap_offset(n) + frame.gap_length(n), n_samples);
+
+        if (gap_begin > pos) {
+            pass_signal_(samples + pos * n_chans_, gap_begin - pos);
+        }
+
+        if (gap_end > gap_begin) {
+            n_concealed += conceal_gap_(samples + gap_begin * n_chans_,
+                                        gap_end - gap_begin);
+        }
+
+        pos = std::max(pos, gap_end);
+    }
+
+    if (pos < n_samples) {
+        pass_signal_(samples + pos * n_chans_, n_samples - pos);
+    }
+
+    return n_concealed;
+}
+
+size_t PlcReader::conceal_gap_(sample_t* samples, size_t n_samples) {
+    // Gap, either new or continued from previous frame.
+    if (!in_gap_ && !begin_gap_()) {
+        return 0;
+    }
+
+    return synthesize_(samples, n_samples);
+}
+
+void PlcReader::pass_signal_(sample_t* samples, size_t n_samples) {
+    if (in_gap_) {
+        end_gap_();
+    }
+
+    if (fade_remaining_ != 0) {
+        cross_fade_(samples, n_samples);
+    }
+
+    append_history_(samples, n_samples);
+}
+
+bool PlcReader::begin_gap_() {
+    if (history_size_ < history_len_) {
+        // Not enough history, e.g. gap before first packet.
+        return false;
+    }
+
+    // Unroll ring buffer.
+    const size_t tail_len = history_len_ - history_pos_;
+
+    memcpy(pitch_buf_.data(), history_.data() + history_pos_ * n_chans_,
+           tail_len * n_chans_ * sizeof(sample_t));
+    memcpy(pitch_buf_.data() + tail_len * n_chans_, history_.data(),
+           history_pos_ * n_chans_ * sizeof(sample_t));
+
+    for (size_t n = 0; n < history_len_; n++) {
+        sample_t sum = 0;
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            sum += pitch_buf_[n * n_chans_ + ch];
+        }
+        pitch_mono_[n] = sum;
+    }
+
+    pitch_period_ = find_pitch_();
+
+    in_gap_ = true;
+    synth_pos_ = 0;
+    fade_remaining_ = 0;
+
+    roc_log(LogTrace, "plc reader: starting concealment: pitch_period=%lu",
+            (unsigned long)pitch_period_);
+
+    return true;
+}
+
+void PlcReader::end_gap_() {
+    in_gap_ = false;
+    fade_remaining_ = fade_len_;
+}
+
+size_t PlcReader::find_pitch_() const {
+    size_t best_lag = max_pitch_;
+    float best_score = 0;
+
+    // Coarse search.
+    for (size_t lag = min_pitch_; lag <= max_pitch_; lag += search_stride_) {
+        const float score = pitch_score_(lag, search_stride_);
+        if (score > best_score) {
+            best_score = score;
+            best_lag = lag;
+        }
+    }
+
+    // Refine around best coarse lag.
+    const size_t from = std::max(best_lag - std::min(best_lag, search_stride_ - 1),
+                                 min_pitch_);
+    const size_t to = std::min(best_lag + search_stride_ - 1, max_pitch_);
+
+    best_score = 0;
+
+    for (size_t lag = from; lag <= to; lag++) {
+        const float score = pitch_score_(lag, 1);
+        if (score > best_score) {
+            best_score = score;
+            best_lag = lag;
+        }
+    }
+
+    return best_lag;
+}
+
+float PlcReader::pitch_score_(size_t lag, size_t stride) const {
+    // Compare last max_pitch_ samples with samples delayed by lag.
+    const size_t win_start = history_len_ - max_pitch_;
+
+    float corr = 0, energy = 0;
+
+    for (size_t n = win_start; n < history_len_; n += stride) {
+        const sample_t delayed = pitch_mono_[n - lag];
+        corr += pitch_mono_[n] * delayed;
+        energy += delayed * delayed;
+    }
+
+    if (!(energy > 0)) {
+        return 0;
+    }
+
+    return corr / sqrtf(energy);
+}
+
+sample_t PlcReader::synth_sample_(size_t pos, size_t ch) const {
+    if (pos >= max_len_) {
+        return 0;
+    }
+
+    // Repeat last pitch period of history.
+    const size_t src = history_len_ - pitch_period_ + pos % pitch_period_;
+
+    // Keep full volume during first quarter, then fade out linearly.
+    const size_t hold_len = max_len_ / 4;
+    float gain = 1;
+    if (pos > hold_len) {
+        gain = float(max_len_ - pos) / float(max_len_ - hold_len);
+    }
+
+    return pitch_buf_[src * n_chans_ + ch] * gain;
+}
+
+size_t PlcReader::synthesize_(sample_t* samples, size_t n_samples) {
+    if (synth_pos_ >= max_len_) {
+        // Gap is too long, keep silence.
+        return 0;
+    }
+
+    const size_t n_synth = std::min(n_samples, max_len_ - synth_pos_);
+
+    for (size_t n = 0; n < n_synth; n++) {
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            samples[n * n_chans_ + ch] = synth_sample_(synth_pos_, ch);
+        }
+        synth_pos_++;
+    }
+
+    synth_pos_ += n_samples - n_synth;
+
+    return n_synth;
+}
+
+void PlcReader::cross_fade_(sample_t* samples, size_t n_samples) {
+    const size_t n_fade = std::min(n_samples, fade_remaining_);
+
+    for (size_t n = 0; n < n_fade; n++) {
+        const float weight =
+            float(fade_len_ - fade_remaining_ + 1) / float(fade_len_ + 1);
+
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            sample_t& s = samples[n * n_chans_ + ch];
+            s = s * weight + synth_sample_(synth_pos_, ch) * (1 - weight);
+        }
+
+        synth_pos_++;
+        fade_remaining_--;
+    }
+}
+
+void PlcReader::append_history_(const sample_t* samples, size_t n_samples) {
+    if (n_samples > history_len_) {
+        samples += (n_samples - history_len_) * n_chans_;
+        n_samples = history_len_;
+    }
+
+    while (n_samples != 0) {
+        const size_t n_chunk = std::min(n_samples, history_len_ - history_pos_);
+
+        memcpy(history_.data() + history_pos_ * n_chans_, samples,
+               n_chunk * n_chans_ * sizeof(sample_t));
+
+        samples += n_chunk * n_chans_;
+        n_samples -= n_chunk;
+
+        history_pos_ = (history_pos_ + n_chunk) % history_len_;
+        history_size_ = std::min(history_size_ + n_chunk, history_len_);
+    }
+}
+
+} // namespace audio
+} // namespace roc
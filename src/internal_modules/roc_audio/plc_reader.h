@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/plc_reader.h
+//! @brief Packet loss concealment reader.
+
+#ifndef ROC_AUDIO_PLC_READER_H_
+#define ROC_AUDIO_PLC_READER_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+
+//! Packet loss concealment parameters.
+struct PlcConfig {
+    //! Minimum pitch period to search for, nanoseconds.
+    //! @note
+    //!  If zero, default value is used.
+    core::nanoseconds_t min_pitch_period;
+
+    //! Maximum pitch period to search for, nanoseconds.
+    //! @remarks
+    //!  Defines how much history is kept and how much CPU is spent on pitch
+    //!  search in the beginning of every gap.
+    //! @note
+    //!  If zero, default value is used.
+    core::nanoseconds_t max_pitch_period;
+
+    //! Duration of cross-fade from concealed signal to real signal, nanoseconds.
+    //! @note
+    //!  If zero, default value is used.
+    //!  If negative, cross-fade is disabled.
+    core::nanoseconds_t fade_duration;
+
+    //! Maximum duration of concealment, nanoseconds.
+    //! @remarks
+    //!  Concealed signal is attenuated during this period and long gaps
+    //!  become silence, to avoid buzzing.
+    //! @note
+    //!  If zero, default value is used.
+    core::nanoseconds_t max_duration;
+
+    //! Initialize config with default values.
+    PlcConfig()
+        : min_pitch_period(0)
+        , max_pitch_period(0)
+        , fade_duration(0)
+        , max_duration(0) {
+    }
+
+    //! Automatically fill missing settings.
+    void deduce_defaults();
+};
+
+//! Packet loss concealment metrics.
+struct PlcMetrics {
+    //! Number of frames where some samples were concealed.
+    size_t concealed_frames;
+
+    //! Number of concealed samples per channel.
+    //! Samples of long gaps which were left silent are not counted.
+    size_t concealed_samples;
+
+    //! Total time spent on concealment, nanoseconds.
+    core::nanoseconds_t conceal_time;
+
+    //! Maximum time spent on concealment of one frame, nanoseconds.
+    core::nanoseconds_t max_conceal_time;
+
+    PlcMetrics()
+        : concealed_frames(0)
+        , concealed_samples(0)
+        , conceal_time(0)
+        , max_conceal_time(0) {
+    }
+};
+
+//! Packet loss concealment reader.
+//!
+//! Replaces gaps caused by lost packets with pitch-based waveform repetition.
+//!
+//! Frames without gaps (see Frame::num_gaps()) are passed through and only
+//! copied into history. Gaps are reported by depacketizer and cover only
+//! samples that were actually lost, so silence present in the signal itself
+//! is never replaced. In the beginning of every gap, pitch period is estimated
+//! using autocorrelation of history, and the gap is filled by repeating last
+//! pitch period of history, with attenuation. When real signal resumes, it is
+//! cross-faded with concealed signal.
+//!
+//! If gaps were already concealed by decoder, they are not reported and frame
+//! is left untouched.
+//!
+//! CPU usage is bounded: pitch search is done once per gap and its cost
+//! depends only on configured pitch range, and the rest is linear.
+class PlcReader : public IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PlcReader(IFrameReader& reader,
+              const SampleSpec& sample_spec,
+              const PlcConfig& config,
+              core::IArena& arena);
+
+    //! Check if object is successfully constructed.
+    bool is_valid() const;
+
+    //! Get metrics.
+    const PlcMetrics& metrics() const;
+
+    //! Read audio frame.
+    virtual bool read(Frame& frame);
+
+private:
+    size_t conceal_frame_(const Frame& frame);
+
+    size_t conceal_gap_(sample_t* samples, size_t n_samples);
+    void pass_signal_(sample_t* samples, size_t n_samples);
+
+    bool begin_gap_();
+    void end_gap_();
+
+    size_t find_pitch_() const;
+    float pitch_score_(size_t lag, size_t stride) const;
+
+    sample_t synth_sample_(size_t pos, size_t ch) const;
+    size_t synthesize_(sample_t* samples, size_t n_samples);
+    void cross_fade_(sample_t* samples, size_t n_samples);
+
+    void append_history_(const sample_t* samples, size_t n_samples);
+
+    IFrameReader& reader_;
+
+    const size_t n_chans_;
+
+    size_t min_pitch_;
+    size_t max_pitch_;
+    size_t fade_len_;
+    size_t max_len_;
+    size_t search_stride_;
+
+    // Ring buffer with last history_len_ samples of real signal.
+    core::Array<sample_t> history_;
+    size_t history_len_;
+    size_t history_pos_;
+    size_t history_size_;
+
+    // Linear copy of history and its mono downmix, made in the beginning of gap.
+    core::Array<sample_t> pitch_buf_;
+    core::Array<sample_t> pitch_mono_;
+    size_t pitch_period_;
+
+    bool in_gap_;
+    size_t synth_pos_;
+    size_t fade_remaining_;
+
+    PlcMetrics metrics_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PLC_READER_H_
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Cutoff frequency, relative to Nyquist frequency of the lower rate.
+const double CutoffFreq = 0.9;
+
+// How much scaling may deviate from nominal ratio.
+// Filter bank is designed for nominal ratio, so large deviations would
+// cause aliasing when downsampling.
+const double MaxScalingDeviation = 0.1;
+
+// One in terms of 32-bit fraction of phase.
+const uint64_t PhaseFractOne = (uint64_t)1 << 32;
+
+// Number of taps on each side of the filter, when not downsampling.
+size_t get_half_taps(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 8;
+
+    case ResamplerProfile_Medium:
+        return 16;
+
+    case ResamplerProfile_High:
+        return 32;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+// Minimum number of phases, defines quality of interpolation between phases.
+size_t get_min_phases(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 64;
+
+    case ResamplerProfile_Medium:
+        return 128;
+
+    case ResamplerProfile_High:
+        return 256;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+// Maximum number of phases, limits memory used by filter bank.
+size_t get_max_phases(ResamplerProfile profile) {
+    return get_min_phases(profile) * 4;
+}
+
+size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        const size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Windowed sinc, t is in input samples, half_width is window half width.
+double windowed_sinc(double t, double cutoff, double half_width) {
+    if (t <= -half_width || t >= half_width) {
+        return 0;
+    }
+
+    const double sinc =
+        t == 0 ? cutoff : std::sin(M_PI * cutoff * t) / (M_PI * t);
+
+    // Blackman window.
+    const double x = t / half_width;
+    const double window =
+        0.42 + 0.5 * std::cos(M_PI * x) + 0.08 * std::cos(2 * M_PI * x);
+
+    return sinc * window;
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler(core::IArena& arena,
+                                       FrameFactory& frame_factory,
+                                       ResamplerProfile profile,
+                                       const SampleSpec& in_spec,
+                                       const SampleSpec& out_spec)
+    : IResampler(arena)
+    , in_spec_(in_spec)
+    , out_spec_(out_spec)
+    , num_ch_(in_spec.num_channels())
+    , nominal_scaling_(out_spec.sample_rate() != 0
+                           ? (double)in_spec.sample_rate() / out_spec.sample_rate()
+                           : 0)
+    , num_phases_(0)
+    , half_taps_(0)
+    , num_taps_(0)
+    , filter_bank_(arena)
+    , interp_coeffs_(arena)
+    , in_buf_size_(0)
+    , in_frame_size_(0)
+    , in_len_(0)
+    , pos_index_(0)
+    , pos_phase_(0)
+    , pos_phase_fract_(0)
+    , step_index_(0)
+    , step_phase_(0)
+    , step_phase_fract_(0)
+    , valid_(false) {
+    if (!check_config_()) {
+        return;
+    }
+
+    if (!init_phases_(profile)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "polyphase resampler: initializing:"
+            " profile=%s num_phases=%lu num_taps=%lu num_ch=%lu",
+            resampler_profile_to_str(profile), (unsigned long)num_phases_,
+            (unsigned long)num_taps_, (unsigned long)num_ch_);
+
+    if (!fill_filter_bank_()) {
+        return;
+    }
+
+    if (!alloc_buffers_(frame_factory)) {
+        return;
+    }
+
+    valid_ = true;
+
+    if (!set_scaling(in_spec_.sample_rate(), out_spec_.sample_rate(), 1.0f)) {
+        valid_ = false;
+        return;
+    }
+}
+
+PolyphaseResampler::~PolyphaseResampler() {
+}
+
+bool PolyphaseResampler::is_valid() const {
+    return valid_;
+}
+
+bool PolyphaseResampler::set_scaling(size_t input_rate,
+                                     size_t output_rate,
+                                     float multiplier) {
+    roc_panic_if_not(is_valid());
+
+    if (input_rate == 0 || output_rate == 0 || multiplier <= 0) {
+        roc_log(LogError,
+                "polyphase resampler: scaling out of range:"
+                " in_rate=%lu out_rate=%lu mult=%e",
+                (unsigned long)input_rate, (unsigned long)output_rate,
+                (double)multiplier);
+        return false;
+    }
+
+    const double new_scaling =
+        (double)input_rate / (double)output_rate * (double)multiplier;
+
+    if (new_scaling > nominal_scaling_ * (1 + MaxScalingDeviation)
+        || new_scaling < nominal_scaling_ / (1 + MaxScalingDeviation)) {
+        roc_log(LogError,
+                "polyphase resampler: scaling too far from nominal ratio:"
+                " in_rate=%lu out_rate=%lu mult=%e nominal_scaling=%.5f",
+                (unsigned long)input_rate, (unsigned long)output_rate,
+                (double)multiplier, nominal_scaling_);
+        return false;
+    }
+
+    // Distance between output samples in phases, in 32.32 fixed point.
+    // When multiplier is 1.0 and rates are nominal, it's an exact integer,
+    // so every output sample falls exactly on one of the phases.
+    const double step =
+        (double)input_rate * (double)num_phases_ / (double)output_rate * (double)multiplier;
+    const uint64_t qt_step = (uint64_t)std::floor(step * (double)PhaseFractOne + 0.5);
+
+    const uint64_t step_phases = qt_step >> 32;
+
+    step_index_ = size_t(step_phases / num_phases_);
+    step_phase_ = size_t(step_phases % num_phases_);
+    step_phase_fract_ = uint32_t(qt_step & (PhaseFractOne - 1));
+
+    return true;
+}
+
+const core::Slice<sample_t>& PolyphaseResampler::begin_push_input() {
+    roc_panic_if_not(is_valid());
+
+    if (in_len_ + in_frame_size_ > in_buf_size_) {
+        // Drop samples that are behind filter window of next output sample.
+        const size_t first_needed = pos_index_ - (half_taps_ - 1);
+        const size_t num_retained = in_len_ - first_needed;
+
+        if (num_retained + in_frame_size_ > in_buf_size_) {
+            roc_panic("polyphase resampler:"
+                      " attempt to push input before popping all output");
+        }
+
+        memmove(in_buf_.data(), in_buf_.data() + first_needed * num_ch_,
+                num_retained * num_ch_ * sizeof(sample_t));
+
+        in_len_ = num_retained;
+        pos_index_ -= first_needed;
+    }
+
+    in_frame_ = in_buf_.subslice(in_len_ * num_ch_, (in_len_ + in_frame_size_) * num_ch_);
+
+    return in_frame_;
+}
+
+void PolyphaseResampler::end_push_input() {
+    roc_panic_if_not(is_valid());
+
+    in_len_ += in_frame_size_;
+}
+
+size_t PolyphaseResampler::pop_output(sample_t* out_data, size_t out_size) {
+    roc_panic_if_not(is_valid());
+
+    size_t out_pos = 0;
+
+    for (; out_pos < out_size; out_pos += num_ch_) {
+        // Filter window should fit into committed input.
+        if (pos_index_ + half_taps_ >= in_len_) {
+            break;
+        }
+
+        const sample_t* in_data =
+            in_buf_.data() + (pos_index_ - (half_taps_ - 1)) * num_ch_;
+
+        resample_(in_data, phase_coeffs_(), out_data + out_pos);
+        advance_();
+    }
+
+    return out_pos;
+}
+
+float PolyphaseResampler::n_left_to_process() const {
+    const double pos_fract =
+        ((double)pos_phase_ + (double)pos_phase_fract_ / (double)PhaseFractOne)
+        / (double)num_phases_;
+
+    return (float)(((double)(in_len_ - pos_index_) - pos_fract) * (double)num_ch_);
+}
+
+bool PolyphaseResampler::check_config_() const {
+    if (!in_spec_.is_valid() || !out_spec_.is_valid() || !in_spec_.is_raw()
+        || !out_spec_.is_raw()) {
+        roc_log(LogError,
+                "polyphase resampler: invalid sample spec:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec_).c_str(),
+                sample_spec_to_str(out_spec_).c_str());
+        return false;
+    }
+
+    if (in_spec_.channel_set() != out_spec_.channel_set()) {
+        roc_log(LogError,
+                "polyphase resampler: input and output channel sets should be equal:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec_).c_str(),
+                sample_spec_to_str(out_spec_).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool PolyphaseResampler::init_phases_(ResamplerProfile profile) {
+    const size_t in_rate = in_spec_.sample_rate();
+    const size_t out_rate = out_spec_.sample_rate();
+
+    // Number of phases needed to represent nominal ratio exactly.
+    const size_t exact_phases = out_rate / gcd(in_rate, out_rate);
+
+    const size_t min_phases = get_min_phases(profile);
+    const size_t max_phases = get_max_phases(profile);
+
+    if (exact_phases <= max_phases) {
+        // Use multiple of exact number of phases, so that nominal ratio still
+        // maps output samples exactly to phases.
+        num_phases_ = exact_phases * ((min_phases + exact_phases - 1) / exact_phases);
+        if (num_phases_ > max_phases) {
+            num_phases_ = exact_phases;
+        }
+    } else {
+        // Ratio can't be represented exactly with reasonable number of phases,
+        // so output samples will be interpolated between phases.
+        num_phases_ = max_phases;
+    }
+
+    // When downsampling, filter becomes wider in terms of input samples.
+    const double downscale = nominal_scaling_ > 1 ? nominal_scaling_ : 1;
+
+    half_taps_ = (size_t)std::ceil((double)get_half_taps(profile) * downscale);
+    num_taps_ = half_taps_ * 2;
+
+    return true;
+}
+
+bool PolyphaseResampler::fill_filter_bank_() {
+    if (!filter_bank_.resize((num_phases_ + 1) * num_taps_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter bank");
+        return false;
+    }
+
+    if (!interp_coeffs_.resize(num_taps_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter bank");
+        return false;
+    }
+
+    const double downscale = nominal_scaling_ > 1 ? nominal_scaling_ : 1;
+    const double cutoff = CutoffFreq / downscale;
+
+    // Phase p corresponds to output sample located p / num_phases input
+    // samples after the input sample with index (half_taps - 1).
+    // Additional phase num_phases equals to phase 0 shifted by one sample,
+    // and is used for interpolation between last and first phase.
+    for (size_t p = 0; p <= num_phases_; p++) {
+        sample_t* coeffs = &filter_bank_[p * num_taps_];
+
+        const double offset = (double)p / (double)num_phases_;
+
+        double sum = 0;
+        for (size_t k = 0; k < num_taps_; k++) {
+            const double t = (double)k - (double)(half_taps_ - 1) - offset;
+            const double h = windowed_sinc(t, cutoff, (double)half_taps_);
+
+            coeffs[k] = (sample_t)h;
+            sum += h;
+        }
+
+        // Normalize each phase to unity gain.
+        for (size_t k = 0; k < num_taps_; k++) {
+            coeffs[k] = (sample_t)((double)coeffs[k] / sum);
+        }
+    }
+
+    return true;
+}
+
+bool PolyphaseResampler::alloc_buffers_(FrameFactory& frame_factory) {
+    in_buf_ = frame_factory.new_raw_buffer();
+    if (!in_buf_) {
+        roc_log(LogError, "polyphase resampler: can't allocate input buffer");
+        return false;
+    }
+
+    in_buf_size_ = in_buf_.size() / num_ch_;
+
+    // Input buffer holds retained history (up to num_taps_) plus new frame.
+    if (in_buf_size_ <= num_taps_ * 2) {
+        roc_log(LogError,
+                "polyphase resampler: frame buffer too small:"
+                " buffer_size=%lu num_taps=%lu num_ch=%lu",
+                (unsigned long)in_buf_.size(), (unsigned long)num_taps_,
+                (unsigned long)num_ch_);
+        return false;
+    }
+
+    // Input frame is kept small, since it adds up to resampler latency.
+    in_frame_size_ = num_taps_;
+    in_buf_.reslice(0, in_buf_size_ * num_ch_);
+
+    // Prepend zeros, so that first output sample is aligned to first
+    // input sample.
+    memset(in_buf_.data(), 0, in_buf_.size() * sizeof(sample_t));
+
+    in_len_ = half_taps_ - 1;
+    pos_index_ = half_taps_ - 1;
+
+    return true;
+}
+
+const sample_t* PolyphaseResampler::phase_coeffs_() {
+    const sample_t* coeffs = &filter_bank_[pos_phase_ * num_taps_];
+
+    if (pos_phase_fract_ == 0) {
+        // Output sample falls exactly on phase.
+        return coeffs;
+    }
+
+    // Interpolate between adjacent phases.
+    const sample_t* next_coeffs = coeffs + num_taps_;
+    const sample_t fract = (sample_t)((double)pos_phase_fract_ / (double)PhaseFractOne);
+
+    sample_t* interp_coeffs = interp_coeffs_.data();
+
+    for (size_t k = 0; k < num_taps_; k++) {
+        interp_coeffs[k] = coeffs[k] + (next_coeffs[k] - coeffs[k]) * fract;
+    }
+
+    return interp_coeffs;
+}
+
+void PolyphaseResampler::resample_(const sample_t* in_data,
+                                   const sample_t* coeffs,
+                                   sample_t* out_data) {
+    // Accumulate each channel in register, sharing coefficients between channels.
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        const sample_t* in_ch = in_data + ch;
+
+        sample_t acc = 0;
+        for (size_t k = 0; k < num_taps_; k++) {
+            acc += in_ch[k * num_ch_] * coeffs[k];
+        }
+        out_data[ch] = acc;
+    }
+}
+
+void PolyphaseResampler::advance_() {
+    const uint64_t fract = (uint64_t)pos_phase_fract_ + step_phase_fract_;
+
+    pos_phase_fract_ = uint32_t(fract & (PhaseFractOne - 1));
+    pos_phase_ += step_phase_ + size_t(fract >> 32);
+    pos_index_ += step_index_;
+
+    if (pos_phase_ >= num_phases_) {
+        pos_phase_ -= num_phases_;
+        pos_index_++;
+    }
+}
+
+} // namespace audio
+} // namespace roc
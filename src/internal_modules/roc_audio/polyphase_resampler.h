@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polyphase_resampler.h
+//! @brief Polyphase resampler.
+
+#ifndef ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+#define ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Polyphase resampler.
+//!
+//! Resamples audio stream using a filter bank precomputed for the nominal
+//! ratio between input and output rates.
+//!
+//! Filter bank consists of N phases, each phase being a windowed sinc filter
+//! shifted by a fraction of input sample. N is chosen so that the nominal
+//! ratio (e.g. 44100 to 48000) maps every output sample exactly to one
+//! of the phases. When scaling is exactly nominal, every output sample is
+//! a single dot product with precomputed coefficients.
+//!
+//! Small deviations from the nominal ratio, applied by frequency estimator
+//! to compensate clock drift, are handled by linear interpolation between
+//! coefficients of two adjacent phases.
+//!
+//! Position of output sample in input stream is tracked in integers
+//! (input sample, phase, and 32-bit fraction of phase), so scaling
+//! is followed with high precision.
+//!
+//! Compared to builtin backend, sinc values are not computed on the fly,
+//! which makes this backend several times cheaper, at the cost of memory
+//! used by the filter bank. The filter bank is designed for the nominal
+//! ratio, hence scaling can deviate from it only within limited bounds.
+class PolyphaseResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PolyphaseResampler(core::IArena& arena,
+                       FrameFactory& frame_factory,
+                       ResamplerProfile profile,
+                       const SampleSpec& in_spec,
+                       const SampleSpec& out_spec);
+
+    ~PolyphaseResampler();
+
+    //! Check if object is successfully constructed.
+    virtual bool is_valid() const;
+
+    //! Set new resample factor.
+    //! @remarks
+    //!  Filter bank is computed for the nominal ratio of input and output
+    //!  rates passed to constructor. If new scaling differs from nominal
+    //!  ratio too much, this function returns false.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(sample_t* out_data, size_t out_size);
+
+    //! How many samples were pushed but not processed yet.
+    virtual float n_left_to_process() const;
+
+private:
+    bool check_config_() const;
+    bool init_phases_(ResamplerProfile profile);
+    bool fill_filter_bank_();
+    bool alloc_buffers_(FrameFactory& frame_factory);
+
+    const sample_t* phase_coeffs_();
+    void resample_(const sample_t* in_data, const sample_t* coeffs, sample_t* out_data);
+    void advance_();
+
+    const SampleSpec in_spec_;
+    const SampleSpec out_spec_;
+
+    const size_t num_ch_;
+
+    // nominal input/output ratio, for which filter bank is computed
+    const double nominal_scaling_;
+
+    // number of phases in filter bank
+    size_t num_phases_;
+
+    // number of taps on each side of filter, and in total
+    size_t half_taps_;
+    size_t num_taps_;
+
+    // (num_phases_ + 1) rows of num_taps_ coefficients
+    core::Array<sample_t> filter_bank_;
+
+    // coefficients interpolated between two adjacent phases
+    core::Array<sample_t> interp_coeffs_;
+
+    // input samples, interleaved
+    core::Slice<sample_t> in_buf_;
+    core::Slice<sample_t> in_frame_;
+
+    // capacity of in_buf_ and size of in_frame_, in samples per channel
+    size_t in_buf_size_;
+    size_t in_frame_size_;
+
+    // number of committed samples per channel in in_buf_
+    size_t in_len_;
+
+    // position of next output sample in input stream:
+    // index in in_buf_ + (phase + phase_fract / 2^32) / num_phases_
+    size_t pos_index_;
+    size_t pos_phase_;
+    uint32_t pos_phase_fract_;
+
+    // distance between two output samples, in the same units
+    size_t step_index_;
+    size_t step_phase_;
+    uint32_t step_phase_fract_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYPHASE_RESAMPLER_H_
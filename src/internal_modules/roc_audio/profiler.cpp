@@ -31,6 +31,10 @@ Profiler::Profiler(core::IArena& arena,
     , last_chunk_num_(0)
     , last_chunk_samples_(0)
     , moving_avg_(0)
+    , frame_count_(0)
+    , frame_time_mean_(0)
+    , frame_time_m2_(0)
+    , frame_time_max_(0)
     , sample_spec_(sample_spec)
     , valid_(false)
     , buffer_full_(false) {
@@ -61,12 +65,10 @@ void Profiler::add_frame(packet::stream_timestamp_t frame_duration,
     roc_panic_if(!valid_);
 
     update_moving_avg_(frame_duration, elapsed);
+    update_frame_time_(elapsed);
 
     if (rate_limiter_.allow()) {
-        roc_log(LogDebug,
-                "profiler: avg for last %.1f sec: %lu sample/sec (%.2f sec/sec)",
-                (double)interval_ / core::Second, (unsigned long)get_moving_avg(),
-                (double)get_moving_avg() / sample_spec_.sample_rate());
+        report_();
     }
 }
 
@@ -87,6 +89,51 @@ float Profiler::get_moving_avg() {
     }
 }
 
+core::nanoseconds_t Profiler::get_frame_time_avg() const {
+    return (core::nanoseconds_t)frame_time_mean_;
+}
+
+core::nanoseconds_t Profiler::get_frame_time_stddev() const {
+    if (frame_count_ < 2) {
+        return 0;
+    }
+    return (core::nanoseconds_t)sqrt(frame_time_m2_ / (double)(frame_count_ - 1));
+}
+
+core::nanoseconds_t Profiler::get_frame_time_max() const {
+    return frame_time_max_;
+}
+
+void Profiler::update_frame_time_(core::nanoseconds_t elapsed) {
+    // Welford's online algorithm for mean and variance
+    // reference: https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    frame_count_++;
+
+    const double delta = (double)elapsed - frame_time_mean_;
+    frame_time_mean_ += delta / (double)frame_count_;
+    frame_time_m2_ += delta * ((double)elapsed - frame_time_mean_);
+
+    if (frame_time_max_ < elapsed) {
+        frame_time_max_ = elapsed;
+    }
+}
+
+void Profiler::report_() {
+    roc_log(LogDebug,
+            "profiler: avg for last %.1f sec: %lu sample/sec (%.2f sec/sec),"
+            " frame time: avg=%.3fms stddev=%.3fms max=%.3fms",
+            (double)interval_ / core::Second, (unsigned long)get_moving_avg(),
+            (double)get_moving_avg() / sample_spec_.sample_rate(),
+            (double)get_frame_time_avg() / core::Millisecond,
+            (double)get_frame_time_stddev() / core::Millisecond,
+            (double)get_frame_time_max() / core::Millisecond);
+
+    frame_count_ = 0;
+    frame_time_mean_ = 0;
+    frame_time_m2_ = 0;
+    frame_time_max_ = 0;
+}
+
 void Profiler::update_moving_avg_(packet::stream_timestamp_t frame_duration,
                                   core::nanoseconds_t elapsed) {
     const float frame_speed = float(frame_duration * core::Second) / elapsed;
@@ -79,9 +79,20 @@ public:
     //! Get computed average.
     float get_moving_avg();
 
+    //! Get average frame processing time since last report.
+    core::nanoseconds_t get_frame_time_avg() const;
+
+    //! Get standard deviation of frame processing time since last report.
+    core::nanoseconds_t get_frame_time_stddev() const;
+
+    //! Get maximum frame processing time since last report.
+    core::nanoseconds_t get_frame_time_max() const;
+
 private:
     void update_moving_avg_(packet::stream_timestamp_t frame_duration,
                             core::nanoseconds_t elapsed);
+    void update_frame_time_(core::nanoseconds_t elapsed);
+    void report_();
 
     core::RateLimiter rate_limiter_;
 
@@ -96,6 +107,12 @@ private:
 
     float moving_avg_;
 
+    // Frame time stats since last report (Welford's algorithm).
+    size_t frame_count_;
+    double frame_time_mean_;
+    double frame_time_m2_;
+    core::nanoseconds_t frame_time_max_;
+
     const SampleSpec sample_spec_;
 
     bool valid_;
@@ -10,6 +10,7 @@
 #include "roc_audio/sample_spec.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace audio {
@@ -41,7 +42,11 @@ core::nanoseconds_t ProfilingReader::read_(Frame& frame, bool& ret) {
 
     ret = reader_.read(frame);
 
-    return core::timestamp(core::ClockMonotonic) - start;
+    const core::nanoseconds_t elapsed = core::timestamp(core::ClockMonotonic) - start;
+
+    core::Tracer::instance().add_event("frame_read", start, elapsed);
+
+    return elapsed;
 }
 
 } // namespace audio
@@ -23,6 +23,8 @@ namespace roc {
 namespace audio {
 
 //! Profiling reader.
+//! Measures time of every read and reports it to Profiler. If core::Tracer
+//! is enabled, also records "frame_read" trace event.
 class ProfilingReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -10,6 +10,7 @@
 #include "roc_audio/sample_spec.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace audio {
@@ -37,7 +38,11 @@ core::nanoseconds_t ProfilingWriter::write_(Frame& frame) {
 
     writer_.write(frame);
 
-    return core::timestamp(core::ClockMonotonic) - start;
+    const core::nanoseconds_t elapsed = core::timestamp(core::ClockMonotonic) - start;
+
+    core::Tracer::instance().add_event("frame_write", start, elapsed);
+
+    return elapsed;
 }
 
 } // namespace audio
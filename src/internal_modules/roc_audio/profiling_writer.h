@@ -23,6 +23,8 @@ namespace roc {
 namespace audio {
 
 //! Profiling writer.
+//! Measures time of every write and reports it to Profiler. If core::Tracer
+//! is enabled, also records "frame_write" trace event.
 class ProfilingWriter : public IFrameWriter, public core::NonCopyable<> {
 public:
     //! Initialization.
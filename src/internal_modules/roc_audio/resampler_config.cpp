@@ -42,6 +42,9 @@ const char* resampler_backend_to_str(ResamplerBackend backend) {
     case ResamplerBackend_SpeexDec:
         return "speexdec";
 
+    case ResamplerBackend_Polyphase:
+        return "polyphase";
+
     case ResamplerBackend_Default:
         return "default";
     }
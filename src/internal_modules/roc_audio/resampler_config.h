@@ -36,7 +36,12 @@ enum ResamplerBackend {
     //! Combined SpeexDSP + decimating resampler.
     //! Tolerable precision, tolerable quality, fast.
     //! May be disabled at build time.
-    ResamplerBackend_SpeexDec
+    ResamplerBackend_SpeexDec,
+
+    //! Built-in polyphase resampler.
+    //! High precision, high quality, fast.
+    //! Scaling may deviate from nominal rate ratio only within limited bounds.
+    ResamplerBackend_Polyphase
 };
 
 //! Resampler parameters presets.
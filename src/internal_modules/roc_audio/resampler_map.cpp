@@ -9,6 +9,7 @@
 #include "roc_audio/resampler_map.h"
 #include "roc_audio/builtin_resampler.h"
 #include "roc_audio/decimation_resampler.h"
+#include "roc_audio/polyphase_resampler.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/scoped_ptr.h"
@@ -68,6 +69,12 @@ ResamplerMap::ResamplerMap()
         back.ctor = &resampler_ctor<BuiltinResampler>;
         add_backend_(back);
     }
+    {
+        Backend back;
+        back.id = ResamplerBackend_Polyphase;
+        back.ctor = &resampler_ctor<PolyphaseResampler>;
+        add_backend_(back);
+    }
 }
 
 size_t ResamplerMap::num_backends() const {
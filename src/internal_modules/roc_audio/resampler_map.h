@@ -53,7 +53,7 @@ public:
 private:
     friend class core::Singleton<ResamplerMap>;
 
-    enum { MaxBackends = 4 };
+    enum { MaxBackends = 5 };
 
     struct Backend {
         Backend()
@@ -7,8 +7,10 @@
  */
 
 #include "roc_audio/resampler_reader.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace audio {
@@ -67,6 +69,8 @@ bool ResamplerReader::set_scaling(float multiplier) {
 bool ResamplerReader::read(Frame& out_frame) {
     roc_panic_if_not(is_valid());
 
+    core::TraceScope trace("resampler");
+
     if (out_frame.num_raw_samples() % out_sample_spec_.num_channels() != 0) {
         roc_panic("resampler reader: unexpected frame size");
     }
@@ -91,6 +95,8 @@ bool ResamplerReader::read(Frame& out_frame) {
     out_frame.set_duration(out_frame.num_raw_samples() / out_sample_spec_.num_channels());
     out_frame.set_capture_timestamp(capture_ts_(out_frame));
 
+    CopyCounter::instance().add(CopyStage_Resampler, out_frame.num_raw_samples());
+
     return true;
 }
 
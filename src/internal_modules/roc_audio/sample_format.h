@@ -28,6 +28,10 @@ enum SampleFormat {
     //! What specific PCM coding and endian is used is defined
     //! by PcmFormat enum.
     SampleFormat_Pcm,
+
+    //! Opus compressed format.
+    //! Frames have variable size and can have only specific durations.
+    SampleFormat_Opus,
 };
 
 //! Get string name of sample format.
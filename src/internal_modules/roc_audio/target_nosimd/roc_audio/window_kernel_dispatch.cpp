@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/window_kernel.h"
+
+namespace roc {
+namespace audio {
+
+size_t get_window_kernels(WindowKernel kernels[MaxWindowKernels]) {
+    kernels[0].name = "scalar";
+    kernels[0].func = window_kernel_scalar;
+
+    return 1;
+}
+
+} // namespace audio
+} // namespace roc
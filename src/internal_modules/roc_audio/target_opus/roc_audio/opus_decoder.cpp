@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+IFrameDecoder* OpusDecoder::construct(core::IArena& arena,
+                                      const SampleSpec& sample_spec) {
+    OpusDecoder* decoder = new (arena) OpusDecoder(arena, sample_spec);
+    if (!decoder) {
+        return NULL;
+    }
+
+    if (!decoder->is_valid()) {
+        arena.destroy_object(*decoder);
+        return NULL;
+    }
+
+    return decoder;
+}
+
+OpusDecoder::OpusDecoder(core::IArena& arena, const SampleSpec& sample_spec)
+    : opus_dec_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    // 2.5 ms, minimum Opus frame duration
+    , min_frame_samples_(sample_spec.sample_rate() / 400)
+    // 120 ms, maximum Opus packet duration
+    , max_frame_samples_(sample_spec.sample_rate() * 120 / 1000)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , output_pos_(0)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , frame_decoded_(false)
+    , frame_samples_(arena)
+    , frame_samples_off_(0)
+    , valid_(false) {
+    if (sample_rate_ != 8000 && sample_rate_ != 12000 && sample_rate_ != 16000
+        && sample_rate_ != 24000 && sample_rate_ != 48000) {
+        roc_log(LogError, "opus decoder: unsupported sample rate: spec=%s",
+                sample_spec_to_str(sample_spec).c_str());
+        return;
+    }
+
+    if (n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError, "opus decoder: unsupported number of channels: spec=%s",
+                sample_spec_to_str(sample_spec).c_str());
+        return;
+    }
+
+    if (!frame_samples_.resize(max_frame_samples_ * n_chans_)) {
+        roc_log(LogError, "opus decoder: can't allocate frame buffer");
+        return;
+    }
+
+    int err = OPUS_OK;
+    opus_dec_ = opus_decoder_create((opus_int32)sample_rate_, (int)n_chans_, &err);
+    if (!opus_dec_ || err != OPUS_OK) {
+        roc_log(LogError, "opus decoder: opus_decoder_create(): %s", opus_strerror(err));
+        opus_dec_ = NULL;
+        return;
+    }
+
+    valid_ = true;
+}
+
+OpusDecoder::~OpusDecoder() {
+    if (opus_dec_) {
+        opus_decoder_destroy(opus_dec_);
+    }
+}
+
+bool OpusDecoder::is_valid() const {
+    return valid_;
+}
+
+packet::stream_timestamp_t OpusDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::stream_timestamp_t OpusDecoder::available() const {
+    return stream_avail_;
+}
+
+size_t OpusDecoder::decoded_sample_count(const void* frame_data,
+                                         size_t frame_size) const {
+    roc_panic_if(!is_valid());
+    roc_panic_if_not(frame_data);
+
+    const int n_samples = opus_packet_get_nb_samples(
+        (const unsigned char*)frame_data, (opus_int32)frame_size, (opus_int32)sample_rate_);
+    if (n_samples < 0) {
+        return 0;
+    }
+
+    return std::min((size_t)n_samples, max_frame_samples_);
+}
+
+void OpusDecoder::begin(packet::stream_timestamp_t frame_position,
+                        const void* frame_data,
+                        size_t frame_size) {
+    roc_panic_if(!is_valid());
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_byte_size_ = frame_size;
+    frame_decoded_ = false;
+    frame_samples_off_ = 0;
+
+    stream_pos_ = frame_position;
+    stream_avail_ =
+        (packet::stream_timestamp_t)decoded_sample_count(frame_data, frame_size);
+}
+
+size_t OpusDecoder::read(sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: read should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    decode_frame_();
+
+    memcpy(samples, frame_samples_.data() + frame_samples_off_ * n_chans_,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    frame_samples_off_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    output_pos_ = stream_pos_;
+
+    return n_samples;
+}
+
+size_t OpusDecoder::shift(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: shift should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    // Decoder state depends on previous frames, so frame is decoded
+    // even if its samples are dropped.
+    decode_frame_();
+
+    frame_samples_off_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    output_pos_ = stream_pos_;
+
+    return n_samples;
+}
+
+size_t OpusDecoder::conceal(sample_t* samples, size_t n_samples) {
+    roc_panic_if(!is_valid());
+
+    // If lost samples are immediately followed by current frame, and it was
+    // not decoded yet, tail of the gap can be restored from in-band FEC data
+    // of current frame. FEC data covers one previous frame, which normally
+    // has the same duration as current one.
+    size_t n_fec = 0;
+
+    if (frame_data_ && !frame_decoded_
+        && output_pos_ + (packet::stream_timestamp_t)n_samples == stream_pos_) {
+        n_fec = std::min(n_samples, (size_t)stream_avail_);
+        n_fec = std::min(n_fec, max_frame_samples_);
+        n_fec -= n_fec % min_frame_samples_;
+    }
+
+    // Opus can conceal only multiples of minimum frame duration, the rest
+    // is filled with zeros.
+    size_t n_plc = n_samples - n_fec;
+    n_plc -= n_plc % min_frame_samples_;
+
+    size_t n_concealed = decode_plc_(samples, n_plc);
+
+    memset(samples + n_concealed * n_chans_, 0,
+           (n_samples - n_fec - n_concealed) * n_chans_ * sizeof(sample_t));
+
+    if (n_fec != 0) {
+        sample_t* fec_samples = samples + (n_samples - n_fec) * n_chans_;
+        const size_t n_restored = decode_fec_(fec_samples, n_fec);
+
+        memset(fec_samples + n_restored * n_chans_, 0,
+               (n_fec - n_restored) * n_chans_ * sizeof(sample_t));
+
+        n_concealed += n_restored;
+    }
+
+    output_pos_ += (packet::stream_timestamp_t)n_samples;
+
+    return n_concealed;
+}
+
+void OpusDecoder::end() {
+    if (!frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    frame_decoded_ = false;
+    frame_samples_off_ = 0;
+}
+
+void OpusDecoder::decode_frame_() {
+    if (frame_decoded_) {
+        return;
+    }
+
+    frame_decoded_ = true;
+
+    const int ret = opus_decode_float(
+        opus_dec_, (const unsigned char*)frame_data_, (opus_int32)frame_byte_size_,
+        frame_samples_.data(), (int)max_frame_samples_, 0);
+
+    size_t n_decoded = 0;
+
+    if (ret < 0) {
+        roc_log(LogDebug, "opus decoder: opus_decode_float(): %s", opus_strerror(ret));
+    } else {
+        n_decoded = (size_t)ret;
+    }
+
+    // Samples that could not be decoded are replaced with silence.
+    if (n_decoded < (size_t)stream_avail_) {
+        memset(frame_samples_.data() + n_decoded * n_chans_, 0,
+               ((size_t)stream_avail_ - n_decoded) * n_chans_ * sizeof(sample_t));
+    }
+}
+
+size_t OpusDecoder::decode_fec_(sample_t* samples, size_t n_samples) {
+    const int ret =
+        opus_decode_float(opus_dec_, (const unsigned char*)frame_data_,
+                          (opus_int32)frame_byte_size_, samples, (int)n_samples, 1);
+
+    if (ret < 0) {
+        roc_log(LogDebug, "opus decoder: opus_decode_float(fec): %s", opus_strerror(ret));
+        return 0;
+    }
+
+    return std::min((size_t)ret, n_samples);
+}
+
+size_t OpusDecoder::decode_plc_(sample_t* samples, size_t n_samples) {
+    size_t n_decoded = 0;
+
+    while (n_decoded < n_samples) {
+        const size_t n_chunk = std::min(n_samples - n_decoded, max_frame_samples_);
+
+        const int ret = opus_decode_float(opus_dec_, NULL, 0,
+                                          samples + n_decoded * n_chans_, (int)n_chunk, 0);
+
+        if (ret <= 0) {
+            roc_log(LogDebug, "opus decoder: opus_decode_float(plc): %s",
+                    opus_strerror(ret));
+            break;
+        }
+
+        n_decoded += std::min((size_t)ret, n_chunk);
+    }
+
+    return n_decoded;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_opus/roc_audio/opus_decoder.h
+//! @brief Opus decoder.
+
+#ifndef ROC_AUDIO_OPUS_DECODER_H_
+#define ROC_AUDIO_OPUS_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+#include <opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus decoder.
+//! @remarks
+//!  Frame is decoded lazily on first read() or shift(), so that if preceding
+//!  packets were lost, conceal() can still use in-band FEC data from it.
+//!  When there is no in-band FEC data, conceal() uses Opus packet loss
+//!  concealment.
+class OpusDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameDecoder* construct(core::IArena& arena, const SampleSpec& sample_spec);
+
+    //! Initialize.
+    OpusDecoder(core::IArena& arena, const SampleSpec& sample_spec);
+
+    virtual ~OpusDecoder();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Get current stream position.
+    virtual packet::stream_timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::stream_timestamp_t available() const;
+
+    //! Get number of samples per channel, that can be decoded from given frame.
+    virtual size_t decoded_sample_count(const void* frame_data, size_t frame_size) const;
+
+    //! Start decoding a new frame.
+    virtual void begin(packet::stream_timestamp_t frame_position,
+                       const void* frame_data,
+                       size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t read(sample_t* samples, size_t n_samples);
+
+    //! Shift samples from current frame.
+    virtual size_t shift(size_t n_samples);
+
+    //! Conceal missing samples.
+    virtual size_t conceal(sample_t* samples, size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end();
+
+private:
+    void decode_frame_();
+    size_t decode_fec_(sample_t* samples, size_t n_samples);
+    size_t decode_plc_(sample_t* samples, size_t n_samples);
+
+    ::OpusDecoder* opus_dec_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    const size_t min_frame_samples_;
+    const size_t max_frame_samples_;
+
+    packet::stream_timestamp_t stream_pos_;
+    packet::stream_timestamp_t stream_avail_;
+    packet::stream_timestamp_t output_pos_;
+
+    const void* frame_data_;
+    size_t frame_byte_size_;
+    bool frame_decoded_;
+
+    core::Array<sample_t> frame_samples_;
+    size_t frame_samples_off_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_DECODER_H_
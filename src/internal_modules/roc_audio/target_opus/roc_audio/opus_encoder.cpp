@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_encoder.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Bitrate per channel, bits per second.
+const int ChannelBitrate = 64000;
+
+// Expected packet loss, percents.
+// Encoder uses it to decide how much in-band FEC data to include.
+const int ExpectedLossPerc = 5;
+
+// Frame durations supported by Opus, in 1/10 of milliseconds.
+const size_t FrameDurations[] = { 25, 50, 100, 200, 400, 600 };
+
+inline size_t duration_2_samples(size_t duration, size_t sample_rate) {
+    return duration * sample_rate / 10000;
+}
+
+} // namespace
+
+IFrameEncoder* OpusEncoder::construct(core::IArena& arena,
+                                      const SampleSpec& sample_spec) {
+    OpusEncoder* encoder = new (arena) OpusEncoder(arena, sample_spec);
+    if (!encoder) {
+        return NULL;
+    }
+
+    if (!encoder->is_valid()) {
+        arena.destroy_object(*encoder);
+        return NULL;
+    }
+
+    return encoder;
+}
+
+OpusEncoder::OpusEncoder(core::IArena& arena, const SampleSpec& sample_spec)
+    : opus_enc_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    , bitrate_(ChannelBitrate * (int)sample_spec.num_channels())
+    , frame_samples_(arena)
+    , frame_pos_(0)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , valid_(false) {
+    if (sample_rate_ != 8000 && sample_rate_ != 12000 && sample_rate_ != 16000
+        && sample_rate_ != 24000 && sample_rate_ != 48000) {
+        roc_log(LogError, "opus encoder: unsupported sample rate: spec=%s",
+                sample_spec_to_str(sample_spec).c_str());
+        return;
+    }
+
+    if (n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError, "opus encoder: unsupported number of channels: spec=%s",
+                sample_spec_to_str(sample_spec).c_str());
+        return;
+    }
+
+    const size_t max_samples =
+        duration_2_samples(FrameDurations[ROC_ARRAY_SIZE(FrameDurations) - 1],
+                           sample_rate_);
+
+    if (!frame_samples_.resize(max_samples * n_chans_)) {
+        roc_log(LogError, "opus encoder: can't allocate frame buffer");
+        return;
+    }
+
+    int err = OPUS_OK;
+    opus_enc_ = opus_encoder_create((opus_int32)sample_rate_, (int)n_chans_,
+                                    OPUS_APPLICATION_AUDIO, &err);
+    if (!opus_enc_ || err != OPUS_OK) {
+        roc_log(LogError, "opus encoder: opus_encoder_create(): %s", opus_strerror(err));
+        opus_enc_ = NULL;
+        return;
+    }
+
+    // Constant bitrate makes all packets of the same size, which is required
+    // by FEC block codes and keeps packet size predictable.
+    if ((err = opus_encoder_ctl(opus_enc_, OPUS_SET_VBR(0))) != OPUS_OK
+        || (err = opus_encoder_ctl(opus_enc_, OPUS_SET_BITRATE(bitrate_))) != OPUS_OK
+        || (err = opus_encoder_ctl(opus_enc_, OPUS_SET_INBAND_FEC(1))) != OPUS_OK
+        || (err = opus_encoder_ctl(opus_enc_, OPUS_SET_PACKET_LOSS_PERC(ExpectedLossPerc)))
+            != OPUS_OK) {
+        roc_log(LogError, "opus encoder: opus_encoder_ctl(): %s", opus_strerror(err));
+        return;
+    }
+
+    valid_ = true;
+}
+
+OpusEncoder::~OpusEncoder() {
+    if (opus_enc_) {
+        opus_encoder_destroy(opus_enc_);
+    }
+}
+
+bool OpusEncoder::is_valid() const {
+    return valid_;
+}
+
+size_t OpusEncoder::encoded_byte_count(size_t num_samples) const {
+    roc_panic_if(!is_valid());
+
+    // With constant bitrate, frame size is determined by bitrate and duration.
+    return ((size_t)bitrate_ * num_samples / sample_rate_ + 7) / 8;
+}
+
+size_t OpusEncoder::encoded_sample_count(size_t num_samples) const {
+    roc_panic_if(!is_valid());
+
+    size_t result = duration_2_samples(FrameDurations[0], sample_rate_);
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(FrameDurations); n++) {
+        const size_t frame_samples = duration_2_samples(FrameDurations[n], sample_rate_);
+        if (frame_samples > num_samples) {
+            break;
+        }
+        result = frame_samples;
+    }
+
+    return result;
+}
+
+void OpusEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if(!is_valid());
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_byte_size_ = frame_size;
+    frame_pos_ = 0;
+}
+
+size_t OpusEncoder::write(const sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus encoder: write should be called only between begin/end");
+    }
+
+    const size_t max_samples = frame_samples_.size() / n_chans_;
+    const size_t n_written = std::min(n_samples, max_samples - frame_pos_);
+
+    memcpy(frame_samples_.data() + frame_pos_ * n_chans_, samples,
+           n_written * n_chans_ * sizeof(sample_t));
+
+    frame_pos_ += n_written;
+
+    return n_written;
+}
+
+size_t OpusEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    size_t frame_byte_count = 0;
+
+    if (frame_pos_ != 0) {
+        // Opus can encode only frames of specific durations. Padding partial
+        // frame here would make encoded duration differ from packet duration,
+        // so it's up to the caller to provide frame of supported duration.
+        if (encoded_sample_count(frame_pos_) != frame_pos_) {
+            roc_log(LogError,
+                    "opus encoder: can't encode frame of unsupported duration:"
+                    " n_samples=%lu",
+                    (unsigned long)frame_pos_);
+        } else {
+            const opus_int32 ret = opus_encode_float(
+                opus_enc_, frame_samples_.data(), (int)frame_pos_,
+                (unsigned char*)frame_data_, (opus_int32)frame_byte_size_);
+            if (ret < 0) {
+                roc_log(LogError, "opus encoder: opus_encode_float(): %s",
+                        opus_strerror((int)ret));
+            } else {
+                frame_byte_count = (size_t)ret;
+            }
+        }
+    }
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    frame_pos_ = 0;
+
+    return frame_byte_count;
+}
+
+} // namespace audio
+} // namespace roc
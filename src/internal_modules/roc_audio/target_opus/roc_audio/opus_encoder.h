@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_opus/roc_audio/opus_encoder.h
+//! @brief Opus encoder.
+
+#ifndef ROC_AUDIO_OPUS_ENCODER_H_
+#define ROC_AUDIO_OPUS_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+#include <opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus encoder.
+//! @remarks
+//!  Encodes one Opus frame per packet. Packet duration should be one of
+//!  durations supported by Opus (2.5, 5, 10, 20, 40, or 60 ms), see
+//!  encoded_sample_count(). Encoder uses constant bitrate, so that all
+//!  packets have the same size, which is required by FEC. In-band FEC
+//!  is enabled, so that decoder can restore a lost packet from the next one.
+class OpusEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameEncoder* construct(core::IArena& arena, const SampleSpec& sample_spec);
+
+    //! Initialize.
+    OpusEncoder(core::IArena& arena, const SampleSpec& sample_spec);
+
+    virtual ~OpusEncoder();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Get encoded frame size in bytes for given number of samples per channel.
+    virtual size_t encoded_byte_count(size_t num_samples) const;
+
+    //! Get supported frame length closest to given number of samples per channel.
+    virtual size_t encoded_sample_count(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t write(const sample_t* samples, size_t n_samples);
+
+    //! Finish encoding frame.
+    //! @remarks
+    //!  Number of written samples should be one returned by encoded_sample_count(),
+    //!  otherwise frame is not encoded and zero is returned.
+    virtual size_t end();
+
+private:
+    ::OpusEncoder* opus_enc_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    const int bitrate_;
+
+    core::Array<sample_t> frame_samples_;
+    size_t frame_pos_;
+
+    void* frame_data_;
+    size_t frame_byte_size_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_ENCODER_H_
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <immintrin.h>
+
+#include "roc_audio/window_kernel.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Kernels are compiled for specific instruction set using target attribute,
+// so that the rest of the code does not require -msse2 or -mavx2, and are
+// selected at run time depending on CPU features.
+
+__attribute__((target("sse2"))) float sse2_hsum(__m128 v) {
+    const __m128 hi = _mm_movehl_ps(v, v);
+    const __m128 sum2 = _mm_add_ps(v, hi);
+    const __m128 sum1 = _mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1));
+    return _mm_cvtss_f32(sum1);
+}
+
+__attribute__((target("sse2"))) void window_kernel_sse2(sample_t* out,
+                                                         const sample_t* in,
+                                                         const sample_t* weights,
+                                                         const size_t n_taps,
+                                                         const size_t num_ch) {
+    size_t t = 0;
+
+    if (num_ch == 1) {
+        __m128 acc = _mm_setzero_ps();
+        for (; t + 4 <= n_taps; t += 4) {
+            acc = _mm_add_ps(acc,
+                             _mm_mul_ps(_mm_loadu_ps(in + t), _mm_loadu_ps(weights + t)));
+        }
+        out[0] += sse2_hsum(acc);
+    } else if (num_ch == 2) {
+        // Accumulators hold [L R L R], every weight is duplicated for both channels.
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for (; t + 4 <= n_taps; t += 4) {
+            const __m128 w = _mm_loadu_ps(weights + t);
+            acc0 = _mm_add_ps(
+                acc0, _mm_mul_ps(_mm_loadu_ps(in + t * 2), _mm_unpacklo_ps(w, w)));
+            acc1 = _mm_add_ps(
+                acc1, _mm_mul_ps(_mm_loadu_ps(in + t * 2 + 4), _mm_unpackhi_ps(w, w)));
+        }
+        float sum[4];
+        _mm_storeu_ps(sum, _mm_add_ps(acc0, acc1));
+        out[0] += sum[0] + sum[2];
+        out[1] += sum[1] + sum[3];
+    } else {
+        const size_t num_ch_4 = num_ch & ~(size_t)3;
+        for (; t < n_taps; t++) {
+            const sample_t* in_sample = in + t * num_ch;
+            const __m128 w = _mm_set1_ps(weights[t]);
+
+            size_t ch = 0;
+            for (; ch < num_ch_4; ch += 4) {
+                _mm_storeu_ps(out + ch,
+                              _mm_add_ps(_mm_loadu_ps(out + ch),
+                                         _mm_mul_ps(_mm_loadu_ps(in_sample + ch), w)));
+            }
+            for (; ch < num_ch; ch++) {
+                out[ch] += in_sample[ch] * weights[t];
+            }
+        }
+    }
+
+    window_kernel_scalar(out, in + t * num_ch, weights + t, n_taps - t, num_ch);
+}
+
+__attribute__((target("avx2"))) void window_kernel_avx2(sample_t* out,
+                                                         const sample_t* in,
+                                                         const sample_t* weights,
+                                                         const size_t n_taps,
+                                                         const size_t num_ch) {
+    size_t t = 0;
+
+    if (num_ch == 1) {
+        __m256 acc = _mm256_setzero_ps();
+        for (; t + 8 <= n_taps; t += 8) {
+            acc = _mm256_add_ps(acc,
+                                _mm256_mul_ps(_mm256_loadu_ps(in + t),
+                                              _mm256_loadu_ps(weights + t)));
+        }
+        const __m128 acc4 =
+            _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        out[0] += sse2_hsum(acc4);
+    } else if (num_ch == 2) {
+        // Accumulator holds [L R L R L R L R], every weight is duplicated for
+        // both channels.
+        __m256 acc = _mm256_setzero_ps();
+        for (; t + 4 <= n_taps; t += 4) {
+            const __m128 w = _mm_loadu_ps(weights + t);
+            const __m256 w8 = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_unpacklo_ps(w, w)), _mm_unpackhi_ps(w, w), 1);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(in + t * 2), w8));
+        }
+        float sum[8];
+        _mm256_storeu_ps(sum, acc);
+        out[0] += (sum[0] + sum[2]) + (sum[4] + sum[6]);
+        out[1] += (sum[1] + sum[3]) + (sum[5] + sum[7]);
+    } else {
+        const size_t num_ch_8 = num_ch & ~(size_t)7;
+        const size_t num_ch_4 = num_ch & ~(size_t)3;
+        for (; t < n_taps; t++) {
+            const sample_t* in_sample = in + t * num_ch;
+            const __m256 w8 = _mm256_set1_ps(weights[t]);
+            const __m128 w4 = _mm_set1_ps(weights[t]);
+
+            size_t ch = 0;
+            for (; ch < num_ch_8; ch += 8) {
+                _mm256_storeu_ps(
+                    out + ch,
+                    _mm256_add_ps(_mm256_loadu_ps(out + ch),
+                                  _mm256_mul_ps(_mm256_loadu_ps(in_sample + ch), w8)));
+            }
+            for (; ch < num_ch_4; ch += 4) {
+                _mm_storeu_ps(out + ch,
+                              _mm_add_ps(_mm_loadu_ps(out + ch),
+                                         _mm_mul_ps(_mm_loadu_ps(in_sample + ch), w4)));
+            }
+            for (; ch < num_ch; ch++) {
+                out[ch] += in_sample[ch] * weights[t];
+            }
+        }
+    }
+
+    window_kernel_scalar(out, in + t * num_ch, weights + t, n_taps - t, num_ch);
+}
+
+} // namespace
+
+size_t get_window_kernels(WindowKernel kernels[MaxWindowKernels]) {
+    size_t n_kernels = 0;
+
+    kernels[n_kernels].name = "scalar";
+    kernels[n_kernels].func = window_kernel_scalar;
+    n_kernels++;
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2")) {
+        kernels[n_kernels].name = "sse2";
+        kernels[n_kernels].func = window_kernel_sse2;
+        n_kernels++;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        kernels[n_kernels].name = "avx2";
+        kernels[n_kernels].func = window_kernel_avx2;
+        n_kernels++;
+    }
+
+    return n_kernels;
+}
+
+} // namespace audio
+} // namespace roc
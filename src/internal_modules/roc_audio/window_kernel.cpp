@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/window_kernel.h"
+
+namespace roc {
+namespace audio {
+
+void window_kernel_scalar(sample_t* out,
+                          const sample_t* in,
+                          const sample_t* weights,
+                          const size_t n_taps,
+                          const size_t num_ch) {
+    for (size_t t = 0; t < n_taps; t++) {
+        const sample_t* in_sample = in + t * num_ch;
+        const sample_t weight = weights[t];
+
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            out[ch] += in_sample[ch] * weight;
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
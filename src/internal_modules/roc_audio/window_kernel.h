@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/window_kernel.h
+//! @brief Resampler window kernels.
+
+#ifndef ROC_AUDIO_WINDOW_KERNEL_H_
+#define ROC_AUDIO_WINDOW_KERNEL_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Window kernel function.
+//! @remarks
+//!  For every channel @c ch, adds sum of `in[t * num_ch + ch] * weights[t]`
+//!  over `t` from 0 to @p n_taps to `out[ch]`. @p in contains @p n_taps
+//!  interleaved input samples, @p weights contains @p n_taps weights, and
+//!  @p out contains @p num_ch accumulators.
+typedef void (*WindowKernelFunc)(sample_t* out,
+                                 const sample_t* in,
+                                 const sample_t* weights,
+                                 size_t n_taps,
+                                 size_t num_ch);
+
+//! Window kernel.
+struct WindowKernel {
+    //! Kernel name.
+    const char* name;
+
+    //! Kernel function.
+    WindowKernelFunc func;
+};
+
+//! Maximum number of window kernels.
+enum { MaxWindowKernels = 4 };
+
+//! Portable window kernel.
+//! @remarks
+//!  Taps are accumulated one by one, in order.
+void window_kernel_scalar(sample_t* out,
+                          const sample_t* in,
+                          const sample_t* weights,
+                          size_t n_taps,
+                          size_t num_ch);
+
+//! Get window kernels supported by current CPU.
+//! @remarks
+//!  Writes kernels to @p kernels and returns their number. First kernel is
+//!  always the portable one, last kernel is the fastest one. Results of
+//!  vectorized kernels may differ from the portable one within rounding error,
+//!  because they sum taps in different order.
+//! @note
+//!  Implemented in target directories.
+size_t get_window_kernels(WindowKernel kernels[MaxWindowKernels]);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_WINDOW_KERNEL_H_
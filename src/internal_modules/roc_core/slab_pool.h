@@ -45,7 +45,8 @@ enum {
 //! given arena, and uses them for multiple smaller fixed-sized objects ("slots").
 //!
 //! Keeps track of free slots and uses them when possible. Automatically allocates new
-//! slabs when there are no free slots available.
+//! slabs when there are no free slots available. Slabs which became completely free
+//! can be returned to arena using reclaim().
 //!
 //! Automatically grows size of new slabs exponentially. The user can also specify the
 //! minimum and maximum limits for the slabs.
@@ -126,6 +127,25 @@ public:
         return impl_.num_guard_failures();
     }
 
+    //! Return memory of slabs which have no used slots back to arena.
+    //! @returns
+    //!  number of bytes returned to arena.
+    //! @remarks
+    //!  Allows to shrink pool after a load peak. Embedded slots are never reclaimed.
+    size_t reclaim() {
+        return impl_.reclaim();
+    }
+
+    //! Get number of objects currently allocated from pool.
+    size_t num_used_slots() const {
+        return impl_.num_used_slots();
+    }
+
+    //! Get number of bytes currently allocated from arena.
+    size_t num_slab_bytes() const {
+        return impl_.num_slab_bytes();
+    }
+
 private:
     enum {
         SlotSize = (sizeof(SlabPoolImpl::SlotHeader) + sizeof(SlabPoolImpl::SlotCanary)
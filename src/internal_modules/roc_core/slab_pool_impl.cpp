@@ -41,13 +41,15 @@ SlabPoolImpl::SlabPoolImpl(const char* name,
     : name_(name)
     , arena_(arena)
     , n_used_slots_(0)
+    , n_slab_bytes_(0)
     , slab_min_bytes_(clamp(min_alloc_bytes, preallocated_size, max_alloc_bytes))
     , slab_max_bytes_(max_alloc_bytes)
     , unaligned_slot_size_(sizeof(SlotHeader) + sizeof(SlotCanary) + object_size
                            + sizeof(SlotCanary))
     , slot_size_(AlignOps::align_max(std::max(sizeof(Slot), unaligned_slot_size_)))
     , slab_hdr_size_(AlignOps::align_max(sizeof(Slab)))
-    , slab_cur_slots_(slab_min_bytes_ == 0 ? 1 : slots_per_slab_(slab_min_bytes_, true))
+    , slab_min_slots_(slab_min_bytes_ == 0 ? 1 : slots_per_slab_(slab_min_bytes_, true))
+    , slab_cur_slots_(slab_min_slots_)
     , slab_max_slots_(slab_max_bytes_ == 0 ? 0 : slots_per_slab_(slab_max_bytes_, false))
     , object_size_(object_size)
     , object_size_padding_(slot_size_ - unaligned_slot_size_)
@@ -130,12 +132,33 @@ size_t SlabPoolImpl::num_guard_failures() const {
     return num_guard_failures_;
 }
 
+size_t SlabPoolImpl::reclaim() {
+    Mutex::Lock lock(mutex_);
+
+    return deallocate_free_slabs_();
+}
+
+size_t SlabPoolImpl::num_used_slots() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_used_slots_;
+}
+
+size_t SlabPoolImpl::num_slab_bytes() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_slab_bytes_;
+}
+
 void* SlabPoolImpl::give_slot_to_user_(Slot* slot) {
+    Slab* slab = slot->slab;
+
     slot->~Slot();
 
     SlotHeader* slot_hdr = (SlotHeader*)slot;
 
     slot_hdr->owner = this;
+    slot_hdr->slab = slab;
 
     void* canary_before = (char*)slot_hdr->data;
     void* memory = (char*)slot_hdr->data + sizeof(SlotCanary);
@@ -183,7 +206,12 @@ SlabPoolImpl::Slot* SlabPoolImpl::take_slot_from_user_(void* memory) {
 
     MemoryOps::poison_after_use(memory, object_size_);
 
-    return new (slot_hdr) Slot;
+    Slab* slab = (Slab*)slot_hdr->slab;
+
+    Slot* slot = new (slot_hdr) Slot;
+    slot->slab = slab;
+
+    return slot;
 }
 
 SlabPoolImpl::Slot* SlabPoolImpl::acquire_slot_() {
@@ -195,6 +223,10 @@ SlabPoolImpl::Slot* SlabPoolImpl::acquire_slot_() {
     if (slot != NULL) {
         free_slots_.remove(*slot);
         n_used_slots_++;
+
+        if (slot->slab) {
+            slot->slab->n_free--;
+        }
     }
 
     return slot;
@@ -207,6 +239,10 @@ void SlabPoolImpl::release_slot_(Slot* slot) {
 
     n_used_slots_--;
     free_slots_.push_front(*slot);
+
+    if (slot->slab) {
+        slot->slab->n_free++;
+    }
 }
 
 bool SlabPoolImpl::reserve_slots_(size_t desired_slots) {
@@ -238,6 +274,19 @@ void SlabPoolImpl::increase_slab_size_(size_t desired_slots) {
     }
 }
 
+// Shrink slab size after some slabs were freed, so that next slab is
+// sized as if the pool grew only up to the remaining slabs.
+void SlabPoolImpl::reset_slab_size_() {
+    size_t n_slab_slots = 0;
+
+    for (Slab* slab = slabs_.front(); slab != NULL; slab = slabs_.nextof(*slab)) {
+        n_slab_slots += slab->n_slots;
+    }
+
+    slab_cur_slots_ = slab_min_slots_;
+    increase_slab_size_(n_slab_slots);
+}
+
 bool SlabPoolImpl::allocate_new_slab_() {
     const size_t slab_size_bytes = slot_offset_(slab_cur_slots_);
 
@@ -247,10 +296,15 @@ bool SlabPoolImpl::allocate_new_slab_() {
     }
 
     Slab* slab = new (memory) Slab;
+    slab->n_slots = slab_cur_slots_;
+    slab->n_free = slab_cur_slots_;
     slabs_.push_back(*slab);
 
+    n_slab_bytes_ += slab_size_bytes;
+
     for (size_t n = 0; n < slab_cur_slots_; n++) {
         Slot* slot = new ((char*)slab + slot_offset_(n)) Slot;
+        slot->slab = slab;
         free_slots_.push_back(*slot);
     }
 
@@ -258,6 +312,48 @@ bool SlabPoolImpl::allocate_new_slab_() {
     return true;
 }
 
+size_t SlabPoolImpl::deallocate_free_slabs_() {
+    if (free_slots_.is_empty()) {
+        return 0;
+    }
+
+    // Number of free slots in every slab is maintained when slots are
+    // acquired and released, so we don't need to scan free slots here.
+    size_t n_bytes = 0;
+
+    Slab* slab = slabs_.front();
+
+    while (slab != NULL) {
+        Slab* next_slab = slabs_.nextof(*slab);
+
+        if (slab->n_free == slab->n_slots) {
+            for (size_t n = 0; n < slab->n_slots; n++) {
+                free_slots_.remove(*(Slot*)((char*)slab + slot_offset_(n)));
+            }
+
+            n_bytes += slot_offset_(slab->n_slots);
+
+            slabs_.remove(*slab);
+            arena_.deallocate(slab);
+        }
+
+        slab = next_slab;
+    }
+
+    n_slab_bytes_ -= n_bytes;
+
+    if (n_bytes != 0) {
+        reset_slab_size_();
+
+        roc_log(LogDebug,
+                "slab pool (%s): reclaimed free slabs: n_bytes=%lu n_used=%lu n_free=%lu",
+                name_, (unsigned long)n_bytes, (unsigned long)n_used_slots_,
+                (unsigned long)free_slots_.size());
+    }
+
+    return n_bytes;
+}
+
 void SlabPoolImpl::deallocate_everything_() {
     if (n_used_slots_ != 0) {
         if (report_guard_(SlabPool_LeakGuard)) {
@@ -286,6 +382,7 @@ void SlabPoolImpl::add_preallocated_memory_(void* memory, size_t memory_size) {
 
     for (size_t n = 0; n < n_slots; n++) {
         Slot* slot = new ((char*)memory + n * slot_size_) Slot;
+        slot->slab = NULL;
         free_slots_.push_back(*slot);
     }
 }
@@ -36,8 +36,8 @@ namespace core {
 //! @endcode
 //!
 //! SlotHeader contains pointer to the owning pool, checked when returning memory to
-//! pool. SlotCanary contains magic bytes filled when returning memory to user, and
-//! checked when returning memory to pool.
+//! pool, and pointer to the slab containing the slot. SlotCanary contains magic bytes
+//! filled when returning memory to user, and checked when returning memory to pool.
 //!
 //! If user data requires padding to be maximum-aligned, this padding
 //! also becomes part of the trailing canary guard.
@@ -49,6 +49,9 @@ public:
     struct SlotHeader {
         //! The pool that the slot belongs to.
         SlabPoolImpl* owner;
+        //! The slab that the slot belongs to.
+        //! NULL for slots from preallocated memory.
+        void* slab;
         //! Variable-length data surrounded by canary guard.
         AlignMax data[];
     };
@@ -87,9 +90,25 @@ public:
     //! Get number of guard failures.
     size_t num_guard_failures() const;
 
+    //! Deallocate slabs which have no used slots.
+    //! @returns
+    //!  number of bytes returned to arena.
+    size_t reclaim();
+
+    //! Get number of slots currently given to user.
+    size_t num_used_slots() const;
+
+    //! Get number of bytes currently allocated from arena.
+    size_t num_slab_bytes() const;
+
 private:
-    struct Slab : ListNode<> {};
-    struct Slot : ListNode<> {};
+    struct Slab : ListNode<> {
+        size_t n_slots;
+        size_t n_free;
+    };
+    struct Slot : ListNode<> {
+        Slab* slab;
+    };
 
     void* give_slot_to_user_(Slot* slot);
     Slot* take_slot_from_user_(void* memory);
@@ -99,7 +118,9 @@ private:
     bool reserve_slots_(size_t desired_slots);
 
     void increase_slab_size_(size_t desired_n_slots);
+    void reset_slab_size_();
     bool allocate_new_slab_();
+    size_t deallocate_free_slabs_();
     void deallocate_everything_();
 
     void add_preallocated_memory_(void* memory, size_t memory_size);
@@ -117,6 +138,7 @@ private:
     List<Slab, NoOwnership> slabs_;
     List<Slot, NoOwnership> free_slots_;
     size_t n_used_slots_;
+    size_t n_slab_bytes_;
 
     const size_t slab_min_bytes_;
     const size_t slab_max_bytes_;
@@ -125,6 +147,7 @@ private:
     const size_t slot_size_;
     const size_t slab_hdr_size_;
 
+    const size_t slab_min_slots_;
     size_t slab_cur_slots_;
     const size_t slab_max_slots_;
 
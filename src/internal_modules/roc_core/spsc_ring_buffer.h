@@ -39,6 +39,10 @@ public:
 
     //! Deinitialize.
     ~SpscRingBuffer() {
+        if (!byte_buf_.is_valid()) {
+            return;
+        }
+
         while (void* ptr = byte_buf_.begin_read()) {
             static_cast<T*>(ptr)->~T();
             byte_buf_.end_read();
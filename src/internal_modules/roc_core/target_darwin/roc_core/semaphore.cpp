@@ -63,6 +63,28 @@ bool Semaphore::timed_wait(nanoseconds_t deadline) {
     }
 }
 
+bool Semaphore::try_wait() {
+    for (;;) {
+        mach_timespec_t ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 0;
+
+        const kern_return_t ret = semaphore_timedwait(sem_id_, ts);
+
+        if (ret == KERN_SUCCESS) {
+            return true;
+        }
+
+        if (ret == KERN_OPERATION_TIMED_OUT) {
+            return false;
+        }
+
+        if (ret != KERN_ABORTED) {
+            roc_panic("semaphore: semaphore_timedwait(): %s", mach_error_string(ret));
+        }
+    }
+}
+
 void Semaphore::wait() {
     for (;;) {
         const kern_return_t ret = semaphore_wait(sem_id_);
@@ -34,6 +34,10 @@ public:
     //! Deadline should be in the same time domain as core::timestamp().
     ROC_ATTR_NODISCARD bool timed_wait(nanoseconds_t deadline);
 
+    //! If the counter is non-zero, decrement it and return true.
+    //! Otherwise, return false immediately.
+    ROC_ATTR_NODISCARD bool try_wait();
+
     //! Wait until the counter becomes non-zero, decrement it, and return.
     void wait();
 
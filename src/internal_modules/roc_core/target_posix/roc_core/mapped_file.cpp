@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/mapped_file.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+MappedFile::MappedFile()
+    : fd_(-1)
+    , mode_(ReadOnly)
+    , data_(NULL)
+    , size_(0) {
+}
+
+MappedFile::~MappedFile() {
+    if (fd_ != -1) {
+        (void)close();
+    }
+}
+
+bool MappedFile::is_opened() const {
+    return fd_ != -1;
+}
+
+bool MappedFile::open(const char* path, Mode mode) {
+    if (!path) {
+        roc_panic("mapped file: path is null");
+    }
+
+    if (fd_ != -1) {
+        roc_panic("mapped file: already opened");
+    }
+
+    const int flags = mode == ReadOnly ? O_RDONLY : (O_RDWR | O_CREAT | O_TRUNC);
+
+    fd_ = ::open(path, flags | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+        roc_log(LogDebug, "mapped file: open(): %s: %s", path, errno_to_str().c_str());
+        return false;
+    }
+
+    mode_ = mode;
+
+    struct stat st;
+    if (fstat(fd_, &st) == -1) {
+        roc_log(LogError, "mapped file: fstat(): %s: %s", path, errno_to_str().c_str());
+        (void)close();
+        return false;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        roc_log(LogDebug, "mapped file: not a regular file: %s", path);
+        (void)close();
+        return false;
+    }
+
+    if (mode == ReadOnly && !map_((size_t)st.st_size)) {
+        (void)close();
+        return false;
+    }
+
+    return true;
+}
+
+bool MappedFile::resize(size_t size) {
+    if (fd_ == -1) {
+        roc_panic("mapped file: not opened");
+    }
+
+    if (mode_ != ReadWrite) {
+        roc_panic("mapped file: can't resize file opened for reading");
+    }
+
+    // Reserve disk space before it's accessed through mapping. Otherwise file
+    // is grown sparsely, and if disk is full, writing to mapping kills process
+    // with SIGBUS instead of reporting an error. On failure, current mapping
+    // is kept intact.
+    if (size > size_ && !reserve_(size_, size)) {
+        return false;
+    }
+
+    if (!unmap_()) {
+        return false;
+    }
+
+    if (ftruncate(fd_, (off_t)size) == -1) {
+        roc_log(LogError, "mapped file: ftruncate(): %s", errno_to_str().c_str());
+        return false;
+    }
+
+    return map_(size);
+}
+
+bool MappedFile::close() {
+    if (fd_ == -1) {
+        return true;
+    }
+
+    bool ok = unmap_();
+
+    if (::close(fd_) == -1) {
+        roc_log(LogError, "mapped file: close(): %s", errno_to_str().c_str());
+        ok = false;
+    }
+
+    fd_ = -1;
+
+    return ok;
+}
+
+uint8_t* MappedFile::data() const {
+    return data_;
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
+
+bool MappedFile::reserve_(size_t from, size_t to) {
+#if defined(__APPLE__) && defined(__MACH__)
+    // posix_fallocate() is not available, so blocks are allocated by writing
+    // zeros to them.
+    char zeros[4096];
+    memset(zeros, 0, sizeof(zeros));
+
+    while (from < to) {
+        const size_t chunk = std::min(to - from, sizeof(zeros));
+
+        const ssize_t ret = pwrite(fd_, zeros, chunk, (off_t)from);
+        if (ret == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            roc_log(LogError, "mapped file: pwrite(): %s", errno_to_str().c_str());
+            return false;
+        }
+
+        from += (size_t)ret;
+    }
+#else
+    int err;
+    while ((err = posix_fallocate(fd_, (off_t)from, (off_t)(to - from))) == EINTR) {
+    }
+    if (err != 0) {
+        roc_log(LogError, "mapped file: posix_fallocate(): %s",
+                errno_to_str(err).c_str());
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+bool MappedFile::map_(size_t size) {
+    if (size == 0) {
+        // mmap() doesn't allow empty mappings.
+        return true;
+    }
+
+    const int prot = mode_ == ReadOnly ? PROT_READ : (PROT_READ | PROT_WRITE);
+
+    void* addr = mmap(NULL, size, prot, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+        roc_log(LogError, "mapped file: mmap(): %s", errno_to_str().c_str());
+        return false;
+    }
+
+    if (mode_ == ReadOnly) {
+        // Only a hint, failure is not critical.
+        (void)posix_madvise(addr, size, POSIX_MADV_SEQUENTIAL);
+    }
+
+    data_ = (uint8_t*)addr;
+    size_ = size;
+
+    return true;
+}
+
+bool MappedFile::unmap_() {
+    if (!data_) {
+        return true;
+    }
+
+    bool ok = true;
+
+    if (munmap(data_, size_) == -1) {
+        roc_log(LogError, "mapped file: munmap(): %s", errno_to_str().c_str());
+        ok = false;
+    }
+
+    data_ = NULL;
+    size_ = 0;
+
+    return ok;
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/mapped_file.h
+//! @brief Memory-mapped file.
+
+#ifndef ROC_CORE_MAPPED_FILE_H_
+#define ROC_CORE_MAPPED_FILE_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Memory-mapped file.
+//! @remarks
+//!  Maps whole file into memory. File can be opened for reading, when it's
+//!  mapped read-only, or for writing, when it's mapped read-write and can be
+//!  resized. Only regular files can be mapped.
+class MappedFile : public NonCopyable<> {
+public:
+    //! Mapping mode.
+    enum Mode {
+        ReadOnly, //!< Open existing file for reading.
+        ReadWrite //!< Create or truncate file for writing.
+    };
+
+    //! Initialize.
+    MappedFile();
+
+    //! Unmap and close file, if it's opened.
+    ~MappedFile();
+
+    //! Check if file is opened.
+    bool is_opened() const;
+
+    //! Open and map file.
+    //! @remarks
+    //!  In ReadOnly mode, whole file is mapped, and kernel is advised that
+    //!  it will be accessed sequentially.
+    //!  In ReadWrite mode, file is truncated to zero size, and resize()
+    //!  should be used to allocate space.
+    ROC_ATTR_NODISCARD bool open(const char* path, Mode mode);
+
+    //! Change file size and remap it.
+    //! @remarks
+    //!  Can be used only in ReadWrite mode. Pointer returned by data()
+    //!  is invalidated. When growing, disk space is reserved before remapping,
+    //!  and if it can't be reserved (e.g. disk is full), false is returned
+    //!  and current mapping is kept.
+    ROC_ATTR_NODISCARD bool resize(size_t size);
+
+    //! Unmap and close file.
+    //! @returns
+    //!  false if an error occurred when closing file.
+    ROC_ATTR_NODISCARD bool close();
+
+    //! Get pointer to mapped memory.
+    //! @remarks
+    //!  Returns NULL if file is empty.
+    uint8_t* data() const;
+
+    //! Get mapped file size.
+    size_t size() const;
+
+private:
+    bool reserve_(size_t from, size_t to);
+    bool map_(size_t size);
+    bool unmap_();
+
+    int fd_;
+    Mode mode_;
+
+    uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MAPPED_FILE_H_
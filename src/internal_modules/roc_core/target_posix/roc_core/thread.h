@@ -32,6 +32,11 @@ public:
     //! Get numeric identifier of current thread.
     static uint64_t get_tid();
 
+    //! Get number of online CPUs.
+    //! @remarks
+    //!  Returns 1 if it can't be determined.
+    static size_t get_cpu_count();
+
     //! Raise current thread priority to realtime.
     ROC_ATTR_NODISCARD static bool enable_realtime();
 
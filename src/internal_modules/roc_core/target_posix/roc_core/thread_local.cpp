@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/thread_local.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+ThreadLocal::ThreadLocal(Destructor destructor) {
+    if (int err = pthread_key_create(&key_, destructor)) {
+        roc_panic("thread local: pthread_key_create(): %s", errno_to_str(err).c_str());
+    }
+}
+
+ThreadLocal::~ThreadLocal() {
+    if (int err = pthread_key_delete(key_)) {
+        roc_panic("thread local: pthread_key_delete(): %s", errno_to_str(err).c_str());
+    }
+}
+
+void ThreadLocal::set(void* value) {
+    if (int err = pthread_setspecific(key_, value)) {
+        roc_panic("thread local: pthread_setspecific(): %s", errno_to_str(err).c_str());
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/thread_local.h
+//! @brief Thread-local pointer.
+
+#ifndef ROC_CORE_THREAD_LOCAL_H_
+#define ROC_CORE_THREAD_LOCAL_H_
+
+#include <pthread.h>
+
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace core {
+
+//! Thread-local pointer.
+//! @remarks
+//!  Every thread has its own value, initially NULL.
+class ThreadLocal : public NonCopyable<> {
+public:
+    //! Function called on thread exit for non-NULL value.
+    typedef void (*Destructor)(void* value);
+
+    //! Initialize.
+    //! @p destructor may be NULL.
+    explicit ThreadLocal(Destructor destructor);
+
+    //! Deinitialize.
+    //! @remarks
+    //!  Destructor is not invoked for values of threads still running.
+    ~ThreadLocal();
+
+    //! Get value for current thread.
+    void* get() const {
+        return pthread_getspecific(key_);
+    }
+
+    //! Set value for current thread.
+    void set(void* value);
+
+private:
+    pthread_key_t key_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_THREAD_LOCAL_H_
@@ -57,6 +57,22 @@ bool Semaphore::timed_wait(nanoseconds_t deadline) {
     }
 }
 
+bool Semaphore::try_wait() {
+    for (;;) {
+        if (sem_trywait(&sem_) == 0) {
+            return true;
+        }
+
+        if (errno == EAGAIN) {
+            return false;
+        }
+
+        if (errno != EINTR) {
+            roc_panic("semaphore: sem_trywait(): %s", errno_to_str().c_str());
+        }
+    }
+}
+
 void Semaphore::wait() {
     for (;;) {
         if (sem_wait(&sem_) == 0) {
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/tracer.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/seqlock.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+//! Per-thread ring of trace events.
+//! Written by owner thread and read by dumping thread. When full, new events
+//! overwrite the oldest ones. Every element is protected by seqlock and holds
+//! its position, so that reader can detect elements overwritten concurrently.
+class TraceRing : public NonCopyable<> {
+public:
+    TraceRing(IArena& arena, size_t size)
+        : arena_(arena)
+        , records_(NULL)
+        , size_(size)
+        , write_pos_(0)
+        , read_pos_(0) {
+        records_ = (Seqlock<Record>*)arena_.allocate(sizeof(Seqlock<Record>) * size_);
+        if (!records_) {
+            return;
+        }
+        for (size_t n = 0; n < size_; n++) {
+            new (&records_[n]) Seqlock<Record>(Record());
+        }
+    }
+
+    ~TraceRing() {
+        if (records_) {
+            for (size_t n = 0; n < size_; n++) {
+                records_[n].~Seqlock<Record>();
+            }
+            arena_.deallocate(records_);
+        }
+    }
+
+    bool is_valid() const {
+        return records_ != NULL;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    // Called from owner thread.
+    void push_back(const TraceEvent& event) {
+        const uint32_t pos = AtomicOps::load_relaxed(write_pos_);
+
+        Record record;
+        record.event = event;
+        record.pos = pos;
+
+        records_[pos % size_].exclusive_store(record);
+
+        AtomicOps::store_release(write_pos_, pos + 1);
+    }
+
+    // Called from dumping thread.
+    // Increments @p n_lost for every skipped overwritten event.
+    bool pop_front(TraceEvent& event, size_t& n_lost) {
+        const uint32_t write_pos = AtomicOps::load_acquire(write_pos_);
+
+        while (read_pos_ != write_pos) {
+            if (uint32_t(write_pos - read_pos_) > size_) {
+                // Writer wrapped around and overwrote oldest events.
+                n_lost += uint32_t(write_pos - read_pos_) - size_;
+                read_pos_ = write_pos - (uint32_t)size_;
+            }
+
+            const uint32_t pos = read_pos_++;
+
+            Record record;
+            if (records_[pos % size_].try_load(record) && record.pos == pos) {
+                event = record.event;
+                return true;
+            }
+
+            // Element was overwritten while we were reading it.
+            n_lost++;
+        }
+
+        return false;
+    }
+
+private:
+    struct Record {
+        TraceEvent event;
+        uint32_t pos;
+
+        Record()
+            : pos(0) {
+        }
+    };
+
+    IArena& arena_;
+
+    Seqlock<Record>* records_;
+    const size_t size_;
+
+    uint32_t write_pos_;
+    uint32_t read_pos_;
+};
+
+namespace {
+
+enum { DefaultRingSize = 16384 };
+
+} // namespace
+
+Tracer::Tracer()
+    : enabled_(0)
+    , ring_size_(DefaultRingSize)
+    , n_slots_(0)
+    , thread_slot_(&Tracer::release_slot_)
+    , n_dropped_(0) {
+}
+
+void Tracer::enable(size_t ring_size) {
+    roc_panic_if_msg(ring_size == 0, "tracer: ring size should be non-zero");
+
+    roc_log(LogDebug, "tracer: enabling tracing: ring_size=%lu",
+            (unsigned long)ring_size);
+
+    ring_size_ = (int)ring_size;
+    enabled_ = 1;
+}
+
+void Tracer::disable() {
+    roc_log(LogDebug, "tracer: disabling tracing");
+
+    enabled_ = 0;
+}
+
+void Tracer::add_event(const char* name, nanoseconds_t begin, nanoseconds_t duration) {
+    if (!enabled_) {
+        return;
+    }
+
+    Slot* slot = (Slot*)thread_slot_.get();
+
+    if (!slot) {
+        // First event from this thread.
+        slot = acquire_slot_();
+        if (!slot) {
+            n_dropped_++;
+            return;
+        }
+        thread_slot_.set(slot);
+    }
+
+    TraceEvent event;
+    event.name = name;
+    event.tid = slot->tid;
+    event.begin = begin;
+    event.duration = duration;
+
+    slot->ring->push_back(event);
+}
+
+size_t Tracer::num_dropped() const {
+    return (size_t)(int)n_dropped_;
+}
+
+bool Tracer::dump(const char* path) {
+    Mutex::Lock lock(dump_mutex_);
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        roc_log(LogError, "tracer: failed to open output file \"%s\": %s", path,
+                errno_to_str().c_str());
+        return false;
+    }
+
+    const uint64_t pid = Thread::get_pid();
+
+    size_t n_events = 0;
+    size_t n_lost = 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    const int n_slots = n_slots_;
+
+    for (int n = 0; n < n_slots; n++) {
+        TraceEvent event;
+
+        while (slots_[n].ring->pop_front(event, n_lost)) {
+            // Chrome trace uses microseconds, fractional part keeps nanoseconds.
+            fprintf(file,
+                    "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%llu,\"tid\":%llu,"
+                    "\"ts\":%lld.%03d,\"dur\":%lld.%03d}",
+                    n_events != 0 ? "," : "", event.name, (unsigned long long)pid,
+                    (unsigned long long)event.tid, (long long)(event.begin / 1000),
+                    (int)(event.begin % 1000), (long long)(event.duration / 1000),
+                    (int)(event.duration % 1000));
+            n_events++;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    n_dropped_ += (int)n_lost;
+
+    const bool ok = !ferror(file);
+
+    if (fclose(file) != 0 || !ok) {
+        roc_log(LogError, "tracer: failed to write output file \"%s\": %s", path,
+                errno_to_str().c_str());
+        return false;
+    }
+
+    if (n_lost != 0) {
+        roc_log(LogInfo,
+                "tracer: ring overflow, oldest events were dropped:"
+                " n_lost=%lu n_dropped_total=%lu",
+                (unsigned long)n_lost, (unsigned long)num_dropped());
+    }
+
+    roc_log(LogDebug, "tracer: dumped trace: path=%s n_events=%lu n_dropped=%lu", path,
+            (unsigned long)n_events, (unsigned long)num_dropped());
+
+    return true;
+}
+
+Tracer::Slot* Tracer::acquire_slot_() {
+    Mutex::Lock lock(register_mutex_);
+
+    const int n_slots = n_slots_;
+    const size_t ring_size = (size_t)(int)ring_size_;
+
+    // Reuse slot released by exited thread, together with its ring.
+    // Prefer slots with current ring size, unless there are no more slots.
+    Slot* free_slot = NULL;
+
+    for (int n = 0; n < n_slots; n++) {
+        if (slots_[n].busy) {
+            continue;
+        }
+        if (slots_[n].ring->size() == ring_size || n_slots == MaxThreads) {
+            free_slot = &slots_[n];
+            break;
+        }
+    }
+
+    if (free_slot) {
+        free_slot->tid = Thread::get_tid();
+        free_slot->busy = 1;
+        return free_slot;
+    }
+
+    if (n_slots == MaxThreads) {
+        return NULL;
+    }
+
+    TraceRing* ring = new (arena_) TraceRing(arena_, ring_size);
+    if (!ring) {
+        return NULL;
+    }
+
+    if (!ring->is_valid()) {
+        arena_.destroy_object(*ring);
+        return NULL;
+    }
+
+    slots_[n_slots].tid = Thread::get_tid();
+    slots_[n_slots].ring = ring;
+    slots_[n_slots].busy = 1;
+
+    // Publish slot only after it's fully initialized.
+    n_slots_ = n_slots + 1;
+
+    return &slots_[n_slots];
+}
+
+// Called on exit of thread that acquired slot.
+// Ring is not freed, it may still be read by dump().
+void Tracer::release_slot_(void* slot) {
+    ((Slot*)slot)->busy = 0;
+}
+
+} // namespace core
+} // namespace roc
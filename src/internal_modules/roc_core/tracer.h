@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/tracer.h
+//! @brief Frame-time tracer.
+
+#ifndef ROC_CORE_TRACER_H_
+#define ROC_CORE_TRACER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread_local.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Trace event.
+//! Describes one execution of some pipeline stage.
+struct TraceEvent {
+    //! Stage name.
+    //! Should be a string literal without characters that need escaping in JSON.
+    const char* name;
+
+    //! Thread ID.
+    uint64_t tid;
+
+    //! Monotonic timestamp when stage started.
+    nanoseconds_t begin;
+
+    //! How long stage took.
+    nanoseconds_t duration;
+
+    TraceEvent()
+        : name(NULL)
+        , tid(0)
+        , begin(0)
+        , duration(0) {
+    }
+};
+
+class TraceRing;
+
+//! Frame-time tracer.
+//!
+//! Collects timings of pipeline stages, to find out which stage does not fit
+//! into the frame budget. Events are recorded into per-thread lock-free
+//! ring buffers, and can be later dumped in Chrome trace event format, which
+//! can be opened in chrome://tracing or Perfetto UI.
+//!
+//! Tracing is disabled by default. When disabled, the cost of a trace point
+//! is a single atomic load.
+//!
+//! Each thread acquires a slot with ring buffer when it records first event,
+//! and caches it in thread-local storage. After that, recording is lock-free.
+//! When thread exits, its slot is released and reused by the next thread that
+//! starts recording, preferably if slot's ring has current size; events left
+//! in the ring are kept until dump.
+//! Dumping drains all rings and may be called from any thread concurrently
+//! with recording. When a ring is full, new events of that thread overwrite
+//! the oldest ones, so that dump always has the most recent events; number
+//! of overwritten events is reported by num_dropped() and logged by dump().
+class Tracer : public NonCopyable<> {
+public:
+    //! Maximum number of threads that can record events simultaneously.
+    enum { MaxThreads = 64 };
+
+    //! Get instance.
+    static Tracer& instance() {
+        return Singleton<Tracer>::instance();
+    }
+
+    //! Enable tracing.
+    //! @p ring_size defines maximum number of events stored per thread
+    //! between dumps. It is applied to rings allocated after this call.
+    void enable(size_t ring_size);
+
+    //! Disable tracing.
+    //! Already recorded events are kept until dump.
+    void disable();
+
+    //! Check if tracing is enabled.
+    bool is_enabled() const {
+        return enabled_ != 0;
+    }
+
+    //! Record event for current thread.
+    //! Does nothing if tracing is disabled.
+    void add_event(const char* name, nanoseconds_t begin, nanoseconds_t duration);
+
+    //! Get number of events dropped because of ring overflow.
+    //! @remarks
+    //!  Overwritten events are detected and counted during dump.
+    size_t num_dropped() const;
+
+    //! Write all recorded events to file in Chrome trace event JSON format.
+    //! Removes written events from rings.
+    //! @returns
+    //!  false if file can't be written.
+    bool dump(const char* path);
+
+private:
+    friend class Singleton<Tracer>;
+
+    struct Slot {
+        uint64_t tid;
+        TraceRing* ring;
+        Atomic<int> busy;
+
+        Slot()
+            : tid(0)
+            , ring(NULL)
+            , busy(0) {
+        }
+    };
+
+    Tracer();
+
+    Slot* acquire_slot_();
+    static void release_slot_(void* slot);
+
+    HeapArena arena_;
+
+    Atomic<int> enabled_;
+    Atomic<int> ring_size_;
+
+    Mutex register_mutex_;
+    Mutex dump_mutex_;
+
+    // Slots [0; n_slots_) have rings, which never change.
+    // Slot is busy while owner thread is alive.
+    Slot slots_[MaxThreads];
+    Atomic<int> n_slots_;
+
+    // Slot of current thread.
+    ThreadLocal thread_slot_;
+
+    Atomic<int> n_dropped_;
+};
+
+//! Trace scope.
+//! Records trace event covering lifetime of the object.
+class TraceScope : public NonCopyable<> {
+public:
+    //! Start stage.
+    //! @p name should be a string literal.
+    explicit TraceScope(const char* name)
+        : name_(name)
+        , begin_(0) {
+        if (Tracer::instance().is_enabled()) {
+            begin_ = timestamp(ClockMonotonic);
+        }
+    }
+
+    //! End stage.
+    ~TraceScope() {
+        if (begin_ != 0) {
+            Tracer::instance().add_event(name_, begin_,
+                                         timestamp(ClockMonotonic) - begin_);
+        }
+    }
+
+private:
+    const char* name_;
+    nanoseconds_t begin_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_TRACER_H_
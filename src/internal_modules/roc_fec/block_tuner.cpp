@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/block_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+BlockTuner::BlockTuner(const BlockTunerConfig& config,
+                       const WriterConfig& writer_config,
+                       Writer& writer,
+                       size_t max_block_length)
+    : config_(config)
+    , max_block_length_(max_block_length)
+    , writer_(writer)
+    , valid_(false) {
+    if (config_.min_source_packets == 0
+        || config_.min_source_packets > config_.max_source_packets
+        || config_.min_repair_packets > config_.max_repair_packets
+        || config_.min_source_packets + config_.min_repair_packets > max_block_length_) {
+        roc_log(LogError,
+                "fec tuner: invalid block bounds:"
+                " min_sbl=%lu max_sbl=%lu min_rbl=%lu max_rbl=%lu max_blen=%lu",
+                (unsigned long)config_.min_source_packets,
+                (unsigned long)config_.max_source_packets,
+                (unsigned long)config_.min_repair_packets,
+                (unsigned long)config_.max_repair_packets,
+                (unsigned long)max_block_length_);
+        return;
+    }
+
+    if (!(config_.redundancy > 0) || !(config_.loss_decay > 0)
+        || config_.loss_decay > 1) {
+        roc_log(LogError, "fec tuner: invalid config: redundancy=%.3f loss_decay=%.3f",
+                (double)config_.redundancy, (double)config_.loss_decay);
+        return;
+    }
+
+    metrics_.n_source_packets = writer_config.n_source_packets;
+    metrics_.n_repair_packets = writer_config.n_repair_packets;
+
+    valid_ = true;
+}
+
+bool BlockTuner::is_valid() const {
+    return valid_;
+}
+
+const BlockTunerMetrics& BlockTuner::metrics() const {
+    return metrics_;
+}
+
+void BlockTuner::update_loss(float loss_ratio) {
+    roc_panic_if(!is_valid());
+
+    if (!(loss_ratio > 0)) {
+        loss_ratio = 0;
+    }
+    if (loss_ratio > 1) {
+        loss_ratio = 1;
+    }
+
+    // Grow immediately, decay smoothly.
+    if (loss_ratio > metrics_.loss_ratio) {
+        metrics_.loss_ratio = loss_ratio;
+    } else {
+        metrics_.loss_ratio += (loss_ratio - metrics_.loss_ratio) * config_.loss_decay;
+    }
+
+    size_t sblen = 0, rblen = 0;
+    select_block_size_(metrics_.loss_ratio, sblen, rblen);
+
+    if (sblen == metrics_.n_source_packets && rblen == metrics_.n_repair_packets) {
+        return;
+    }
+
+    if (!writer_.resize(sblen, rblen)) {
+        roc_log(LogDebug, "fec tuner: can't resize block: sbl=%lu rbl=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        return;
+    }
+
+    roc_log(LogDebug,
+            "fec tuner: changing block size:"
+            " loss=%.4f old_sbl=%lu old_rbl=%lu new_sbl=%lu new_rbl=%lu",
+            (double)metrics_.loss_ratio, (unsigned long)metrics_.n_source_packets,
+            (unsigned long)metrics_.n_repair_packets, (unsigned long)sblen,
+            (unsigned long)rblen);
+
+    metrics_.n_source_packets = sblen;
+    metrics_.n_repair_packets = rblen;
+    metrics_.n_resizes++;
+}
+
+void BlockTuner::select_block_size_(float loss, size_t& sblen, size_t& rblen) const {
+    // Fraction of block that should be covered by repair packets.
+    const float repair_ratio = loss * config_.redundancy;
+
+    const size_t min_sblen = config_.min_source_packets;
+    const size_t min_rblen = config_.min_repair_packets;
+
+    const size_t max_sblen =
+        std::max(min_sblen, std::min(config_.max_source_packets,
+                                     max_block_length_ - min_rblen));
+
+    if (repair_ratio < 1) {
+        // Try longest blocks first, and shorten block until number of repair
+        // packets needed to get repair ratio fits into bounds.
+        for (sblen = max_sblen; sblen >= min_sblen; sblen--) {
+            // rblen / (sblen + rblen) >= repair_ratio
+            const float need_rblen =
+                repair_ratio * float(sblen) / (1 - repair_ratio);
+
+            if (need_rblen > float(config_.max_repair_packets)) {
+                continue;
+            }
+
+            rblen = std::max(min_rblen, (size_t)ceilf(need_rblen));
+
+            if (rblen <= config_.max_repair_packets
+                && sblen + rblen <= max_block_length_) {
+                return;
+            }
+        }
+    }
+
+    // Loss is too high, use highest possible repair ratio.
+    sblen = min_sblen;
+    rblen = std::min(config_.max_repair_packets, max_block_length_ - min_sblen);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/block_tuner.h
+//! @brief FEC block tuner.
+
+#ifndef ROC_FEC_BLOCK_TUNER_H_
+#define ROC_FEC_BLOCK_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/writer.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC block tuner parameters.
+struct BlockTunerConfig {
+    //! Minimum number of source packets in block.
+    size_t min_source_packets;
+
+    //! Maximum number of source packets in block.
+    //! @remarks
+    //!  Receiver latency should be large enough to hold a block of this size,
+    //!  otherwise repair packets arrive too late to be useful.
+    size_t max_source_packets;
+
+    //! Minimum number of repair packets in block.
+    size_t min_repair_packets;
+
+    //! Maximum number of repair packets in block.
+    size_t max_repair_packets;
+
+    //! How much repair packets should exceed expected number of lost packets.
+    //! E.g. if it is 2 and 5% of packets are lost, tuner will try to keep
+    //! repair packets at 10% of block.
+    float redundancy;
+
+    //! How quickly loss estimate decreases when losses go away, in range (0; 1].
+    //! Loss estimate increases immediately when losses grow, but decreases
+    //! smoothly, to avoid flapping on bursty links.
+    float loss_decay;
+
+    BlockTunerConfig()
+        : min_source_packets(6)
+        , max_source_packets(18)
+        , min_repair_packets(1)
+        , max_repair_packets(18)
+        , redundancy(2.0f)
+        , loss_decay(0.25f) {
+    }
+};
+
+//! FEC block tuner metrics.
+struct BlockTunerMetrics {
+    //! Smoothed loss ratio, used to select block size.
+    float loss_ratio;
+
+    //! Currently selected number of source packets in block.
+    size_t n_source_packets;
+
+    //! Currently selected number of repair packets in block.
+    size_t n_repair_packets;
+
+    //! Number of times block size was changed.
+    size_t n_resizes;
+
+    BlockTunerMetrics()
+        : loss_ratio(0)
+        , n_source_packets(0)
+        , n_repair_packets(0)
+        , n_resizes(0) {
+    }
+};
+
+//! FEC block tuner.
+//!
+//! Adjusts block size of FEC writer according to packet loss reported by
+//! receiver. When loss grows, repair ratio is increased, and if maximum
+//! number of repair packets is not enough, block is shortened. When loss
+//! goes away, repair packets are reduced and block is lengthened, to save
+//! bandwidth.
+//!
+//! Block size is selected so that number of repair packets covers expected
+//! number of lost packets in block multiplied by redundancy factor, and
+//! number of source packets is as large as possible within configured bounds.
+class BlockTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config defines tuning bounds
+    //!  - @p writer_config defines initial block size
+    //!  - @p writer is FEC writer to be resized
+    //!  - @p max_block_length is maximum block length supported by encoder
+    BlockTuner(const BlockTunerConfig& config,
+               const WriterConfig& writer_config,
+               Writer& writer,
+               size_t max_block_length);
+
+    //! Check if object is successfully constructed.
+    bool is_valid() const;
+
+    //! Get metrics.
+    const BlockTunerMetrics& metrics() const;
+
+    //! Update block size according to loss ratio reported by receiver.
+    //! @p loss_ratio is a fraction of packets lost since previous report.
+    void update_loss(float loss_ratio);
+
+private:
+    void select_block_size_(float loss, size_t& sblen, size_t& rblen) const;
+
+    const BlockTunerConfig config_;
+    const size_t max_block_length_;
+
+    Writer& writer_;
+
+    BlockTunerMetrics metrics_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_BLOCK_TUNER_H_
@@ -48,6 +48,18 @@ public:
     //!  This method may be called only between begin() and end() calls.
     virtual void fill() = 0;
 
+    //! Fill one repair packet in current block.
+    //!
+    //! @remarks
+    //!  Same as fill(), but encodes only repair packet with given index, which
+    //!  allows to spread encoding of a block over time. Repair packets should
+    //!  be filled in order of increasing index.
+    //!
+    //! @pre
+    //!  This method may be called only between begin() and end() calls,
+    //!  after all source packets of the block were set.
+    virtual void fill_repair(size_t index) = 0;
+
     //! Finish block.
     //!
     //! @remarks
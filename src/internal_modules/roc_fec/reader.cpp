@@ -9,6 +9,7 @@
 #include "roc_fec/reader.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 #include "roc_packet/fec_scheme_to_str.h"
 #include "roc_status/code_to_str.h"
 
@@ -36,6 +37,7 @@ Reader::Reader(const ReaderConfig& config,
     , alive_(true)
     , started_(false)
     , can_repair_(false)
+    , early_repair_done_(false)
     , next_packet_(0)
     , cur_sbn_(0)
     , payload_size_(0)
@@ -60,9 +62,15 @@ bool Reader::is_alive() const {
     return alive_;
 }
 
+const ReaderMetrics& Reader::metrics() const {
+    return metrics_;
+}
+
 status::StatusCode Reader::read(packet::PacketPtr& pp) {
     roc_panic_if_not(is_valid());
 
+    core::TraceScope trace("fec_reader");
+
     if (!alive_) {
         // TODO(gh-183): return StatusDead
         return status::StatusNoData;
@@ -78,6 +86,15 @@ status::StatusCode Reader::read(packet::PacketPtr& pp) {
         return status::StatusNoData;
     }
 
+    // Reader may become dead during read and return no packet,
+    // so only packets actually returned are counted.
+    if (code == status::StatusOK) {
+        metrics_.read_packets++;
+        if (pp->flags() & packet::Packet::FlagRestored) {
+            metrics_.restored_packets++;
+        }
+    }
+
     return code;
 }
 
@@ -197,6 +214,7 @@ void Reader::next_block_() {
     payload_resized_ = false;
 
     can_repair_ = false;
+    early_repair_done_ = false;
 
     fill_block_();
 }
@@ -210,6 +228,13 @@ void Reader::try_repair_() {
         return;
     }
 
+    // Optimal codecs can't restore anything having less packets than source
+    // block length, so don't waste time; can_repair_ is kept to retry when more
+    // packets arrive. Other codecs may still restore some of the packets.
+    if (is_optimal_scheme_() && !has_enough_packets_()) {
+        return;
+    }
+
     if (!decoder_.begin(source_block_.size(), repair_block_.size(), payload_size_)) {
         roc_log(LogDebug,
                 "fec reader: can't begin decoder block, shutting down:"
@@ -311,6 +336,51 @@ status::StatusCode Reader::fetch_packets_(packet::IReader& reader,
 void Reader::fill_block_() {
     fill_source_block_();
     fill_repair_block_();
+
+    // Don't wait until reading reaches a lost packet, and restore lost packets
+    // as soon as enough packets of the block are received. This is done once
+    // per block, so that non-optimal codecs, which may fail to restore all
+    // packets, don't rerun decoding on every new packet. Losses which were not
+    // restored here are retried when reading reaches them.
+    if (!early_repair_done_ && can_repair_ && has_lost_packets_()
+        && has_enough_packets_()) {
+        try_repair_();
+        early_repair_done_ = !can_repair_;
+    }
+}
+
+bool Reader::is_optimal_scheme_() const {
+    // Reed-Solomon is MDS code, which restores whole block from any
+    // source block length packets.
+    return fec_scheme_ == packet::FEC_ReedSolomon_M8;
+}
+
+bool Reader::has_enough_packets_() {
+    size_t n_packets = 0;
+
+    for (size_t n = 0; n < source_block_.size(); n++) {
+        if (source_block_[n]) {
+            n_packets++;
+        }
+    }
+
+    for (size_t n = 0; n < repair_block_.size(); n++) {
+        if (repair_block_[n]) {
+            n_packets++;
+        }
+    }
+
+    return n_packets >= source_block_.size();
+}
+
+bool Reader::has_lost_packets_() {
+    for (size_t n = next_packet_; n < source_block_.size(); n++) {
+        if (!source_block_[n]) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void Reader::fill_source_block_() {
@@ -373,6 +443,12 @@ void Reader::fill_source_block_() {
             can_repair_ = true;
             source_block_[p_num] = pp;
             n_added++;
+        } else if (p_num >= next_packet_
+                   && source_block_[p_num]->has_flags(packet::Packet::FlagRestored)) {
+            // Packet was restored before it arrived, e.g. it was reordered.
+            // Prefer original packet if restored one was not read yet.
+            source_block_[p_num] = pp;
+            n_added++;
         }
     }
 
@@ -36,6 +36,21 @@ struct ReaderConfig {
     }
 };
 
+//! FEC reader metrics.
+struct ReaderMetrics {
+    //! Number of source packets returned from reader.
+    //! Includes restored packets.
+    uint64_t read_packets;
+
+    //! Number of lost source packets restored from repair packets.
+    uint64_t restored_packets;
+
+    ReaderMetrics()
+        : read_packets(0)
+        , restored_packets(0) {
+    }
+};
+
 //! FEC reader.
 class Reader : public packet::IReader, public core::NonCopyable<> {
 public:
@@ -66,9 +81,16 @@ public:
     //! Is decoder alive?
     bool is_alive() const;
 
+    //! Get metrics.
+    const ReaderMetrics& metrics() const;
+
     //! Read packet.
     //! @remarks
     //!  When a packet loss is detected, try to restore it from repair packets.
+    //!  Restoring is attempted once as soon as number of received source and
+    //!  repair packets of the current block reaches source block length, without
+    //!  waiting until reading reaches the lost packet. Remaining losses are
+    //!  restored when reading reaches them.
     virtual ROC_ATTR_NODISCARD status::StatusCode read(packet::PacketPtr&);
 
 private:
@@ -89,6 +111,10 @@ private:
     void fill_source_block_();
     void fill_repair_block_();
 
+    bool is_optimal_scheme_() const;
+    bool has_enough_packets_();
+    bool has_lost_packets_();
+
     bool process_source_packet_(const packet::PacketPtr&);
     bool process_repair_packet_(const packet::PacketPtr&);
 
@@ -126,6 +152,7 @@ private:
     bool alive_;
     bool started_;
     bool can_repair_;
+    bool early_repair_done_;
 
     size_t next_packet_;
     packet::blknum_t cur_sbn_;
@@ -138,6 +165,8 @@ private:
 
     unsigned n_packets_;
 
+    ReaderMetrics metrics_;
+
     const size_t max_sbn_jump_;
     const packet::FecScheme fec_scheme_;
 };
@@ -124,13 +124,25 @@ void OpenfecEncoder::fill() {
     roc_panic_if_not(is_valid());
 
     for (size_t i = sblen_; i < sblen_ + rblen_; ++i) {
-        roc_log(LogTrace, "openfec encoder: of_build_repair_symbol(): index=%lu",
-                (unsigned long)i);
+        fill_repair(i);
+    }
+}
+
+void OpenfecEncoder::fill_repair(size_t index) {
+    roc_panic_if_not(is_valid());
+
+    if (index < sblen_ || index >= sblen_ + rblen_) {
+        roc_panic("openfec encoder: repair index out of bounds:"
+                  " index=%lu sblen=%lu rblen=%lu",
+                  (unsigned long)index, (unsigned long)sblen_, (unsigned long)rblen_);
+    }
+
+    roc_log(LogTrace, "openfec encoder: of_build_repair_symbol(): index=%lu",
+            (unsigned long)index);
 
-        if (OF_STATUS_OK
-            != of_build_repair_symbol(of_sess_, &data_tab_[0], (uint32_t)i)) {
-            roc_panic("openfec encoder: of_build_repair_symbol() failed");
-        }
+    if (OF_STATUS_OK
+        != of_build_repair_symbol(of_sess_, &data_tab_[0], (uint32_t)index)) {
+        roc_panic("openfec encoder: of_build_repair_symbol() failed");
     }
 }
 
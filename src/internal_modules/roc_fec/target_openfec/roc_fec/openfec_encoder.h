@@ -68,6 +68,9 @@ public:
     //! Fill repair packets.
     virtual void fill();
 
+    //! Fill one repair packet.
+    virtual void fill_repair(size_t index);
+
     //! Finish block.
     //!
     //! @remarks
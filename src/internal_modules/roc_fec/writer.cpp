@@ -35,9 +35,15 @@ Writer::Writer(const WriterConfig& config,
     , repair_composer_(repair_composer)
     , packet_factory_(packet_factory)
     , repair_block_(arena)
+    , source_block_(arena)
+    , has_pending_block_(false)
+    , pending_sblen_(0)
+    , pending_rblen_(0)
+    , pending_repair_(0)
     , first_packet_(true)
     , cur_packet_(0)
     , fec_scheme_(fec_scheme)
+    , enable_pacing_(config.enable_repair_pacing)
     , valid_(false)
     , alive_(true) {
     cur_sbn_ = (packet::blknum_t)core::fast_random_range(0, packet::blknum_t(-1));
@@ -124,6 +130,13 @@ status::StatusCode Writer::write(const packet::PacketPtr& pp) {
 
     cur_packet_++;
 
+    if (has_pending_block_) {
+        // Spread repair packets of previous block evenly over source
+        // packets of current block.
+        write_paced_repair_packets_(
+            (pending_rblen_ * cur_packet_ + cur_sblen_ - 1) / cur_sblen_);
+    }
+
     if (cur_packet_ == cur_sblen_) {
         end_block_();
         next_block_();
@@ -142,6 +155,11 @@ bool Writer::begin_block_(const packet::PacketPtr& pp) {
             (unsigned long)cur_sbn_, (unsigned long)cur_sblen_, (unsigned long)cur_rblen_,
             (unsigned long)cur_payload_size_);
 
+    if (enable_pacing_) {
+        // Encoder block is started in end_paced_block_().
+        return true;
+    }
+
     if (!encoder_.begin(cur_sblen_, cur_rblen_, cur_payload_size_)) {
         roc_log(LogError,
                 "fec writer: can't begin encoder block, shutting down:"
@@ -154,6 +172,11 @@ bool Writer::begin_block_(const packet::PacketPtr& pp) {
 }
 
 void Writer::end_block_() {
+    if (enable_pacing_) {
+        end_paced_block_();
+        return;
+    }
+
     make_repair_packets_();
     encode_repair_packets_();
     compose_repair_packets_();
@@ -162,6 +185,47 @@ void Writer::end_block_() {
     encoder_.end();
 }
 
+void Writer::end_paced_block_() {
+    // Normally all repair packets of previous block are already written
+    // together with source packets of current block.
+    if (has_pending_block_) {
+        write_paced_repair_packets_(pending_rblen_);
+    }
+
+    if (!resize_block_(repair_block_, cur_rblen_)) {
+        return;
+    }
+
+    if (!encoder_.begin(cur_sblen_, cur_rblen_, cur_payload_size_)) {
+        roc_log(LogError,
+                "fec writer: can't begin encoder block, shutting down:"
+                " sblen=%lu rblen=%lu",
+                (unsigned long)cur_sblen_, (unsigned long)cur_rblen_);
+        alive_ = false;
+        return;
+    }
+
+    for (size_t i = 0; i < cur_sblen_; i++) {
+        encoder_.set(i, source_block_[i]->fec()->payload);
+        source_block_[i] = NULL;
+    }
+
+    make_repair_packets_();
+
+    for (size_t i = 0; i < cur_rblen_; i++) {
+        packet::PacketPtr rp = repair_block_[i];
+        if (rp) {
+            encoder_.set(cur_sblen_ + i, rp->fec()->payload);
+        }
+    }
+
+    // Repair packets will be encoded and written by write_paced_repair_packets_().
+    has_pending_block_ = true;
+    pending_sblen_ = cur_sblen_;
+    pending_rblen_ = cur_rblen_;
+    pending_repair_ = 0;
+}
+
 void Writer::next_block_() {
     cur_block_repair_sn_ += (packet::seqnum_t)cur_rblen_;
     cur_sbn_++;
@@ -174,13 +238,15 @@ bool Writer::apply_sizes_(size_t sblen, size_t rblen, size_t payload_size) {
         return (alive_ = false);
     }
 
-    if (repair_block_.size() != rblen) {
-        if (!repair_block_.resize(rblen)) {
-            roc_log(LogError,
-                    "fec writer: can't allocate repair block memory, shutting down:"
-                    " cur_rbl=%lu new_rbl=%lu",
-                    (unsigned long)repair_block_.size(), (unsigned long)rblen);
-            return (alive_ = false);
+    if (enable_pacing_) {
+        // Repair block may be still in use by previous block, so it's
+        // resized in end_paced_block_().
+        if (!resize_block_(source_block_, sblen)) {
+            return false;
+        }
+    } else {
+        if (!resize_block_(repair_block_, rblen)) {
+            return false;
         }
     }
 
@@ -191,8 +257,26 @@ bool Writer::apply_sizes_(size_t sblen, size_t rblen, size_t payload_size) {
     return true;
 }
 
+bool Writer::resize_block_(core::Array<packet::PacketPtr>& block, size_t size) {
+    if (block.size() != size) {
+        if (!block.resize(size)) {
+            roc_log(LogError,
+                    "fec writer: can't allocate block memory, shutting down:"
+                    " cur_size=%lu new_size=%lu",
+                    (unsigned long)block.size(), (unsigned long)size);
+            return (alive_ = false);
+        }
+    }
+
+    return true;
+}
+
 status::StatusCode Writer::write_source_packet_(const packet::PacketPtr& pp) {
-    encoder_.set(cur_packet_, pp->fec()->payload);
+    if (enable_pacing_) {
+        source_block_[cur_packet_] = pp;
+    } else {
+        encoder_.set(cur_packet_, pp->fec()->payload);
+    }
 
     fill_packet_fec_fields_(pp, (packet::seqnum_t)cur_packet_);
 
@@ -276,22 +360,63 @@ void Writer::compose_repair_packets_() {
 }
 
 status::StatusCode Writer::write_repair_packets_() {
-    for (size_t i = 0; i < cur_rblen_; i++) {
-        packet::PacketPtr rp = repair_block_[i];
-        if (!rp) {
+    size_t i = 0;
+
+    while (i < cur_rblen_) {
+        if (!repair_block_[i]) {
+            i++;
             continue;
         }
 
-        const status::StatusCode code = writer_.write(repair_block_[i]);
+        // Write run of consecutive repair packets by one call.
+        size_t run_end = i + 1;
+        while (run_end < cur_rblen_ && repair_block_[run_end]) {
+            run_end++;
+        }
+
+        const status::StatusCode code =
+            writer_.write_batch(repair_block_.data() + i, run_end - i);
         // TODO(gh-183): forward status
         roc_panic_if(code != status::StatusOK);
 
-        repair_block_[i] = NULL;
+        for (; i < run_end; i++) {
+            repair_block_[i] = NULL;
+        }
     }
 
     return status::StatusOK;
 }
 
+// Encodes and writes repair packets of pending block until given number of its
+// packets is written, and finishes pending block when all of them are written.
+void Writer::write_paced_repair_packets_(size_t n_packets) {
+    for (; pending_repair_ < n_packets; pending_repair_++) {
+        encoder_.fill_repair(pending_sblen_ + pending_repair_);
+
+        packet::PacketPtr rp = repair_block_[pending_repair_];
+        if (!rp) {
+            continue;
+        }
+
+        if (!repair_composer_.compose(*rp)) {
+            // TODO(gh-183): return status from composer
+            roc_panic("fec writer: can't compose repair packet");
+        }
+        rp->add_flags(packet::Packet::FlagComposed);
+
+        const status::StatusCode code = writer_.write(rp);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+
+        repair_block_[pending_repair_] = NULL;
+    }
+
+    if (pending_repair_ == pending_rblen_) {
+        encoder_.end();
+        has_pending_block_ = false;
+    }
+}
+
 void Writer::fill_packet_fec_fields_(const packet::PacketPtr& packet,
                                      packet::seqnum_t pack_n) {
     packet::FEC& fec = *packet->fec();
@@ -33,9 +33,21 @@ struct WriterConfig {
     //! Number of FEC packets in block.
     size_t n_repair_packets;
 
+    //! Spread repair packets of a block over the next block.
+    //! @remarks
+    //!  By default, all repair packets of a block are encoded and written at
+    //!  once, after the last source packet of the block. If pacing is enabled,
+    //!  repair packets are encoded and written one by one, evenly interleaved
+    //!  with source packets of the next block. This removes periodic spikes of
+    //!  encoding time and bursts of repair packets, but repair packets arrive
+    //!  one block later, so receiver latency should be large enough to cover
+    //!  two blocks to benefit from them.
+    bool enable_repair_pacing;
+
     WriterConfig()
         : n_source_packets(18)
-        , n_repair_packets(10) {
+        , n_repair_packets(10)
+        , enable_repair_pacing(false) {
     }
 };
 
@@ -75,14 +87,18 @@ public:
     //! @remarks
     //!  - writes the given source packet to the output writer
     //!  - generates repair packets and also writes them to the output writer
+    //!  - if repair pacing is enabled, writes next portion of repair packets
+    //!    of the previous block
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr&);
 
 private:
     bool begin_block_(const packet::PacketPtr& pp);
     void end_block_();
+    void end_paced_block_();
     void next_block_();
 
     bool apply_sizes_(size_t sblen, size_t rblen, size_t payload_size);
+    bool resize_block_(core::Array<packet::PacketPtr>& block, size_t size);
 
     status::StatusCode write_source_packet_(const packet::PacketPtr&);
     void make_repair_packets_();
@@ -90,6 +106,7 @@ private:
     void encode_repair_packets_();
     void compose_repair_packets_();
     status::StatusCode write_repair_packets_();
+    void write_paced_repair_packets_(size_t n_packets);
     void fill_packet_fec_fields_(const packet::PacketPtr& packet, packet::seqnum_t n);
 
     void validate_fec_packet_(const packet::PacketPtr&);
@@ -113,6 +130,17 @@ private:
 
     core::Array<packet::PacketPtr> repair_block_;
 
+    // Source packets of current block, used only with pacing. Encoder is busy
+    // with previous block until its repair packets are written, so source
+    // packets are passed to encoder at the end of block.
+    core::Array<packet::PacketPtr> source_block_;
+
+    // Block which repair packets are being written, used only with pacing.
+    bool has_pending_block_;
+    size_t pending_sblen_;
+    size_t pending_rblen_;
+    size_t pending_repair_;
+
     bool first_packet_;
 
     packet::blknum_t cur_sbn_;
@@ -121,6 +149,7 @@ private:
     size_t cur_packet_;
 
     const packet::FecScheme fec_scheme_;
+    const bool enable_pacing_;
 
     bool valid_;
     bool alive_;
@@ -9,11 +9,11 @@
 #include "roc_netio/udp_port.h"
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
 #include "roc_core/string_builder.h"
 #include "roc_core/time.h"
-#include "roc_netio/socket_ops.h"
 #include "roc_status/code_to_str.h"
 
 namespace roc {
@@ -23,6 +23,9 @@ namespace {
 
 const core::nanoseconds_t PacketLogInterval = 20 * core::Second;
 
+// Size of receive buffer for datagrams coalesced by GRO.
+const size_t MaxCoalescedSize = 65536;
+
 } // namespace
 
 UdpPort::UdpPort(const UdpConfig& config,
@@ -36,6 +39,10 @@ UdpPort::UdpPort(const UdpConfig& config,
     , loop_(event_loop)
     , handle_initialized_(false)
     , write_sem_initialized_(false)
+    , poll_initialized_(false)
+    , poll_events_(0)
+    , send_blocked_(false)
+    , pacing_timer_initialized_(false)
     , multicast_group_joined_(false)
     , recv_started_(false)
     , want_close_(false)
@@ -43,6 +50,15 @@ UdpPort::UdpPort(const UdpConfig& config,
     , fd_()
     , packet_factory_(packet_factory)
     , inbound_writer_(NULL)
+    , recv_bufs_(arena)
+    , recv_dgrams_(arena)
+    , recv_packets_(arena)
+    , send_packets_(arena)
+    , send_dgrams_(arena)
+    , send_pos_(0)
+    , gso_enabled_(false)
+    , gro_enabled_(false)
+    , gro_buf_(arena)
     , rate_limiter_(PacketLogInterval) {
     BasicPort::update_descriptor();
 }
@@ -122,6 +138,12 @@ bool UdpPort::open() {
                   uv_strerror(fd_err));
     }
 
+    if (config_.batch_size > 1) {
+        if (!init_batching_()) {
+            return false;
+        }
+    }
+
     update_descriptor();
 
     roc_log(LogDebug, "udp port: %s: opened port", descriptor());
@@ -166,6 +188,17 @@ packet::IWriter* UdpPort::start_send() {
         write_sem_initialized_ = true;
     }
 
+    if (!pacing_timer_initialized_) {
+        if (int err = uv_timer_init(&loop_, &pacing_timer_)) {
+            roc_log(LogError, "udp port: %s: uv_timer_init(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            return NULL;
+        }
+
+        pacing_timer_.data = this;
+        pacing_timer_initialized_ = true;
+    }
+
     return this;
 }
 
@@ -180,16 +213,23 @@ bool UdpPort::start_recv(packet::IWriter& inbound_writer) {
         }
     }
 
+    inbound_writer_ = &inbound_writer;
+
     if (!recv_started_) {
-        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
-            roc_log(LogError, "udp port: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
-                    uv_err_name(err), uv_strerror(err));
-            return false;
+        if (poll_initialized_) {
+            recv_started_ = true;
+            update_poll_();
+        } else {
+            if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+                roc_log(LogError, "udp port: %s: uv_udp_recv_start(): [%s] %s",
+                        descriptor(), uv_err_name(err), uv_strerror(err));
+                inbound_writer_ = NULL;
+                return false;
+            }
+            recv_started_ = true;
         }
-        recv_started_ = true;
     }
 
-    inbound_writer_ = &inbound_writer;
     return true;
 }
 
@@ -200,11 +240,16 @@ void UdpPort::close_cb_(uv_handle_t* handle) {
 
     if (handle == (uv_handle_t*)&self.handle_) {
         self.handle_initialized_ = false;
+    } else if (handle == (uv_handle_t*)&self.poll_handle_) {
+        self.poll_initialized_ = false;
+    } else if (handle == (uv_handle_t*)&self.pacing_timer_) {
+        self.pacing_timer_initialized_ = false;
     } else {
         self.write_sem_initialized_ = false;
     }
 
-    if (self.handle_initialized_ || self.write_sem_initialized_) {
+    if (self.handle_initialized_ || self.write_sem_initialized_
+        || self.poll_initialized_ || self.pacing_timer_initialized_) {
         return;
     }
 
@@ -311,37 +356,7 @@ void UdpPort::recv_cb_(uv_udp_t* handle,
 
     self.received_packets_++;
 
-    roc_log(LogTrace, "udp port: %s: received packet: num=%d src=%s dst=%s nread=%ld",
-            self.descriptor(), (int)self.received_packets_,
-            address::socket_addr_to_str(src_addr).c_str(),
-            address::socket_addr_to_str(self.config_.bind_address).c_str(), (long)nread);
-
-    if ((size_t)nread > bp->size()) {
-        roc_panic("udp port: %s: unexpected buffer size: got %ld, max %ld",
-                  self.descriptor(), (long)nread, (long)bp->size());
-    }
-
-    packet::PacketPtr pp = self.packet_factory_.new_packet();
-    if (!pp) {
-        roc_log(LogError, "udp port: %s: can't allocate packet", self.descriptor());
-        return;
-    }
-
-    pp->add_flags(packet::Packet::FlagUDP);
-
-    pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.config_.bind_address;
-    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
-
-    pp->set_buffer(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
-
-    if (self.inbound_writer_) {
-        const status::StatusCode code = self.inbound_writer_->write(pp);
-        if (code != status::StatusOK) {
-            roc_panic("udp port: %s: can't writer packet: status=%s", self.descriptor(),
-                      status::code_to_str(code));
-        }
-    }
+    self.deliver_packet_(bp, (size_t)nread, src_addr);
 }
 
 void UdpPort::write_sem_cb_(uv_async_t* handle) {
@@ -349,39 +364,7 @@ void UdpPort::write_sem_cb_(uv_async_t* handle) {
 
     UdpPort& self = *(UdpPort*)handle->data;
 
-    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
-    // try_pop_front_exclusive() may return NULL if the queue is not empty, but
-    // push_back() is currently in progress. In this case we can exit the loop
-    // before processing all packets, but write() always calls uv_async_send()
-    // after push_back(), so we'll wake up soon and process the rest packets.
-    while (packet::PacketPtr pp = self.outbound_queue_.try_pop_front_exclusive()) {
-        packet::UDP& udp = *pp->udp();
-
-        const int packet_num = ++self.sent_packets_;
-        ++self.sent_packets_blk_;
-
-        roc_log(LogTrace, "udp port: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
-                self.descriptor(), packet_num,
-                address::socket_addr_to_str(self.config_.bind_address).c_str(),
-                address::socket_addr_to_str(udp.dst_addr).c_str(),
-                (long)pp->buffer().size());
-
-        uv_buf_t buf;
-        buf.base = (char*)pp->buffer().data();
-        buf.len = pp->buffer().size();
-
-        udp.request.data = &self;
-
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp port: %s: uv_udp_send(): [%s] %s", self.descriptor(),
-                    uv_err_name(err), uv_strerror(err));
-            continue;
-        }
-
-        // will be decremented in send_cb_()
-        pp->incref();
-    }
+    self.send_pending_();
 }
 
 void UdpPort::send_cb_(uv_udp_send_t* req, int status) {
@@ -392,11 +375,11 @@ void UdpPort::send_cb_(uv_udp_send_t* req, int status) {
     packet::PacketPtr pp =
         packet::Packet::container_of(ROC_CONTAINER_OF(req, packet::UDP, request));
 
-    // one reference for incref() called from write_sem_cb_()
+    // one reference for incref() called from send_async_()
     // one reference for the shared pointer above
     roc_panic_if(pp->getref() < 2);
 
-    // decrement reference counter incremented in write_sem_cb_()
+    // decrement reference counter incremented in send_async_()
     pp->decref();
 
     if (status < 0) {
@@ -416,7 +399,64 @@ void UdpPort::send_cb_(uv_udp_send_t* req, int status) {
     }
 }
 
+void UdpPort::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UdpPort& self = *(UdpPort*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp port: %s: poll error: [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    if (events & UV_READABLE) {
+        self.recv_batch_();
+    }
+
+    if (events & UV_WRITABLE) {
+        self.send_blocked_ = false;
+        self.update_poll_();
+        self.send_pending_();
+    }
+}
+
+void UdpPort::pacing_timer_cb_(uv_timer_t* handle) {
+    roc_panic_if_not(handle);
+
+    UdpPort& self = *(UdpPort*)handle->data;
+
+    self.send_pending_();
+}
+
 status::StatusCode UdpPort::write(const packet::PacketPtr& pp) {
+    validate_packet_(pp);
+
+    write_(&pp, 1);
+
+    report_stats_();
+
+    return status::StatusOK;
+}
+
+status::StatusCode UdpPort::write_batch(const packet::PacketPtr* packets,
+                                        size_t n_packets) {
+    if (n_packets == 0) {
+        return status::StatusOK;
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        validate_packet_(packets[n]);
+    }
+
+    write_(packets, n_packets);
+
+    report_stats_();
+
+    return status::StatusOK;
+}
+
+void UdpPort::validate_packet_(const packet::PacketPtr& pp) {
     if (!pp) {
         roc_panic("udp port: %s: unexpected null packet", descriptor());
     }
@@ -432,25 +472,34 @@ status::StatusCode UdpPort::write(const packet::PacketPtr& pp) {
     if (want_close_) {
         roc_panic("udp port: %s: attempt to use closed sender", descriptor());
     }
-
-    write_(pp);
-
-    report_stats_();
-
-    return status::StatusOK;
 }
 
-void UdpPort::write_(const packet::PacketPtr& pp) {
-    const bool had_pending = (++pending_packets_ > 1);
-    if (!had_pending) {
-        if (try_nonblocking_write_(pp)) {
-            --pending_packets_;
-            return;
+void UdpPort::write_(const packet::PacketPtr* packets, size_t n_packets) {
+    size_t n = 0;
+
+    // Packets can be sent in-place only while there are no packets queued
+    // before them, otherwise they would be reordered.
+    for (; n < n_packets; n++) {
+        const bool had_pending = (++pending_packets_ > 1);
+        if (had_pending || !try_nonblocking_write_(packets[n])) {
+            break;
         }
+        --pending_packets_;
+    }
+
+    if (n == n_packets) {
+        return;
     }
 
-    outbound_queue_.push_back(*pp);
+    // Pending counter is already incremented for this packet.
+    outbound_queue_.push_back(*packets[n]);
 
+    for (n++; n < n_packets; n++) {
+        ++pending_packets_;
+        outbound_queue_.push_back(*packets[n]);
+    }
+
+    // Network thread is woken up once for the whole batch.
     if (int err = uv_async_send(&write_sem_)) {
         roc_panic("udp port: %s: uv_async_send(): [%s] %s", descriptor(),
                   uv_err_name(err), uv_strerror(err));
@@ -463,8 +512,16 @@ bool UdpPort::try_nonblocking_write_(const packet::PacketPtr& pp) {
     }
 
     const packet::UDP& udp = *pp->udp();
-    const bool success =
-        socket_try_send_to(fd_, pp->buffer().data(), pp->buffer().size(), udp.dst_addr);
+
+    // Paced packet should not be sent before its send time.
+    if (udp.send_timestamp != 0
+        && udp.send_timestamp > core::timestamp(core::ClockMonotonic)) {
+        return false;
+    }
+
+    const bool success = socket_try_send_to(fd_, pp->buffer().data(),
+                                            pp->buffer().size(), udp.dst_addr)
+        >= 0;
 
     if (success) {
         const int packet_num = ++sent_packets_;
@@ -479,8 +536,557 @@ bool UdpPort::try_nonblocking_write_(const packet::PacketPtr& pp) {
     return success;
 }
 
+packet::PacketPtr UdpPort::new_packet_(const core::BufferPtr& bp,
+                                       size_t size,
+                                       const address::SocketAddr& src_addr) {
+    roc_log(LogTrace, "udp port: %s: received packet: num=%d src=%s dst=%s nread=%ld",
+            descriptor(), (int)received_packets_,
+            address::socket_addr_to_str(src_addr).c_str(),
+            address::socket_addr_to_str(config_.bind_address).c_str(), (long)size);
+
+    if (size > bp->size()) {
+        roc_panic("udp port: %s: unexpected buffer size: got %ld, max %ld", descriptor(),
+                  (long)size, (long)bp->size());
+    }
+
+    packet::PacketPtr pp = packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "udp port: %s: can't allocate packet", descriptor());
+        return NULL;
+    }
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = src_addr;
+    pp->udp()->dst_addr = config_.bind_address;
+    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
+
+    pp->set_buffer(core::Slice<uint8_t>(*bp, 0, size));
+
+    return pp;
+}
+
+void UdpPort::deliver_packet_(const core::BufferPtr& bp,
+                              size_t size,
+                              const address::SocketAddr& src_addr) {
+    packet::PacketPtr pp = new_packet_(bp, size, src_addr);
+    if (!pp) {
+        return;
+    }
+
+    write_inbound_(&pp, 1);
+}
+
+void UdpPort::enqueue_packet_(const core::BufferPtr& bp,
+                              size_t size,
+                              const address::SocketAddr& src_addr) {
+    packet::PacketPtr pp = new_packet_(bp, size, src_addr);
+    if (!pp) {
+        return;
+    }
+
+    if (recv_packets_.size() == recv_packets_.capacity()) {
+        deliver_enqueued_packets_();
+    }
+
+    if (!recv_packets_.push_back(pp)) {
+        roc_panic("udp port: %s: can't add packet to batch", descriptor());
+    }
+}
+
+void UdpPort::deliver_enqueued_packets_() {
+    if (recv_packets_.size() == 0) {
+        return;
+    }
+
+    write_inbound_(recv_packets_.data(), recv_packets_.size());
+
+    recv_packets_.clear();
+}
+
+void UdpPort::write_inbound_(const packet::PacketPtr* packets, size_t n_packets) {
+    if (!inbound_writer_) {
+        return;
+    }
+
+    const status::StatusCode code = inbound_writer_->write_batch(packets, n_packets);
+    if (code != status::StatusOK) {
+        roc_panic("udp port: %s: can't write packet: status=%s", descriptor(),
+                  status::code_to_str(code));
+    }
+}
+
+bool UdpPort::init_batching_() {
+    const size_t batch_size = config_.batch_size;
+
+    if (!recv_bufs_.resize(batch_size) || !recv_dgrams_.resize(batch_size)
+        || !recv_packets_.grow(batch_size) || !send_packets_.grow(batch_size)
+        || !send_dgrams_.grow(batch_size)) {
+        roc_log(LogError, "udp port: %s: can't allocate batch of size %lu", descriptor(),
+                (unsigned long)batch_size);
+        return false;
+    }
+
+    // uv_udp_t handle registers its socket in the loop only when receiving is
+    // started or a send request is queued, which never happens in batched mode,
+    // so we can safely install our own poll handle for the same socket.
+    if (int err = uv_poll_init(&loop_, &poll_handle_, fd_)) {
+        roc_log(LogError, "udp port: %s: uv_poll_init(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_.data = this;
+    poll_initialized_ = true;
+
+    if (config_.enable_gso) {
+        gso_enabled_ = socket_check_gso(fd_);
+        if (!gso_enabled_) {
+            roc_log(LogInfo, "udp port: %s: segmentation offload not supported",
+                    descriptor());
+        }
+    }
+
+    if (config_.enable_gro) {
+        if (!gro_buf_.resize(batch_size * MaxCoalescedSize)) {
+            roc_log(LogError, "udp port: %s: can't allocate receive offload buffer",
+                    descriptor());
+            return false;
+        }
+
+        gro_enabled_ = socket_enable_gro(fd_);
+
+        if (gro_enabled_) {
+            // Datagrams are received into intermediate buffer and then
+            // copied to packet buffers, see recv_coalesced_().
+            for (size_t n = 0; n < batch_size; n++) {
+                recv_dgrams_[n].buf = gro_buf_.data() + n * MaxCoalescedSize;
+                recv_dgrams_[n].bufsz = MaxCoalescedSize;
+            }
+        } else {
+            roc_log(LogInfo, "udp port: %s: receive offload not supported",
+                    descriptor());
+            gro_buf_.clear();
+        }
+    }
+
+    roc_log(LogDebug, "udp port: %s: enabled batched mode: batch_size=%lu gso=%d gro=%d",
+            descriptor(), (unsigned long)batch_size, (int)gso_enabled_,
+            (int)gro_enabled_);
+
+    return true;
+}
+
+void UdpPort::update_poll_() {
+    int events = 0;
+    if (recv_started_) {
+        events |= UV_READABLE;
+    }
+    if (send_blocked_) {
+        events |= UV_WRITABLE;
+    }
+
+    if (events == poll_events_) {
+        return;
+    }
+
+    if (events != 0) {
+        if (int err = uv_poll_start(&poll_handle_, events, poll_cb_)) {
+            roc_panic("udp port: %s: uv_poll_start(): [%s] %s", descriptor(),
+                      uv_err_name(err), uv_strerror(err));
+        }
+    } else {
+        if (int err = uv_poll_stop(&poll_handle_)) {
+            roc_log(LogError, "udp port: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+        }
+    }
+
+    poll_events_ = events;
+}
+
+void UdpPort::recv_batch_() {
+    const size_t batch_size = recv_dgrams_.size();
+
+    for (;;) {
+        // Buffers that were filled by previous batch were passed to packets,
+        // allocate new ones. Unused buffers are kept for next batch.
+        for (size_t n = 0; n < batch_size && !gro_enabled_; n++) {
+            if (recv_bufs_[n]) {
+                continue;
+            }
+
+            recv_bufs_[n] = packet_factory_.new_packet_buffer();
+            if (!recv_bufs_[n]) {
+                roc_log(LogError, "udp port: %s: can't allocate buffer", descriptor());
+                return;
+            }
+
+            recv_dgrams_[n].buf = recv_bufs_[n]->data();
+            recv_dgrams_[n].bufsz = recv_bufs_[n]->size();
+        }
+
+        const ssize_t ret = socket_try_recv_batch(fd_, recv_dgrams_.data(), batch_size);
+
+        if (ret == SockErr_WouldBlock) {
+            return;
+        }
+
+        if (ret < 0) {
+            roc_log(LogError, "udp port: %s: network error: num=%d dst=%s", descriptor(),
+                    (int)received_packets_,
+                    address::socket_addr_to_str(config_.bind_address).c_str());
+            return;
+        }
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            const SocketDatagram& dgram = recv_dgrams_[n];
+
+            core::BufferPtr bp;
+            if (!gro_enabled_) {
+                bp = recv_bufs_[n];
+                recv_bufs_[n] = NULL;
+            }
+
+            if (!dgram.addr) {
+                roc_log(LogError,
+                        "udp port: %s:"
+                        " can't determine source address: num=%d dst=%s nread=%ld",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(config_.bind_address).c_str(),
+                        (long)dgram.datasz);
+            }
+
+            if (dgram.truncated) {
+                roc_log(LogDebug,
+                        "udp port: %s:"
+                        " ignoring partial read: num=%d src=%s dst=%s nread=%ld",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(dgram.addr).c_str(),
+                        address::socket_addr_to_str(config_.bind_address).c_str(),
+                        (long)dgram.datasz);
+                continue;
+            }
+
+            if (dgram.datasz == 0) {
+                roc_log(LogTrace, "udp port: %s: empty packet: num=%d src=%s dst=%s",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(dgram.addr).c_str(),
+                        address::socket_addr_to_str(config_.bind_address).c_str());
+                continue;
+            }
+
+            if (gro_enabled_) {
+                recv_coalesced_(dgram);
+            } else {
+                received_packets_++;
+
+                enqueue_packet_(bp, dgram.datasz, dgram.addr);
+            }
+        }
+
+        // Whole batch is passed to inbound writer at once.
+        deliver_enqueued_packets_();
+
+        if ((size_t)ret < batch_size) {
+            // Socket queue is drained.
+            return;
+        }
+    }
+}
+
+void UdpPort::recv_coalesced_(const SocketDatagram& dgram) {
+    const uint8_t* data = (const uint8_t*)dgram.buf;
+    const size_t segment_size = dgram.segment_size ? dgram.segment_size : dgram.datasz;
+
+    for (size_t off = 0; off < dgram.datasz; off += segment_size) {
+        const size_t size = ROC_MIN(segment_size, dgram.datasz - off);
+
+        core::BufferPtr bp = packet_factory_.new_packet_buffer();
+        if (!bp) {
+            roc_log(LogError, "udp port: %s: can't allocate buffer", descriptor());
+            return;
+        }
+
+        if (size > bp->size()) {
+            roc_log(LogDebug,
+                    "udp port: %s:"
+                    " ignoring too large packet: num=%d src=%s dst=%s nread=%ld",
+                    descriptor(), (int)received_packets_,
+                    address::socket_addr_to_str(dgram.addr).c_str(),
+                    address::socket_addr_to_str(config_.bind_address).c_str(),
+                    (long)size);
+            continue;
+        }
+
+        memcpy(bp->data(), data + off, size);
+
+        // Every segment is counted as a separate packet.
+        received_packets_++;
+
+        enqueue_packet_(bp, size, dgram.addr);
+    }
+}
+
+void UdpPort::send_pending_() {
+    if (poll_initialized_) {
+        send_batch_();
+    } else {
+        send_async_();
+    }
+
+    schedule_pacing_();
+}
+
+void UdpPort::send_async_() {
+    const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+
+    while (packet::PacketPtr pp = pop_outbound_(now)) {
+        packet::UDP& udp = *pp->udp();
+
+        const int packet_num = ++sent_packets_;
+        ++sent_packets_blk_;
+
+        roc_log(LogTrace, "udp port: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
+                descriptor(), packet_num,
+                address::socket_addr_to_str(config_.bind_address).c_str(),
+                address::socket_addr_to_str(udp.dst_addr).c_str(),
+                (long)pp->buffer().size());
+
+        uv_buf_t buf;
+        buf.base = (char*)pp->buffer().data();
+        buf.len = pp->buffer().size();
+
+        udp.request.data = this;
+
+        if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                                  send_cb_)) {
+            roc_log(LogError, "udp port: %s: uv_udp_send(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            continue;
+        }
+
+        // will be decremented in send_cb_()
+        pp->incref();
+    }
+}
+
+void UdpPort::send_batch_() {
+    const size_t batch_size = send_packets_.capacity();
+
+    for (;;) {
+        if (send_blocked_) {
+            // Wait until socket becomes writable, see poll_cb_().
+            return;
+        }
+
+        if (send_pos_ == send_packets_.size()) {
+            // Previous batch is fully processed, collect next one.
+            send_packets_.clear();
+            send_pos_ = 0;
+
+            const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+
+            while (send_packets_.size() < batch_size) {
+                packet::PacketPtr pp = pop_outbound_(now);
+                if (!pp) {
+                    break;
+                }
+                if (!send_packets_.push_back(pp)) {
+                    roc_panic("udp port: %s: can't add packet to batch", descriptor());
+                }
+            }
+
+            if (send_packets_.is_empty()) {
+                return;
+            }
+
+            if (!send_dgrams_.resize(send_packets_.size())) {
+                roc_panic("udp port: %s: can't resize batch", descriptor());
+            }
+
+            for (size_t n = 0; n < send_packets_.size(); n++) {
+                const packet::PacketPtr& pp = send_packets_[n];
+
+                send_dgrams_[n].buf = pp->buffer().data();
+                send_dgrams_[n].bufsz = pp->buffer().size();
+                send_dgrams_[n].addr = pp->udp()->dst_addr;
+            }
+        }
+
+        const size_t run_length = gso_enabled_ ? gso_run_length_(send_pos_) : 1;
+
+        ssize_t ret;
+
+        if (run_length > 1) {
+            ret = socket_try_send_segmented(fd_, &send_dgrams_[send_pos_], run_length);
+
+            if (ret == SockErr_Failure) {
+                // Kernel or driver refused segmentation offload, disable it and
+                // resend the same packets individually.
+                roc_log(LogInfo,
+                        "udp port: %s: segmentation offload failed, disabling it",
+                        descriptor());
+                gso_enabled_ = false;
+                continue;
+            }
+        } else {
+            size_t batch_end = send_pos_ + 1;
+            if (gso_enabled_) {
+                // Send packets individually until next run that can be segmented.
+                while (batch_end < send_packets_.size()
+                       && gso_run_length_(batch_end) == 1) {
+                    batch_end++;
+                }
+            } else {
+                batch_end = send_packets_.size();
+            }
+
+            ret = socket_try_send_batch(fd_, &send_dgrams_[send_pos_],
+                                        batch_end - send_pos_);
+        }
+
+        if (ret == SockErr_WouldBlock) {
+            send_blocked_ = true;
+            update_poll_();
+            return;
+        }
+
+        if (ret < 0) {
+            // Drop first packet of the batch and retry with the rest.
+            complete_send_(1, false);
+        } else {
+            complete_send_((size_t)ret, true);
+        }
+    }
+}
+
+packet::PacketPtr UdpPort::pop_outbound_(core::nanoseconds_t now) {
+    for (;;) {
+        if (packet::PacketPtr pp = paced_queue_.front()) {
+            if (pp->udp()->send_timestamp <= now) {
+                paced_queue_.remove(*pp);
+                return pp;
+            }
+        }
+
+        // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
+        // try_pop_front_exclusive() may return NULL if the queue is not empty, but
+        // push_back() is currently in progress. In this case we can return before
+        // processing all packets, but write() always calls uv_async_send() after
+        // push_back(), so we'll wake up soon and process the rest packets.
+        packet::PacketPtr pp = outbound_queue_.try_pop_front_exclusive();
+        if (!pp) {
+            return NULL;
+        }
+
+        if (pp->udp()->send_timestamp <= now && paced_queue_.is_empty()) {
+            return pp;
+        }
+
+        // Keep packets ordered by send time, and packets with equal send time
+        // in the order they were written.
+        packet::PacketPtr after = paced_queue_.back();
+        while (after && after->udp()->send_timestamp > pp->udp()->send_timestamp) {
+            after = paced_queue_.prevof(*after);
+        }
+
+        if (after) {
+            paced_queue_.insert_after(*pp, *after);
+        } else {
+            paced_queue_.push_front(*pp);
+        }
+    }
+}
+
+void UdpPort::schedule_pacing_() {
+    if (!pacing_timer_initialized_) {
+        return;
+    }
+
+    packet::PacketPtr head = paced_queue_.front();
+    if (!head) {
+        if (int err = uv_timer_stop(&pacing_timer_)) {
+            roc_log(LogError, "udp port: %s: uv_timer_stop(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+        }
+        return;
+    }
+
+    if (send_blocked_) {
+        // Will be resumed from poll_cb_().
+        return;
+    }
+
+    const core::nanoseconds_t delay =
+        head->udp()->send_timestamp - core::timestamp(core::ClockMonotonic);
+
+    // Round up, since packet should not be sent before its send time.
+    const uint64_t timeout_ms =
+        delay > 0 ? (uint64_t)((delay + core::Millisecond - 1) / core::Millisecond) : 0;
+
+    if (int err = uv_timer_start(&pacing_timer_, pacing_timer_cb_, timeout_ms, 0)) {
+        roc_log(LogError, "udp port: %s: uv_timer_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+    }
+}
+
+size_t UdpPort::gso_run_length_(size_t pos) const {
+    const SocketDatagram& first = send_dgrams_[pos];
+
+    size_t n = 1;
+    while (pos + n < send_dgrams_.size()) {
+        const SocketDatagram& dgram = send_dgrams_[pos + n];
+
+        if (dgram.addr != first.addr || dgram.bufsz > first.bufsz) {
+            break;
+        }
+
+        n++;
+
+        // Only last segment may be shorter.
+        if (dgram.bufsz < first.bufsz) {
+            break;
+        }
+    }
+
+    return n;
+}
+
+void UdpPort::complete_send_(size_t n_packets, bool success) {
+    for (size_t n = 0; n < n_packets; n++) {
+        packet::PacketPtr pp = send_packets_[send_pos_];
+        send_packets_[send_pos_] = NULL;
+        send_pos_++;
+
+        const int packet_num = ++sent_packets_;
+        ++sent_packets_blk_;
+
+        if (success) {
+            roc_log(LogTrace, "udp port: %s: sent packet: num=%d src=%s dst=%s sz=%ld",
+                    descriptor(), packet_num,
+                    address::socket_addr_to_str(config_.bind_address).c_str(),
+                    address::socket_addr_to_str(pp->udp()->dst_addr).c_str(),
+                    (long)pp->buffer().size());
+        } else {
+            roc_log(LogError, "udp port: %s: can't send packet: src=%s dst=%s sz=%ld",
+                    descriptor(),
+                    address::socket_addr_to_str(config_.bind_address).c_str(),
+                    address::socket_addr_to_str(pp->udp()->dst_addr).c_str(),
+                    (long)pp->buffer().size());
+        }
+
+        const int pending_packets = --pending_packets_;
+
+        if (pending_packets == 0 && want_close_) {
+            start_closing_();
+        }
+    }
+}
+
 bool UdpPort::fully_closed_() const {
-    if (!handle_initialized_ && !write_sem_initialized_) {
+    if (!handle_initialized_ && !write_sem_initialized_ && !poll_initialized_
+        && !pacing_timer_initialized_) {
         return true;
     }
 
@@ -499,17 +1105,27 @@ void UdpPort::start_closing_() {
     roc_log(LogDebug, "udp port: %s: initiating asynchronous close", descriptor());
 
     if (recv_started_) {
-        if (int err = uv_udp_recv_stop(&handle_)) {
-            roc_log(LogError, "udp port: %s: uv_udp_recv_stop(): [%s] %s", descriptor(),
-                    uv_err_name(err), uv_strerror(err));
+        if (poll_initialized_) {
+            recv_started_ = false;
+            update_poll_();
+        } else {
+            if (int err = uv_udp_recv_stop(&handle_)) {
+                roc_log(LogError, "udp port: %s: uv_udp_recv_stop(): [%s] %s",
+                        descriptor(), uv_err_name(err), uv_strerror(err));
+            }
+            recv_started_ = false;
         }
-        recv_started_ = false;
     }
 
     if (multicast_group_joined_) {
         leave_multicast_group_();
     }
 
+    // Poll handle should be closed before UDP handle, since they share socket.
+    if (poll_initialized_ && !uv_is_closing((uv_handle_t*)&poll_handle_)) {
+        uv_close((uv_handle_t*)&poll_handle_, close_cb_);
+    }
+
     if (handle_initialized_ && !uv_is_closing((uv_handle_t*)&handle_)) {
         uv_close((uv_handle_t*)&handle_, close_cb_);
     }
@@ -517,6 +1133,10 @@ void UdpPort::start_closing_() {
     if (write_sem_initialized_ && !uv_is_closing((uv_handle_t*)&write_sem_)) {
         uv_close((uv_handle_t*)&write_sem_, close_cb_);
     }
+
+    if (pacing_timer_initialized_ && !uv_is_closing((uv_handle_t*)&pacing_timer_)) {
+        uv_close((uv_handle_t*)&pacing_timer_, close_cb_);
+    }
 }
 
 bool UdpPort::join_multicast_group_() {
@@ -15,13 +15,16 @@
 #include <uv.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/rate_limiter.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/socket_ops.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
@@ -51,9 +54,35 @@ struct UdpConfig {
     //! Used only if sending is started.
     bool enable_non_blocking;
 
+    //! Maximum number of datagrams transferred by one system call.
+    //! If greater than one, port uses batched mode, where it receives and
+    //! sends datagrams in batches (using recvmmsg() and sendmmsg() if they
+    //! are supported by platform). Datagrams received by one system call are
+    //! delivered to inbound writer in one write_batch() call.
+    //! If zero or one, batching is disabled.
+    size_t batch_size;
+
+    //! If true, try to use UDP generic segmentation offload (GSO) when sending.
+    //! Consecutive packets of the same size sent to the same address are
+    //! combined into one super-datagram, which is split by kernel or NIC.
+    //! If GSO is not supported or refused by kernel, port falls back to
+    //! sending packets individually.
+    //! Used only in batched mode.
+    bool enable_gso;
+
+    //! If true, try to use UDP generic receive offload (GRO) when receiving.
+    //! Kernel may coalesce multiple datagrams into one, which are split back
+    //! into individual packets by port. Requires an intermediate buffer of
+    //! 64K per datagram in batch.
+    //! Used only in batched mode.
+    bool enable_gro;
+
     UdpConfig()
         : enable_reuseaddr(false)
-        , enable_non_blocking(true) {
+        , enable_non_blocking(true)
+        , batch_size(0)
+        , enable_gso(false)
+        , enable_gro(false) {
         multicast_interface[0] = '\0';
     }
 
@@ -62,11 +91,17 @@ struct UdpConfig {
         return bind_address == other.bind_address
             && strcmp(multicast_interface, other.multicast_interface) == 0
             && enable_reuseaddr == other.enable_reuseaddr
-            && enable_non_blocking == other.enable_non_blocking;
+            && enable_non_blocking == other.enable_non_blocking
+            && batch_size == other.batch_size && enable_gso == other.enable_gso
+            && enable_gro == other.enable_gro;
     }
 };
 
 //! UDP sender/receiver port.
+//!
+//! Outbound packets with non-zero send timestamp (see packet::UDP) are held
+//! by port until their send time, and then released from network thread using
+//! timer. Resolution of timer is one millisecond.
 class UdpPort : public BasicPort, private packet::IWriter {
 public:
     //! Initialize.
@@ -116,11 +151,43 @@ private:
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
 
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
+
+    static void pacing_timer_cb_(uv_timer_t* handle);
+
     // Implements packet::IWriter::write()
     virtual status::StatusCode write(const packet::PacketPtr& packet);
-    void write_(const packet::PacketPtr& packet);
+    // Implements packet::IWriter::write_batch()
+    virtual status::StatusCode write_batch(const packet::PacketPtr* packets,
+                                           size_t n_packets);
+    void validate_packet_(const packet::PacketPtr& pp);
+    void write_(const packet::PacketPtr* packets, size_t n_packets);
     bool try_nonblocking_write_(const packet::PacketPtr& pp);
 
+    packet::PacketPtr new_packet_(const core::BufferPtr& bp,
+                                  size_t size,
+                                  const address::SocketAddr& src_addr);
+    void deliver_packet_(const core::BufferPtr& bp,
+                         size_t size,
+                         const address::SocketAddr& src_addr);
+    void enqueue_packet_(const core::BufferPtr& bp,
+                         size_t size,
+                         const address::SocketAddr& src_addr);
+    void deliver_enqueued_packets_();
+    void write_inbound_(const packet::PacketPtr* packets, size_t n_packets);
+
+    bool init_batching_();
+    void update_poll_();
+    void recv_batch_();
+    void recv_coalesced_(const SocketDatagram& dgram);
+    void send_pending_();
+    void send_async_();
+    void send_batch_();
+    packet::PacketPtr pop_outbound_(core::nanoseconds_t now);
+    void schedule_pacing_();
+    size_t gso_run_length_(size_t pos) const;
+    void complete_send_(size_t n_packets, bool success);
+
     bool fully_closed_() const;
     void start_closing_();
 
@@ -142,6 +209,16 @@ private:
     uv_async_t write_sem_;
     bool write_sem_initialized_;
 
+    // Used in batched mode instead of uv_udp_recv_start() and uv_udp_send().
+    uv_poll_t poll_handle_;
+    bool poll_initialized_;
+    int poll_events_;
+    bool send_blocked_;
+
+    // Used to release paced packets.
+    uv_timer_t pacing_timer_;
+    bool pacing_timer_initialized_;
+
     bool multicast_group_joined_;
     bool recv_started_;
     bool want_close_;
@@ -153,6 +230,22 @@ private:
 
     packet::IWriter* inbound_writer_;
     core::MpscQueue<packet::Packet> outbound_queue_;
+    // Packets taken from outbound queue which send time didn't come yet,
+    // ordered by send timestamp. Accessed only from network thread.
+    core::List<packet::Packet> paced_queue_;
+
+    core::Array<core::BufferPtr> recv_bufs_;
+    core::Array<SocketDatagram> recv_dgrams_;
+    // Received packets delivered to inbound writer in one batch.
+    core::Array<packet::PacketPtr> recv_packets_;
+
+    core::Array<packet::PacketPtr> send_packets_;
+    core::Array<SocketDatagram> send_dgrams_;
+    size_t send_pos_;
+
+    bool gso_enabled_;
+    bool gro_enabled_;
+    core::Array<uint8_t> gro_buf_;
 
     core::RateLimiter rate_limiter_;
 
@@ -10,7 +10,9 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <signal.h>
+#include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <time.h>
@@ -26,6 +28,19 @@ namespace netio {
 
 namespace {
 
+// Maximum number of datagrams transferred by a single batched system call.
+enum { MaxBatchSize = 64 };
+
+// Maximum number of segments and total payload size of UDP GSO super-datagram.
+// Payload limit leaves room for UDP and IPv6 headers within 64K.
+enum { MaxGsoSegments = 64, MaxGsoSize = 65535 - 8 - 40 };
+
+// Control message buffer, large enough for UDP_GRO and UDP_SEGMENT.
+union ControlBuf {
+    char data[CMSG_SPACE(sizeof(int))];
+    cmsghdr align;
+};
+
 int to_domain(address::AddrFamily family) {
     switch (family) {
     case address::Family_IPv4:
@@ -75,6 +90,65 @@ bool is_malformed(int err) {
     return err == EBADF || err == EFAULT || err == ENOTSOCK;
 }
 
+void init_recv_msghdr(msghdr& hdr,
+                      iovec& iov,
+                      sockaddr_storage& addr,
+                      ControlBuf& control,
+                      const SocketDatagram& dgram) {
+    roc_panic_if(!dgram.buf);
+
+    iov.iov_base = dgram.buf;
+    iov.iov_len = dgram.bufsz;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = &addr;
+    hdr.msg_namelen = sizeof(addr);
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control.data;
+    hdr.msg_controllen = sizeof(control.data);
+}
+
+void init_send_msghdr(msghdr& hdr, iovec& iov, const SocketDatagram& dgram) {
+    roc_panic_if(!dgram.buf);
+    roc_panic_if(!dgram.addr.has_host_port());
+
+    iov.iov_base = dgram.buf;
+    iov.iov_len = dgram.bufsz;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = const_cast<sockaddr*>(dgram.addr.saddr());
+    hdr.msg_namelen = dgram.addr.slen();
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+}
+
+void finish_recv_datagram(SocketDatagram& dgram,
+                          msghdr& hdr,
+                          const sockaddr_storage& addr,
+                          size_t datasz) {
+    dgram.datasz = datasz;
+    dgram.segment_size = 0;
+    dgram.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+
+#if defined(UDP_GRO)
+    // If kernel coalesced multiple datagrams, it reports their size.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int segment_size = 0;
+            memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+            if (segment_size > 0 && (size_t)segment_size < datasz) {
+                dgram.segment_size = (size_t)segment_size;
+            }
+        }
+    }
+#endif // defined(UDP_GRO)
+
+    if (!dgram.addr.set_host_port_saddr((const sockaddr*)&addr)) {
+        dgram.addr.clear();
+    }
+}
+
 bool get_local_address(SocketHandle sock, address::SocketAddr& address) {
     socklen_t addrlen = address.max_slen();
 
@@ -653,6 +727,342 @@ ssize_t socket_try_send_to(SocketHandle sock,
     return ret;
 }
 
+#if defined(__linux__)
+
+// This version is used on Linux, where recvmmsg() and sendmmsg() allow
+// to transfer multiple datagrams using a single system call.
+
+ssize_t
+socket_try_recv_batch(SocketHandle sock, SocketDatagram* dgrams, size_t n_dgrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!dgrams);
+
+    if (n_dgrams == 0) {
+        return 0;
+    }
+
+    if (n_dgrams > MaxBatchSize) {
+        n_dgrams = MaxBatchSize;
+    }
+
+    mmsghdr msgs[MaxBatchSize];
+    iovec iovs[MaxBatchSize];
+    sockaddr_storage addrs[MaxBatchSize];
+    ControlBuf controls[MaxBatchSize];
+
+    for (size_t n = 0; n < n_dgrams; n++) {
+        init_recv_msghdr(msgs[n].msg_hdr, iovs[n], addrs[n], controls[n], dgrams[n]);
+        msgs[n].msg_len = 0;
+    }
+
+    int ret;
+    while ((ret = recvmmsg(sock, msgs, (unsigned)n_dgrams, MSG_DONTWAIT, NULL)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if ((ret < 0 && is_ewouldblock(errno)) || ret == 0) {
+        return SockErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: recvmmsg(): %s", core::errno_to_str().c_str());
+        return SockErr_Failure;
+    }
+
+    for (size_t n = 0; n < (size_t)ret; n++) {
+        finish_recv_datagram(dgrams[n], msgs[n].msg_hdr, addrs[n], msgs[n].msg_len);
+    }
+
+    return ret;
+}
+
+ssize_t
+socket_try_send_batch(SocketHandle sock, const SocketDatagram* dgrams, size_t n_dgrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!dgrams);
+
+    if (n_dgrams == 0) {
+        return 0;
+    }
+
+    if (n_dgrams > MaxBatchSize) {
+        n_dgrams = MaxBatchSize;
+    }
+
+    mmsghdr msgs[MaxBatchSize];
+    iovec iovs[MaxBatchSize];
+
+    for (size_t n = 0; n < n_dgrams; n++) {
+        init_send_msghdr(msgs[n].msg_hdr, iovs[n], dgrams[n]);
+        msgs[n].msg_len = 0;
+    }
+
+    // If some datagrams were sent and then an error occurred, sendmmsg()
+    // returns the number of sent datagrams, and the error is reported
+    // by the next call.
+    int ret;
+    while ((ret = sendmmsg(sock, msgs, (unsigned)n_dgrams, MSG_DONTWAIT)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if ((ret < 0 && is_ewouldblock(errno)) || ret == 0) {
+        return SockErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: sendmmsg(): %s", core::errno_to_str().c_str());
+        return SockErr_Failure;
+    }
+
+    return ret;
+}
+
+#else // !defined(__linux__)
+
+// This version is used on other platforms, where we fall back to one
+// system call per datagram.
+
+ssize_t
+socket_try_recv_batch(SocketHandle sock, SocketDatagram* dgrams, size_t n_dgrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!dgrams);
+
+    size_t n_recv = 0;
+
+    while (n_recv < n_dgrams && n_recv < MaxBatchSize) {
+        msghdr hdr;
+        iovec iov;
+        sockaddr_storage addr;
+        ControlBuf control;
+
+        init_recv_msghdr(hdr, iov, addr, control, dgrams[n_recv]);
+
+        ssize_t ret;
+        while ((ret = recvmsg(sock, &hdr, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_recv != 0) {
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return SockErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: recvmsg(): %s", core::errno_to_str().c_str());
+            return SockErr_Failure;
+        }
+
+        finish_recv_datagram(dgrams[n_recv], hdr, addr, (size_t)ret);
+        n_recv++;
+    }
+
+    return (ssize_t)n_recv;
+}
+
+ssize_t
+socket_try_send_batch(SocketHandle sock, const SocketDatagram* dgrams, size_t n_dgrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!dgrams);
+
+    size_t n_sent = 0;
+
+    while (n_sent < n_dgrams && n_sent < MaxBatchSize) {
+        msghdr hdr;
+        iovec iov;
+
+        init_send_msghdr(hdr, iov, dgrams[n_sent]);
+
+        ssize_t ret;
+        while ((ret = sendmsg(sock, &hdr, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_sent != 0) {
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return SockErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: sendmsg(): %s", core::errno_to_str().c_str());
+            return SockErr_Failure;
+        }
+
+        n_sent++;
+    }
+
+    return (ssize_t)n_sent;
+}
+
+#endif // defined(__linux__)
+
+#if defined(UDP_SEGMENT)
+
+ssize_t socket_try_send_segmented(SocketHandle sock,
+                                  const SocketDatagram* segments,
+                                  size_t n_segments) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!segments);
+
+    if (n_segments == 0) {
+        return 0;
+    }
+
+    const size_t segment_size = segments[0].bufsz;
+    const address::SocketAddr& remote_address = segments[0].addr;
+
+    roc_panic_if(segment_size == 0);
+    roc_panic_if(!remote_address.has_host_port());
+
+    iovec iovs[MaxGsoSegments];
+    size_t total_size = 0;
+    size_t n_iovs = 0;
+
+    while (n_iovs < n_segments && n_iovs < MaxGsoSegments) {
+        const SocketDatagram& seg = segments[n_iovs];
+
+        roc_panic_if(!seg.buf);
+        roc_panic_if(seg.bufsz > segment_size);
+
+        if (n_iovs != 0 && segments[n_iovs - 1].bufsz != segment_size) {
+            roc_panic("socket: only last segment may be shorter than segment size");
+        }
+
+        if (total_size + seg.bufsz > MaxGsoSize) {
+            break;
+        }
+
+        iovs[n_iovs].iov_base = seg.buf;
+        iovs[n_iovs].iov_len = seg.bufsz;
+
+        total_size += seg.bufsz;
+        n_iovs++;
+    }
+
+    roc_panic_if(n_iovs == 0);
+
+    ControlBuf control;
+    memset(&control, 0, sizeof(control));
+
+    msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = const_cast<sockaddr*>(remote_address.saddr());
+    hdr.msg_namelen = remote_address.slen();
+    hdr.msg_iov = iovs;
+    hdr.msg_iovlen = n_iovs;
+    hdr.msg_control = control.data;
+    hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+    const uint16_t gso_size = (uint16_t)segment_size;
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(gso_size));
+    memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+    ssize_t ret;
+    while ((ret = sendmsg(sock, &hdr, MSG_DONTWAIT)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return SockErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogDebug, "socket: sendmsg(UDP_SEGMENT): %s",
+                core::errno_to_str().c_str());
+        return SockErr_Failure;
+    }
+
+    return (ssize_t)n_iovs;
+}
+
+bool socket_check_gso(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+    int opt_val = 0;
+    socklen_t opt_len = sizeof(opt_val);
+
+    if (getsockopt(sock, IPPROTO_UDP, UDP_SEGMENT, &opt_val, &opt_len) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        roc_log(LogDebug, "socket: getsockopt(UDP_SEGMENT): %s",
+                core::errno_to_str().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+#else // !defined(UDP_SEGMENT)
+
+ssize_t socket_try_send_segmented(SocketHandle sock,
+                                  const SocketDatagram* segments,
+                                  size_t n_segments) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!segments);
+
+    roc_log(LogDebug, "socket: UDP_SEGMENT not supported on this platform");
+    return SockErr_Failure;
+}
+
+bool socket_check_gso(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+    roc_log(LogDebug, "socket: UDP_SEGMENT not supported on this platform");
+    return false;
+}
+
+#endif // defined(UDP_SEGMENT)
+
+bool socket_enable_gro(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(UDP_GRO)
+    int opt_val = 1;
+
+    if (setsockopt(sock, IPPROTO_UDP, UDP_GRO, &opt_val, sizeof(opt_val)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        roc_log(LogDebug, "socket: setsockopt(UDP_GRO): %s",
+                core::errno_to_str().c_str());
+        return false;
+    }
+
+    return true;
+#else  // !defined(UDP_GRO)
+    roc_log(LogDebug, "socket: UDP_GRO not supported on this platform");
+    return false;
+#endif // defined(UDP_GRO)
+}
+
 bool socket_shutdown(SocketHandle sock) {
     roc_panic_if(sock < 0);
 
@@ -47,6 +47,45 @@ enum SocketError {
     SockErr_Failure = -3
 };
 
+//! Datagram descriptor for batched I/O.
+struct SocketDatagram {
+    //! Datagram buffer.
+    void* buf;
+
+    //! Buffer size.
+    //! When sending, this number of bytes is sent from buffer.
+    //! When receiving, this is the maximum number of bytes to receive.
+    size_t bufsz;
+
+    //! Number of bytes received.
+    //! Set when receiving.
+    size_t datasz;
+
+    //! Size of coalesced datagrams.
+    //! Set when receiving, if receive offload is enabled and the kernel coalesced
+    //! multiple datagrams into one. In this case, @c datasz bytes should be split
+    //! into datagrams of this size (the last one may be shorter).
+    //! Zero if datagram was not coalesced.
+    size_t segment_size;
+
+    //! Remote address.
+    //! When sending, datagram is sent to this address.
+    //! When receiving, set to the address of the sender.
+    address::SocketAddr addr;
+
+    //! Whether datagram was truncated because it did not fit into buffer.
+    //! Set when receiving.
+    bool truncated;
+
+    SocketDatagram()
+        : buf(NULL)
+        , bufsz(0)
+        , datasz(0)
+        , segment_size(0)
+        , truncated(false) {
+    }
+};
+
 //! Platform-specific socket handle.
 typedef int SocketHandle;
 
@@ -101,6 +140,42 @@ ROC_ATTR_NODISCARD ssize_t socket_try_send_to(SocketHandle sock,
                                               size_t bufsz,
                                               const address::SocketAddr& remote_address);
 
+//! Try to receive multiple datagrams from socket, without blocking.
+//! Fills datagrams in the order they were received, starting from the first one.
+//! May use a single system call when supported by platform.
+//! @returns number of datagrams received (> 0) or SocketError (< 0).
+ROC_ATTR_NODISCARD ssize_t socket_try_recv_batch(SocketHandle sock,
+                                                 SocketDatagram* dgrams,
+                                                 size_t n_dgrams);
+
+//! Try to send multiple datagrams via socket, without blocking.
+//! Sends datagrams in order, starting from the first one. If not all datagrams
+//! were sent, the rest should be retried later.
+//! May use a single system call when supported by platform.
+//! @returns number of datagrams sent (> 0) or SocketError (< 0).
+ROC_ATTR_NODISCARD ssize_t socket_try_send_batch(SocketHandle sock,
+                                                 const SocketDatagram* dgrams,
+                                                 size_t n_dgrams);
+
+//! Try to send multiple datagrams via socket as one super-datagram, without
+//! blocking, using UDP generic segmentation offload (GSO).
+//! All datagrams are sent to the address of the first one. All datagrams should
+//! have the same size, except the last one, which may be shorter. If datagrams
+//! don't fit into one super-datagram, only the first part of them is sent.
+//! @returns number of datagrams sent (> 0) or SocketError (< 0).
+//! If GSO is refused by kernel, returns SockErr_Failure.
+ROC_ATTR_NODISCARD ssize_t socket_try_send_segmented(SocketHandle sock,
+                                                     const SocketDatagram* segments,
+                                                     size_t n_segments);
+
+//! Check if UDP generic segmentation offload (GSO) is supported for socket.
+ROC_ATTR_NODISCARD bool socket_check_gso(SocketHandle sock);
+
+//! Enable UDP generic receive offload (GRO) for socket.
+//! When enabled, socket_try_recv_batch() may return coalesced datagrams.
+//! @returns false if GRO is not supported.
+ROC_ATTR_NODISCARD bool socket_enable_gro(SocketHandle sock);
+
 //! Gracefully shutdown connection.
 ROC_ATTR_NODISCARD bool socket_shutdown(SocketHandle sock);
 
@@ -15,23 +15,68 @@ namespace node {
 
 Context::Context(const ContextConfig& config, core::IArena& arena)
     : arena_(arena)
+    , shared_pools_(NULL)
     , packet_pool_("packet_pool", arena_)
     , packet_buffer_pool_(
           "packet_buffer_pool", arena_, sizeof(core::Buffer) + config.max_packet_size)
     , frame_buffer_pool_(
           "frame_buffer_pool", arena_, sizeof(core::Buffer) + config.max_frame_size)
+    , memory_limiter_("context", config.max_memory)
+    , limited_packet_pool_(packet_pool_, memory_limiter_)
+    , limited_packet_buffer_pool_(packet_buffer_pool_, memory_limiter_)
+    , limited_frame_buffer_pool_(frame_buffer_pool_, memory_limiter_)
     , encoding_map_(arena_)
-    , network_loop_(packet_pool_, packet_buffer_pool_, arena_)
-    , control_loop_(network_loop_, arena_) {
-    roc_log(LogDebug, "context: initializing");
+    , network_loop_(limited_packet_pool_, limited_packet_buffer_pool_, arena_)
+    , control_loop_(network_loop_, arena_)
+    , valid_(true) {
+    roc_log(LogDebug, "context: initializing: max_memory=%lu",
+            (unsigned long)config.max_memory);
+}
+
+Context::Context(const ContextConfig& config,
+                 SharedPools& shared_pools,
+                 core::IArena& arena)
+    : arena_(arena)
+    , shared_pools_(&shared_pools)
+    , packet_pool_("packet_pool", arena_)
+    , packet_buffer_pool_("packet_buffer_pool", arena_)
+    , frame_buffer_pool_("frame_buffer_pool", arena_)
+    , memory_limiter_("context", config.max_memory)
+    , limited_packet_pool_(shared_pools.packet_pool(), memory_limiter_)
+    , limited_packet_buffer_pool_(shared_pools.packet_buffer_pool(), memory_limiter_)
+    , limited_frame_buffer_pool_(shared_pools.frame_buffer_pool(), memory_limiter_)
+    , encoding_map_(arena_)
+    , network_loop_(limited_packet_pool_, limited_packet_buffer_pool_, arena_)
+    , control_loop_(network_loop_, arena_)
+    , valid_(false) {
+    roc_log(LogDebug, "context: initializing with shared pools: max_memory=%lu",
+            (unsigned long)config.max_memory);
+
+    if (config.max_packet_size > shared_pools.max_packet_size()
+        || config.max_frame_size > shared_pools.max_frame_size()) {
+        roc_log(LogError,
+                "context: sizes exceed limits of shared pools:"
+                " max_packet_size=%lu(shared %lu) max_frame_size=%lu(shared %lu)",
+                (unsigned long)config.max_packet_size,
+                (unsigned long)shared_pools.max_packet_size(),
+                (unsigned long)config.max_frame_size,
+                (unsigned long)shared_pools.max_frame_size());
+        return;
+    }
+
+    valid_ = true;
 }
 
 Context::~Context() {
     roc_log(LogDebug, "context: deinitializing");
+
+    if (shared_pools_) {
+        shared_pools_->reclaim();
+    }
 }
 
 bool Context::is_valid() {
-    return network_loop_.is_valid() && control_loop_.is_valid();
+    return valid_ && network_loop_.is_valid() && control_loop_.is_valid();
 }
 
 core::IArena& Context::arena() {
@@ -39,15 +84,19 @@ core::IArena& Context::arena() {
 }
 
 core::IPool& Context::packet_pool() {
-    return packet_pool_;
+    return limited_packet_pool_;
 }
 
 core::IPool& Context::packet_buffer_pool() {
-    return packet_buffer_pool_;
+    return limited_packet_buffer_pool_;
 }
 
 core::IPool& Context::frame_buffer_pool() {
-    return frame_buffer_pool_;
+    return limited_frame_buffer_pool_;
+}
+
+size_t Context::memory_usage() {
+    return memory_limiter_.num_acquired();
 }
 
 rtp::EncodingMap& Context::encoding_map() {
@@ -16,10 +16,13 @@
 #include "roc_core/allocation_policy.h"
 #include "roc_core/atomic.h"
 #include "roc_core/iarena.h"
+#include "roc_core/limited_pool.h"
+#include "roc_core/memory_limiter.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/slab_pool.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
+#include "roc_node/shared_pools.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_rtp/encoding_map.h"
 
@@ -34,9 +37,14 @@ struct ContextConfig {
     //! Maximum size in bytes of an audio frame.
     size_t max_frame_size;
 
+    //! Maximum memory in bytes used by objects allocated from context pools.
+    //! If zero, there is no limit.
+    size_t max_memory;
+
     ContextConfig()
         : max_packet_size(2048)
-        , max_frame_size(4096) {
+        , max_frame_size(4096)
+        , max_memory(0) {
     }
 };
 
@@ -44,8 +52,15 @@ struct ContextConfig {
 class Context : public core::RefCounted<Context, core::ManualAllocation> {
 public:
     //! Initialize.
+    //! Context will use its own pools.
     explicit Context(const ContextConfig& config, core::IArena& arena);
 
+    //! Initialize.
+    //! Context will allocate packets and buffers from @p shared_pools.
+    //! Maximum packet and frame sizes from @p config should not exceed the
+    //! ones of @p shared_pools.
+    Context(const ContextConfig& config, SharedPools& shared_pools, core::IArena& arena);
+
     //! Deinitialize.
     ~Context();
 
@@ -64,6 +79,9 @@ public:
     //! Get frame buffer pool.
     core::IPool& frame_buffer_pool();
 
+    //! Get number of bytes currently used by objects allocated from context pools.
+    size_t memory_usage();
+
     //! Get encoding map.
     rtp::EncodingMap& encoding_map();
 
@@ -76,14 +94,25 @@ public:
 private:
     core::IArena& arena_;
 
+    SharedPools* shared_pools_;
+
+    // Used if there are no shared pools.
     core::SlabPool<packet::Packet> packet_pool_;
     core::SlabPool<core::Buffer> packet_buffer_pool_;
     core::SlabPool<core::Buffer> frame_buffer_pool_;
 
+    core::MemoryLimiter memory_limiter_;
+
+    core::LimitedPool limited_packet_pool_;
+    core::LimitedPool limited_packet_buffer_pool_;
+    core::LimitedPool limited_frame_buffer_pool_;
+
     rtp::EncodingMap encoding_map_;
 
     netio::NetworkLoop network_loop_;
     ctl::ControlLoop control_loop_;
+
+    bool valid_;
 };
 
 } // namespace node
@@ -0,0 +1,754 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/metrics_exporter.h"
+#include "roc_address/socket_addr_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/string_builder.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+// Maximum number of connections (participants) per slot.
+enum { MaxParticipants = 64 };
+
+// How often to report that participants were truncated.
+const core::nanoseconds_t TruncationReportInterval = core::Minute;
+
+// Maximum size of HTTP request headers.
+enum { MaxRequestSize = 8192 };
+
+// Size of buffer for reading request.
+enum { ReadBufSize = 512 };
+
+struct MetricInfo {
+    const char* name;
+    const char* type;
+    const char* help;
+};
+
+const MetricInfo pipeline_metrics[] = {
+    { "roc_pipeline_tasks_total", "counter", "Number of processed pipeline tasks." },
+    { "roc_pipeline_tasks_in_place_total", "counter",
+      "Number of pipeline tasks processed in place when scheduled." },
+    { "roc_pipeline_tasks_in_frame_total", "counter",
+      "Number of pipeline tasks processed between subframes." },
+    { "roc_pipeline_preemptions_total", "counter",
+      "Number of times task processing was preempted by frame processing." },
+    { "roc_pipeline_scheduler_calls_total", "counter",
+      "Number of times asynchronous task processing was scheduled." },
+    { "roc_pipeline_scheduler_cancellations_total", "counter",
+      "Number of times asynchronous task processing was cancelled." },
+};
+
+const MetricInfo receiver_slot_metrics[] = {
+    { "roc_receiver_connections", "gauge", "Number of connected senders." },
+    { "roc_receiver_late_packets_total", "counter",
+      "Number of packets dropped because they were received too late." },
+    { "roc_receiver_recovered_packets_total", "counter",
+      "Number of lost packets restored using FEC." },
+    { "roc_receiver_decoded_samples_total", "counter",
+      "Number of samples per channel decoded from packets." },
+    { "roc_receiver_missing_samples_total", "counter",
+      "Number of samples per channel replaced with silence." },
+    { "roc_receiver_plc_frames_total", "counter",
+      "Number of frames where packet loss concealment was applied." },
+    { "roc_receiver_plc_samples_total", "counter",
+      "Number of samples per channel restored by packet loss concealment." },
+    { "roc_receiver_plc_cpu_seconds_total", "counter",
+      "Time spent on packet loss concealment." },
+};
+
+const MetricInfo receiver_party_metrics[] = {
+    { "roc_receiver_e2e_latency_seconds", "gauge", "Estimated end-to-end latency." },
+    { "roc_receiver_niq_latency_seconds", "gauge",
+      "Estimated latency of network incoming queue." },
+    { "roc_receiver_niq_stalling_seconds", "gauge", "Time since last received packet." },
+    { "roc_receiver_jitter_seconds", "gauge", "Estimated interarrival jitter." },
+    { "roc_receiver_lost_packets", "gauge",
+      "Cumulative number of lost packets reported by link meter." },
+    { "roc_receiver_queued_packets", "gauge",
+      "Number of packets in incoming source queue." },
+    { "roc_receiver_resampler_scaling", "gauge",
+      "Clock drift compensation scaling factor." },
+};
+
+const MetricInfo sender_slot_metrics[] = {
+    { "roc_sender_connections", "gauge", "Number of discovered receivers." },
+    { "roc_sender_fec_source_packets", "gauge",
+      "Number of source packets per FEC block." },
+    { "roc_sender_fec_repair_packets", "gauge",
+      "Number of repair packets per FEC block." },
+    { "roc_sender_fec_loss_ratio", "gauge",
+      "Loss ratio used to select FEC block size." },
+    { "roc_sender_pacing_delay_seconds", "gauge",
+      "Average delay added to packets by pacing." },
+    { "roc_sender_pacing_max_delay_seconds", "gauge",
+      "Maximum delay added to packets by pacing." },
+    { "roc_sender_pacing_burst_packets", "gauge",
+      "Average number of packets spread by pacing at once." },
+    { "roc_sender_pacing_max_burst_packets", "gauge",
+      "Maximum number of packets spread by pacing at once." },
+};
+
+const MetricInfo sender_party_metrics[] = {
+    { "roc_sender_e2e_latency_seconds", "gauge", "Estimated end-to-end latency." },
+    { "roc_sender_rtt_seconds", "gauge", "Estimated round-trip time." },
+    { "roc_sender_jitter_seconds", "gauge",
+      "Interarrival jitter reported by receiver." },
+    { "roc_sender_lost_packets", "gauge",
+      "Cumulative number of lost packets reported by receiver." },
+};
+
+double ns_2_sec(core::nanoseconds_t ns) {
+    return (double)ns / core::Second;
+}
+
+void fill_pipeline_values(const pipeline::PipelineLoop::Stats& stats, double* values) {
+    values[0] = (double)stats.task_processed_total;
+    values[1] = (double)stats.task_processed_in_place;
+    values[2] = (double)stats.task_processed_in_frame;
+    values[3] = (double)stats.preemptions;
+    values[4] = (double)stats.scheduler_calls;
+    values[5] = (double)stats.scheduler_cancellations;
+}
+
+bool format_value(core::StringBuilder& b,
+                  const char* name,
+                  const size_t* slot,
+                  const size_t* party,
+                  double value) {
+    char value_str[32];
+    snprintf(value_str, sizeof(value_str), "%.15g", value);
+
+    b.append_str(name);
+
+    if (slot) {
+        b.append_str("{slot=\"");
+        b.append_uint(*slot, 10);
+        b.append_str("\"");
+        if (party) {
+            b.append_str(",connection=\"");
+            b.append_uint(*party, 10);
+            b.append_str("\"");
+        }
+        b.append_str("}");
+    }
+
+    b.append_str(" ");
+    b.append_str(value_str);
+    b.append_str("\n");
+
+    return b.is_ok();
+}
+
+bool format_header(core::StringBuilder& b, const MetricInfo& info) {
+    b.append_str("# HELP ");
+    b.append_str(info.name);
+    b.append_str(" ");
+    b.append_str(info.help);
+    b.append_str("\n# TYPE ");
+    b.append_str(info.name);
+    b.append_str(" ");
+    b.append_str(info.type);
+    b.append_str("\n");
+
+    return b.is_ok();
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const MetricsExporterConfig& config,
+                                 Context& context,
+                                 Receiver& receiver)
+    : config_(config)
+    , node_type_(NodeType_Receiver)
+    , context_(context)
+    , arena_(context.arena())
+    , receiver_(&receiver)
+    , sender_(NULL)
+    , node_values_(arena_)
+    , slot_values_(arena_)
+    , party_values_(arena_)
+    , party_slots_(arena_)
+    , party_indices_(arena_)
+    , cur_slot_(0)
+    , cur_num_participants_(0)
+    , query_ok_(false)
+    , truncation_limiter_(TruncationReportInterval)
+    , text_(arena_)
+    , new_text_(arena_)
+    , port_(NULL)
+    , conn_cond_(conn_mutex_)
+    , stop_cond_(stop_mutex_)
+    , stopping_(0)
+    , started_(false) {
+}
+
+MetricsExporter::MetricsExporter(const MetricsExporterConfig& config,
+                                 Context& context,
+                                 Sender& sender)
+    : config_(config)
+    , node_type_(NodeType_Sender)
+    , context_(context)
+    , arena_(context.arena())
+    , receiver_(NULL)
+    , sender_(&sender)
+    , node_values_(arena_)
+    , slot_values_(arena_)
+    , party_values_(arena_)
+    , party_slots_(arena_)
+    , party_indices_(arena_)
+    , cur_slot_(0)
+    , cur_num_participants_(0)
+    , query_ok_(false)
+    , truncation_limiter_(TruncationReportInterval)
+    , text_(arena_)
+    , new_text_(arena_)
+    , port_(NULL)
+    , conn_cond_(conn_mutex_)
+    , stop_cond_(stop_mutex_)
+    , stopping_(0)
+    , started_(false) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(address::SocketAddr& bind_address) {
+    roc_panic_if_msg(started_, "metrics exporter: already started");
+
+    // Prepare cache before accepting first connection.
+    if (!update()) {
+        roc_log(LogError, "metrics exporter: can't query initial metrics");
+        return false;
+    }
+
+    netio::TcpServerConfig server_config;
+    server_config.bind_address = bind_address;
+
+    netio::NetworkLoop::Tasks::AddTcpServerPort port_task(server_config, *this);
+    if (!context_.network_loop().schedule_and_wait(port_task)) {
+        roc_log(LogError, "metrics exporter: can't bind to %s",
+                address::socket_addr_to_str(bind_address).c_str());
+        return false;
+    }
+
+    port_ = port_task.get_handle();
+    bind_address = server_config.bind_address;
+
+    stopping_ = 0;
+    started_ = true;
+
+    if (!Thread::start()) {
+        roc_log(LogError, "metrics exporter: can't start thread");
+        stop();
+        return false;
+    }
+
+    roc_log(LogInfo, "metrics exporter: serving metrics at http://%s/metrics",
+            address::socket_addr_to_str(bind_address).c_str());
+
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!started_) {
+        return;
+    }
+
+    {
+        core::Mutex::Lock lock(stop_mutex_);
+
+        stopping_ = 1;
+        stop_cond_.broadcast();
+    }
+
+    if (Thread::is_joinable()) {
+        Thread::join();
+    }
+
+    {
+        core::Mutex::Lock lock(conn_mutex_);
+
+        // New connections are refused after stopping_ is set, so it's
+        // enough to terminate current ones and wait until they're removed.
+        for (Connection* conn = conn_list_.front(); conn;
+             conn = conn_list_.nextof(*conn)) {
+            conn->terminate(netio::Term_Failure);
+        }
+
+        while (!conn_list_.is_empty()) {
+            conn_cond_.wait();
+        }
+    }
+
+    netio::NetworkLoop::Tasks::RemovePort port_task(port_);
+    if (!context_.network_loop().schedule_and_wait(port_task)) {
+        roc_panic("metrics exporter: can't remove network port");
+    }
+
+    port_ = NULL;
+    started_ = false;
+}
+
+bool MetricsExporter::update() {
+    node_values_.clear();
+    slot_values_.clear();
+    party_values_.clear();
+    party_slots_.clear();
+    party_indices_.clear();
+
+    query_ok_ = true;
+
+    if (node_type_ == NodeType_Receiver) {
+        if (!query_receiver_()) {
+            return false;
+        }
+    } else {
+        if (!query_sender_()) {
+            return false;
+        }
+    }
+
+    if (!query_ok_) {
+        roc_log(LogError, "metrics exporter: can't allocate metrics");
+        return false;
+    }
+
+    if (!format_text_(new_text_)) {
+        roc_log(LogError, "metrics exporter: can't format metrics");
+        return false;
+    }
+
+    core::Mutex::Lock lock(text_mutex_);
+
+    return text_.assign(new_text_.c_str());
+}
+
+bool MetricsExporter::get_text(core::StringBuffer& text) {
+    core::Mutex::Lock lock(text_mutex_);
+
+    return text.assign(text_.c_str());
+}
+
+netio::IConnHandler* MetricsExporter::add_connection(netio::IConn& conn) {
+    core::Mutex::Lock lock(conn_mutex_);
+
+    if (stopping_) {
+        return NULL;
+    }
+
+    Connection* handler = new (arena_) Connection(*this, conn, arena_);
+    if (!handler) {
+        roc_log(LogError, "metrics exporter: can't allocate connection");
+        return NULL;
+    }
+
+    conn_list_.push_back(*handler);
+
+    return handler;
+}
+
+void MetricsExporter::remove_connection(netio::IConnHandler& handler) {
+    core::Mutex::Lock lock(conn_mutex_);
+
+    Connection& conn = static_cast<Connection&>(handler);
+
+    conn_list_.remove(conn);
+    arena_.destroy_object(conn);
+
+    conn_cond_.broadcast();
+}
+
+void MetricsExporter::run() {
+    roc_log(LogDebug, "metrics exporter: starting thread");
+
+    while (!stopping_) {
+        {
+            core::Mutex::Lock lock(stop_mutex_);
+
+            const core::nanoseconds_t deadline =
+                core::timestamp(core::ClockMonotonic) + config_.update_interval;
+
+            // Sleep until next update, or until stop() wakes us up.
+            while (!stopping_) {
+                const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+                if (now >= deadline) {
+                    break;
+                }
+                (void)stop_cond_.timed_wait(deadline - now);
+            }
+        }
+
+        if (stopping_) {
+            break;
+        }
+
+        if (!update()) {
+            roc_log(LogError, "metrics exporter: can't update metrics");
+        }
+    }
+
+    roc_log(LogDebug, "metrics exporter: finishing thread");
+}
+
+bool MetricsExporter::format_response_(core::StringBuffer& response) {
+    core::Mutex::Lock lock(text_mutex_);
+
+    core::StringBuilder b(response);
+
+    b.append_str("HTTP/1.0 200 OK\r\n"
+                 "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                 "Connection: close\r\n"
+                 "Content-Length: ");
+    b.append_uint(text_.len(), 10);
+    b.append_str("\r\n\r\n");
+    b.append_str(text_.c_str());
+
+    return b.is_ok();
+}
+
+bool MetricsExporter::query_receiver_() {
+    for (cur_slot_ = 0; cur_slot_ < config_.num_slots; cur_slot_++) {
+        size_t party_count = MaxParticipants;
+        cur_num_participants_ = 0;
+
+        if (!receiver_->get_metrics(cur_slot_, receiver_slot_metrics_, this,
+                                    receiver_party_metrics_, &party_count, this)) {
+            roc_log(LogError, "metrics exporter: can't query metrics of slot %lu",
+                    (unsigned long)cur_slot_);
+            return false;
+        }
+
+        report_truncation_(party_count);
+    }
+
+    return true;
+}
+
+bool MetricsExporter::query_sender_() {
+    for (cur_slot_ = 0; cur_slot_ < config_.num_slots; cur_slot_++) {
+        size_t party_count = MaxParticipants;
+        cur_num_participants_ = 0;
+
+        if (!sender_->get_metrics(cur_slot_, sender_slot_metrics_, this,
+                                  sender_party_metrics_, &party_count, this)) {
+            roc_log(LogError, "metrics exporter: can't query metrics of slot %lu",
+                    (unsigned long)cur_slot_);
+            return false;
+        }
+
+        report_truncation_(party_count);
+    }
+
+    return true;
+}
+
+void MetricsExporter::receiver_slot_metrics_(
+    const pipeline::ReceiverSlotMetrics& slot_metrics, void* arg) {
+    MetricsExporter& self = *(MetricsExporter*)arg;
+
+    if (self.node_values_.size() == 0) {
+        if (!self.node_values_.resize(ROC_ARRAY_SIZE(pipeline_metrics))) {
+            self.query_ok_ = false;
+            return;
+        }
+        fill_pipeline_values(slot_metrics.pipeline, self.node_values_.data());
+    }
+
+    self.cur_num_participants_ = slot_metrics.num_participants;
+
+    // Counters include disconnected participants and never decrease.
+    if (!self.slot_values_.push_back((double)slot_metrics.num_participants)
+        || !self.slot_values_.push_back((double)slot_metrics.depacketizer.late_packets)
+        || !self.slot_values_.push_back((double)slot_metrics.fec.restored_packets)
+        || !self.slot_values_.push_back(
+            (double)slot_metrics.depacketizer.decoded_samples)
+        || !self.slot_values_.push_back(
+            (double)slot_metrics.depacketizer.missing_samples)
+        || !self.slot_values_.push_back((double)slot_metrics.plc.concealed_frames)
+        || !self.slot_values_.push_back((double)slot_metrics.plc.concealed_samples)
+        || !self.slot_values_.push_back(ns_2_sec(slot_metrics.plc.conceal_time))) {
+        self.query_ok_ = false;
+    }
+}
+
+void MetricsExporter::receiver_party_metrics_(
+    const pipeline::ReceiverParticipantMetrics& party_metrics,
+    size_t party_index,
+    void* arg) {
+    MetricsExporter& self = *(MetricsExporter*)arg;
+
+    double* values = NULL;
+    if (!self.add_party_values_(ROC_ARRAY_SIZE(receiver_party_metrics), values)) {
+        return;
+    }
+
+    if (!self.party_indices_.push_back(party_index)) {
+        self.query_ok_ = false;
+        return;
+    }
+
+    values[0] = ns_2_sec(party_metrics.latency.e2e_latency);
+    values[1] = ns_2_sec(party_metrics.latency.niq_latency);
+    values[2] = ns_2_sec(party_metrics.latency.niq_stalling);
+    values[3] = ns_2_sec(party_metrics.link.jitter);
+    values[4] = (double)party_metrics.link.lost_packets;
+    values[5] = (double)party_metrics.queued_packets;
+    values[6] = (double)party_metrics.scaling;
+}
+
+void MetricsExporter::sender_slot_metrics_(
+    const pipeline::SenderSlotMetrics& slot_metrics, void* arg) {
+    MetricsExporter& self = *(MetricsExporter*)arg;
+
+    if (self.node_values_.size() == 0) {
+        if (!self.node_values_.resize(ROC_ARRAY_SIZE(pipeline_metrics))) {
+            self.query_ok_ = false;
+            return;
+        }
+        fill_pipeline_values(slot_metrics.pipeline, self.node_values_.data());
+    }
+
+    self.cur_num_participants_ = slot_metrics.num_participants;
+
+    if (!self.slot_values_.push_back((double)slot_metrics.num_participants)
+        || !self.slot_values_.push_back((double)slot_metrics.fec.n_source_packets)
+        || !self.slot_values_.push_back((double)slot_metrics.fec.n_repair_packets)
+        || !self.slot_values_.push_back((double)slot_metrics.fec.loss_ratio)
+        || !self.slot_values_.push_back(ns_2_sec(slot_metrics.pacer.mean_delay))
+        || !self.slot_values_.push_back(ns_2_sec(slot_metrics.pacer.max_delay))
+        || !self.slot_values_.push_back((double)slot_metrics.pacer.mean_burst)
+        || !self.slot_values_.push_back((double)slot_metrics.pacer.max_burst)) {
+        self.query_ok_ = false;
+    }
+}
+
+void MetricsExporter::sender_party_metrics_(
+    const pipeline::SenderParticipantMetrics& party_metrics,
+    size_t party_index,
+    void* arg) {
+    MetricsExporter& self = *(MetricsExporter*)arg;
+
+    double* values = NULL;
+    if (!self.add_party_values_(ROC_ARRAY_SIZE(sender_party_metrics), values)) {
+        return;
+    }
+
+    if (!self.party_indices_.push_back(party_index)) {
+        self.query_ok_ = false;
+        return;
+    }
+
+    values[0] = ns_2_sec(party_metrics.latency.e2e_latency);
+    values[1] = ns_2_sec(party_metrics.link.rtt);
+    values[2] = ns_2_sec(party_metrics.link.jitter);
+    values[3] = (double)party_metrics.link.lost_packets;
+}
+
+void MetricsExporter::report_truncation_(size_t party_count) {
+    if (cur_num_participants_ <= party_count) {
+        return;
+    }
+
+    if (truncation_limiter_.allow()) {
+        roc_log(LogInfo,
+                "metrics exporter: too many participants in slot %lu,"
+                " exporting only %lu of %lu",
+                (unsigned long)cur_slot_, (unsigned long)party_count,
+                (unsigned long)cur_num_participants_);
+    }
+}
+
+bool MetricsExporter::add_party_values_(size_t n_values, double*& values) {
+    const size_t pos = party_values_.size();
+
+    if (!party_values_.resize(pos + n_values) || !party_slots_.push_back(cur_slot_)) {
+        query_ok_ = false;
+        return false;
+    }
+
+    values = party_values_.data() + pos;
+    return true;
+}
+
+bool MetricsExporter::format_text_(core::StringBuffer& text) {
+    const MetricInfo* slot_metrics = receiver_slot_metrics;
+    size_t n_slot_metrics = ROC_ARRAY_SIZE(receiver_slot_metrics);
+
+    const MetricInfo* party_metrics = receiver_party_metrics;
+    size_t n_party_metrics = ROC_ARRAY_SIZE(receiver_party_metrics);
+
+    if (node_type_ == NodeType_Sender) {
+        slot_metrics = sender_slot_metrics;
+        n_slot_metrics = ROC_ARRAY_SIZE(sender_slot_metrics);
+
+        party_metrics = sender_party_metrics;
+        n_party_metrics = ROC_ARRAY_SIZE(sender_party_metrics);
+    }
+
+    core::StringBuilder b(text);
+
+    if (node_values_.size() != 0) {
+        for (size_t m = 0; m < ROC_ARRAY_SIZE(pipeline_metrics); m++) {
+            if (!format_header(b, pipeline_metrics[m])
+                || !format_value(b, pipeline_metrics[m].name, NULL, NULL,
+                                 node_values_[m])) {
+                return false;
+            }
+        }
+    }
+
+    for (size_t m = 0; m < n_slot_metrics; m++) {
+        if (!format_header(b, slot_metrics[m])) {
+            return false;
+        }
+        for (size_t slot = 0; slot < slot_values_.size() / n_slot_metrics; slot++) {
+            if (!format_value(b, slot_metrics[m].name, &slot, NULL,
+                              slot_values_[slot * n_slot_metrics + m])) {
+                return false;
+            }
+        }
+    }
+
+    for (size_t m = 0; m < n_party_metrics; m++) {
+        if (!format_header(b, party_metrics[m])) {
+            return false;
+        }
+        for (size_t party = 0; party < party_slots_.size(); party++) {
+            if (!format_value(b, party_metrics[m].name, &party_slots_[party],
+                              &party_indices_[party],
+                              party_values_[party * n_party_metrics + m])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+MetricsExporter::Connection::Connection(MetricsExporter& exporter,
+                                        netio::IConn& conn,
+                                        core::IArena& arena)
+    : exporter_(exporter)
+    , conn_(conn)
+    , response_(arena)
+    , response_pos_(0)
+    , request_size_(0)
+    , got_request_(false)
+    , terminating_(0) {
+    memset(request_tail_, 0, sizeof(request_tail_));
+}
+
+void MetricsExporter::Connection::terminate(netio::TerminationMode mode) {
+    if (terminating_.compare_exchange(0, 1)) {
+        conn_.async_terminate(mode);
+    }
+}
+
+void MetricsExporter::Connection::connection_refused(netio::IConn&) {
+    roc_panic("metrics exporter: unexpected connection_refused() call");
+}
+
+void MetricsExporter::Connection::connection_established(netio::IConn&) {
+    roc_log(LogDebug, "metrics exporter: accepted connection from %s",
+            address::socket_addr_to_str(conn_.remote_address()).c_str());
+}
+
+void MetricsExporter::Connection::connection_writable(netio::IConn&) {
+    if (got_request_ && !terminating_) {
+        write_response_();
+    }
+}
+
+void MetricsExporter::Connection::connection_readable(netio::IConn&) {
+    if (!got_request_ && !terminating_) {
+        read_request_();
+    }
+}
+
+void MetricsExporter::Connection::connection_terminated(netio::IConn&) {
+}
+
+void MetricsExporter::Connection::read_request_() {
+    char buf[ReadBufSize];
+
+    for (;;) {
+        const ssize_t ret = conn_.try_read(buf, sizeof(buf));
+
+        if (ret == netio::SockErr_WouldBlock) {
+            return;
+        }
+
+        if (ret < 0) {
+            // Peer closed connection or connection failed before request end.
+            terminate(netio::Term_Failure);
+            return;
+        }
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            memmove(request_tail_, request_tail_ + 1, sizeof(request_tail_) - 1);
+            request_tail_[sizeof(request_tail_) - 1] = buf[n];
+
+            if (memcmp(request_tail_, "\r\n\r\n", 4) == 0
+                || memcmp(request_tail_ + 2, "\n\n", 2) == 0) {
+                got_request_ = true;
+                break;
+            }
+        }
+
+        request_size_ += (size_t)ret;
+
+        if (got_request_) {
+            break;
+        }
+
+        if (request_size_ > MaxRequestSize) {
+            roc_log(LogError, "metrics exporter: request is too large");
+            terminate(netio::Term_Failure);
+            return;
+        }
+    }
+
+    if (!exporter_.format_response_(response_)) {
+        roc_log(LogError, "metrics exporter: can't format response");
+        terminate(netio::Term_Failure);
+        return;
+    }
+
+    write_response_();
+}
+
+void MetricsExporter::Connection::write_response_() {
+    while (response_pos_ < response_.len()) {
+        const ssize_t ret = conn_.try_write(response_.c_str() + response_pos_,
+                                            response_.len() - response_pos_);
+
+        if (ret == netio::SockErr_WouldBlock) {
+            return;
+        }
+
+        if (ret < 0) {
+            terminate(netio::Term_Failure);
+            return;
+        }
+
+        response_pos_ += (size_t)ret;
+    }
+
+    terminate(netio::Term_Normal);
+}
+
+} // namespace node
+} // namespace roc
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/metrics_exporter.h
+//! @brief Metrics exporter.
+
+#ifndef ROC_NODE_METRICS_EXPORTER_H_
+#define ROC_NODE_METRICS_EXPORTER_H_
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/attributes.h"
+#include "roc_core/cond.h"
+#include "roc_core/list.h"
+#include "roc_core/list_node.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/rate_limiter.h"
+#include "roc_core/string_buffer.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+#include "roc_netio/iconn.h"
+#include "roc_netio/iconn_acceptor.h"
+#include "roc_netio/iconn_handler.h"
+#include "roc_netio/network_loop.h"
+#include "roc_node/context.h"
+#include "roc_node/receiver.h"
+#include "roc_node/sender.h"
+
+namespace roc {
+namespace node {
+
+//! Metrics exporter config.
+struct MetricsExporterConfig {
+    //! Number of node slots to query, starting from zero.
+    size_t num_slots;
+
+    //! How often to query metrics.
+    core::nanoseconds_t update_interval;
+
+    MetricsExporterConfig()
+        : num_slots(1)
+        , update_interval(core::Second) {
+    }
+};
+
+//! Metrics exporter.
+//!
+//! Serves metrics of receiver or sender node over HTTP, in Prometheus text
+//! exposition format, so that they can be scraped by Prometheus or any
+//! compatible collector.
+//!
+//! Metrics are queried by a background thread and cached. HTTP requests are
+//! served on network loop thread from the cache, so scraping never waits for
+//! the pipeline. Every request gets the same response, regardless of method
+//! and path, and connection is closed after response.
+class MetricsExporter : public netio::IConnAcceptor, private core::Thread {
+public:
+    //! Initialize exporter for receiver.
+    MetricsExporter(const MetricsExporterConfig& config,
+                    Context& context,
+                    Receiver& receiver);
+
+    //! Initialize exporter for sender.
+    MetricsExporter(const MetricsExporterConfig& config,
+                    Context& context,
+                    Sender& sender);
+
+    //! Stop and deinitialize.
+    virtual ~MetricsExporter();
+
+    //! Start serving metrics.
+    //! @remarks
+    //!  Updates @p bind_address with the actual address, e.g. if port was zero.
+    ROC_ATTR_NODISCARD bool start(address::SocketAddr& bind_address);
+
+    //! Stop serving metrics.
+    //! Terminates open connections and waits until they're closed.
+    void stop();
+
+    //! Query metrics and update cached text.
+    //! @remarks
+    //!  Called automatically by background thread after start().
+    //!  Should not be called concurrently with itself.
+    ROC_ATTR_NODISCARD bool update();
+
+    //! Get cached metrics text.
+    ROC_ATTR_NODISCARD bool get_text(core::StringBuffer& text);
+
+private:
+    enum NodeType { NodeType_Receiver, NodeType_Sender };
+
+    class Connection : public netio::IConnHandler, public core::ListNode<> {
+    public:
+        Connection(MetricsExporter& exporter, netio::IConn& conn, core::IArena& arena);
+
+        void terminate(netio::TerminationMode mode);
+
+        virtual void connection_refused(netio::IConn& conn);
+        virtual void connection_established(netio::IConn& conn);
+        virtual void connection_writable(netio::IConn& conn);
+        virtual void connection_readable(netio::IConn& conn);
+        virtual void connection_terminated(netio::IConn& conn);
+
+    private:
+        void read_request_();
+        void write_response_();
+
+        MetricsExporter& exporter_;
+        netio::IConn& conn_;
+
+        core::StringBuffer response_;
+        size_t response_pos_;
+
+        size_t request_size_;
+        char request_tail_[4];
+
+        bool got_request_;
+        core::Atomic<int> terminating_;
+    };
+
+    virtual netio::IConnHandler* add_connection(netio::IConn& conn);
+    virtual void remove_connection(netio::IConnHandler& handler);
+
+    virtual void run();
+
+    bool format_response_(core::StringBuffer& response);
+
+    bool query_receiver_();
+    bool query_sender_();
+
+    static void receiver_slot_metrics_(const pipeline::ReceiverSlotMetrics& slot_metrics,
+                                       void* arg);
+    static void
+    receiver_party_metrics_(const pipeline::ReceiverParticipantMetrics& party_metrics,
+                            size_t party_index,
+                            void* arg);
+
+    static void sender_slot_metrics_(const pipeline::SenderSlotMetrics& slot_metrics,
+                                     void* arg);
+    static void
+    sender_party_metrics_(const pipeline::SenderParticipantMetrics& party_metrics,
+                          size_t party_index,
+                          void* arg);
+
+    void report_truncation_(size_t party_count);
+
+    bool add_party_values_(size_t n_values, double*& values);
+
+    bool format_text_(core::StringBuffer& text);
+
+    const MetricsExporterConfig config_;
+    const NodeType node_type_;
+
+    Context& context_;
+    core::IArena& arena_;
+
+    Receiver* receiver_;
+    Sender* sender_;
+
+    // metrics collected by last query
+    // values are stored in the order of metric tables in .cpp
+    core::Array<double> node_values_;
+    core::Array<double> slot_values_;
+    core::Array<double> party_values_;
+    core::Array<size_t> party_slots_;
+    core::Array<size_t> party_indices_;
+
+    size_t cur_slot_;
+    size_t cur_num_participants_;
+    bool query_ok_;
+
+    core::RateLimiter truncation_limiter_;
+
+    // cached text
+    core::StringBuffer text_;
+    core::StringBuffer new_text_;
+    core::Mutex text_mutex_;
+
+    netio::NetworkLoop::PortHandle port_;
+
+    core::List<Connection, core::NoOwnership> conn_list_;
+    core::Mutex conn_mutex_;
+    core::Cond conn_cond_;
+
+    // wakes up background thread when stopping
+    core::Mutex stop_mutex_;
+    core::Cond stop_cond_;
+    core::Atomic<int> stopping_;
+    bool started_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_METRICS_EXPORTER_H_
@@ -170,6 +170,8 @@ status::StatusCode ReceiverDecoder::write_packet(address::Interface iface,
         return status::StatusUnknown;
     }
 
+    core::Mutex::Lock lock(write_mutex_);
+
     return writer->write(packet);
 }
 
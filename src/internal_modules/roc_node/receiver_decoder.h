@@ -82,6 +82,10 @@ private:
 
     core::Mutex mutex_;
 
+    // Endpoint inbound writers allow only one writer thread at a time,
+    // while write_packet() may be called concurrently.
+    core::Mutex write_mutex_;
+
     address::SocketAddr bind_address_;
 
     core::Optional<packet::ConcurrentQueue> endpoint_queues_[address::Iface_Max];
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/shared_pools.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace node {
+
+SharedPools::SharedPools(const SharedPoolsConfig& config, core::IArena& arena)
+    : max_packet_size_(config.max_packet_size)
+    , max_frame_size_(config.max_frame_size)
+    , packet_pool_("shared_packet_pool", arena)
+    , packet_buffer_pool_(
+          "shared_packet_buffer_pool", arena, sizeof(core::Buffer) + config.max_packet_size)
+    , frame_buffer_pool_(
+          "shared_frame_buffer_pool", arena, sizeof(core::Buffer) + config.max_frame_size)
+    , memory_limiter_("shared_pools", config.max_memory)
+    , limited_packet_pool_(packet_pool_, memory_limiter_)
+    , limited_packet_buffer_pool_(packet_buffer_pool_, memory_limiter_)
+    , limited_frame_buffer_pool_(frame_buffer_pool_, memory_limiter_)
+    , reclaimed_bytes_(0) {
+    roc_log(LogDebug,
+            "shared pools: initializing:"
+            " max_packet_size=%lu max_frame_size=%lu max_memory=%lu",
+            (unsigned long)max_packet_size_, (unsigned long)max_frame_size_,
+            (unsigned long)config.max_memory);
+}
+
+size_t SharedPools::max_packet_size() const {
+    return max_packet_size_;
+}
+
+size_t SharedPools::max_frame_size() const {
+    return max_frame_size_;
+}
+
+core::IPool& SharedPools::packet_pool() {
+    return limited_packet_pool_;
+}
+
+core::IPool& SharedPools::packet_buffer_pool() {
+    return limited_packet_buffer_pool_;
+}
+
+core::IPool& SharedPools::frame_buffer_pool() {
+    return limited_frame_buffer_pool_;
+}
+
+size_t SharedPools::reclaim() {
+    const size_t n_bytes = packet_pool_.reclaim() + packet_buffer_pool_.reclaim()
+        + frame_buffer_pool_.reclaim();
+
+    if (n_bytes != 0) {
+        reclaimed_bytes_ += n_bytes;
+
+        roc_log(LogDebug, "shared pools: reclaimed memory: n_bytes=%lu",
+                (unsigned long)n_bytes);
+    }
+
+    return n_bytes;
+}
+
+SharedPoolsMetrics SharedPools::metrics() {
+    SharedPoolsMetrics metrics;
+
+    metrics.used_bytes = memory_limiter_.num_acquired();
+    metrics.allocated_bytes = packet_pool_.num_slab_bytes()
+        + packet_buffer_pool_.num_slab_bytes() + frame_buffer_pool_.num_slab_bytes();
+    metrics.reclaimed_bytes = reclaimed_bytes_;
+
+    return metrics;
+}
+
+} // namespace node
+} // namespace roc
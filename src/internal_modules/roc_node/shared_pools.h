@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/shared_pools.h
+//! @brief Pools shared by multiple contexts.
+
+#ifndef ROC_NODE_SHARED_POOLS_H_
+#define ROC_NODE_SHARED_POOLS_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/buffer.h"
+#include "roc_core/iarena.h"
+#include "roc_core/limited_pool.h"
+#include "roc_core/memory_limiter.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace node {
+
+//! Shared pools config.
+struct SharedPoolsConfig {
+    //! Maximum size in bytes of a network packet.
+    size_t max_packet_size;
+
+    //! Maximum size in bytes of an audio frame.
+    size_t max_frame_size;
+
+    //! Maximum memory in bytes used by objects allocated from all pools.
+    //! If zero, there is no limit.
+    size_t max_memory;
+
+    SharedPoolsConfig()
+        : max_packet_size(2048)
+        , max_frame_size(4096)
+        , max_memory(0) {
+    }
+};
+
+//! Shared pools metrics.
+struct SharedPoolsMetrics {
+    //! Number of bytes currently used by objects allocated from pools.
+    size_t used_bytes;
+
+    //! Number of bytes currently allocated from arena.
+    //! Includes memory of free slots which were not reclaimed yet.
+    size_t allocated_bytes;
+
+    //! Total number of bytes returned to arena by reclaim().
+    size_t reclaimed_bytes;
+
+    SharedPoolsMetrics()
+        : used_bytes(0)
+        , allocated_bytes(0)
+        , reclaimed_bytes(0) {
+    }
+};
+
+//! Pools shared by multiple contexts.
+//!
+//! By default, every Context owns its packet and buffer pools. When many contexts
+//! are hosted in one process, memory reserved by idle contexts can't be used by
+//! busy ones. Instead, contexts can be constructed with SharedPools, so that they
+//! allocate packets and buffers from common pools.
+//!
+//! Memory usage of all contexts is limited by max_memory. Each context can be
+//! additionally limited by ContextConfig::max_memory.
+//!
+//! Slabs which became free after a load peak are returned to arena by reclaim(),
+//! which is invoked when a context is destroyed and can be also invoked
+//! periodically by the user.
+//!
+//! Should outlive all contexts that use it.
+//!
+//! Thread-safe.
+class SharedPools : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    SharedPools(const SharedPoolsConfig& config, core::IArena& arena);
+
+    //! Get maximum size in bytes of a network packet.
+    size_t max_packet_size() const;
+
+    //! Get maximum size in bytes of an audio frame.
+    size_t max_frame_size() const;
+
+    //! Get packet pool.
+    core::IPool& packet_pool();
+
+    //! Get packet buffer pool.
+    core::IPool& packet_buffer_pool();
+
+    //! Get frame buffer pool.
+    core::IPool& frame_buffer_pool();
+
+    //! Return free slabs of all pools back to arena.
+    //! @returns
+    //!  number of bytes returned to arena.
+    size_t reclaim();
+
+    //! Get metrics.
+    SharedPoolsMetrics metrics();
+
+private:
+    const size_t max_packet_size_;
+    const size_t max_frame_size_;
+
+    core::SlabPool<packet::Packet> packet_pool_;
+    core::SlabPool<core::Buffer> packet_buffer_pool_;
+    core::SlabPool<core::Buffer> frame_buffer_pool_;
+
+    core::MemoryLimiter memory_limiter_;
+
+    core::LimitedPool limited_packet_pool_;
+    core::LimitedPool limited_packet_buffer_pool_;
+    core::LimitedPool limited_frame_buffer_pool_;
+
+    core::Atomic<size_t> reclaimed_bytes_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_SHARED_POOLS_H_
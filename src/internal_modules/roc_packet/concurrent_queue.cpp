@@ -13,13 +13,36 @@
 namespace roc {
 namespace packet {
 
-ConcurrentQueue::ConcurrentQueue(Mode mode) {
+ConcurrentQueue::ConcurrentQueue(Mode mode)
+    : reader_sleeping_(0) {
     if (mode == Blocking) {
         write_sem_.reset(new (write_sem_) core::Semaphore());
     }
 }
 
+ConcurrentQueue::ConcurrentQueue(Mode mode, core::IArena& arena, size_t capacity)
+    : reader_sleeping_(0) {
+    if (capacity == 0) {
+        roc_panic("concurrent queue: capacity should be non-zero");
+    }
+
+    if (mode == Blocking) {
+        write_sem_.reset(new (write_sem_) core::Semaphore());
+    }
+
+    ring_.reset(new (ring_) core::SpscRingBuffer<PacketPtr>(arena, capacity));
+}
+
+bool ConcurrentQueue::is_valid() const {
+    return !ring_ || ring_->is_valid();
+}
+
 status::StatusCode ConcurrentQueue::read(PacketPtr& ptr) {
+    if (ring_) {
+        size_t n_packets = 0;
+        return spsc_read_(&ptr, 1, n_packets);
+    }
+
     core::Mutex::Lock lock(read_mutex_);
 
     if (write_sem_) {
@@ -34,11 +57,45 @@ status::StatusCode ConcurrentQueue::read(PacketPtr& ptr) {
     return status::StatusOK;
 }
 
+status::StatusCode
+ConcurrentQueue::read_batch(PacketPtr* packets, size_t max_packets, size_t& n_packets) {
+    if (ring_) {
+        return spsc_read_(packets, max_packets, n_packets);
+    }
+
+    core::Mutex::Lock lock(read_mutex_);
+
+    n_packets = 0;
+
+    while (n_packets < max_packets) {
+        if (write_sem_) {
+            if (n_packets == 0) {
+                write_sem_->wait();
+            } else if (!write_sem_->try_wait()) {
+                break;
+            }
+        }
+
+        packets[n_packets] = queue_.pop_front_exclusive();
+        if (!packets[n_packets]) {
+            break;
+        }
+
+        n_packets++;
+    }
+
+    return n_packets != 0 ? status::StatusOK : status::StatusNoData;
+}
+
 status::StatusCode ConcurrentQueue::write(const PacketPtr& packet) {
     if (!packet) {
         roc_panic("concurrent queue: packet is null");
     }
 
+    if (ring_) {
+        return spsc_write_(&packet, 1);
+    }
+
     queue_.push_back(*packet);
 
     if (write_sem_) {
@@ -48,5 +105,80 @@ status::StatusCode ConcurrentQueue::write(const PacketPtr& packet) {
     return status::StatusOK;
 }
 
+status::StatusCode ConcurrentQueue::write_batch(const PacketPtr* packets,
+                                                size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("concurrent queue: packet is null");
+        }
+    }
+
+    if (ring_) {
+        return spsc_write_(packets, n_packets);
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        queue_.push_back(*packets[n]);
+
+        if (write_sem_) {
+            write_sem_->post();
+        }
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode
+ConcurrentQueue::spsc_read_(PacketPtr* packets, size_t max_packets, size_t& n_packets) {
+    n_packets = 0;
+
+    for (;;) {
+        while (n_packets < max_packets && ring_->pop_front(packets[n_packets])) {
+            n_packets++;
+        }
+
+        if (n_packets != 0 || max_packets == 0 || !write_sem_) {
+            break;
+        }
+
+        // Tell writer that we're going to sleep, and then check buffer again.
+        // Both the flag and the buffer are sequentially consistent, so either
+        // we see the packet here, or writer sees the flag and posts semaphore.
+        reader_sleeping_ = 1;
+
+        if (!ring_->is_empty()) {
+            reader_sleeping_ = 0;
+            continue;
+        }
+
+        write_sem_->wait();
+
+        // Wakeup may be spurious, if writer posted semaphore after we saw
+        // a packet during previous read; in this case we just sleep again.
+        reader_sleeping_ = 0;
+    }
+
+    return n_packets != 0 ? status::StatusOK : status::StatusNoData;
+}
+
+status::StatusCode ConcurrentQueue::spsc_write_(const PacketPtr* packets,
+                                                size_t n_packets) {
+    status::StatusCode code = status::StatusOK;
+
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!ring_->push_back(packets[n])) {
+            code = status::StatusNoSpace;
+            break;
+        }
+    }
+
+    // Wake up reader once per batch, and only if it's sleeping.
+    if (write_sem_ && reader_sleeping_.exchange(0)) {
+        write_sem_->post();
+    }
+
+    return code;
+}
+
 } // namespace packet
 } // namespace roc
@@ -12,11 +12,15 @@
 #ifndef ROC_PACKET_CONCURRENT_QUEUE_H_
 #define ROC_PACKET_CONCURRENT_QUEUE_H_
 
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/stddefs.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
@@ -25,6 +29,17 @@ namespace roc {
 namespace packet {
 
 //! Concurrent blocking packet queue.
+//!
+//! By default, queue is unbounded and allows any number of concurrent writers
+//! and readers. Writes are wait-free, reads are serialized using a mutex,
+//! and in blocking mode every packet is also counted by a semaphore.
+//!
+//! Alternatively, queue can be constructed in single-producer single-consumer
+//! mode, when it's known that there is only one writer thread and one reader
+//! thread, e.g. network thread and pipeline thread. In this mode queue is
+//! bounded and backed by a lock-free ring buffer, reads don't use mutex,
+//! and in blocking mode writer touches semaphore only if reader is actually
+//! sleeping on it.
 class ConcurrentQueue : public IReader, public IWriter, public core::NonCopyable<> {
 public:
     //! Queue mode.
@@ -33,24 +48,59 @@ public:
         NonBlocking //!< Read operation returns null if queue is empty.
     };
 
-    //! Initialize.
+    //! Initialize multiple-producer multiple-consumer queue.
     //! @p mode defines whether reads will be blocking.
     explicit ConcurrentQueue(Mode mode);
 
+    //! Initialize single-producer single-consumer queue.
+    //! @p mode defines whether reads will be blocking.
+    //! @p capacity defines maximum number of packets in queue.
+    //! @remarks
+    //!  Writes should be done from one thread, and reads should be done
+    //!  from one (probably other) thread.
+    ConcurrentQueue(Mode mode, core::IArena& arena, size_t capacity);
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
     //! Read next packet.
     //! If reads are not concurrent, and queue is non-blocking, then
     //! reads are wait-free. Otherwise they may block.
     //! @see Mode.
     virtual ROC_ATTR_NODISCARD status::StatusCode read(PacketPtr&);
 
+    //! Read multiple packets.
+    //! Same as read(), but acquires lock only once. If queue is blocking,
+    //! blocks only until the first packet is available.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    read_batch(PacketPtr* packets, size_t max_packets, size_t& n_packets);
+
     //! Add packet to the queue.
     //! Wait-free operation.
+    //! In single-producer single-consumer mode, returns status::StatusNoSpace
+    //! if queue is full.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
 
+    //! Add multiple packets to the queue.
+    //! Wait-free operation.
+    //! In single-producer single-consumer mode, returns status::StatusNoSpace
+    //! if queue is full; packets that didn't fit are not added.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                              size_t n_packets);
+
 private:
+    status::StatusCode
+    spsc_read_(PacketPtr* packets, size_t max_packets, size_t& n_packets);
+    status::StatusCode spsc_write_(const PacketPtr* packets, size_t n_packets);
+
     core::Optional<core::Semaphore> write_sem_;
     core::Mutex read_mutex_;
     core::MpscQueue<Packet> queue_;
+
+    // Used instead of queue_ and read_mutex_ in single-producer
+    // single-consumer mode.
+    core::Optional<core::SpscRingBuffer<PacketPtr> > ring_;
+    core::Atomic<int> reader_sleeping_;
 };
 
 } // namespace packet
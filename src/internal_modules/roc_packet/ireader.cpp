@@ -14,5 +14,20 @@ namespace packet {
 IReader::~IReader() {
 }
 
+status::StatusCode
+IReader::read_batch(PacketPtr* packets, size_t max_packets, size_t& n_packets) {
+    n_packets = 0;
+
+    while (n_packets < max_packets) {
+        const status::StatusCode code = read(packets[n_packets]);
+        if (code != status::StatusOK) {
+            return n_packets != 0 ? status::StatusOK : code;
+        }
+        n_packets++;
+    }
+
+    return status::StatusOK;
+}
+
 } // namespace packet
 } // namespace roc
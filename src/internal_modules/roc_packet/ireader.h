@@ -13,6 +13,7 @@
 #define ROC_PACKET_IREADER_H_
 
 #include "roc_core/attributes.h"
+#include "roc_core/stddefs.h"
 #include "roc_packet/packet.h"
 #include "roc_status/status_code.h"
 
@@ -32,6 +33,23 @@ public:
     //!
     //! @see status::StatusCode.
     virtual ROC_ATTR_NODISCARD status::StatusCode read(PacketPtr& packet) = 0;
+
+    //! Read multiple packets.
+    //!
+    //! Reads up to @p max_packets packets into @p packets and sets @p n_packets
+    //! to the number of packets read. Stops at first packet that can't be read.
+    //!
+    //! @returns
+    //!  - If at least one packet was read, returns status::StatusOK;
+    //!  - Otherwise, returns code of the failed read and sets @p n_packets to zero.
+    //!
+    //! @remarks
+    //!  Default implementation calls read() for every packet. Readers that can
+    //!  read multiple packets cheaper, e.g. under one lock, override it.
+    //!
+    //! @see status::StatusCode.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    read_batch(PacketPtr* packets, size_t max_packets, size_t& n_packets);
 };
 
 } // namespace packet
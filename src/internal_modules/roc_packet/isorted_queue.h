@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/isorted_queue.h
+//! @brief Sorted packet queue interface.
+
+#ifndef ROC_PACKET_ISORTED_QUEUE_H_
+#define ROC_PACKET_ISORTED_QUEUE_H_
+
+#include "roc_packet/ireader.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Sorted packet queue interface.
+//! @remarks
+//!  Packets written to queue are read in sorted order. Duplicate packets
+//!  are dropped.
+class ISortedQueue : public IWriter, public IReader {
+public:
+    virtual ~ISortedQueue();
+
+    //! Get number of packets in queue.
+    virtual size_t size() const = 0;
+
+    //! Get first packet in the queue.
+    //! @returns
+    //!  the first packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Returned packet is not removed from the queue.
+    virtual PacketPtr head() const = 0;
+
+    //! Get last packet in the queue.
+    //! @returns
+    //!  the last packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Returned packet is not removed from the queue.
+    virtual PacketPtr tail() const = 0;
+
+    //! Get the latest packet that were ever added to the queue.
+    //! @remarks
+    //!  Returns null if the queue never had any packets. Otherwise, returns
+    //!  the latest (by sorting order) ever added packet, even if that packet is not
+    //!  currently in the queue. Returned packet is not removed from the queue if
+    //!  it's still there.
+    virtual PacketPtr latest() const = 0;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_ISORTED_QUEUE_H_
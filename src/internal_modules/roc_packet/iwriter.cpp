@@ -14,5 +14,16 @@ namespace packet {
 IWriter::~IWriter() {
 }
 
+status::StatusCode IWriter::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        const status::StatusCode code = write(packets[n]);
+        if (code != status::StatusOK) {
+            return code;
+        }
+    }
+
+    return status::StatusOK;
+}
+
 } // namespace packet
 } // namespace roc
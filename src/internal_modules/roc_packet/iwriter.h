@@ -13,6 +13,7 @@
 #define ROC_PACKET_IWRITER_H_
 
 #include "roc_core/attributes.h"
+#include "roc_core/stddefs.h"
 #include "roc_packet/packet.h"
 #include "roc_status/status_code.h"
 
@@ -32,6 +33,24 @@ public:
     //!
     //! @see status::StatusCode.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr&) = 0;
+
+    //! Write multiple packets.
+    //!
+    //! Writes @p n_packets packets from @p packets, in order.
+    //!
+    //! @returns
+    //!  - If a returned code is not status::StatusOK, packets starting from the
+    //!    failed one are not written;
+    //!  - If all packets are written, a returned code is always status::StatusOK.
+    //!
+    //! @remarks
+    //!  Default implementation calls write() for every packet. Writers that can
+    //!  write multiple packets cheaper, e.g. under one lock or with one wakeup,
+    //!  override it.
+    //!
+    //! @see status::StatusCode.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                              size_t n_packets);
 };
 
 } // namespace packet
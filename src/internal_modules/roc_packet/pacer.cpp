@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/pacer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+bool has_stream_timestamp(const Packet& packet) {
+    return packet.has_flags(Packet::FlagAudio) && packet.rtp();
+}
+
+} // namespace
+
+Pacer::Pacer(IWriter& writer,
+             const PacerConfig& config,
+             const audio::SampleSpec& sample_spec,
+             core::IArena& arena)
+    : writer_(writer)
+    , config_(config)
+    , sample_spec_(sample_spec)
+    , has_base_(false)
+    , base_ts_(0)
+    , base_sts_(0)
+    , last_ts_(0)
+    , last_duration_(0)
+    , burst_size_(0)
+    , delay_stats_(arena, config.delay_window)
+    , burst_stats_(arena, config.burst_window)
+    , valid_(false) {
+    if (config_.max_delay <= 0) {
+        roc_log(LogError, "pacer: invalid config: max_delay=%.3fms",
+                (double)config_.max_delay / core::Millisecond);
+        return;
+    }
+
+    if (!delay_stats_.is_valid() || !burst_stats_.is_valid()) {
+        return;
+    }
+
+    roc_log(LogDebug, "pacer: initializing: max_delay=%.3fms",
+            (double)config_.max_delay / core::Millisecond);
+
+    valid_ = true;
+}
+
+bool Pacer::is_valid() const {
+    return valid_;
+}
+
+PacerMetrics Pacer::metrics() const {
+    roc_panic_if(!is_valid());
+
+    PacerMetrics metrics;
+    metrics.mean_delay = (core::nanoseconds_t)delay_stats_.mov_avg();
+    metrics.max_delay = (core::nanoseconds_t)delay_stats_.mov_max();
+    metrics.mean_burst = burst_stats_.mov_avg();
+    metrics.max_burst = (size_t)burst_stats_.mov_max();
+
+    return metrics;
+}
+
+status::StatusCode Pacer::write(const PacketPtr& packet) {
+    roc_panic_if(!is_valid());
+
+    if (!packet) {
+        roc_panic("pacer: unexpected null packet");
+    }
+
+    schedule_(&packet, 1, core::timestamp(core::ClockMonotonic));
+
+    return writer_.write(packet);
+}
+
+status::StatusCode Pacer::write_batch(const PacketPtr* packets, size_t n_packets) {
+    roc_panic_if(!is_valid());
+
+    if (n_packets == 0) {
+        return status::StatusOK;
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("pacer: unexpected null packet");
+        }
+    }
+
+    schedule_(packets, n_packets, core::timestamp(core::ClockMonotonic));
+
+    return writer_.write_batch(packets, n_packets);
+}
+
+void Pacer::schedule_(const PacketPtr* packets,
+                      size_t n_packets,
+                      core::nanoseconds_t now) {
+    size_t pos = 0;
+
+    while (pos < n_packets) {
+        if (has_stream_timestamp(*packets[pos])) {
+            stamp_(*packets[pos], schedule_audio_(*packets[pos], now), now);
+            pos++;
+            continue;
+        }
+
+        // Spread run of packets without stream timestamp evenly across
+        // one packet duration after preceding packet.
+        size_t run_len = 1;
+        while (pos + run_len < n_packets
+               && !has_stream_timestamp(*packets[pos + run_len])) {
+            run_len++;
+        }
+
+        const core::nanoseconds_t run_start = std::max(last_ts_, now);
+
+        for (size_t n = 0; n < run_len; n++) {
+            const core::nanoseconds_t offset = last_duration_
+                * (core::nanoseconds_t)(n + 1) / (core::nanoseconds_t)(run_len + 1);
+
+            stamp_(*packets[pos + n], run_start + offset, now);
+        }
+
+        pos += run_len;
+    }
+}
+
+core::nanoseconds_t Pacer::schedule_audio_(const Packet& packet,
+                                          core::nanoseconds_t now) {
+    const stream_timestamp_t sts = packet.stream_timestamp();
+
+    last_duration_ = sample_spec_.stream_timestamp_2_ns(packet.duration());
+
+    if (has_base_) {
+        const core::nanoseconds_t send_ts = base_ts_
+            + sample_spec_.stream_timestamp_delta_2_ns(
+                stream_timestamp_diff(sts, base_sts_));
+
+        // Packet is late, and it's not because it was reordered with packets
+        // still scheduled before it (e.g. by interleaver).
+        const bool is_behind = send_ts < now && last_ts_ <= now;
+        // Packet is too early.
+        const bool is_ahead = send_ts > now + config_.max_delay;
+
+        if (!is_behind && !is_ahead) {
+            return send_ts;
+        }
+
+        roc_log(LogTrace, "pacer: resetting time base: sts=%lu offset=%.3fms",
+                (unsigned long)sts, (double)(send_ts - now) / core::Millisecond);
+    }
+
+    // Packet is sent immediately, and following packets are scheduled
+    // relative to it.
+    has_base_ = true;
+    base_ts_ = now;
+    base_sts_ = sts;
+
+    return now;
+}
+
+void Pacer::stamp_(Packet& packet, core::nanoseconds_t send_ts, core::nanoseconds_t now) {
+    // Packets are sent in the same order as written.
+    send_ts = std::max(send_ts, std::max(last_ts_, now));
+
+    // If packet is written soon after previous one was scheduled, it belongs
+    // to the same burst; otherwise, previous burst is complete.
+    if (burst_size_ != 0 && now >= last_ts_ + last_duration_ / 2) {
+        burst_stats_.add((float)burst_size_);
+        burst_size_ = 0;
+    }
+
+    burst_size_++;
+
+    delay_stats_.add((double)(send_ts - now));
+
+    last_ts_ = send_ts;
+
+    if (!packet.has_flags(Packet::FlagUDP)) {
+        packet.add_flags(Packet::FlagUDP);
+    }
+    packet.udp()->send_timestamp = send_ts;
+}
+
+} // namespace packet
+} // namespace roc
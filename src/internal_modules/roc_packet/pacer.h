@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/pacer.h
+//! @brief Schedules outbound packets evenly in time.
+
+#ifndef ROC_PACKET_PACER_H_
+#define ROC_PACKET_PACER_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mov_stats.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Pacer parameters.
+struct PacerConfig {
+    //! Maximum delay that pacer may add to a packet.
+    //! @remarks
+    //!  If packets are written to pacer ahead of their stream time by more
+    //!  than this, pacer resets its time base. Should be larger than frame
+    //!  length used by sender. Receiver latency should be large enough to
+    //!  cover this delay.
+    core::nanoseconds_t max_delay;
+
+    //! Number of packets used to compute delay metrics.
+    size_t delay_window;
+
+    //! Number of bursts used to compute burst metrics.
+    size_t burst_window;
+
+    PacerConfig()
+        : max_delay(100 * core::Millisecond)
+        , delay_window(200)
+        , burst_window(50) {
+    }
+};
+
+//! Pacer metrics.
+struct PacerMetrics {
+    //! Average delay added to packets by pacer.
+    core::nanoseconds_t mean_delay;
+
+    //! Maximum delay added to packets by pacer.
+    core::nanoseconds_t max_delay;
+
+    //! Average number of packets in burst.
+    float mean_burst;
+
+    //! Maximum number of packets in burst.
+    size_t max_burst;
+
+    PacerMetrics()
+        : mean_delay(0)
+        , max_delay(0)
+        , mean_burst(0)
+        , max_burst(0) {
+    }
+};
+
+//! Schedules outbound packets evenly in time.
+//!
+//! Pipeline produces packets in bursts: all packets of a frame, followed by
+//! repair packets of a completed FEC block, are written at once. Pacer doesn't
+//! delay packets itself, but assigns every packet a send timestamp, at which
+//! network thread should send it (see UDP::send_timestamp).
+//!
+//! Audio packets are scheduled according to their stream timestamps, relative
+//! to time base established by first packet. Packets without stream timestamp
+//! (e.g. repair packets) are spread evenly across one packet duration after
+//! the preceding audio packet. Send timestamps never decrease.
+//!
+//! Time base is reset when a packet is written after its scheduled time (i.e.
+//! sender is behind), or more than max_delay before it (i.e. sender is ahead).
+//! This compensates clock drift between sender and system clock.
+//!
+//! Burst is a group of packets written to pacer while previous packets of
+//! the same group are still scheduled for future. Burst size is the number
+//! of packets that would be sent back-to-back without pacing.
+class Pacer : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Writes packets to @p writer after assigning send timestamps.
+    //!  @p sample_spec defines units of stream timestamps.
+    Pacer(IWriter& writer,
+          const PacerConfig& config,
+          const audio::SampleSpec& sample_spec,
+          core::IArena& arena);
+
+    //! Check if object is successfully constructed.
+    bool is_valid() const;
+
+    //! Get metrics.
+    PacerMetrics metrics() const;
+
+    //! Write packet.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+    //! Write multiple packets.
+    //! @remarks
+    //!  Consecutive packets without stream timestamp are spread evenly.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                              size_t n_packets);
+
+private:
+    void schedule_(const PacketPtr* packets, size_t n_packets, core::nanoseconds_t now);
+    core::nanoseconds_t schedule_audio_(const Packet& packet, core::nanoseconds_t now);
+    void stamp_(Packet& packet, core::nanoseconds_t send_ts, core::nanoseconds_t now);
+
+    IWriter& writer_;
+
+    const PacerConfig config_;
+    const audio::SampleSpec sample_spec_;
+
+    // Time base: moment when packet with base_sts_ should be sent.
+    bool has_base_;
+    core::nanoseconds_t base_ts_;
+    stream_timestamp_t base_sts_;
+
+    // Send timestamp and duration of last scheduled packet.
+    core::nanoseconds_t last_ts_;
+    core::nanoseconds_t last_duration_;
+
+    size_t burst_size_;
+
+    core::MovStats<double> delay_stats_;
+    core::MovStats<float> burst_stats_;
+
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_PACER_H_
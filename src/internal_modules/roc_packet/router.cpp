@@ -53,19 +53,56 @@ status::StatusCode Router::write(const PacketPtr& packet) {
         roc_panic("router: unexpected null packet");
     }
 
-    if (Route* route = find_route_(packet->flags())) {
-        if (allow_route_(*route, *packet)) {
-            if (packet->udp()) {
-                packet->udp()->queue_timestamp = core::timestamp(core::ClockUnix);
+    if (Route* route = route_packet_(*packet)) {
+        if (packet->udp()) {
+            packet->udp()->queue_timestamp = core::timestamp(core::ClockUnix);
+        }
+
+        return route->writer->write(packet);
+    }
+
+    // TODO(gh-183): return status
+    return status::StatusOK;
+}
+
+status::StatusCode Router::write_batch(const PacketPtr* packets, size_t n_packets) {
+    const core::nanoseconds_t queue_timestamp = core::timestamp(core::ClockUnix);
+
+    size_t run_begin = 0;
+    Route* run_route = NULL;
+
+    for (size_t n = 0; n <= n_packets; n++) {
+        Route* route = NULL;
+
+        if (n < n_packets) {
+            if (!packets[n]) {
+                roc_panic("router: unexpected null packet");
+            }
+
+            route = route_packet_(*packets[n]);
+
+            if (route && packets[n]->udp()) {
+                packets[n]->udp()->queue_timestamp = queue_timestamp;
             }
 
-            return route->writer->write(packet);
+            if (route == run_route) {
+                continue;
+            }
+        }
+
+        // Route changed or batch ended, flush accumulated run.
+        if (run_route) {
+            const status::StatusCode code =
+                run_route->writer->write_batch(packets + run_begin, n - run_begin);
+            if (code != status::StatusOK) {
+                return code;
+            }
         }
+
+        run_begin = n;
+        run_route = route;
     }
 
-    roc_log(LogDebug, "router: can't route packet, dropping: source=%lu flags=%s",
-            (unsigned long)packet->source_id(),
-            packet_flags_to_str(packet->flags()).c_str());
     // TODO(gh-183): return status
     return status::StatusOK;
 }
@@ -82,6 +119,20 @@ Router::Route* Router::find_route_(unsigned flags) {
     return NULL;
 }
 
+Router::Route* Router::route_packet_(const Packet& packet) {
+    if (Route* route = find_route_(packet.flags())) {
+        if (allow_route_(*route, packet)) {
+            return route;
+        }
+    }
+
+    roc_log(LogDebug, "router: can't route packet, dropping: source=%lu flags=%s",
+            (unsigned long)packet.source_id(),
+            packet_flags_to_str(packet.flags()).c_str());
+
+    return NULL;
+}
+
 bool Router::allow_route_(Route& route, const Packet& packet) {
     if (packet.has_source_id()) {
         if (route.has_source) {
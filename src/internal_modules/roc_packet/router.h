@@ -62,6 +62,13 @@ public:
     //!  Route @p packet to a writer or drop it if no routes found.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
 
+    //! Write batch of packets.
+    //! @remarks
+    //!  Consecutive packets routed to the same writer are passed to it
+    //!  by one write_batch() call. Packets without route are dropped.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                              size_t n_packets);
+
 private:
     struct Route {
         IWriter* writer;
@@ -80,6 +87,7 @@ private:
     };
 
     Route* find_route_(unsigned flags);
+    Route* route_packet_(const Packet& packet);
     bool allow_route_(Route& route, const Packet& packet);
 
     core::Array<Route, 2> routes_;
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/seqnum_queue.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+// Initial number of slots in ring.
+const size_t MinSlots = 64;
+
+// Maximum distance between first and last packet. Packets farther than half
+// of seqnum range can't be ordered unambiguously.
+const size_t MaxSlots = 1 << 15;
+
+} // namespace
+
+SeqnumQueue::SeqnumQueue(size_t max_size, core::IArena& arena)
+    : slots_(arena)
+    , head_sn_(0)
+    , tail_sn_(0)
+    , n_packets_(0)
+    , max_size_(max_size)
+    , valid_(false) {
+    if (!slots_.resize(MinSlots)) {
+        roc_log(LogError, "seqnum queue: can't allocate ring: size=%lu",
+                (unsigned long)MinSlots);
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool SeqnumQueue::is_valid() const {
+    return valid_;
+}
+
+status::StatusCode SeqnumQueue::read(PacketPtr& packet) {
+    roc_panic_if(!valid_);
+
+    if (n_packets_ == 0) {
+        return status::StatusNoData;
+    }
+
+    PacketPtr& slot = slots_[slot_index_(head_sn_)];
+
+    packet = slot;
+    slot = NULL;
+
+    if (--n_packets_ != 0) {
+        // Skip gaps until next packet. Each slot is skipped at most once per
+        // pass of the window, so the cost is amortized constant.
+        do {
+            head_sn_++;
+        } while (!slots_[slot_index_(head_sn_)]);
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode SeqnumQueue::write(const PacketPtr& packet) {
+    roc_panic_if(!valid_);
+
+    if (!packet) {
+        roc_panic("seqnum queue: attempting to add null packet");
+    }
+
+    if (!packet->rtp()) {
+        roc_panic("seqnum queue: attempting to add packet w/o rtp header");
+    }
+
+    if (max_size_ > 0 && n_packets_ == max_size_) {
+        roc_log(LogDebug,
+                "seqnum queue: queue is full, dropping packet:"
+                " max_size=%u",
+                (unsigned)max_size_);
+        return status::StatusOK;
+    }
+
+    if (!latest_ || latest_->compare(*packet) <= 0) {
+        latest_ = packet;
+    }
+
+    const seqnum_t sn = packet->rtp()->seqnum;
+
+    if (n_packets_ == 0) {
+        head_sn_ = tail_sn_ = sn;
+        slots_[slot_index_(sn)] = packet;
+        n_packets_++;
+        return status::StatusOK;
+    }
+
+    seqnum_t new_head_sn = head_sn_;
+    seqnum_t new_tail_sn = tail_sn_;
+
+    if (seqnum_lt(sn, head_sn_)) {
+        new_head_sn = sn;
+    } else if (seqnum_lt(tail_sn_, sn)) {
+        new_tail_sn = sn;
+    }
+
+    const size_t span = size_t(seqnum_t(new_tail_sn - new_head_sn)) + 1;
+
+    if (span > MaxSlots) {
+        roc_log(LogDebug,
+                "seqnum queue: dropping packet too far from queue:"
+                " sn=%lu head=%lu tail=%lu",
+                (unsigned long)sn, (unsigned long)head_sn_, (unsigned long)tail_sn_);
+        return status::StatusOK;
+    }
+
+    if (span > slots_.size()) {
+        if (!grow_(span)) {
+            roc_log(LogError, "seqnum queue: can't grow ring: cur_size=%lu new_size=%lu",
+                    (unsigned long)slots_.size(), (unsigned long)span);
+            return status::StatusNoMem;
+        }
+    }
+
+    PacketPtr& slot = slots_[slot_index_(sn)];
+
+    if (slot) {
+        roc_log(LogDebug, "seqnum queue: dropping duplicate packet");
+        return status::StatusOK;
+    }
+
+    slot = packet;
+
+    head_sn_ = new_head_sn;
+    tail_sn_ = new_tail_sn;
+    n_packets_++;
+
+    return status::StatusOK;
+}
+
+size_t SeqnumQueue::size() const {
+    return n_packets_;
+}
+
+PacketPtr SeqnumQueue::head() const {
+    if (n_packets_ == 0) {
+        return NULL;
+    }
+    return slots_[slot_index_(head_sn_)];
+}
+
+PacketPtr SeqnumQueue::tail() const {
+    if (n_packets_ == 0) {
+        return NULL;
+    }
+    return slots_[slot_index_(tail_sn_)];
+}
+
+PacketPtr SeqnumQueue::latest() const {
+    return latest_;
+}
+
+size_t SeqnumQueue::slot_index_(seqnum_t sn) const {
+    return sn & (slots_.size() - 1);
+}
+
+bool SeqnumQueue::grow_(size_t min_size) {
+    const size_t old_size = slots_.size();
+
+    size_t new_size = old_size;
+    while (new_size < min_size) {
+        new_size *= 2;
+    }
+
+    roc_log(LogDebug, "seqnum queue: growing ring: cur_size=%lu new_size=%lu",
+            (unsigned long)old_size, (unsigned long)new_size);
+
+    if (!slots_.resize(new_size)) {
+        return false;
+    }
+
+    // Move packets to their slots in larger ring. New slot of every packet
+    // is either the same as old one, or is in the newly added part of ring,
+    // so packets never overwrite each other.
+    const size_t old_mask = old_size - 1;
+
+    for (seqnum_t sn = head_sn_;; sn++) {
+        const size_t old_index = sn & old_mask;
+        const size_t new_index = slot_index_(sn);
+
+        if (old_index != new_index && slots_[old_index]) {
+            slots_[new_index] = slots_[old_index];
+            slots_[old_index] = NULL;
+        }
+
+        if (sn == tail_sn_) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/seqnum_queue.h
+//! @brief Packet queue indexed by sequence number.
+
+#ifndef ROC_PACKET_SEQNUM_QUEUE_H_
+#define ROC_PACKET_SEQNUM_QUEUE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/isorted_queue.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Packet queue indexed by sequence number.
+//! @remarks
+//!  Drop-in replacement for SortedQueue for RTP packets. Packets are stored
+//!  in a ring with power-of-two number of slots, where each packet occupies
+//!  the slot determined by its RTP sequence number. This gives constant-time
+//!  insertion, duplicate detection, and removal of the first packet, regardless
+//!  of queue depth and reordering.
+//! @remarks
+//!  The ring grows automatically when distance between the first and the last
+//!  packet exceeds its size. Packets that are too far from the rest of the
+//!  queue to be unambiguously ordered are dropped.
+class SeqnumQueue : public ISortedQueue, public core::NonCopyable<> {
+public:
+    //! Construct empty queue.
+    //! @remarks
+    //!  If @p max_size is non-zero, it specifies maximum number of packets in queue.
+    SeqnumQueue(size_t max_size, core::IArena& arena);
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Add packet to the queue.
+    //! @remarks
+    //!  - if the maximum queue size is reached, packet is dropped
+    //!  - if packet has the same seqnum as another packet in the queue, it is dropped
+    //!  - otherwise, packet is inserted into the queue, keeping the queue sorted
+    //! @pre
+    //!  Packet should have RTP header.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+    //! Read next packet.
+    //! @remarks
+    //!  Removes returned packet from the queue.
+    virtual ROC_ATTR_NODISCARD status::StatusCode read(PacketPtr& packet);
+
+    //! Get number of packets in queue.
+    virtual size_t size() const;
+
+    //! Get first packet in the queue.
+    virtual PacketPtr head() const;
+
+    //! Get last packet in the queue.
+    virtual PacketPtr tail() const;
+
+    //! Get the latest packet that were ever added to the queue.
+    virtual PacketPtr latest() const;
+
+private:
+    size_t slot_index_(seqnum_t sn) const;
+    bool grow_(size_t min_size);
+
+    core::Array<PacketPtr> slots_;
+
+    seqnum_t head_sn_;
+    seqnum_t tail_sn_;
+    size_t n_packets_;
+
+    PacketPtr latest_;
+
+    const size_t max_size_;
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_SEQNUM_QUEUE_H_
@@ -26,28 +26,40 @@ const address::SocketAddr& Shipper::outbound_address() const {
 }
 
 status::StatusCode Shipper::write(const PacketPtr& packet) {
+    prepare_(*packet);
+
+    return outbound_writer_.write(packet);
+}
+
+status::StatusCode Shipper::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        prepare_(*packets[n]);
+    }
+
+    return outbound_writer_.write_batch(packets, n_packets);
+}
+
+void Shipper::prepare_(Packet& packet) {
     if (outbound_address_) {
-        if (!packet->has_flags(Packet::FlagUDP)) {
-            packet->add_flags(Packet::FlagUDP);
+        if (!packet.has_flags(Packet::FlagUDP)) {
+            packet.add_flags(Packet::FlagUDP);
         }
-        if (!packet->udp()->dst_addr) {
-            packet->udp()->dst_addr = outbound_address_;
+        if (!packet.udp()->dst_addr) {
+            packet.udp()->dst_addr = outbound_address_;
         }
     }
 
-    if (!packet->has_flags(Packet::FlagPrepared)) {
+    if (!packet.has_flags(Packet::FlagPrepared)) {
         roc_panic("shipper: unexpected packet: should be prepared");
     }
 
-    if (!packet->has_flags(Packet::FlagComposed)) {
-        if (!composer_.compose(*packet)) {
+    if (!packet.has_flags(Packet::FlagComposed)) {
+        if (!composer_.compose(packet)) {
             // TODO(gh-183): return status from composer
             roc_panic("shipper: can't compose packet");
         }
-        packet->add_flags(Packet::FlagComposed);
+        packet.add_flags(Packet::FlagComposed);
     }
-
-    return outbound_writer_.write(packet);
 }
 
 } // namespace packet
@@ -37,7 +37,16 @@ public:
     //! Write outgoing packet.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
 
+    //! Write batch of outgoing packets.
+    //! @remarks
+    //!  All packets are prepared and then passed to outbound writer
+    //!  by one write_batch() call.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                              size_t n_packets);
+
 private:
+    void prepare_(Packet& packet);
+
     IComposer& composer_;
     IWriter& outbound_writer_;
     address::SocketAddr outbound_address_;
@@ -14,8 +14,7 @@
 
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
-#include "roc_packet/ireader.h"
-#include "roc_packet/iwriter.h"
+#include "roc_packet/isorted_queue.h"
 #include "roc_packet/packet.h"
 
 namespace roc {
@@ -24,7 +23,9 @@ namespace packet {
 //! Sorted packet queue.
 //! @remarks
 //!  Packets order is determined by Packet::compare() method.
-class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
+//!  Packets are kept in a list, so insertion time is linear in the number
+//!  of packets that are newer than inserted one.
+class SortedQueue : public ISortedQueue, public core::NonCopyable<> {
 public:
     //! Construct empty queue.
     //! @remarks
@@ -45,21 +46,21 @@ public:
     virtual ROC_ATTR_NODISCARD status::StatusCode read(PacketPtr& packet);
 
     //! Get number of packets in queue.
-    size_t size() const;
+    virtual size_t size() const;
 
     //! Get first packet in the queue.
     //! @returns
     //!  the first packet in the queue or null if there are no packets
     //! @remarks
     //!  Returned packet is not removed from the queue.
-    PacketPtr head() const;
+    virtual PacketPtr head() const;
 
     //! Get last packet in the queue.
     //! @returns
     //!  the last packet in the queue or null if there are no packets
     //! @remarks
     //!  Returned packet is not removed from the queue.
-    PacketPtr tail() const;
+    virtual PacketPtr tail() const;
 
     //! Get the latest packet that were ever added to the queue.
     //! @remarks
@@ -67,7 +68,7 @@ public:
     //!  the latest (by sorting order) ever added packet, even if that packet is not
     //!  currently in the queue. Returned packet is not removed from the queue if
     //!  it's still there.
-    PacketPtr latest() const;
+    virtual PacketPtr latest() const;
 
 private:
     core::List<Packet> list_;
@@ -46,6 +46,13 @@ struct UDP {
     //!  allows us to account additional jitter introduced by thread-switch time.
     core::nanoseconds_t queue_timestamp;
 
+    //! Packet send timestamp (STS), nanoseconds of monotonic clock.
+    //! @remarks
+    //!  It points to a moment when network thread should send the packet.
+    //!  Zero means that packet should be sent as soon as possible.
+    //!  Set by Pacer.
+    core::nanoseconds_t send_timestamp;
+
     //! Sender request state.
     //! @remarks
     //!  Used by network thread.
@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/config.h"
+#include "roc_core/thread.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
@@ -20,7 +21,9 @@ SenderSinkConfig::SenderSinkConfig()
     , enable_auto_duration(false)
     , enable_auto_cts(false)
     , enable_profiling(false)
-    , enable_interleaving(false) {
+    , enable_interleaving(false)
+    , enable_adaptive_fec(false)
+    , enable_pacing(false) {
 }
 
 void SenderSinkConfig::deduce_defaults() {
@@ -46,16 +49,21 @@ void ReceiverCommonConfig::deduce_defaults() {
 
 ReceiverSessionConfig::ReceiverSessionConfig()
     : payload_type(0)
-    , enable_beeping(false) {
+    , enable_beeping(false)
+    , enable_plc(false)
+    , enable_seqnum_queue(false) {
 }
 
 void ReceiverSessionConfig::deduce_defaults() {
     latency.deduce_defaults(DefaultLatency, true);
     watchdog.deduce_defaults(latency.target_latency);
     resampler.deduce_defaults(latency.tuner_backend, latency.tuner_profile);
+    plc.deduce_defaults();
 }
 
-ReceiverSourceConfig::ReceiverSourceConfig() {
+ReceiverSourceConfig::ReceiverSourceConfig()
+    : num_shards(0)
+    , num_session_threads(0) {
 }
 
 void ReceiverSourceConfig::deduce_defaults() {
@@ -81,5 +89,17 @@ void TranscoderConfig::deduce_defaults() {
                               audio::LatencyTunerProfile_Default);
 }
 
+ParallelTranscoderConfig::ParallelTranscoderConfig()
+    : num_threads(0)
+    , chunk_length(DefaultChunkLength)
+    , chunk_overlap(DefaultChunkOverlap) {
+}
+
+void ParallelTranscoderConfig::deduce_defaults() {
+    if (num_threads == 0) {
+        num_threads = core::Thread::get_cpu_count();
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -15,15 +15,18 @@
 #include "roc_address/protocol.h"
 #include "roc_audio/feedback_monitor.h"
 #include "roc_audio/latency_tuner.h"
+#include "roc_audio/plc_reader.h"
 #include "roc_audio/profiler.h"
 #include "roc_audio/resampler_config.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/pipeline_loop.h"
 #include "roc_rtcp/config.h"
@@ -54,6 +57,17 @@ const core::nanoseconds_t DefaultPacketLength = 5 * core::Millisecond;
 //!  networks allow lower latencies, and some networks require higher.
 const core::nanoseconds_t DefaultLatency = 200 * core::Millisecond;
 
+//! Default chunk length for parallel transcoding.
+//! @remarks
+//!  Large enough to make warm-up overhead negligible, and small enough to keep
+//!  memory usage moderate when many threads are used.
+const core::nanoseconds_t DefaultChunkLength = 10 * core::Second;
+
+//! Default chunk overlap for parallel transcoding.
+//! @remarks
+//!  Covers delay of all resampler backends with default profiles.
+const core::nanoseconds_t DefaultChunkOverlap = 100 * core::Millisecond;
+
 //! Parameters of sender sink and sender session.
 struct SenderSinkConfig {
     //! Input sample spec
@@ -74,6 +88,10 @@ struct SenderSinkConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC block tuner parameters.
+    //! Used if adaptive FEC is enabled.
+    fec::BlockTunerConfig fec_tuner;
+
     //! Latency parameters.
     audio::LatencyConfig latency;
 
@@ -89,6 +107,10 @@ struct SenderSinkConfig {
     //! RTCP config.
     rtcp::Config rtcp;
 
+    //! Pacer parameters.
+    //! Used if pacing is enabled.
+    packet::PacerConfig pacer;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool enable_timing;
 
@@ -104,6 +126,14 @@ struct SenderSinkConfig {
     //! Interleave packets.
     bool enable_interleaving;
 
+    //! Adjust FEC block size according to packet loss reported by receiver.
+    //! Requires control endpoint. Not supported for multicast.
+    bool enable_adaptive_fec;
+
+    //! Spread outbound packets evenly in time instead of sending them in
+    //! bursts, according to their stream timestamps.
+    bool enable_pacing;
+
     //! Initialize config.
     SenderSinkConfig();
 
@@ -170,9 +200,25 @@ struct ReceiverSessionConfig {
     //! Resampler parameters.
     audio::ResamplerConfig resampler;
 
+    //! Packet loss concealment parameters.
+    audio::PlcConfig plc;
+
     //! Insert weird beeps instead of silence on packet loss.
     bool enable_beeping;
 
+    //! Conceal packet losses instead of inserting silence.
+    //! @remarks
+    //!  If set, audio::PlcReader is inserted after depacketizer.
+    //!  Ignored if beeping is enabled.
+    bool enable_plc;
+
+    //! Store incoming source packets in a queue indexed by sequence number.
+    //! @remarks
+    //!  If set, packet::SeqnumQueue is used instead of packet::SortedQueue.
+    //!  It provides constant-time insertion and removal, which is beneficial
+    //!  with large latencies and heavy packet reordering.
+    bool enable_seqnum_queue;
+
     //! Initialize config.
     ReceiverSessionConfig();
 
@@ -191,6 +237,20 @@ struct ReceiverSourceConfig {
     //! Default parameters for a session.
     ReceiverSessionConfig session_defaults;
 
+    //! Number of shards to distribute slots between.
+    //! @remarks
+    //!  If greater than one, each shard gets its own mixer and worker thread,
+    //!  and slots of different shards are processed in parallel. Otherwise,
+    //!  all slots are processed on the thread that reads frames.
+    size_t num_shards;
+
+    //! Number of worker threads used by every slot to read its sessions.
+    //! @remarks
+    //!  If non-zero, frames of sessions within a slot are read in parallel
+    //!  on these threads and on the thread that reads frames, and then are
+    //!  mixed. Otherwise, sessions are read one by one.
+    size_t num_session_threads;
+
     //! Initialize config.
     ReceiverSourceConfig();
 
@@ -234,6 +294,30 @@ struct TranscoderConfig {
     void deduce_defaults();
 };
 
+//! Parallel transcoder parameters.
+struct ParallelTranscoderConfig {
+    //! Number of threads, including the calling thread.
+    //! @remarks
+    //!  If zero, number of CPUs is used.
+    size_t num_threads;
+
+    //! Duration of input chunk transcoded by one thread at once.
+    core::nanoseconds_t chunk_length;
+
+    //! Duration of input transcoded before and after every chunk.
+    //! @remarks
+    //!  Output produced from overlap is dropped. It's needed to warm up and
+    //!  drain resampler, so that chunk boundaries are not audible. Should be
+    //!  larger than resampler delay.
+    core::nanoseconds_t chunk_overlap;
+
+    //! Initialize config.
+    ParallelTranscoderConfig();
+
+    //! Fill unset values with defaults.
+    void deduce_defaults();
+};
+
 } // namespace pipeline
 } // namespace roc
 
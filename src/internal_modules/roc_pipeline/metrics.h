@@ -12,10 +12,16 @@
 #ifndef ROC_PIPELINE_METRICS_H_
 #define ROC_PIPELINE_METRICS_H_
 
+#include "roc_audio/depacketizer.h"
 #include "roc_audio/latency_tuner.h"
+#include "roc_audio/plc_reader.h"
 #include "roc_core/stddefs.h"
+#include "roc_fec/block_tuner.h"
+#include "roc_fec/reader.h"
 #include "roc_packet/ilink_meter.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/units.h"
+#include "roc_pipeline/pipeline_loop.h"
 
 namespace roc {
 namespace pipeline {
@@ -43,6 +49,19 @@ struct SenderSlotMetrics {
     //! Is slot configuration complete (all endpoints bound).
     bool is_complete;
 
+    //! Current FEC block size and loss estimate used to select it.
+    //! Block size is zero if FEC is disabled.
+    //! Loss estimate is zero if adaptive FEC is disabled.
+    fec::BlockTunerMetrics fec;
+
+    //! Pacing delay and burst statistics.
+    //! Zero if pacing is disabled.
+    packet::PacerMetrics pacer;
+
+    //! Task processing statistics of pipeline loop.
+    //! Pipeline loop is shared by all slots.
+    PipelineLoop::Stats pipeline;
+
     SenderSlotMetrics()
         : source_id(0)
         , num_participants(0)
@@ -58,7 +77,26 @@ struct ReceiverParticipantMetrics {
     //! Latency metrics.
     audio::LatencyMetrics latency;
 
-    ReceiverParticipantMetrics() {
+    //! Depacketizer metrics.
+    audio::DepacketizerMetrics depacketizer;
+
+    //! Packet loss concealment metrics.
+    //! Zero if PLC is disabled.
+    audio::PlcMetrics plc;
+
+    //! FEC reader metrics.
+    //! Zero if FEC is disabled.
+    fec::ReaderMetrics fec;
+
+    //! Number of packets in incoming source queue.
+    size_t queued_packets;
+
+    //! Scaling factor applied to resampler to compensate clock drift.
+    float scaling;
+
+    ReceiverParticipantMetrics()
+        : queued_packets(0)
+        , scaling(1.0f) {
     }
 };
 
@@ -70,9 +108,29 @@ struct ReceiverSlotMetrics {
     //! Number of participants (remote senders) connected to slot.
     size_t num_participants;
 
+    //! Depacketizer metrics.
+    //! Summed over all participants, including already disconnected ones.
+    audio::DepacketizerMetrics depacketizer;
+
+    //! Packet loss concealment metrics.
+    //! Summed over all participants, including already disconnected ones.
+    audio::PlcMetrics plc;
+
+    //! FEC reader metrics.
+    //! Summed over all participants, including already disconnected ones.
+    fec::ReaderMetrics fec;
+
+    //! Number of packets in incoming source queues of connected participants.
+    size_t queued_packets;
+
+    //! Task processing statistics of pipeline loop.
+    //! Pipeline loop is shared by all slots.
+    PipelineLoop::Stats pipeline;
+
     ReceiverSlotMetrics()
         : source_id(0)
-        , num_participants(0) {
+        , num_participants(0)
+        , queued_packets(0) {
     }
 };
 
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/parallel_transcoder.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_pipeline/transcoder_sink.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+size_t align_up(size_t size, size_t align) {
+    return (size + align - 1) / align * align;
+}
+
+} // namespace
+
+ParallelTranscoder::Job::Job(ParallelTranscoder& transcoder, core::IArena& arena)
+    : transcoder_(transcoder)
+    , output_(arena)
+    , warmup_begin_(0)
+    , chunk_begin_(0)
+    , chunk_end_(0)
+    , drain_end_(0)
+    , ok_(false) {
+}
+
+void ParallelTranscoder::Job::assign(size_t warmup_begin,
+                                     size_t chunk_begin,
+                                     size_t chunk_end,
+                                     size_t drain_end) {
+    roc_panic_if_not(warmup_begin <= chunk_begin && chunk_begin < chunk_end
+                     && chunk_end <= drain_end);
+
+    warmup_begin_ = warmup_begin;
+    chunk_begin_ = chunk_begin;
+    chunk_end_ = chunk_end;
+    drain_end_ = drain_end;
+}
+
+void ParallelTranscoder::Job::transcode() {
+    if (!output_.resize(0)) {
+        roc_panic("parallel transcoder: can't resize output buffer");
+    }
+
+    ok_ = true;
+
+    // Every chunk gets its own pipeline, so that it doesn't depend on state
+    // left by previous chunks.
+    TranscoderSink pipeline(transcoder_.config_, this, transcoder_.buffer_pool_,
+                            transcoder_.arena_);
+    if (!pipeline.is_valid()) {
+        roc_log(LogError, "parallel transcoder: can't create transcoder pipeline");
+        ok_ = false;
+        return;
+    }
+
+    const size_t n_ch = transcoder_.in_channels_;
+    audio::sample_t* samples = transcoder_.input_.data();
+
+    for (size_t pos = warmup_begin_; pos < drain_end_ && ok_;) {
+        const size_t n_samples = std::min(drain_end_ - pos, transcoder_.in_frame_size_);
+
+        audio::Frame frame(samples + pos * n_ch, n_samples * n_ch);
+        frame.set_duration((packet::stream_timestamp_t)n_samples);
+
+        pipeline.write(frame);
+
+        pos += n_samples;
+    }
+}
+
+bool ParallelTranscoder::Job::write_output(audio::IFrameWriter* writer) {
+    if (!ok_) {
+        return false;
+    }
+
+    const size_t n_ch = transcoder_.out_channels_;
+    const size_t offset = transcoder_.input_offset_;
+
+    // Drop output produced from leading and trailing overlap.
+    const size_t skip = transcoder_.output_pos_(offset + chunk_begin_)
+        - transcoder_.output_pos_(offset + warmup_begin_);
+    const size_t count = transcoder_.output_pos_(offset + chunk_end_)
+        - transcoder_.output_pos_(offset + chunk_begin_);
+
+    if (output_.size() < (skip + count) * n_ch) {
+        roc_log(LogError,
+                "parallel transcoder: pipeline produced less samples than expected,"
+                " chunk overlap may be too small: expected=%lu actual=%lu",
+                (unsigned long)(skip + count), (unsigned long)(output_.size() / n_ch));
+        return false;
+    }
+
+    if (!writer || count == 0) {
+        return true;
+    }
+
+    audio::sample_t* samples = output_.data() + skip * n_ch;
+
+    for (size_t pos = 0; pos < count;) {
+        const size_t n_samples = std::min(count - pos, transcoder_.out_frame_size_);
+
+        audio::Frame frame(samples + pos * n_ch, n_samples * n_ch);
+        frame.set_duration((packet::stream_timestamp_t)n_samples);
+
+        writer->write(frame);
+
+        pos += n_samples;
+    }
+
+    return true;
+}
+
+void ParallelTranscoder::Job::write(audio::Frame& frame) {
+    const size_t size = output_.size();
+
+    if (!output_.grow_exp(size + frame.num_raw_samples())
+        || !output_.resize(size + frame.num_raw_samples())) {
+        roc_log(LogError, "parallel transcoder: can't allocate output buffer");
+        ok_ = false;
+        return;
+    }
+
+    memcpy(output_.data() + size, frame.raw_samples(),
+           frame.num_raw_samples() * sizeof(audio::sample_t));
+}
+
+ParallelTranscoder::Worker::Worker(ParallelTranscoder& transcoder, size_t index)
+    : transcoder_(transcoder)
+    , index_(index) {
+}
+
+void ParallelTranscoder::Worker::wake_up() {
+    sem_.post();
+}
+
+void ParallelTranscoder::Worker::run() {
+    for (;;) {
+        sem_.wait();
+
+        if (transcoder_.stop_) {
+            break;
+        }
+
+        transcoder_.jobs_[index_]->transcode();
+        transcoder_.done_sem_.post();
+    }
+}
+
+ParallelTranscoder::ParallelTranscoder(const TranscoderConfig& config,
+                                       const ParallelTranscoderConfig& parallel_config,
+                                       core::nanoseconds_t frame_length,
+                                       core::IPool& buffer_pool,
+                                       core::IArena& arena)
+    : buffer_pool_(buffer_pool)
+    , arena_(arena)
+    , config_(config)
+    , in_channels_(config.input_sample_spec.num_channels())
+    , out_channels_(config.output_sample_spec.num_channels())
+    , in_frame_size_(0)
+    , out_frame_size_(0)
+    , chunk_size_(0)
+    , overlap_size_(0)
+    , input_(arena)
+    , input_offset_(0)
+    , input_end_(0)
+    , input_eof_(false)
+    , jobs_(arena)
+    , workers_(arena)
+    , stop_(false)
+    , valid_(false) {
+    config_.deduce_defaults();
+
+    // Profiling separate chunks is meaningless.
+    config_.enable_profiling = false;
+
+    ParallelTranscoderConfig par_config = parallel_config;
+    par_config.deduce_defaults();
+
+    const audio::SampleSpec& in_spec = config_.input_sample_spec;
+    const audio::SampleSpec& out_spec = config_.output_sample_spec;
+
+    in_frame_size_ = in_spec.ns_2_samples_per_chan(frame_length);
+    out_frame_size_ = out_spec.ns_2_samples_per_chan(frame_length);
+
+    if (in_frame_size_ == 0 || out_frame_size_ == 0) {
+        roc_log(LogError, "parallel transcoder: invalid frame length: %ld",
+                (long)frame_length);
+        return;
+    }
+
+    // Chunk boundaries are multiples of this number of input samples, because
+    // it's the smallest one that corresponds to integer number of output samples.
+    const size_t align =
+        in_spec.sample_rate() / gcd(in_spec.sample_rate(), out_spec.sample_rate());
+
+    chunk_size_ = align_up(
+        std::max(in_spec.ns_2_samples_per_chan(par_config.chunk_length), in_frame_size_),
+        align);
+
+    // Channel mapping is stateless, so overlap is needed only for resampling.
+    if (in_spec.sample_rate() != out_spec.sample_rate()) {
+        // Resampler may buffer up to a whole frame before producing output,
+        // so overlap should be larger regardless of configuration.
+        const size_t min_overlap =
+            audio::FrameFactory(buffer_pool).raw_buffer_size() / in_channels_ * 2;
+
+        overlap_size_ = align_up(
+            std::max(in_spec.ns_2_samples_per_chan(par_config.chunk_overlap), min_overlap),
+            align);
+    }
+
+    roc_log(LogDebug,
+            "parallel transcoder: initializing:"
+            " num_threads=%lu chunk_size=%lu overlap_size=%lu",
+            (unsigned long)par_config.num_threads, (unsigned long)chunk_size_,
+            (unsigned long)overlap_size_);
+
+    if (!jobs_.grow(par_config.num_threads)
+        || !workers_.grow(par_config.num_threads - 1)) {
+        roc_log(LogError, "parallel transcoder: can't allocate job array");
+        return;
+    }
+
+    for (size_t n = 0; n < par_config.num_threads; n++) {
+        Job* job = new (arena_) Job(*this, arena_);
+        if (!job) {
+            roc_log(LogError, "parallel transcoder: can't allocate job");
+            return;
+        }
+
+        if (!jobs_.push_back(job)) {
+            roc_panic("parallel transcoder: can't add job");
+        }
+    }
+
+    for (size_t n = 1; n < par_config.num_threads; n++) {
+        // Caller thread transcodes job 0, workers start from 1.
+        Worker* worker = new (arena_) Worker(*this, n);
+        if (!worker) {
+            roc_log(LogError, "parallel transcoder: can't allocate worker");
+            return;
+        }
+
+        if (!worker->start()) {
+            roc_log(LogError, "parallel transcoder: can't start worker thread");
+            arena_.destroy_object(*worker);
+            return;
+        }
+
+        if (!workers_.push_back(worker)) {
+            roc_panic("parallel transcoder: can't add worker");
+        }
+    }
+
+    valid_ = true;
+}
+
+ParallelTranscoder::~ParallelTranscoder() {
+    stop_workers_();
+
+    for (size_t n = 0; n < jobs_.size(); n++) {
+        arena_.destroy_object(*jobs_[n]);
+    }
+}
+
+bool ParallelTranscoder::is_valid() const {
+    return valid_;
+}
+
+bool ParallelTranscoder::run(sndio::ISource& source, audio::IFrameWriter* writer) {
+    roc_panic_if(!valid_);
+
+    if (!input_.resize(0)) {
+        roc_panic("parallel transcoder: can't resize input buffer");
+    }
+
+    input_offset_ = 0;
+    input_end_ = 0;
+    input_eof_ = false;
+
+    // Beginning of next chunk, in samples per channel from beginning of input.
+    size_t pos = 0;
+    size_t n_chunks = 0;
+
+    for (;;) {
+        // Read input for all jobs, including trailing overlap of the last one.
+        if (!fill_input_(source, pos + jobs_.size() * chunk_size_ + overlap_size_)) {
+            return false;
+        }
+
+        if (pos >= input_end_) {
+            break;
+        }
+
+        size_t n_jobs = 0;
+
+        for (; n_jobs < jobs_.size() && pos < input_end_; n_jobs++) {
+            const size_t warmup_begin = pos > overlap_size_ ? pos - overlap_size_ : 0;
+            const size_t chunk_end = std::min(pos + chunk_size_, input_end_);
+
+            jobs_[n_jobs]->assign(warmup_begin - input_offset_, pos - input_offset_,
+                                  chunk_end - input_offset_,
+                                  chunk_end + overlap_size_ - input_offset_);
+
+            pos = chunk_end;
+        }
+
+        transcode_jobs_(n_jobs);
+
+        // Jobs are written in order, so output doesn't depend on scheduling.
+        for (size_t n = 0; n < n_jobs; n++) {
+            if (!jobs_[n]->write_output(writer)) {
+                return false;
+            }
+        }
+
+        n_chunks += n_jobs;
+
+        drop_input_(pos > overlap_size_ ? pos - overlap_size_ : 0);
+    }
+
+    roc_log(LogDebug,
+            "parallel transcoder: finished transcoding:"
+            " n_chunks=%lu in_samples=%lu out_samples=%lu",
+            (unsigned long)n_chunks, (unsigned long)input_end_,
+            (unsigned long)output_pos_(input_end_));
+
+    return true;
+}
+
+bool ParallelTranscoder::fill_input_(sndio::ISource& source, size_t until) {
+    const size_t frame_size = in_frame_size_ * in_channels_;
+
+    while (!input_eof_ && input_end_ < until) {
+        const size_t size = input_.size();
+
+        if (!input_.grow_exp(size + frame_size) || !input_.resize(size + frame_size)) {
+            roc_log(LogError, "parallel transcoder: can't allocate input buffer");
+            return false;
+        }
+
+        audio::Frame frame(input_.data() + size, frame_size);
+
+        if (source.read(frame)) {
+            input_end_ += in_frame_size_;
+            continue;
+        }
+
+        // Input is exhausted, replace last frame with zeros, used as trailing
+        // overlap of the last chunk.
+        const size_t overlap_size = overlap_size_ * in_channels_;
+
+        if (!input_.resize(size + overlap_size)) {
+            roc_log(LogError, "parallel transcoder: can't allocate input buffer");
+            return false;
+        }
+
+        if (overlap_size != 0) {
+            memset(input_.data() + size, 0, overlap_size * sizeof(audio::sample_t));
+        }
+
+        input_eof_ = true;
+    }
+
+    return true;
+}
+
+void ParallelTranscoder::drop_input_(size_t until) {
+    roc_panic_if_not(until >= input_offset_);
+
+    const size_t n_drop = (until - input_offset_) * in_channels_;
+    const size_t n_keep = input_.size() - n_drop;
+
+    if (n_keep != 0) {
+        memmove(input_.data(), input_.data() + n_drop,
+                n_keep * sizeof(audio::sample_t));
+    }
+
+    if (!input_.resize(n_keep)) {
+        roc_panic("parallel transcoder: can't resize input buffer");
+    }
+
+    input_offset_ = until;
+}
+
+void ParallelTranscoder::transcode_jobs_(size_t n_jobs) {
+    roc_panic_if_not(n_jobs > 0 && n_jobs <= jobs_.size());
+
+    // Job n is transcoded by worker n - 1.
+    for (size_t n = 1; n < n_jobs; n++) {
+        workers_[n - 1]->wake_up();
+    }
+
+    jobs_[0]->transcode();
+
+    for (size_t n = 1; n < n_jobs; n++) {
+        done_sem_.wait();
+    }
+}
+
+void ParallelTranscoder::stop_workers_() {
+    stop_ = true;
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->wake_up();
+    }
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->join();
+        arena_.destroy_object(*workers_[n]);
+    }
+
+    if (!workers_.resize(0)) {
+        roc_panic("parallel transcoder: can't resize worker array");
+    }
+}
+
+size_t ParallelTranscoder::output_pos_(size_t input_pos) const {
+    return (size_t)((uint64_t)input_pos * config_.output_sample_spec.sample_rate()
+                    / config_.input_sample_spec.sample_rate());
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/parallel_transcoder.h
+//! @brief Parallel offline transcoder.
+
+#ifndef ROC_PIPELINE_PARALLEL_TRANSCODER_H_
+#define ROC_PIPELINE_PARALLEL_TRANSCODER_H_
+
+#include "roc_audio/iframe_writer.h"
+#include "roc_audio/sample.h"
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/ipool.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/config.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Parallel offline transcoder.
+//!
+//! Transcodes whole input file faster than real-time, using a pool of worker
+//! threads. Unlike TranscoderSink driven by sndio::Pump, it doesn't process
+//! input frame by frame, but instead reads it in large blocks.
+//!
+//! Every block is split into chunks, one per thread. Every chunk is transcoded
+//! by its own TranscoderSink, together with overlap before and after the chunk.
+//! Output produced from overlap is dropped: leading overlap warms up resampler,
+//! and trailing overlap drains samples buffered in it. Then chunks are written
+//! to output in order.
+//!
+//! Chunk boundaries are aligned so that they map to integer positions in output
+//! stream, and don't depend on number of threads. Thus, the result is the same
+//! regardless of how many threads are used and how they're scheduled.
+//!
+//! Source should not have its own clock.
+class ParallelTranscoder : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p frame_length defines size of frames read from source and written
+    //! to output writer.
+    ParallelTranscoder(const TranscoderConfig& config,
+                       const ParallelTranscoderConfig& parallel_config,
+                       core::nanoseconds_t frame_length,
+                       core::IPool& buffer_pool,
+                       core::IArena& arena);
+
+    //! Stop worker threads.
+    ~ParallelTranscoder();
+
+    //! Check if the transcoder was succefully constructed.
+    bool is_valid() const;
+
+    //! Transcode whole input.
+    //! @remarks
+    //!  Reads frames from @p source until it's exhausted, and writes transcoded
+    //!  frames to @p writer. If @p writer is NULL, output is dropped.
+    //! @returns
+    //!  false if an error occurred.
+    ROC_ATTR_NODISCARD bool run(sndio::ISource& source, audio::IFrameWriter* writer);
+
+private:
+    // Transcodes one chunk at a time and keeps its output.
+    class Job : public audio::IFrameWriter, public core::NonCopyable<> {
+    public:
+        Job(ParallelTranscoder& transcoder, core::IArena& arena);
+
+        void assign(size_t warmup_begin,
+                    size_t chunk_begin,
+                    size_t chunk_end,
+                    size_t drain_end);
+
+        void transcode();
+
+        bool write_output(audio::IFrameWriter* writer);
+
+        virtual void write(audio::Frame& frame);
+
+    private:
+        ParallelTranscoder& transcoder_;
+
+        core::Array<audio::sample_t> output_;
+
+        // Positions in input buffer, in samples per channel.
+        size_t warmup_begin_;
+        size_t chunk_begin_;
+        size_t chunk_end_;
+        size_t drain_end_;
+
+        bool ok_;
+    };
+
+    class Worker : public core::Thread {
+    public:
+        Worker(ParallelTranscoder& transcoder, size_t index);
+
+        void wake_up();
+
+    private:
+        virtual void run();
+
+        ParallelTranscoder& transcoder_;
+        const size_t index_;
+        core::Semaphore sem_;
+    };
+
+    bool fill_input_(sndio::ISource& source, size_t until);
+    void drop_input_(size_t until);
+
+    void transcode_jobs_(size_t n_jobs);
+    void stop_workers_();
+
+    size_t output_pos_(size_t input_pos) const;
+
+    core::IPool& buffer_pool_;
+    core::IArena& arena_;
+
+    TranscoderConfig config_;
+
+    const size_t in_channels_;
+    const size_t out_channels_;
+
+    size_t in_frame_size_;
+    size_t out_frame_size_;
+    size_t chunk_size_;
+    size_t overlap_size_;
+
+    // Input samples, interleaved. First sample corresponds to input_offset_
+    // samples per channel from the beginning of the input. Followed by
+    // overlap of zeros when input is exhausted.
+    core::Array<audio::sample_t> input_;
+    size_t input_offset_;
+    size_t input_end_;
+    bool input_eof_;
+
+    core::Array<Job*> jobs_;
+    core::Array<Worker*> workers_;
+
+    // Written by caller before waking up workers, true asks workers to exit.
+    bool stop_;
+    core::Semaphore done_sem_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_PARALLEL_TRANSCODER_H_
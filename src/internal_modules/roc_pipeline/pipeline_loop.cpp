@@ -9,6 +9,7 @@
 #include "roc_pipeline/pipeline_loop.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace pipeline {
@@ -17,6 +18,9 @@ namespace {
 
 const core::nanoseconds_t StatsReportInterval = core::Minute;
 
+// How quickly sub-frame processing cost estimate follows measurements.
+const double SubframeCostDecay = 0.1;
+
 } // namespace
 
 PipelineLoop::PipelineLoop(IPipelineTaskScheduler& scheduler,
@@ -38,7 +42,10 @@ PipelineLoop::PipelineLoop(IPipelineTaskScheduler& scheduler,
     , subframe_tasks_deadline_(0)
     , samples_processed_(0)
     , enough_samples_to_process_tasks_(false)
-    , rate_limiter_(StatsReportInterval) {
+    , subframe_cost_(0)
+    , rate_limiter_(StatsReportInterval)
+    , published_task_stats_(Stats())
+    , published_sched_stats_(Stats()) {
 }
 
 PipelineLoop::~PipelineLoop() {
@@ -48,8 +55,15 @@ PipelineLoop::~PipelineLoop() {
     }
 }
 
-const PipelineLoop::Stats& PipelineLoop::get_stats_ref() const {
-    return stats_;
+PipelineLoop::Stats PipelineLoop::get_stats() const {
+    const Stats task_stats = published_task_stats_.wait_load();
+    const Stats sched_stats = published_sched_stats_.wait_load();
+
+    Stats stats = task_stats;
+    stats.scheduler_calls = sched_stats.scheduler_calls;
+    stats.scheduler_cancellations = sched_stats.scheduler_cancellations;
+
+    return stats;
 }
 
 size_t PipelineLoop::num_pending_tasks() const {
@@ -122,14 +136,16 @@ bool PipelineLoop::schedule_and_maybe_process_task_(PipelineTask& task) {
     process_task_(task, false);
     --pending_tasks_;
 
-    stats_.task_processed_total++;
-    stats_.task_processed_in_place++;
+    task_stats_.task_processed_total++;
+    task_stats_.task_processed_in_place++;
 
     const int n_pending_frames = pending_frames_;
     if (n_pending_frames != 0) {
-        stats_.preemptions++;
+        task_stats_.preemptions++;
     }
 
+    published_task_stats_.exclusive_store(task_stats_);
+
     pipeline_mutex_.unlock();
 
     if (n_pending_frames == 0 && pending_tasks_ != 0) {
@@ -180,11 +196,13 @@ bool PipelineLoop::maybe_process_tasks_() {
         process_task_(*task, true);
         --pending_tasks_;
 
-        stats_.task_processed_total++;
+        task_stats_.task_processed_total++;
+        published_task_stats_.exclusive_store(task_stats_);
     }
 
     if (n_pending_frames != 0) {
-        stats_.preemptions++;
+        task_stats_.preemptions++;
+        published_task_stats_.exclusive_store(task_stats_);
     }
 
     pipeline_mutex_.unlock();
@@ -206,7 +224,11 @@ bool PipelineLoop::process_subframes_and_tasks_simple_(audio::Frame& frame) {
 
     pipeline_mutex_.lock();
 
-    const bool frame_res = process_subframe_imp(frame);
+    bool frame_res = false;
+    {
+        core::TraceScope trace("pipeline_subframe");
+        frame_res = process_subframe_imp(frame);
+    }
 
     pipeline_mutex_.unlock();
 
@@ -238,7 +260,8 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
     for (;;) {
         const bool first_iteration = (frame_pos == 0);
 
-        frame_res = process_next_subframe_(frame, &frame_pos, frame_duration);
+        frame_res =
+            process_next_subframe_(frame, &frame_pos, frame_duration, next_frame_deadline);
 
         if (first_iteration) {
             next_frame_deadline =
@@ -250,8 +273,10 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
                 process_task_(*task, true);
                 --pending_tasks_;
 
-                stats_.task_processed_total++;
-                stats_.task_processed_in_frame++;
+                task_stats_.task_processed_total++;
+                task_stats_.task_processed_in_frame++;
+
+                published_task_stats_.exclusive_store(task_stats_);
 
                 if (!subframe_task_processing_allowed_(next_frame_deadline)) {
                     break;
@@ -303,7 +328,8 @@ void PipelineLoop::schedule_async_task_processing_() {
         }
 
         scheduler_.schedule_task_processing(*this, deadline);
-        stats_.scheduler_calls++;
+        sched_stats_.scheduler_calls++;
+        published_sched_stats_.exclusive_store(sched_stats_);
 
         processing_state_ = ProcScheduled;
     }
@@ -322,7 +348,8 @@ void PipelineLoop::cancel_async_task_processing_() {
 
     if (processing_state_ == ProcScheduled) {
         scheduler_.cancel_task_processing(*this);
-        stats_.scheduler_cancellations++;
+        sched_stats_.scheduler_cancellations++;
+        published_sched_stats_.exclusive_store(sched_stats_);
 
         processing_state_ = ProcNotScheduled;
     }
@@ -333,7 +360,10 @@ void PipelineLoop::cancel_async_task_processing_() {
 void PipelineLoop::process_task_(PipelineTask& task, bool notify) {
     IPipelineTaskCompleter* completer = task.completer_;
 
-    task.success_ = process_task_imp(task);
+    {
+        core::TraceScope trace("pipeline_task");
+        task.success_ = process_task_imp(task);
+    }
     task.state_ = PipelineTask::StateFinished;
 
     if (completer) {
@@ -345,10 +375,13 @@ void PipelineLoop::process_task_(PipelineTask& task, bool notify) {
 
 bool PipelineLoop::process_next_subframe_(audio::Frame& frame,
                                           packet::stream_timestamp_t* frame_pos,
-                                          packet::stream_timestamp_t frame_duration) {
-    const size_t subframe_duration = max_samples_between_tasks_
-        ? std::min(frame_duration - *frame_pos, max_samples_between_tasks_)
-        : frame_duration;
+                                          packet::stream_timestamp_t frame_duration,
+                                          core::nanoseconds_t next_frame_deadline) {
+    const core::nanoseconds_t subframe_start_time =
+        config_.enable_adaptive_subframes ? timestamp_imp() : 0;
+
+    const packet::stream_timestamp_t subframe_duration = next_subframe_duration_(
+        frame_duration - *frame_pos, next_frame_deadline, subframe_start_time);
 
     audio::Frame sub_frame(frame.bytes()
                                + sample_spec_.stream_timestamp_2_bytes(*frame_pos),
@@ -362,9 +395,19 @@ bool PipelineLoop::process_next_subframe_(audio::Frame& frame,
                                         + sample_spec_.stream_timestamp_2_ns(*frame_pos));
     }
 
-    const bool ret = process_subframe_imp(sub_frame);
+    bool ret = false;
+    {
+        core::TraceScope trace("pipeline_subframe");
+        ret = process_subframe_imp(sub_frame);
+    }
+
+    const core::nanoseconds_t subframe_end_time = timestamp_imp();
+
+    subframe_tasks_deadline_ = subframe_end_time + config_.max_inframe_task_processing;
 
-    subframe_tasks_deadline_ = timestamp_imp() + config_.max_inframe_task_processing;
+    if (config_.enable_adaptive_subframes) {
+        update_subframe_cost_(subframe_end_time - subframe_start_time, subframe_duration);
+    }
 
     if (*frame_pos == 0) {
         frame.set_capture_timestamp(sub_frame.capture_timestamp());
@@ -386,6 +429,56 @@ bool PipelineLoop::process_next_subframe_(audio::Frame& frame,
     return ret;
 }
 
+packet::stream_timestamp_t
+PipelineLoop::next_subframe_duration_(packet::stream_timestamp_t remaining_duration,
+                                      core::nanoseconds_t next_frame_deadline,
+                                      core::nanoseconds_t now) const {
+    if (!config_.enable_adaptive_subframes || !(subframe_cost_ > 0)) {
+        return max_samples_between_tasks_
+            ? std::min(remaining_duration, max_samples_between_tasks_)
+            : remaining_duration;
+    }
+
+    core::nanoseconds_t budget = config_.max_subframe_processing;
+
+    if (pending_tasks_ != 0 && next_frame_deadline != 0) {
+        // Leave time for pending tasks before next frame is expected.
+        const core::nanoseconds_t slack = next_frame_deadline
+            - no_task_proc_half_interval_ - config_.max_inframe_task_processing - now;
+
+        if (slack > 0 && slack < budget) {
+            budget = slack;
+        }
+    }
+
+    // Clamp before casting, since when cost estimate decays to almost zero,
+    // quotient doesn't fit into stream_timestamp_t.
+    double duration = (double)budget / subframe_cost_;
+
+    // Sub-frames smaller than minimum interval between tasks don't help
+    // task processing, but add overhead.
+    duration = std::max(duration, (double)min_samples_between_tasks_);
+    duration = std::max(duration, 1.0);
+    duration = std::min(duration, (double)remaining_duration);
+
+    return (packet::stream_timestamp_t)duration;
+}
+
+void PipelineLoop::update_subframe_cost_(core::nanoseconds_t elapsed,
+                                         packet::stream_timestamp_t subframe_duration) {
+    if (subframe_duration == 0 || elapsed < 0) {
+        return;
+    }
+
+    const double cost = (double)elapsed / subframe_duration;
+
+    if (subframe_cost_ > 0) {
+        subframe_cost_ += (cost - subframe_cost_) * SubframeCostDecay;
+    } else {
+        subframe_cost_ = cost;
+    }
+}
+
 bool PipelineLoop::start_subframe_task_processing_() {
     if (pending_tasks_ == 0) {
         return false;
@@ -469,18 +562,20 @@ void PipelineLoop::report_stats_() {
     }
 
     if (rate_limiter_.allow()) {
+        const Stats stats = get_stats();
+
         roc_log(LogDebug,
                 "pipeline loop:"
                 " tasks=%lu in_place=%.2f in_frame=%.2f preempts=%lu sched=%lu/%lu",
-                (unsigned long)stats_.task_processed_total,
-                stats_.task_processed_total
-                    ? double(stats_.task_processed_in_place) / stats_.task_processed_total
+                (unsigned long)stats.task_processed_total,
+                stats.task_processed_total
+                    ? double(stats.task_processed_in_place) / stats.task_processed_total
                     : 0.,
-                stats_.task_processed_total
-                    ? double(stats_.task_processed_in_frame) / stats_.task_processed_total
+                stats.task_processed_total
+                    ? double(stats.task_processed_in_frame) / stats.task_processed_total
                     : 0.,
-                (unsigned long)stats_.preemptions, (unsigned long)stats_.scheduler_calls,
-                (unsigned long)stats_.scheduler_cancellations);
+                (unsigned long)stats.preemptions, (unsigned long)stats.scheduler_calls,
+                (unsigned long)stats.scheduler_cancellations);
     }
 
     scheduler_mutex_.unlock();
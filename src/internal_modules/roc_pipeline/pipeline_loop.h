@@ -49,8 +49,23 @@ struct PipelineLoopConfig {
     //! If the frame is larger than this size, it is split into multiple subframes
     //! to allow task processing between the sub-frames.
     //! Set to zero to disable frame splitting.
+    //! When adaptive sub-frames are enabled, used only until processing cost
+    //! is measured.
     core::nanoseconds_t max_frame_length_between_tasks;
 
+    //! Enable adaptive sub-frame size.
+    //! When enabled, sub-frame size is selected before every sub-frame from
+    //! measured processing cost per sample, so that processing of one sub-frame
+    //! takes about max_subframe_processing. If there are pending tasks, sub-frame
+    //! is also shrunk so that tasks can be processed before the next frame is
+    //! expected. Cheap frames are processed in one piece, and expensive frames
+    //! are split into pieces of equal processing time instead of equal duration.
+    bool enable_adaptive_subframes;
+
+    //! Maximum processing time of one sub-frame, when adaptive sub-frames are enabled.
+    //! Defines how long tasks may wait while sub-frame is processed.
+    core::nanoseconds_t max_subframe_processing;
+
     //! Maximum task processing duration happening immediately after processing a frame.
     //! If this period expires and there are still pending tasks, asynchronous
     //! task processing is scheduled.
@@ -69,6 +84,8 @@ struct PipelineLoopConfig {
         : enable_precise_task_scheduling(true)
         , min_frame_length_between_tasks(200 * core::Microsecond)
         , max_frame_length_between_tasks(1 * core::Millisecond)
+        , enable_adaptive_subframes(false)
+        , max_subframe_processing(1 * core::Millisecond)
         , max_inframe_task_processing(20 * core::Microsecond)
         , task_processing_prohibited_interval(200 * core::Microsecond) {
     }
@@ -116,6 +133,9 @@ struct PipelineLoopConfig {
 //! of after every frame. This is needed to reduce task processing overhead when using
 //! tiny frames.
 //!
+//! By default, sub-frame size is fixed. Optionally, it can be selected adaptively from
+//! measured processing cost, see PipelineLoopConfig::enable_adaptive_subframes.
+//!
 //! There are two types of time slices dedicated for task processing:
 //!  - in-frame task processing: short intervals between sub-frames
 //!    (inside process_frame_and_tasks())
@@ -245,7 +265,6 @@ public:
     //! Process some of the enqueued tasks, if any.
     void process_tasks();
 
-protected:
     //! Task processing statistics.
     struct Stats {
         //! Total number of tasks processed.
@@ -276,6 +295,15 @@ protected:
         }
     };
 
+    //! Get snapshot of task processing statistics.
+    //! @remarks
+    //!  Lock-free, can be called from any thread concurrently with other methods.
+    //!  Task counters (including preemptions) are consistent with each other,
+    //!  and scheduler counters are consistent with each other, but the two
+    //!  groups are loaded separately.
+    Stats get_stats() const;
+
+protected:
     //! Initialization.
     PipelineLoop(IPipelineTaskScheduler& scheduler,
                  const PipelineLoopConfig& config,
@@ -289,10 +317,6 @@ protected:
     //! How much pending frames are there.
     size_t num_pending_frames() const;
 
-    //! Get task processing statistics.
-    //! Returned object can't be accessed concurrently with other methods.
-    const Stats& get_stats_ref() const;
-
     //! Split frame and process subframes and some of the enqueued tasks.
     bool process_subframes_and_tasks(audio::Frame& frame);
 
@@ -323,7 +347,15 @@ private:
     void process_task_(PipelineTask& task, bool notify);
     bool process_next_subframe_(audio::Frame& frame,
                                 packet::stream_timestamp_t* frame_pos,
-                                packet::stream_timestamp_t frame_duration);
+                                packet::stream_timestamp_t frame_duration,
+                                core::nanoseconds_t next_frame_deadline);
+
+    packet::stream_timestamp_t
+    next_subframe_duration_(packet::stream_timestamp_t remaining_duration,
+                            core::nanoseconds_t next_frame_deadline,
+                            core::nanoseconds_t now) const;
+    void update_subframe_cost_(core::nanoseconds_t elapsed,
+                               packet::stream_timestamp_t subframe_duration);
 
     bool start_subframe_task_processing_();
     bool subframe_task_processing_allowed_(core::nanoseconds_t next_frame_deadline) const;
@@ -382,9 +414,18 @@ private:
     // did we accumulate enough samples in samples_processed_
     bool enough_samples_to_process_tasks_;
 
+    // moving average of sub-frame processing time per sample, nanoseconds
+    double subframe_cost_;
+
     // task processing statistics
+    // task counters are updated under pipeline mutex, scheduler counters are
+    // updated under scheduler mutex; each group is modified in a private copy
+    // and then published via its own seqlock, which thus has a single writer
     core::RateLimiter rate_limiter_;
-    Stats stats_;
+    Stats task_stats_;
+    Stats sched_stats_;
+    core::Seqlock<Stats> published_task_stats_;
+    core::Seqlock<Stats> published_sched_stats_;
 };
 
 } // namespace pipeline
@@ -18,6 +18,19 @@
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+// Maximum number of packets pulled from inbound queue at once.
+enum { MaxPullBatch = 32 };
+
+// Maximum number of packets written by network thread and not yet pulled
+// by pipeline thread.
+enum { InboundQueueSize = 4096 };
+
+const core::nanoseconds_t DropReportInterval = 5 * core::Second;
+
+} // namespace
+
 ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
                                    StateTracker& state_tracker,
                                    ReceiverSessionGroup& session_group,
@@ -32,10 +45,18 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
     , composer_(NULL)
     , parser_(NULL)
     , inbound_address_(inbound_address)
+    , inbound_queue_(packet::ConcurrentQueue::NonBlocking, arena, InboundQueueSize)
+    , n_dropped_packets_(0)
+    , drop_limiter_(DropReportInterval)
     , valid_(false) {
     packet::IComposer* composer = NULL;
     packet::IParser* parser = NULL;
 
+    if (!inbound_queue_.is_valid()) {
+        roc_log(LogError, "receiver endpoint: can't allocate inbound queue");
+        return;
+    }
+
     switch (proto) {
     case address::Proto_RTP:
     case address::Proto_RTP_LDPC_Source:
@@ -193,24 +214,44 @@ status::StatusCode ReceiverEndpoint::pull_packets(core::nanoseconds_t current_ti
 
     roc_panic_if(!parser_);
 
-    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
-    // It may return NULL either if the queue is empty or if the packets in the
-    // queue were added in a very short time or are being added currently. It's
-    // acceptable to consider such packets late and pull them next time.
-    while (packet::PacketPtr packet = inbound_queue_.try_pop_front_exclusive()) {
-        if (!parser_->parse(*packet, packet->buffer())) {
-            roc_log(LogDebug, "receiver endpoint: can't parse packet");
-            continue;
+    status::StatusCode code = status::StatusOK;
+
+    for (;;) {
+        // Inbound queue is a non-blocking single-producer single-consumer
+        // queue, so reading from it is lock-free and wait-free. Packets that
+        // are being added currently are pulled next time.
+        packet::PacketPtr packets[MaxPullBatch];
+        size_t n_packets = 0;
+
+        if (inbound_queue_.read_batch(packets, MaxPullBatch, n_packets)
+            != status::StatusOK) {
+            break;
         }
 
-        const status::StatusCode code = session_group_.route_packet(packet, current_time);
-        state_tracker_.add_pending_packets(-1);
+        // Pending counter is updated once per batch. Every popped packet is
+        // routed, even if routing of some previous packet failed; the first
+        // error is reported.
+        for (size_t n = 0; n < n_packets; n++) {
+            if (!parser_->parse(*packets[n], packets[n]->buffer())) {
+                roc_log(LogDebug, "receiver endpoint: can't parse packet");
+                continue;
+            }
+
+            const status::StatusCode route_code =
+                session_group_.route_packet(packets[n], current_time);
+            if (route_code != status::StatusOK && code == status::StatusOK) {
+                code = route_code;
+            }
+        }
+
+        state_tracker_.add_pending_packets(-(int)n_packets);
+
         if (code != status::StatusOK) {
-            return code;
+            break;
         }
     }
 
-    return status::StatusOK;
+    return code;
 }
 
 // Implementation of inbound_writer().write()
@@ -221,10 +262,53 @@ status::StatusCode ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!parser_);
 
     state_tracker_.add_pending_packets(+1);
-    inbound_queue_.push_back(*packet);
+
+    if (inbound_queue_.write(packet) != status::StatusOK) {
+        state_tracker_.add_pending_packets(-1);
+        report_drops_(1);
+    }
 
     return status::StatusOK;
 }
 
+// Implementation of inbound_writer().write_batch()
+status::StatusCode ReceiverEndpoint::write_batch(const packet::PacketPtr* packets,
+                                                 size_t n_packets) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if(!parser_);
+
+    // Pending counter is updated once per batch, before packets become
+    // visible to pull_packets().
+    state_tracker_.add_pending_packets((int)n_packets);
+
+    size_t n_written = 0;
+
+    while (n_written < n_packets) {
+        if (inbound_queue_.write(packets[n_written]) != status::StatusOK) {
+            break;
+        }
+        n_written++;
+    }
+
+    if (n_written < n_packets) {
+        state_tracker_.add_pending_packets(-(int)(n_packets - n_written));
+        report_drops_(n_packets - n_written);
+    }
+
+    return status::StatusOK;
+}
+
+void ReceiverEndpoint::report_drops_(size_t n_dropped) {
+    n_dropped_packets_ += n_dropped;
+
+    if (drop_limiter_.allow()) {
+        roc_log(LogInfo,
+                "receiver endpoint: inbound queue is full, dropped packets:"
+                " proto=%s n_dropped=%lu",
+                address::proto_to_str(proto_), (unsigned long)n_dropped_packets_);
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -15,10 +15,11 @@
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
 #include "roc_core/iarena.h"
-#include "roc_core/mpsc_queue.h"
 #include "roc_core/optional.h"
+#include "roc_core/rate_limiter.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/shipper.h"
@@ -84,8 +85,11 @@ public:
     //! This way packets from network reach receiver pipeline.
     //! @remarks
     //!  Packets passed to this writer will be pulled into pipeline.
-    //!  This writer is thread-safe and lock-free, packets can be written
-    //!  to it from netio thread.
+    //!  This writer is lock-free, packets can be written to it from netio
+    //!  thread, but only from one thread at a time.
+    //! @note
+    //!  If packets are written faster than pipeline pulls them and inbound
+    //!  queue becomes full, new packets are dropped.
     packet::IWriter& inbound_writer();
 
     //! Pull packets written to inbound writer into pipeline.
@@ -97,6 +101,10 @@ public:
 
 private:
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    write_batch(const packet::PacketPtr* packets, size_t n_packets);
+
+    void report_drops_(size_t n_dropped);
 
     const address::Protocol proto_;
 
@@ -116,7 +124,11 @@ private:
     core::ScopedPtr<packet::IParser> fec_parser_;
     core::Optional<rtcp::Parser> rtcp_parser_;
     address::SocketAddr inbound_address_;
-    core::MpscQueue<packet::Packet> inbound_queue_;
+    packet::ConcurrentQueue inbound_queue_;
+
+    // Accessed only by writer thread.
+    size_t n_dropped_packets_;
+    core::RateLimiter drop_limiter_;
 
     bool valid_;
 };
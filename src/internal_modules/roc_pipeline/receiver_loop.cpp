@@ -287,6 +287,7 @@ bool ReceiverLoop::task_query_slot_(Task& task) {
     roc_panic_if(!task.slot_metrics_);
 
     task.slot_->get_metrics(*task.slot_metrics_, task.party_metrics_, task.party_count_);
+    task.slot_metrics_->pipeline = get_stats();
     return true;
 }
 
@@ -40,9 +40,17 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     // packets in the queues.
     packet::IWriter* pkt_writer = NULL;
 
-    source_queue_.reset(new (source_queue_) packet::SortedQueue(0));
-    if (!source_queue_) {
-        return;
+    if (session_config.enable_seqnum_queue) {
+        packet::SeqnumQueue* seqnum_queue = new (arena) packet::SeqnumQueue(0, arena);
+        source_queue_.reset(seqnum_queue, arena);
+        if (!source_queue_ || !seqnum_queue->is_valid()) {
+            return;
+        }
+    } else {
+        source_queue_.reset(new (arena) packet::SortedQueue(0), arena);
+        if (!source_queue_) {
+            return;
+        }
     }
     pkt_writer = source_queue_.get();
 
@@ -167,6 +175,15 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             }
             frm_reader = watchdog_.get();
         }
+
+        if (session_config.enable_plc && !session_config.enable_beeping) {
+            plc_reader_.reset(new (plc_reader_) audio::PlcReader(
+                *frm_reader, out_spec, session_config.plc, arena));
+            if (!plc_reader_ || !plc_reader_->is_valid()) {
+                return;
+            }
+            frm_reader = plc_reader_.get();
+        }
     }
 
     if (pkt_encoding->sample_spec.channel_set()
@@ -369,6 +386,15 @@ ReceiverParticipantMetrics ReceiverSession::get_metrics() const {
     ReceiverParticipantMetrics metrics;
     metrics.link = source_meter_->metrics();
     metrics.latency = latency_monitor_->metrics();
+    metrics.depacketizer = depacketizer_->metrics();
+    if (plc_reader_) {
+        metrics.plc = plc_reader_->metrics();
+    }
+    if (fec_reader_) {
+        metrics.fec = fec_reader_->metrics();
+    }
+    metrics.queued_packets = source_queue_->size();
+    metrics.scaling = latency_monitor_->scaling();
 
     return metrics;
 }
@@ -20,6 +20,7 @@
 #include "roc_audio/iframe_reader.h"
 #include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
+#include "roc_audio/plc_reader.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/iarena.h"
@@ -35,7 +36,9 @@
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_packet/isorted_queue.h"
 #include "roc_packet/router.h"
+#include "roc_packet/seqnum_queue.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/config.h"
@@ -120,7 +123,7 @@ private:
 
     core::Optional<packet::Router> packet_router_;
 
-    core::Optional<packet::SortedQueue> source_queue_;
+    core::ScopedPtr<packet::ISortedQueue> source_queue_;
     core::Optional<packet::SortedQueue> repair_queue_;
 
     core::Optional<rtp::LinkMeter> source_meter_;
@@ -131,6 +134,7 @@ private:
     core::Optional<rtp::Filter> filter_;
     core::Optional<packet::DelayedReader> delayed_reader_;
     core::Optional<audio::Watchdog> watchdog_;
+    core::Optional<audio::PlcReader> plc_reader_;
 
     core::Optional<rtp::Parser> fec_parser_;
     core::ScopedPtr<fec::IBlockDecoder> fec_decoder_;
@@ -16,6 +16,29 @@
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+void add_counters(audio::DepacketizerMetrics& depacketizer,
+                  audio::PlcMetrics& plc,
+                  fec::ReaderMetrics& fec,
+                  const ReceiverParticipantMetrics& party_metrics) {
+    depacketizer.decoded_samples += party_metrics.depacketizer.decoded_samples;
+    depacketizer.missing_samples += party_metrics.depacketizer.missing_samples;
+    depacketizer.concealed_samples += party_metrics.depacketizer.concealed_samples;
+    depacketizer.late_packets += party_metrics.depacketizer.late_packets;
+
+    plc.concealed_frames += party_metrics.plc.concealed_frames;
+    plc.concealed_samples += party_metrics.plc.concealed_samples;
+    plc.conceal_time += party_metrics.plc.conceal_time;
+    plc.max_conceal_time =
+        std::max(plc.max_conceal_time, party_metrics.plc.max_conceal_time);
+
+    fec.read_packets += party_metrics.fec.read_packets;
+    fec.restored_packets += party_metrics.fec.restored_packets;
+}
+
+} // namespace
+
 ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_config,
                                            const ReceiverSlotConfig& slot_config,
                                            StateTracker& state_tracker,
@@ -39,11 +62,25 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
         return;
     }
 
+    if (source_config_.num_session_threads != 0) {
+        session_mixer_.reset(new (session_mixer_) ReceiverSessionMixer(
+            frame_factory_, source_config_.common.output_sample_spec,
+            source_config_.num_session_threads, arena_));
+        if (!session_mixer_ || !session_mixer_->is_valid()) {
+            return;
+        }
+        mixer_.add_input(*session_mixer_);
+    }
+
     valid_ = true;
 }
 
 ReceiverSessionGroup::~ReceiverSessionGroup() {
     remove_all_sessions_();
+
+    if (session_mixer_ && session_mixer_->is_valid()) {
+        mixer_.remove_input(*session_mixer_);
+    }
 }
 
 bool ReceiverSessionGroup::is_valid() const {
@@ -150,6 +187,21 @@ void ReceiverSessionGroup::get_slot_metrics(ReceiverSlotMetrics& slot_metrics) c
 
     slot_metrics.source_id = identity_->ssrc();
     slot_metrics.num_participants = sessions_.size();
+
+    slot_metrics.depacketizer = removed_depacketizer_metrics_;
+    slot_metrics.plc = removed_plc_metrics_;
+    slot_metrics.fec = removed_fec_metrics_;
+    slot_metrics.queued_packets = 0;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        const ReceiverParticipantMetrics party_metrics = sess->get_metrics();
+
+        add_counters(slot_metrics.depacketizer, slot_metrics.plc, slot_metrics.fec,
+                     party_metrics);
+
+        slot_metrics.queued_packets += party_metrics.queued_packets;
+    }
 }
 
 void ReceiverSessionGroup::get_participant_metrics(
@@ -404,7 +456,17 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
         return status::StatusOK;
     }
 
-    mixer_.add_input(sess->frame_reader());
+    if (session_mixer_) {
+        if (!session_mixer_->add_input(sess->frame_reader())) {
+            roc_log(LogError,
+                    "session group: can't create session, can't add mixer input");
+            session_router_.remove_session(sess);
+            // TODO(gh-183): handle and return status
+            return status::StatusOK;
+        }
+    } else {
+        mixer_.add_input(sess->frame_reader());
+    }
     sessions_.push_back(*sess);
 
     state_tracker_.add_active_sessions(+1);
@@ -415,7 +477,14 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 void ReceiverSessionGroup::remove_session_(core::SharedPtr<ReceiverSession> sess) {
     roc_log(LogInfo, "session group: removing session");
 
-    mixer_.remove_input(sess->frame_reader());
+    add_counters(removed_depacketizer_metrics_, removed_plc_metrics_,
+                 removed_fec_metrics_, sess->get_metrics());
+
+    if (session_mixer_) {
+        session_mixer_->remove_input(sess->frame_reader());
+    } else {
+        mixer_.remove_input(sess->frame_reader());
+    }
     sessions_.remove(*sess);
 
     session_router_.remove_session(sess);
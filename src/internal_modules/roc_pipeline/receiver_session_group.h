@@ -21,6 +21,7 @@
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/receiver_session_mixer.h"
 #include "roc_pipeline/receiver_session_router.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtcp/communicator.h"
@@ -139,6 +140,9 @@ private:
     StateTracker& state_tracker_;
     audio::Mixer& mixer_;
 
+    // Used instead of mixer_ to read sessions in parallel.
+    core::Optional<ReceiverSessionMixer> session_mixer_;
+
     const rtp::EncodingMap& encoding_map_;
 
     core::IArena& arena_;
@@ -153,6 +157,11 @@ private:
     core::List<ReceiverSession> sessions_;
     ReceiverSessionRouter session_router_;
 
+    // Counters of removed sessions, to keep slot counters monotonic.
+    audio::DepacketizerMetrics removed_depacketizer_metrics_;
+    audio::PlcMetrics removed_plc_metrics_;
+    fec::ReaderMetrics removed_fec_metrics_;
+
     bool valid_;
 };
 
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_mixer.h"
+#include "roc_audio/copy_counter.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionMixer::Input::Input(audio::IFrameReader& reader,
+                                   const core::Slice<audio::sample_t>& buffer)
+    : reader_(reader)
+    , buffer_(buffer)
+    , size_(0)
+    , has_frame_(false)
+    , flags_(0)
+    , capture_ts_(0) {
+}
+
+audio::IFrameReader& ReceiverSessionMixer::Input::reader() {
+    return reader_;
+}
+
+void ReceiverSessionMixer::Input::fetch(size_t n_samples) {
+    audio::Frame frame(buffer_.data(), n_samples);
+
+    size_ = n_samples;
+    has_frame_ = reader_.read(frame);
+    flags_ = frame.flags();
+    capture_ts_ = frame.capture_timestamp();
+}
+
+bool ReceiverSessionMixer::Input::read(audio::Frame& frame) {
+    roc_panic_if_msg(frame.num_raw_samples() != size_,
+                     "session mixer: unexpected frame size: fetched=%lu requested=%lu",
+                     (unsigned long)size_, (unsigned long)frame.num_raw_samples());
+
+    if (!has_frame_) {
+        return false;
+    }
+
+    memcpy(frame.raw_samples(), buffer_.data(), size_ * sizeof(audio::sample_t));
+    audio::CopyCounter::instance().add(audio::CopyStage_SessionMixer, size_);
+
+    frame.set_flags(flags_);
+    frame.set_capture_timestamp(capture_ts_);
+
+    return true;
+}
+
+ReceiverSessionMixer::Worker::Worker(ReceiverSessionMixer& mixer, size_t index)
+    : mixer_(mixer)
+    , index_(index) {
+}
+
+void ReceiverSessionMixer::Worker::wake_up() {
+    sem_.post();
+}
+
+void ReceiverSessionMixer::Worker::run() {
+    for (;;) {
+        sem_.wait();
+
+        if (mixer_.fetch_size_ == 0) {
+            break;
+        }
+
+        mixer_.fetch_stride_(index_);
+        mixer_.done_sem_.post();
+    }
+}
+
+ReceiverSessionMixer::ReceiverSessionMixer(audio::FrameFactory& frame_factory,
+                                           const audio::SampleSpec& sample_spec,
+                                           size_t num_threads,
+                                           core::IArena& arena)
+    : frame_factory_(frame_factory)
+    , arena_(arena)
+    , sample_spec_(sample_spec)
+    , mixer_(frame_factory, sample_spec, true)
+    , inputs_(arena)
+    , workers_(arena)
+    , fetch_size_(0)
+    , max_read_(frame_factory.raw_buffer_size())
+    , valid_(false) {
+    if (!mixer_.is_valid()) {
+        return;
+    }
+
+    roc_log(LogDebug, "session mixer: initializing: num_threads=%lu",
+            (unsigned long)num_threads);
+
+    if (!workers_.grow(num_threads)) {
+        roc_log(LogError, "session mixer: can't allocate worker array");
+        return;
+    }
+
+    for (size_t n = 0; n < num_threads; n++) {
+        // Caller thread reads inputs with index 0, workers start from 1.
+        Worker* worker = new (arena_) Worker(*this, n + 1);
+        if (!worker) {
+            roc_log(LogError, "session mixer: can't allocate worker");
+            return;
+        }
+
+        if (!worker->start()) {
+            roc_log(LogError, "session mixer: can't start worker thread");
+            arena_.destroy_object(*worker);
+            return;
+        }
+
+        if (!workers_.push_back(worker)) {
+            roc_panic("session mixer: can't add worker");
+        }
+    }
+
+    valid_ = true;
+}
+
+ReceiverSessionMixer::~ReceiverSessionMixer() {
+    stop_workers_();
+
+    while (inputs_.size() != 0) {
+        remove_input(inputs_.back()->reader());
+    }
+}
+
+bool ReceiverSessionMixer::is_valid() const {
+    return valid_;
+}
+
+bool ReceiverSessionMixer::add_input(audio::IFrameReader& reader) {
+    roc_panic_if(!valid_);
+
+    core::Slice<audio::sample_t> buffer = frame_factory_.new_raw_buffer();
+    if (!buffer) {
+        roc_log(LogError, "session mixer: can't allocate input buffer");
+        return false;
+    }
+    buffer.reslice(0, buffer.capacity());
+
+    Input* input = new (arena_) Input(reader, buffer);
+    if (!input) {
+        roc_log(LogError, "session mixer: can't allocate input");
+        return false;
+    }
+
+    if (!inputs_.push_back(input)) {
+        roc_log(LogError, "session mixer: can't add input");
+        arena_.destroy_object(*input);
+        return false;
+    }
+
+    mixer_.add_input(*input);
+
+    return true;
+}
+
+void ReceiverSessionMixer::remove_input(audio::IFrameReader& reader) {
+    for (size_t n = 0; n < inputs_.size(); n++) {
+        Input* input = inputs_[n];
+
+        if (&input->reader() != &reader) {
+            continue;
+        }
+
+        mixer_.remove_input(*input);
+        arena_.destroy_object(*input);
+
+        // Keep order of remaining inputs, so that they're mixed
+        // in the same order as they were added.
+        for (size_t m = n + 1; m < inputs_.size(); m++) {
+            inputs_[m - 1] = inputs_[m];
+        }
+        if (!inputs_.resize(inputs_.size() - 1)) {
+            roc_panic("session mixer: can't resize input array");
+        }
+
+        return;
+    }
+
+    roc_panic("session mixer: input not found");
+}
+
+bool ReceiverSessionMixer::read(audio::Frame& frame) {
+    roc_panic_if(!valid_);
+
+    // Optimization for single input case.
+    // There is nothing to parallelize and mix, so input reads directly into
+    // caller's frame, without intermediate buffers.
+    if (inputs_.size() == 1) {
+        return read_single_(frame);
+    }
+
+    audio::sample_t* samples = frame.raw_samples();
+    size_t n_samples = frame.num_raw_samples();
+
+    unsigned flags = 0;
+    core::nanoseconds_t capture_ts = 0;
+
+    while (n_samples != 0) {
+        // Inputs can't read more than fits into their buffers, so large
+        // frames are split into several rounds.
+        size_t n_read = n_samples;
+        if (n_read > max_read_) {
+            n_read = max_read_;
+        }
+
+        fetch_inputs_(n_read);
+
+        audio::Frame sub_frame(samples, n_read);
+        mixer_.read(sub_frame);
+
+        flags |= sub_frame.flags();
+        if (capture_ts == 0) {
+            capture_ts = sub_frame.capture_timestamp();
+        }
+
+        samples += n_read;
+        n_samples -= n_read;
+    }
+
+    frame.set_flags(flags);
+    frame.set_duration(packet::stream_timestamp_t(frame.num_raw_samples()
+                                                  / sample_spec_.num_channels()));
+    frame.set_capture_timestamp(capture_ts);
+
+    return true;
+}
+
+bool ReceiverSessionMixer::read_single_(audio::Frame& frame) {
+    if (!inputs_[0]->reader().read(frame)) {
+        memset(frame.raw_samples(), 0, frame.num_raw_samples() * sizeof(audio::sample_t));
+
+        frame.set_flags(0);
+        frame.set_duration(packet::stream_timestamp_t(frame.num_raw_samples()
+                                                      / sample_spec_.num_channels()));
+        frame.set_capture_timestamp(0);
+    }
+
+    return true;
+}
+
+void ReceiverSessionMixer::fetch_inputs_(size_t n_samples) {
+    fetch_size_ = n_samples;
+
+    // Waking up workers costs more than reading a single input.
+    if (inputs_.size() < 2 || workers_.size() == 0) {
+        for (size_t n = 0; n < inputs_.size(); n++) {
+            inputs_[n]->fetch(n_samples);
+        }
+        return;
+    }
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->wake_up();
+    }
+
+    fetch_stride_(0);
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        done_sem_.wait();
+    }
+}
+
+void ReceiverSessionMixer::fetch_stride_(size_t index) {
+    const size_t stride = workers_.size() + 1;
+
+    for (size_t n = index; n < inputs_.size(); n += stride) {
+        inputs_[n]->fetch(fetch_size_);
+    }
+}
+
+void ReceiverSessionMixer::stop_workers_() {
+    fetch_size_ = 0;
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->wake_up();
+    }
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->join();
+        arena_.destroy_object(*workers_[n]);
+    }
+
+    if (!workers_.resize(0)) {
+        roc_panic("session mixer: can't resize worker array");
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_mixer.h
+//! @brief Receiver session mixer.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_MIXER_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_MIXER_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/slice.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver session mixer.
+//!
+//! Reads frames from inputs in parallel, using a pool of worker threads,
+//! and then mixes them using audio::Mixer.
+//!
+//! When a frame is requested, inputs are divided between the caller thread
+//! and workers, each thread reads its inputs into per-input buffers, and the
+//! caller waits until all threads finish. Thus, frames are still produced only
+//! when requested by the caller, but the wall-clock time of a frame doesn't
+//! grow linearly with the number of inputs.
+//!
+//! If there is only one input, it reads directly into the caller's frame,
+//! without worker threads and intermediate buffers.
+//!
+//! Inputs should be independent from each other, and should not be added or
+//! removed concurrently with reading.
+class ReceiverSessionMixer : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p num_threads defines number of worker threads, in addition
+    //! to the caller thread.
+    ReceiverSessionMixer(audio::FrameFactory& frame_factory,
+                         const audio::SampleSpec& sample_spec,
+                         size_t num_threads,
+                         core::IArena& arena);
+
+    //! Stop worker threads.
+    ~ReceiverSessionMixer();
+
+    //! Check if the mixer was succefully constructed.
+    bool is_valid() const;
+
+    //! Add input reader.
+    //! @returns
+    //!  false if there is not enough memory for input buffer.
+    ROC_ATTR_NODISCARD bool add_input(audio::IFrameReader& reader);
+
+    //! Remove input reader.
+    void remove_input(audio::IFrameReader& reader);
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Reads samples from every input reader in parallel, mixes them,
+    //!  and fills @p frame with the result.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    // Holds frame read from input until it's mixed.
+    class Input : public audio::IFrameReader {
+    public:
+        Input(audio::IFrameReader& reader, const core::Slice<audio::sample_t>& buffer);
+
+        audio::IFrameReader& reader();
+
+        void fetch(size_t n_samples);
+
+        virtual bool read(audio::Frame& frame);
+
+    private:
+        audio::IFrameReader& reader_;
+        core::Slice<audio::sample_t> buffer_;
+
+        size_t size_;
+        bool has_frame_;
+        unsigned flags_;
+        core::nanoseconds_t capture_ts_;
+    };
+
+    class Worker : public core::Thread {
+    public:
+        Worker(ReceiverSessionMixer& mixer, size_t index);
+
+        void wake_up();
+
+    private:
+        virtual void run();
+
+        ReceiverSessionMixer& mixer_;
+        const size_t index_;
+        core::Semaphore sem_;
+    };
+
+    bool read_single_(audio::Frame& frame);
+
+    void fetch_inputs_(size_t n_samples);
+    void fetch_stride_(size_t index);
+    void stop_workers_();
+
+    audio::FrameFactory& frame_factory_;
+    core::IArena& arena_;
+
+    const audio::SampleSpec sample_spec_;
+
+    audio::Mixer mixer_;
+
+    core::Array<Input*> inputs_;
+    core::Array<Worker*> workers_;
+
+    // Written by caller before waking up workers, zero asks workers to exit.
+    size_t fetch_size_;
+    core::Semaphore done_sem_;
+
+    size_t max_read_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_MIXER_H_
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_shard.h"
+#include "roc_audio/copy_counter.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+// At most one frame request is in flight, plus exit request.
+const size_t MaxRequests = 2;
+
+} // namespace
+
+ReceiverShard::ReceiverShard(const ReceiverSourceConfig& source_config,
+                             StateTracker& state_tracker,
+                             const rtp::EncodingMap& encoding_map,
+                             packet::PacketFactory& packet_factory,
+                             audio::FrameFactory& frame_factory,
+                             core::IArena& arena)
+    : core::RefCounted<ReceiverShard, core::ArenaAllocation>(arena)
+    , source_config_(source_config)
+    , encoding_map_(encoding_map)
+    , packet_factory_(packet_factory)
+    , frame_factory_(frame_factory)
+    , arena_(arena)
+    , state_tracker_(state_tracker)
+    , mixer_(frame_factory, source_config.common.output_sample_spec, true)
+    , requests_(arena, MaxRequests)
+    , results_(arena, MaxRequests)
+    , pending_size_(0)
+    , in_flight_(false)
+    , valid_(false) {
+    if (!mixer_.is_valid() || !requests_.is_valid() || !results_.is_valid()) {
+        return;
+    }
+
+    buffer_ = frame_factory.new_raw_buffer();
+    if (!buffer_) {
+        roc_log(LogError, "receiver shard: can't allocate frame buffer");
+        return;
+    }
+    buffer_.reslice(0, buffer_.capacity());
+
+    if (!start()) {
+        roc_log(LogError, "receiver shard: can't start worker thread");
+        return;
+    }
+
+    valid_ = true;
+}
+
+ReceiverShard::~ReceiverShard() {
+    stop_();
+}
+
+bool ReceiverShard::is_valid() const {
+    return valid_;
+}
+
+ReceiverSlot* ReceiverShard::create_slot(const ReceiverSlotConfig& slot_config) {
+    roc_panic_if(!is_valid());
+
+    core::SharedPtr<ReceiverSlot> slot =
+        new (arena_) ReceiverSlot(source_config_, slot_config, state_tracker_, mixer_,
+                                  encoding_map_, packet_factory_, frame_factory_, arena_);
+
+    if (!slot || !slot->is_valid()) {
+        roc_log(LogError, "receiver shard: can't create slot");
+        return NULL;
+    }
+
+    slots_.push_back(*slot);
+    return slot.get();
+}
+
+void ReceiverShard::delete_slot(ReceiverSlot* slot) {
+    roc_panic_if(!is_valid());
+
+    slots_.remove(*slot);
+}
+
+bool ReceiverShard::has_slot(ReceiverSlot* slot) {
+    return slots_.contains(*slot);
+}
+
+size_t ReceiverShard::num_slots() const {
+    return slots_.size();
+}
+
+core::nanoseconds_t ReceiverShard::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    core::nanoseconds_t next_deadline = 0;
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        const core::nanoseconds_t slot_deadline = slot->refresh(current_time);
+
+        if (slot_deadline != 0) {
+            if (next_deadline == 0) {
+                next_deadline = slot_deadline;
+            } else {
+                next_deadline = std::min(next_deadline, slot_deadline);
+            }
+        }
+    }
+
+    return next_deadline;
+}
+
+void ReceiverShard::reclock(core::nanoseconds_t playback_time) {
+    roc_panic_if(!is_valid());
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->reclock(playback_time);
+    }
+}
+
+size_t ReceiverShard::max_read() const {
+    return buffer_.size();
+}
+
+void ReceiverShard::start_read(size_t n_samples) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if_msg(pending_size_ != 0,
+                     "receiver shard: previous frame was not retrieved");
+
+    roc_panic_if_msg(n_samples == 0 || n_samples > buffer_.size(),
+                     "receiver shard: invalid frame size: size=%lu max=%lu",
+                     (unsigned long)n_samples, (unsigned long)buffer_.size());
+
+    pending_size_ = n_samples;
+
+    // Shard without slots produces silence, no need to wake up worker.
+    in_flight_ = !slots_.is_empty();
+    if (!in_flight_) {
+        return;
+    }
+
+    if (!requests_.push_back(n_samples)) {
+        roc_panic("receiver shard: request ring overflow");
+    }
+    request_sem_.post();
+}
+
+bool ReceiverShard::read(audio::Frame& frame) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if_msg(frame.num_raw_samples() != pending_size_,
+                     "receiver shard: unexpected frame size: requested=%lu got=%lu",
+                     (unsigned long)pending_size_,
+                     (unsigned long)frame.num_raw_samples());
+
+    pending_size_ = 0;
+
+    Result result;
+
+    if (in_flight_) {
+        in_flight_ = false;
+
+        result_sem_.wait();
+
+        if (!results_.pop_front(result)) {
+            roc_panic("receiver shard: result ring underflow");
+        }
+
+        memcpy(frame.raw_samples(), buffer_.data(),
+               frame.num_raw_samples() * sizeof(audio::sample_t));
+
+        audio::CopyCounter::instance().add(audio::CopyStage_Shard,
+                                           frame.num_raw_samples());
+    } else {
+        memset(frame.raw_samples(), 0, frame.num_raw_samples() * sizeof(audio::sample_t));
+    }
+
+    frame.set_flags(result.flags);
+    frame.set_duration(packet::stream_timestamp_t(
+        frame.num_raw_samples()
+        / source_config_.common.output_sample_spec.num_channels()));
+    frame.set_capture_timestamp(result.capture_ts);
+
+    return true;
+}
+
+void ReceiverShard::run() {
+    roc_log(LogDebug, "receiver shard: starting worker thread");
+
+    for (;;) {
+        request_sem_.wait();
+
+        size_t n_samples = 0;
+        if (!requests_.pop_front(n_samples)) {
+            roc_panic("receiver shard: request ring underflow");
+        }
+
+        if (n_samples == 0) {
+            break;
+        }
+
+        audio::Frame frame(buffer_.data(), n_samples);
+        mixer_.read(frame);
+
+        Result result;
+        result.flags = frame.flags();
+        result.capture_ts = frame.capture_timestamp();
+
+        if (!results_.push_back(result)) {
+            roc_panic("receiver shard: result ring overflow");
+        }
+        result_sem_.post();
+    }
+
+    roc_log(LogDebug, "receiver shard: exiting worker thread");
+}
+
+void ReceiverShard::stop_() {
+    if (!is_joinable()) {
+        return;
+    }
+
+    roc_panic_if_msg(in_flight_,
+                     "receiver shard: stopping while frame is in progress");
+
+    if (!requests_.push_back(0)) {
+        roc_panic("receiver shard: request ring overflow");
+    }
+    request_sem_.post();
+
+    join();
+}
+
+} // namespace pipeline
+} // namespace roc
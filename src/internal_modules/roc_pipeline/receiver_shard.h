@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_shard.h
+//! @brief Receiver shard.
+
+#ifndef ROC_PIPELINE_RECEIVER_SHARD_H_
+#define ROC_PIPELINE_RECEIVER_SHARD_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/slice.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/thread.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/receiver_slot.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver shard.
+//!
+//! Contains:
+//!  - one or more receiver slots
+//!  - mixer, to mix audio from slots of the shard
+//!  - worker thread, to read frames from the mixer
+//!
+//! Slots are created, refreshed, and reclocked on the caller thread, while
+//! frames are produced on the worker thread. Caller requests a frame using
+//! start_read(), and then retrieves it using read(), which blocks until the
+//! worker finishes. Between these two calls, caller should not touch slots
+//! of the shard.
+//!
+//! Requests and results are passed through lock-free SPSC rings, and semaphores
+//! are used only to sleep and wake up.
+class ReceiverShard : public core::RefCounted<ReceiverShard, core::ArenaAllocation>,
+                      public audio::IFrameReader,
+                      private core::Thread {
+public:
+    //! Initialize.
+    ReceiverShard(const ReceiverSourceConfig& source_config,
+                  StateTracker& state_tracker,
+                  const rtp::EncodingMap& encoding_map,
+                  packet::PacketFactory& packet_factory,
+                  audio::FrameFactory& frame_factory,
+                  core::IArena& arena);
+
+    //! Stop worker thread.
+    ~ReceiverShard();
+
+    //! Check if the shard was successfully constructed.
+    bool is_valid() const;
+
+    //! Create slot.
+    ReceiverSlot* create_slot(const ReceiverSlotConfig& slot_config);
+
+    //! Delete slot.
+    void delete_slot(ReceiverSlot* slot);
+
+    //! Check if slot belongs to this shard.
+    bool has_slot(ReceiverSlot* slot);
+
+    //! Get number of slots.
+    size_t num_slots() const;
+
+    //! Pull packets and refresh slots according to current time.
+    //! @returns
+    //!  deadline (absolute time) when refresh should be invoked again
+    //!  if there are no frames
+    core::nanoseconds_t refresh(core::nanoseconds_t current_time);
+
+    //! Adjust sessions clock to match consumer clock.
+    void reclock(core::nanoseconds_t playback_time);
+
+    //! Get maximum number of samples that can be requested at once.
+    size_t max_read() const;
+
+    //! Ask worker thread to start reading frame of given size.
+    //! @remarks
+    //!  Frame should be then retrieved using read().
+    void start_read(size_t n_samples);
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Waits until worker thread finishes frame requested by start_read().
+    //!  Frame size should be the same as passed to start_read().
+    virtual bool read(audio::Frame& frame);
+
+private:
+    struct Result {
+        unsigned flags;
+        core::nanoseconds_t capture_ts;
+
+        Result()
+            : flags(0)
+            , capture_ts(0) {
+        }
+    };
+
+    virtual void run();
+
+    void stop_();
+
+    const ReceiverSourceConfig& source_config_;
+
+    const rtp::EncodingMap& encoding_map_;
+
+    packet::PacketFactory& packet_factory_;
+    audio::FrameFactory& frame_factory_;
+    core::IArena& arena_;
+
+    StateTracker& state_tracker_;
+
+    audio::Mixer mixer_;
+    core::List<ReceiverSlot> slots_;
+
+    core::Slice<audio::sample_t> buffer_;
+
+    // Requested frame sizes, zero asks worker to exit.
+    core::SpscRingBuffer<size_t> requests_;
+    core::SpscRingBuffer<Result> results_;
+
+    core::Semaphore request_sem_;
+    core::Semaphore result_sem_;
+
+    // Size of frame requested by caller and not retrieved yet.
+    size_t pending_size_;
+    // Whether worker thread is producing requested frame.
+    bool in_flight_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SHARD_H_
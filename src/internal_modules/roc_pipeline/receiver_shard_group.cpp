@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_shard_group.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverShardGroup::ReceiverShardGroup(const ReceiverSourceConfig& source_config,
+                                       StateTracker& state_tracker,
+                                       const rtp::EncodingMap& encoding_map,
+                                       packet::PacketFactory& packet_factory,
+                                       audio::FrameFactory& frame_factory,
+                                       core::IArena& arena)
+    : sample_spec_(source_config.common.output_sample_spec)
+    , mixer_(frame_factory, source_config.common.output_sample_spec, true)
+    , shards_(arena)
+    , max_read_(0)
+    , valid_(false) {
+    if (!mixer_.is_valid()) {
+        return;
+    }
+
+    roc_panic_if_msg(source_config.num_shards == 0,
+                     "receiver shard group: number of shards should be positive");
+
+    roc_log(LogDebug, "receiver shard group: initializing: num_shards=%lu",
+            (unsigned long)source_config.num_shards);
+
+    if (!shards_.grow(source_config.num_shards)) {
+        roc_log(LogError, "receiver shard group: can't allocate shard array");
+        return;
+    }
+
+    for (size_t n = 0; n < source_config.num_shards; n++) {
+        core::SharedPtr<ReceiverShard> shard =
+            new (arena) ReceiverShard(source_config, state_tracker, encoding_map,
+                                      packet_factory, frame_factory, arena);
+
+        if (!shard || !shard->is_valid()) {
+            roc_log(LogError, "receiver shard group: can't create shard");
+            return;
+        }
+
+        if (!shards_.push_back(shard)) {
+            roc_log(LogError, "receiver shard group: can't add shard");
+            return;
+        }
+
+        mixer_.add_input(*shard);
+
+        if (max_read_ == 0 || max_read_ > shard->max_read()) {
+            max_read_ = shard->max_read();
+        }
+    }
+
+    valid_ = true;
+}
+
+ReceiverShardGroup::~ReceiverShardGroup() {
+    for (size_t n = 0; n < shards_.size(); n++) {
+        mixer_.remove_input(*shards_[n]);
+    }
+}
+
+bool ReceiverShardGroup::is_valid() const {
+    return valid_;
+}
+
+size_t ReceiverShardGroup::num_shards() const {
+    return shards_.size();
+}
+
+ReceiverSlot* ReceiverShardGroup::create_slot(const ReceiverSlotConfig& slot_config) {
+    roc_panic_if(!is_valid());
+
+    ReceiverShard* shard = shards_[0].get();
+
+    for (size_t n = 1; n < shards_.size(); n++) {
+        if (shards_[n]->num_slots() < shard->num_slots()) {
+            shard = shards_[n].get();
+        }
+    }
+
+    return shard->create_slot(slot_config);
+}
+
+void ReceiverShardGroup::delete_slot(ReceiverSlot* slot) {
+    roc_panic_if(!is_valid());
+
+    for (size_t n = 0; n < shards_.size(); n++) {
+        if (shards_[n]->has_slot(slot)) {
+            shards_[n]->delete_slot(slot);
+            return;
+        }
+    }
+
+    roc_panic("receiver shard group: slot not found");
+}
+
+core::nanoseconds_t ReceiverShardGroup::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    core::nanoseconds_t next_deadline = 0;
+
+    for (size_t n = 0; n < shards_.size(); n++) {
+        const core::nanoseconds_t shard_deadline = shards_[n]->refresh(current_time);
+
+        if (shard_deadline != 0) {
+            if (next_deadline == 0) {
+                next_deadline = shard_deadline;
+            } else {
+                next_deadline = std::min(next_deadline, shard_deadline);
+            }
+        }
+    }
+
+    return next_deadline;
+}
+
+void ReceiverShardGroup::reclock(core::nanoseconds_t playback_time) {
+    roc_panic_if(!is_valid());
+
+    for (size_t n = 0; n < shards_.size(); n++) {
+        shards_[n]->reclock(playback_time);
+    }
+}
+
+bool ReceiverShardGroup::read(audio::Frame& frame) {
+    roc_panic_if(!is_valid());
+
+    audio::sample_t* samples = frame.raw_samples();
+    size_t n_samples = frame.num_raw_samples();
+
+    unsigned flags = 0;
+    core::nanoseconds_t capture_ts = 0;
+
+    while (n_samples != 0) {
+        // Shards can't produce more than fits into their buffers, so large
+        // frames are split into several rounds.
+        size_t n_read = n_samples;
+        if (n_read > max_read_) {
+            n_read = max_read_;
+        }
+
+        for (size_t n = 0; n < shards_.size(); n++) {
+            shards_[n]->start_read(n_read);
+        }
+
+        // Mixer reads shards one by one, each read waits until corresponding
+        // worker finishes, while other workers keep running.
+        audio::Frame sub_frame(samples, n_read);
+        mixer_.read(sub_frame);
+
+        flags |= sub_frame.flags();
+        if (capture_ts == 0) {
+            capture_ts = sub_frame.capture_timestamp();
+        }
+
+        samples += n_read;
+        n_samples -= n_read;
+    }
+
+    frame.set_flags(flags);
+    frame.set_duration(packet::stream_timestamp_t(frame.num_raw_samples()
+                                                  / sample_spec_.num_channels()));
+    frame.set_capture_timestamp(capture_ts);
+
+    return true;
+}
+
+} // namespace pipeline
+} // namespace roc
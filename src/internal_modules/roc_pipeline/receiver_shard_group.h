@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_shard_group.h
+//! @brief Receiver shard group.
+
+#ifndef ROC_PIPELINE_RECEIVER_SHARD_GROUP_H_
+#define ROC_PIPELINE_RECEIVER_SHARD_GROUP_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/receiver_shard.h"
+#include "roc_pipeline/receiver_slot.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver shard group.
+//!
+//! Contains:
+//!  - one or more receiver shards, each with its own worker thread
+//!  - mixer, to mix audio from all shards
+//!
+//! Slots are distributed between shards, new slot is added to the shard with
+//! the smallest number of slots. When a frame is read, all shards are asked
+//! to start reading, and then their results are mixed. Hence shards produce
+//! their parts of the frame in parallel, and the frame cadence is still
+//! defined by the caller.
+class ReceiverShardGroup : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    ReceiverShardGroup(const ReceiverSourceConfig& source_config,
+                       StateTracker& state_tracker,
+                       const rtp::EncodingMap& encoding_map,
+                       packet::PacketFactory& packet_factory,
+                       audio::FrameFactory& frame_factory,
+                       core::IArena& arena);
+
+    //! Stop shards.
+    ~ReceiverShardGroup();
+
+    //! Check if the group was successfully constructed.
+    bool is_valid() const;
+
+    //! Get number of shards.
+    size_t num_shards() const;
+
+    //! Create slot.
+    ReceiverSlot* create_slot(const ReceiverSlotConfig& slot_config);
+
+    //! Delete slot.
+    void delete_slot(ReceiverSlot* slot);
+
+    //! Pull packets and refresh slots according to current time.
+    //! @returns
+    //!  deadline (absolute time) when refresh should be invoked again
+    //!  if there are no frames
+    core::nanoseconds_t refresh(core::nanoseconds_t current_time);
+
+    //! Adjust sessions clock to match consumer clock.
+    void reclock(core::nanoseconds_t playback_time);
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Reads frame from every shard in parallel and mixes them.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    const audio::SampleSpec sample_spec_;
+
+    audio::Mixer mixer_;
+    core::Array<core::SharedPtr<ReceiverShard> > shards_;
+
+    size_t max_read_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SHARD_GROUP_H_
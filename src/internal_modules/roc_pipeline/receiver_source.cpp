@@ -30,12 +30,22 @@ ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
 
     audio::IFrameReader* frm_reader = NULL;
 
-    mixer_.reset(new (mixer_) audio::Mixer(
-        frame_factory_, source_config.common.output_sample_spec, true));
-    if (!mixer_ || !mixer_->is_valid()) {
-        return;
+    if (source_config_.num_shards > 1) {
+        shard_group_.reset(new (shard_group_) ReceiverShardGroup(
+            source_config_, state_tracker_, encoding_map_, packet_factory_,
+            frame_factory_, arena_));
+        if (!shard_group_ || !shard_group_->is_valid()) {
+            return;
+        }
+        frm_reader = shard_group_.get();
+    } else {
+        mixer_.reset(new (mixer_) audio::Mixer(
+            frame_factory_, source_config.common.output_sample_spec, true));
+        if (!mixer_ || !mixer_->is_valid()) {
+            return;
+        }
+        frm_reader = mixer_.get();
     }
-    frm_reader = mixer_.get();
 
     if (!source_config_.common.output_sample_spec.is_raw()) {
         const audio::SampleSpec in_spec(
@@ -79,6 +89,10 @@ ReceiverSlot* ReceiverSource::create_slot(const ReceiverSlotConfig& slot_config)
 
     roc_log(LogInfo, "receiver source: adding slot");
 
+    if (shard_group_) {
+        return shard_group_->create_slot(slot_config);
+    }
+
     core::SharedPtr<ReceiverSlot> slot =
         new (arena_) ReceiverSlot(source_config_, slot_config, state_tracker_, *mixer_,
                                   encoding_map_, packet_factory_, frame_factory_, arena_);
@@ -97,6 +111,11 @@ void ReceiverSource::delete_slot(ReceiverSlot* slot) {
 
     roc_log(LogInfo, "receiver source: removing slot");
 
+    if (shard_group_) {
+        shard_group_->delete_slot(slot);
+        return;
+    }
+
     slots_.remove(*slot);
 }
 
@@ -112,6 +131,10 @@ core::nanoseconds_t ReceiverSource::refresh(core::nanoseconds_t current_time) {
                      " expected positive value, got %lld",
                      (long long)current_time);
 
+    if (shard_group_) {
+        return shard_group_->refresh(current_time);
+    }
+
     core::nanoseconds_t next_deadline = 0;
 
     for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
@@ -182,6 +205,11 @@ void ReceiverSource::reclock(core::nanoseconds_t playback_time) {
                      " expected positive value, got %lld",
                      (long long)playback_time);
 
+    if (shard_group_) {
+        shard_group_->reclock(playback_time);
+        return;
+    }
+
     for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
          slot = slots_.nextof(*slot)) {
         slot->reclock(playback_time);
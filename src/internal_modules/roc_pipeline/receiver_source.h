@@ -23,6 +23,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
+#include "roc_pipeline/receiver_shard_group.h"
 #include "roc_pipeline/receiver_slot.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtp/encoding_map.h"
@@ -37,6 +38,9 @@ namespace pipeline {
 //!  - one or more receiver slots
 //!  - mixer, to mix audio from all slots
 //!
+//! If sharding is enabled in config, slots are distributed between shards
+//! instead, see ReceiverShardGroup.
+//!
 //! Pipeline:
 //!  - input: packets
 //!  - output: frames
@@ -126,6 +130,7 @@ private:
     StateTracker state_tracker_;
 
     core::Optional<audio::Mixer> mixer_;
+    core::Optional<ReceiverShardGroup> shard_group_;
     core::Optional<audio::ProfilingReader> profiler_;
     core::Optional<audio::PcmMapperReader> pcm_mapper_;
 
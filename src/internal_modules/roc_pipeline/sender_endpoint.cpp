@@ -213,5 +213,24 @@ status::StatusCode SenderEndpoint::write(const packet::PacketPtr& packet) {
     return status::StatusOK;
 }
 
+// Implementation of inbound_writer().write_batch()
+status::StatusCode SenderEndpoint::write_batch(const packet::PacketPtr* packets,
+                                               size_t n_packets) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if(!parser_);
+
+    // Pending counter is updated once per batch, before packets become
+    // visible to pull_packets().
+    state_tracker_.add_pending_packets((int)n_packets);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        roc_panic_if(!packets[n]);
+        inbound_queue_.push_back(*packets[n]);
+    }
+
+    return status::StatusOK;
+}
+
 } // namespace pipeline
 } // namespace roc
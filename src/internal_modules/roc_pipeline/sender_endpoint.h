@@ -95,6 +95,8 @@ public:
 
 private:
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    write_batch(const packet::PacketPtr* packets, size_t n_packets);
 
     const address::Protocol proto_;
 
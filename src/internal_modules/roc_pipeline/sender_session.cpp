@@ -73,7 +73,18 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
                                 packet::Packet::FlagRepair)) {
             return false;
         }
+    }
+
+    if (sink_config_.enable_pacing) {
+        pacer_.reset(new (pacer_) packet::Pacer(*pkt_writer, sink_config_.pacer,
+                                                pkt_encoding->sample_spec, arena_));
+        if (!pacer_ || !pacer_->is_valid()) {
+            return false;
+        }
+        pkt_writer = pacer_.get();
+    }
 
+    if (repair_endpoint) {
         if (sink_config_.enable_interleaving) {
             interleaver_.reset(new (interleaver_) packet::Interleaver(
                 *pkt_writer, arena_,
@@ -100,6 +111,15 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         pkt_writer = fec_writer_.get();
+
+        if (sink_config_.enable_adaptive_fec) {
+            fec_tuner_.reset(new (fec_tuner_) fec::BlockTuner(
+                sink_config_.fec_tuner, sink_config_.fec_writer, *fec_writer_,
+                fec_encoder_->max_block_length()));
+            if (!fec_tuner_ || !fec_tuner_->is_valid()) {
+                return false;
+            }
+        }
     }
 
     timestamp_extractor_.reset(new (timestamp_extractor_) rtp::TimestampExtractor(
@@ -268,6 +288,17 @@ void SenderSession::get_slot_metrics(SenderSlotMetrics& slot_metrics) const {
     slot_metrics.num_participants =
         feedback_monitor_ ? feedback_monitor_->num_participants() : 0;
     slot_metrics.is_complete = (frame_writer_ != NULL);
+
+    if (fec_tuner_) {
+        slot_metrics.fec = fec_tuner_->metrics();
+    } else if (fec_writer_) {
+        slot_metrics.fec.n_source_packets = sink_config_.fec_writer.n_source_packets;
+        slot_metrics.fec.n_repair_packets = sink_config_.fec_writer.n_repair_packets;
+    }
+
+    if (pacer_) {
+        slot_metrics.pacer = pacer_->metrics();
+    }
 }
 
 void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metrics,
@@ -344,6 +375,14 @@ SenderSession::notify_send_stream(packet::stream_source_t recv_source_id,
 
         feedback_monitor_->process_feedback(recv_source_id, latency_metrics,
                                             link_metrics);
+
+        // Feedback monitor is started only if there is a single receiver,
+        // so all reports come from the same stream and can be used to
+        // estimate loss since previous report.
+        if (fec_tuner_ && recv_report.packet_count != 0) {
+            fec_tuner_->update_loss(fec_loss_estimator_.update(recv_report.packet_count,
+                                                               recv_report.cum_loss));
+        }
     }
 
     return status::StatusOK;
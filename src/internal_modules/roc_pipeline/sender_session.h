@@ -24,9 +24,11 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/iblock_encoder.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/interleaver.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
 #include "roc_pipeline/config.h"
@@ -35,6 +37,7 @@
 #include "roc_rtcp/communicator.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/iparticipant.h"
+#include "roc_rtcp/loss_estimator.h"
 #include "roc_rtp/encoding_map.h"
 #include "roc_rtp/identity.h"
 #include "roc_rtp/sequencer.h"
@@ -137,10 +140,14 @@ private:
 
     core::Optional<packet::Router> router_;
 
+    core::Optional<packet::Pacer> pacer_;
+
     core::Optional<packet::Interleaver> interleaver_;
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::Writer> fec_writer_;
+    core::Optional<fec::BlockTuner> fec_tuner_;
+    rtcp::LossEstimator fec_loss_estimator_;
 
     core::Optional<rtp::TimestampExtractor> timestamp_extractor_;
 
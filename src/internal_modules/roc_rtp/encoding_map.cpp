@@ -12,6 +12,11 @@
 #include "roc_audio/sample_format.h"
 #include "roc_core/panic.h"
 
+#ifdef ROC_TARGET_OPUS
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#endif // ROC_TARGET_OPUS
+
 namespace roc {
 namespace rtp {
 
@@ -38,6 +43,22 @@ EncodingMap::EncodingMap(core::IArena& arena)
 
         add_builtin_(enc);
     }
+#ifdef ROC_TARGET_OPUS
+    {
+        Encoding enc;
+        enc.payload_type = PayloadType_Opus_Stereo;
+        enc.sample_spec.set_sample_rate(48000);
+        enc.sample_spec.set_sample_format(audio::SampleFormat_Opus);
+        enc.sample_spec.set_channel_set(
+            audio::ChannelSet(audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                              audio::ChanMask_Surround_Stereo));
+        enc.packet_flags = packet::Packet::FlagAudio;
+        enc.new_encoder = &audio::OpusEncoder::construct;
+        enc.new_decoder = &audio::OpusDecoder::construct;
+
+        add_builtin_(enc);
+    }
+#endif // ROC_TARGET_OPUS
 }
 
 const Encoding* EncodingMap::find_by_pt(unsigned int pt) const {
@@ -126,6 +147,17 @@ void EncodingMap::find_codecs_(Encoding& enc) {
         }
         break;
 
+    case audio::SampleFormat_Opus:
+#ifdef ROC_TARGET_OPUS
+        if (!enc.new_encoder) {
+            enc.new_encoder = &audio::OpusEncoder::construct;
+        }
+        if (!enc.new_decoder) {
+            enc.new_decoder = &audio::OpusDecoder::construct;
+        }
+#endif // ROC_TARGET_OPUS
+        break;
+
     case audio::SampleFormat_Invalid:
         break;
     }
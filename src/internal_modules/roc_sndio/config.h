@@ -36,10 +36,18 @@ struct Config {
     //! Requested input or output latency.
     core::nanoseconds_t latency;
 
+    //! Allow memory-mapped file sinks.
+    //! @remarks
+    //!  Memory-mapped sinks are faster, but grow output file in large chunks,
+    //!  so they're intended for bounded output, like offline transcoding.
+    //!  By default, buffered sinks are used, which suit unbounded recording.
+    bool enable_mmap_sink;
+
     //! Initialize.
     Config()
         : frame_length(DefaultFrameLength)
-        , latency(0) {
+        , latency(0)
+        , enable_mmap_sink(false) {
     }
 };
 
@@ -8,6 +8,7 @@
 
 #include "roc_sndio/pump.h"
 #include "roc_core/log.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace sndio {
@@ -144,7 +145,10 @@ bool Pump::transfer_frame_(ISource& current_source) {
 
     // if sink has clock, here we block on it
     // note that either source or sink has clock, but not both
-    sink_.write(frame);
+    {
+        core::TraceScope trace("sink_write");
+        sink_.write(frame);
+    }
 
     {
         // tell source what is playback time of first sample of last read frame
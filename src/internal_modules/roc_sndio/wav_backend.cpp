@@ -10,6 +10,8 @@
 
 #include "roc_sndio/wav_backend.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_sndio/wav_mmap_sink.h"
+#include "roc_sndio/wav_mmap_source.h"
 #include "roc_sndio/wav_sink.h"
 #include "roc_sndio/wav_source.h"
 
@@ -27,6 +29,38 @@ bool has_suffix(const char* str, const char* suffix) {
     return strncmp(str + len_str - len_suffix, suffix, len_suffix) == 0;
 }
 
+// Memory-mapped devices are faster, but work only with regular files
+// and a subset of WAV encodings. Other cases are handled by dr_wav.
+template <class MmapDevice, class Device>
+IDevice* open_wav_device(const char* path,
+                         const Config& config,
+                         bool try_mmap,
+                         core::IArena& arena) {
+    if (try_mmap && strcmp(path, "-") != 0) {
+        core::ScopedPtr<MmapDevice> mmap_device(new (arena) MmapDevice(arena, config),
+                                                arena);
+        if (mmap_device && mmap_device->is_valid() && mmap_device->open(path)) {
+            return mmap_device.release();
+        }
+
+        roc_log(LogDebug, "wav backend: can't map file, falling back to stdio: path=%s",
+                path);
+    }
+
+    core::ScopedPtr<Device> device(new (arena) Device(arena, config), arena);
+    if (!device || !device->is_valid()) {
+        roc_log(LogDebug, "wav backend: can't construct device: path=%s", path);
+        return NULL;
+    }
+
+    if (!device->open(path)) {
+        roc_log(LogDebug, "wav backend: open failed: path=%s", path);
+        return NULL;
+    }
+
+    return device.release();
+}
+
 } // namespace
 
 WavBackend::WavBackend() {
@@ -60,35 +94,12 @@ IDevice* WavBackend::open_device(DeviceType device_type,
     }
 
     switch (device_type) {
-    case DeviceType_Sink: {
-        core::ScopedPtr<WavSink> sink(new (arena) WavSink(arena, config), arena);
-        if (!sink || !sink->is_valid()) {
-            roc_log(LogDebug, "wav backend: can't construct sink: path=%s", path);
-            return NULL;
-        }
-
-        if (!sink->open(path)) {
-            roc_log(LogDebug, "wav backend: open failed: path=%s", path);
-            return NULL;
-        }
-
-        return sink.release();
-    } break;
-
-    case DeviceType_Source: {
-        core::ScopedPtr<WavSource> source(new (arena) WavSource(arena, config), arena);
-        if (!source || !source->is_valid()) {
-            roc_log(LogDebug, "wav backend: can't construct source: path=%s", path);
-            return NULL;
-        }
-
-        if (!source->open(path)) {
-            roc_log(LogDebug, "wav backend: open failed: path=%s", path);
-            return NULL;
-        }
+    case DeviceType_Sink:
+        return open_wav_device<WavMmapSink, WavSink>(path, config,
+                                                     config.enable_mmap_sink, arena);
 
-        return source.release();
-    } break;
+    case DeviceType_Source:
+        return open_wav_device<WavMmapSource, WavSource>(path, config, true, arena);
 
     default:
         break;
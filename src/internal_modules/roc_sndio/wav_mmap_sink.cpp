@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/wav_mmap_sink.h"
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/sample_format.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Initial size of output file, grown twice when exhausted.
+const size_t InitialFileSize = 64 * 1024;
+
+} // namespace
+
+WavMmapSink::WavMmapSink(core::IArena& arena, const Config& config)
+    : data_pos_(0)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "wav mmap sink: setting io latency not supported");
+        return;
+    }
+
+    sample_spec_ = config.sample_spec;
+
+    sample_spec_.use_defaults(audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                              audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo,
+                              44100);
+
+    if (!sample_spec_.is_raw()) {
+        roc_log(LogError, "wav mmap sink: sample format can be only \"-\" or \"%s\"",
+                audio::pcm_format_to_str(audio::Sample_RawFormat));
+        return;
+    }
+
+    header_.reset(new (header_)
+                      WavHeader(sample_spec_.num_channels(), sample_spec_.sample_rate(),
+                                sizeof(audio::sample_t) * 8));
+
+    valid_ = true;
+}
+
+WavMmapSink::~WavMmapSink() {
+    close_();
+}
+
+bool WavMmapSink::is_valid() const {
+    return valid_;
+}
+
+bool WavMmapSink::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        return false;
+    }
+
+    return true;
+}
+
+ISink* WavMmapSink::to_sink() {
+    return this;
+}
+
+ISource* WavMmapSink::to_source() {
+    return NULL;
+}
+
+DeviceType WavMmapSink::type() const {
+    return DeviceType_Sink;
+}
+
+DeviceState WavMmapSink::state() const {
+    return DeviceState_Active;
+}
+
+void WavMmapSink::pause() {
+    // no-op
+}
+
+bool WavMmapSink::resume() {
+    return true;
+}
+
+bool WavMmapSink::restart() {
+    return true;
+}
+
+audio::SampleSpec WavMmapSink::sample_spec() const {
+    if (!file_.is_opened()) {
+        roc_panic("wav mmap sink: not opened");
+    }
+
+    return sample_spec_;
+}
+
+core::nanoseconds_t WavMmapSink::latency() const {
+    return 0;
+}
+
+bool WavMmapSink::has_latency() const {
+    return false;
+}
+
+bool WavMmapSink::has_clock() const {
+    return false;
+}
+
+void WavMmapSink::write(audio::Frame& frame) {
+    if (!file_.is_opened()) {
+        roc_panic("wav mmap sink: not opened");
+    }
+
+    const size_t n_samples = frame.num_raw_samples();
+    if (n_samples == 0) {
+        return;
+    }
+
+    const size_t n_bytes = n_samples * sizeof(audio::sample_t);
+
+    if (!grow_(data_pos_ + n_bytes)) {
+        roc_log(LogError, "wav mmap sink: failed to write samples");
+        return;
+    }
+
+    memcpy(file_.data() + data_pos_, frame.raw_samples(), n_bytes);
+    data_pos_ += n_bytes;
+
+    const WavHeader::WavHeaderData& wav_header = header_->update_and_get_header(
+        uint32_t(n_samples / sample_spec_.num_channels()));
+    memcpy(file_.data(), &wav_header, sizeof(wav_header));
+}
+
+bool WavMmapSink::open_(const char* path) {
+    if (file_.is_opened()) {
+        roc_panic("wav mmap sink: already opened");
+    }
+
+    if (!file_.open(path, core::MappedFile::ReadWrite)) {
+        roc_log(LogDebug, "wav mmap sink: can't map output file: path=%s", path);
+        return false;
+    }
+
+    if (!grow_(InitialFileSize)) {
+        close_();
+        return false;
+    }
+
+    header_->reset_sample_counter(0);
+
+    const WavHeader::WavHeaderData& wav_header = header_->update_and_get_header(0);
+    memcpy(file_.data(), &wav_header, sizeof(wav_header));
+
+    data_pos_ = sizeof(wav_header);
+
+    roc_log(LogInfo,
+            "wav mmap sink: opened output file:"
+            " path=%s out_bits=%lu out_rate=%lu out_ch=%lu",
+            path, (unsigned long)header_->bits_per_sample(),
+            (unsigned long)header_->sample_rate(),
+            (unsigned long)header_->num_channels());
+
+    return true;
+}
+
+bool WavMmapSink::grow_(size_t size) {
+    if (size <= file_.size()) {
+        return true;
+    }
+
+    size_t new_size = file_.size() != 0 ? file_.size() : InitialFileSize;
+    while (new_size < size) {
+        new_size *= 2;
+    }
+
+    roc_log(LogTrace, "wav mmap sink: growing output file: old_size=%lu new_size=%lu",
+            (unsigned long)file_.size(), (unsigned long)new_size);
+
+    if (!file_.resize(new_size)) {
+        roc_log(LogError, "wav mmap sink: can't grow output file: size=%lu",
+                (unsigned long)new_size);
+        return false;
+    }
+
+    return true;
+}
+
+void WavMmapSink::close_() {
+    if (!file_.is_opened()) {
+        return;
+    }
+
+    roc_log(LogDebug, "wav mmap sink: closing output file");
+
+    // Cut off unused space reserved by grow_().
+    if (data_pos_ != 0 && !file_.resize(data_pos_)) {
+        roc_log(LogError, "wav mmap sink: can't truncate output file");
+    }
+
+    if (!file_.close()) {
+        roc_panic("wav mmap sink: can't close output file");
+    }
+
+    data_pos_ = 0;
+}
+
+} // namespace sndio
+} // namespace roc
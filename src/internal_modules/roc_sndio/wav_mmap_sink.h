@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/wav_mmap_sink.h
+//! @brief Memory-mapped WAV sink.
+
+#ifndef ROC_SNDIO_WAV_MMAP_SINK_H_
+#define ROC_SNDIO_WAV_MMAP_SINK_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mapped_file.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isink.h"
+
+#include "wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV sink.
+//! @remarks
+//!  Writes samples to output file mapped into memory. File is grown
+//!  geometrically, so that it's remapped only a few times, and is truncated
+//!  to actual size when sink is closed. Header is kept up to date after
+//!  every frame, so that the file is readable even if it wasn't closed.
+class WavMmapSink : public ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    WavMmapSink(core::IArena& arena, const Config& config);
+
+    virtual ~WavMmapSink();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open output file.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+private:
+    bool open_(const char* path);
+    bool grow_(size_t size);
+    void close_();
+
+    audio::SampleSpec sample_spec_;
+
+    core::MappedFile file_;
+    core::Optional<WavHeader> header_;
+
+    size_t data_pos_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_WAV_MMAP_SINK_H_
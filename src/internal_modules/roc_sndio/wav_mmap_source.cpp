@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/wav_mmap_source.h"
+#include "roc_audio/sample.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    WavFormat_Pcm = 0x1,
+    WavFormat_IeeeFloat = 0x3,
+    WavFormat_Extensible = 0xFFFE
+};
+
+enum {
+    RiffHeaderSize = 12,
+    ChunkHeaderSize = 8,
+    FmtChunkSize = 16,
+    FmtExtensibleChunkSize = 40,
+    FmtSubFormatOffset = 24
+};
+
+uint16_t read_le16(const uint8_t* p) {
+    return uint16_t(p[0] | (p[1] << 8));
+}
+
+uint32_t read_le32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+        | (uint32_t(p[3]) << 24);
+}
+
+audio::PcmFormat wav_pcm_format(uint16_t format_tag, uint16_t bits) {
+    if (format_tag == WavFormat_Pcm) {
+        switch (bits) {
+        case 8:
+            return audio::PcmFormat_UInt8;
+        case 16:
+            return audio::PcmFormat_SInt16_Le;
+        case 24:
+            return audio::PcmFormat_SInt24_Le;
+        case 32:
+            return audio::PcmFormat_SInt32_Le;
+        default:
+            break;
+        }
+    }
+
+    if (format_tag == WavFormat_IeeeFloat) {
+        switch (bits) {
+        case 32:
+            return audio::PcmFormat_Float32_Le;
+        case 64:
+            return audio::PcmFormat_Float64_Le;
+        default:
+            break;
+        }
+    }
+
+    return audio::PcmFormat_Invalid;
+}
+
+} // namespace
+
+WavMmapSource::WavMmapSource(core::IArena& arena, const Config& config)
+    : in_format_(audio::PcmFormat_Invalid)
+    , in_format_is_raw_(false)
+    , in_sample_size_(0)
+    , num_channels_(0)
+    , sample_rate_(0)
+    , data_(NULL)
+    , data_size_(0)
+    , data_pos_(0)
+    , eof_(false)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "wav mmap source: setting io latency not supported");
+        return;
+    }
+
+    if (!config.sample_spec.is_empty()) {
+        roc_log(LogError, "wav mmap source: setting io encoding not supported");
+        return;
+    }
+
+    valid_ = true;
+}
+
+WavMmapSource::~WavMmapSource() {
+    close_();
+}
+
+bool WavMmapSource::is_valid() const {
+    return valid_;
+}
+
+bool WavMmapSource::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        return false;
+    }
+
+    return true;
+}
+
+ISink* WavMmapSource::to_sink() {
+    return NULL;
+}
+
+ISource* WavMmapSource::to_source() {
+    return this;
+}
+
+DeviceType WavMmapSource::type() const {
+    return DeviceType_Source;
+}
+
+DeviceState WavMmapSource::state() const {
+    return DeviceState_Active;
+}
+
+void WavMmapSource::pause() {
+    // no-op
+}
+
+bool WavMmapSource::resume() {
+    return true;
+}
+
+bool WavMmapSource::restart() {
+    if (!file_.is_opened()) {
+        roc_panic("wav mmap source: not opened");
+    }
+
+    roc_log(LogDebug, "wav mmap source: restarting");
+
+    data_pos_ = 0;
+    eof_ = false;
+
+    return true;
+}
+
+audio::SampleSpec WavMmapSource::sample_spec() const {
+    if (!file_.is_opened()) {
+        roc_panic("wav mmap source: not opened");
+    }
+
+    audio::ChannelSet channel_set;
+    channel_set.set_layout(audio::ChanLayout_Surround);
+    channel_set.set_order(audio::ChanOrder_Smpte);
+    channel_set.set_count(num_channels_);
+
+    return audio::SampleSpec(sample_rate_, audio::Sample_RawFormat, channel_set);
+}
+
+core::nanoseconds_t WavMmapSource::latency() const {
+    return 0;
+}
+
+bool WavMmapSource::has_latency() const {
+    return false;
+}
+
+bool WavMmapSource::has_clock() const {
+    return false;
+}
+
+void WavMmapSource::reclock(core::nanoseconds_t timestamp) {
+    // no-op
+}
+
+bool WavMmapSource::read(audio::Frame& frame) {
+    if (!file_.is_opened()) {
+        roc_panic("wav mmap source: not opened");
+    }
+
+    if (eof_) {
+        return false;
+    }
+
+    const size_t frame_samples = frame.num_raw_samples();
+
+    size_t n_samples = (data_size_ - data_pos_) / in_sample_size_;
+    if (n_samples > frame_samples) {
+        n_samples = frame_samples;
+    }
+    n_samples -= n_samples % num_channels_;
+
+    if (n_samples == 0) {
+        roc_log(LogDebug, "wav mmap source: got eof from input file");
+        eof_ = true;
+        return false;
+    }
+
+    if (in_format_is_raw_) {
+        // Samples in file are already in raw format.
+        memcpy(frame.raw_samples(), data_ + data_pos_,
+               n_samples * sizeof(audio::sample_t));
+    } else {
+        size_t in_bit_off = 0;
+        size_t out_bit_off = 0;
+
+        const size_t n_mapped = mapper_->map(
+            data_ + data_pos_, data_size_ - data_pos_, in_bit_off, frame.raw_samples(),
+            frame_samples * sizeof(audio::sample_t), out_bit_off, n_samples);
+
+        roc_panic_if(n_mapped != n_samples);
+    }
+
+    data_pos_ += n_samples * in_sample_size_;
+
+    if (n_samples != frame_samples) {
+        roc_log(LogDebug, "wav mmap source: got eof from input file");
+        eof_ = true;
+
+        memset(frame.raw_samples() + n_samples, 0,
+               (frame_samples - n_samples) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+bool WavMmapSource::open_(const char* path) {
+    if (file_.is_opened()) {
+        roc_panic("wav mmap source: already opened");
+    }
+
+    if (!file_.open(path, core::MappedFile::ReadOnly)) {
+        roc_log(LogDebug, "wav mmap source: can't map input file: path=%s", path);
+        return false;
+    }
+
+    if (!parse_header_()) {
+        roc_log(LogDebug, "wav mmap source: unsupported input file: path=%s", path);
+        close_();
+        return false;
+    }
+
+    in_format_is_raw_ = audio::pcm_format_traits(in_format_).canon_id
+        == audio::pcm_format_traits(audio::Sample_RawFormat).canon_id;
+
+    mapper_.reset(new (mapper_) audio::PcmMapper(in_format_, audio::Sample_RawFormat));
+
+    data_pos_ = 0;
+    eof_ = false;
+
+    roc_log(LogInfo,
+            "wav mmap source: opened input file:"
+            " path=%s in_fmt=%s in_rate=%lu in_ch=%lu data_size=%lu",
+            path, audio::pcm_format_to_str(in_format_), (unsigned long)sample_rate_,
+            (unsigned long)num_channels_, (unsigned long)data_size_);
+
+    return true;
+}
+
+bool WavMmapSource::parse_header_() {
+    const uint8_t* buf = file_.data();
+    const size_t buf_size = file_.size();
+
+    if (buf_size < RiffHeaderSize || memcmp(buf, "RIFF", 4) != 0
+        || memcmp(buf + 8, "WAVE", 4) != 0) {
+        roc_log(LogDebug, "wav mmap source: missing riff header");
+        return false;
+    }
+
+    bool has_fmt = false;
+    uint16_t block_align = 0;
+    uint16_t bits = 0;
+
+    size_t off = RiffHeaderSize;
+
+    while (buf_size - off >= ChunkHeaderSize) {
+        const uint8_t* chunk = buf + off;
+        size_t chunk_size = read_le32(chunk + 4);
+
+        off += ChunkHeaderSize;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size < FmtChunkSize || buf_size - off < FmtChunkSize) {
+                roc_log(LogDebug, "wav mmap source: truncated fmt chunk");
+                return false;
+            }
+
+            uint16_t format_tag = read_le16(buf + off);
+            num_channels_ = read_le16(buf + off + 2);
+            sample_rate_ = read_le32(buf + off + 4);
+            block_align = read_le16(buf + off + 12);
+            bits = read_le16(buf + off + 14);
+
+            if (format_tag == WavFormat_Extensible && chunk_size >= FmtExtensibleChunkSize
+                && buf_size - off >= FmtExtensibleChunkSize) {
+                // First two bytes of sub-format GUID hold format tag.
+                format_tag = read_le16(buf + off + FmtSubFormatOffset);
+            }
+
+            in_format_ = wav_pcm_format(format_tag, bits);
+            has_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!has_fmt) {
+                roc_log(LogDebug, "wav mmap source: data chunk before fmt chunk");
+                return false;
+            }
+
+            // Size may be bogus if file was not finalized, e.g. after crash.
+            if (chunk_size > buf_size - off) {
+                chunk_size = buf_size - off;
+            }
+
+            data_ = buf + off;
+            data_size_ = chunk_size;
+            break;
+        }
+
+        if (chunk_size > buf_size - off) {
+            break;
+        }
+
+        // Chunks are padded to even size.
+        off += chunk_size + (chunk_size & 1);
+
+        if (off > buf_size) {
+            break;
+        }
+    }
+
+    if (!data_) {
+        roc_log(LogDebug, "wav mmap source: missing data chunk");
+        return false;
+    }
+
+    if (in_format_ == audio::PcmFormat_Invalid) {
+        roc_log(LogDebug, "wav mmap source: unsupported sample format: bits=%lu",
+                (unsigned long)bits);
+        return false;
+    }
+
+    if (num_channels_ == 0 || sample_rate_ == 0
+        || block_align != num_channels_ * (bits / 8u)) {
+        roc_log(LogDebug,
+                "wav mmap source: invalid fmt chunk: ch=%lu rate=%lu block_align=%lu",
+                (unsigned long)num_channels_, (unsigned long)sample_rate_,
+                (unsigned long)block_align);
+        return false;
+    }
+
+    in_sample_size_ = bits / 8u;
+
+    // Drop incomplete trailing frame.
+    data_size_ -= data_size_ % block_align;
+
+    return true;
+}
+
+void WavMmapSource::close_() {
+    if (!file_.is_opened()) {
+        return;
+    }
+
+    data_ = NULL;
+    data_size_ = 0;
+
+    if (!file_.close()) {
+        roc_log(LogError, "wav mmap source: can't close input file");
+    }
+}
+
+} // namespace sndio
+} // namespace roc
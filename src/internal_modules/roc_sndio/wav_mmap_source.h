@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/wav_mmap_source.h
+//! @brief Memory-mapped WAV source.
+
+#ifndef ROC_SNDIO_WAV_MMAP_SOURCE_H_
+#define ROC_SNDIO_WAV_MMAP_SOURCE_H_
+
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mapped_file.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV source.
+//! @remarks
+//!  Maps input file into memory and converts samples directly from the
+//!  data chunk into frames using PcmMapper. If file samples are already
+//!  in raw format, they're just copied.
+//!
+//!  Supports integer PCM and IEEE float WAV files, including
+//!  WAVE_FORMAT_EXTENSIBLE. Other encodings and non-regular files (e.g.
+//!  pipes) are not supported, and open() fails for them.
+class WavMmapSource : public ISource, private core::NonCopyable<> {
+public:
+    //! Initialize.
+    WavMmapSource(core::IArena& arena, const Config& config);
+
+    virtual ~WavMmapSource();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open input file.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    bool open_(const char* path);
+    bool parse_header_();
+    void close_();
+
+    core::MappedFile file_;
+
+    core::Optional<audio::PcmMapper> mapper_;
+    audio::PcmFormat in_format_;
+    bool in_format_is_raw_;
+    size_t in_sample_size_;
+
+    size_t num_channels_;
+    size_t sample_rate_;
+
+    const uint8_t* data_;
+    size_t data_size_;
+    size_t data_pos_;
+
+    bool eof_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_WAV_MMAP_SOURCE_H_
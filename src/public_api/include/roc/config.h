@@ -156,6 +156,7 @@ typedef enum roc_protocol {
      * Audio encodings:
      *   - \ref ROC_PACKET_ENCODING_AVP_L16_MONO
      *   - \ref ROC_PACKET_ENCODING_AVP_L16_STEREO
+     *   - \ref ROC_PACKET_ENCODING_OPUS_STEREO
      *   - encodings registered using roc_context_register_encoding()
      *
      * FEC encodings:
@@ -262,6 +263,22 @@ typedef enum roc_packet_encoding {
      *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
      */
     ROC_PACKET_ENCODING_AVP_L16_STEREO = 10,
+
+    /** Opus, 2 channels, 48000 rate.
+     *
+     * Uses Opus compressed frames (RFC 6716) with constant bitrate and in-band
+     * FEC. Packet duration is rounded down to a frame duration supported by
+     * Opus (2.5, 5, 10, 20, 40, or 60 ms). Receiver uses Opus packet loss
+     * concealment and in-band FEC to restore lost packets.
+     *
+     * Available only if the library was built with Opus support.
+     *
+     * Supported by protocols:
+     *  - \ref ROC_PROTO_RTP
+     *  - \ref ROC_PROTO_RTP_RS8M_SOURCE
+     *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
+     */
+    ROC_PACKET_ENCODING_OPUS_STEREO = 100,
 } roc_packet_encoding;
 
 /** Forward Error Correction encoding.
@@ -577,7 +594,24 @@ typedef enum roc_resampler_backend {
      *
      * Recommended when CPU resources are extremely limited.
      */
-    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3
+    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3,
+
+    /** Fast high-quality and high-precision built-in polyphase resampler.
+     *
+     * This backend precomputes a bank of filter phases for the nominal ratio between
+     * frame and packet sample rates (e.g. 44100 vs 48000), and only interpolates
+     * between adjacent phases to follow small scaling adjustments needed for clock
+     * drift compensation.
+     *
+     * Compared to \c ROC_RESAMPLER_BACKEND_BUILTIN, it provides similar precision
+     * and quality at a fraction of CPU cost, in return for some memory used by the
+     * filter bank. Scaling can't deviate from nominal ratio by more than 10%.
+     *
+     * This backend is always available.
+     *
+     * Recommended when frame and packet sample rates are fixed and CPU usage matters.
+     */
+    ROC_RESAMPLER_BACKEND_POLYPHASE = 4
 } roc_resampler_backend;
 
 /** Resampler profile.
@@ -682,6 +716,15 @@ typedef struct roc_sender_config {
      */
     unsigned int packet_interleaving;
 
+    /** Enable packet pacing.
+     *
+     * If non-zero, the sender spreads packets evenly in time according to
+     * their stream timestamps, instead of sending all packets produced from
+     * a frame at once. This reduces bursts when large frames are written,
+     * but increases latency by up to one frame.
+     */
+    unsigned int packet_pacing;
+
     /** FEC encoding to use.
      *
      * If FEC is enabled, the sender employs a FEC encoding to generate redundant
@@ -721,6 +764,30 @@ typedef struct roc_sender_config {
      */
     unsigned int fec_block_repair_packets;
 
+    /** Enable adaptive FEC block size.
+     * Used if some FEC encoding is selected.
+     *
+     * If non-zero, the sender adjusts number of source and repair packets per block
+     * according to packet loss reported by receiver via \ref ROC_PROTO_RTCP. When loss
+     * grows, repair ratio is increased and block is shortened; when loss goes away,
+     * repair packets are reduced and block is lengthened, to save traffic.
+     *
+     * In this mode, \c fec_block_source_packets and \c fec_block_repair_packets define
+     * initial block size. Adaptation works only with unicast control endpoint.
+     */
+    unsigned int fec_block_adaptation;
+
+    /** Enable FEC repair packet pacing.
+     * Used if some FEC encoding is selected.
+     *
+     * If non-zero, repair packets of a block are not sent all at once after the
+     * last source packet of the block, but are evenly interleaved with source
+     * packets of the next block. This avoids bursts of repair packets and spikes
+     * of encoding time, but repair packets arrive one block later, so receiver
+     * latency should be large enough to cover two blocks.
+     */
+    unsigned int fec_repair_pacing;
+
     /** Clock source to use.
      * Defines whether write operation is blocking or non-blocking.
      *
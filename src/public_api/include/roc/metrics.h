@@ -59,6 +59,86 @@ typedef struct roc_receiver_metrics {
     unsigned int connection_count;
 } roc_receiver_metrics;
 
+/** Extended receiver metrics.
+ *
+ * Holds additional receiver-side metrics that are not specific to connection.
+ * Retrieved using \ref roc_receiver_query_ext() and
+ * \ref roc_receiver_decoder_query_ext().
+ *
+ * Before querying, \c struct_size should be set to \c sizeof(roc_receiver_ext_metrics).
+ * New fields may be appended to this struct in future versions; the library fills
+ * only the fields that fit into \c struct_size, so applications built against older
+ * headers remain compatible with newer library.
+ */
+typedef struct roc_receiver_ext_metrics {
+    /** Size of this struct, in bytes.
+     *
+     * Should be set by the user before querying metrics.
+     */
+    size_t struct_size;
+
+    /** Number of packets in incoming queues.
+     *
+     * Defines how much packets are received but not yet played. Grows when
+     * network delivers packets in bursts or when receiver can't keep up.
+     * Summed over all active connections.
+     */
+    unsigned long long queued_packets;
+
+    /** Number of packets dropped because they were received too late.
+     *
+     * A packet is late if it arrives after receiver already played its
+     * samples (or silence instead of them). Growing value usually means that
+     * target latency is too low for the network.
+     * Accumulated over all connections of the slot, including closed ones.
+     */
+    unsigned long long late_packets;
+
+    /** Number of packets restored using FEC.
+     *
+     * Defines how much lost packets were recovered from repair packets.
+     * If FEC is not used, always zero.
+     * Accumulated over all connections of the slot, including closed ones.
+     */
+    unsigned long long recovered_packets;
+
+    /** Number of samples per channel decoded from packets.
+     *
+     * Accumulated over all connections of the slot, including closed ones.
+     */
+    unsigned long long decoded_samples;
+
+    /** Number of samples per channel replaced with silence.
+     *
+     * Defines how much samples were not played because packets were lost
+     * and not restored, or were late. Together with \c decoded_samples,
+     * allows to compute loss ratio after FEC.
+     * Accumulated over all connections of the slot, including closed ones.
+     */
+    unsigned long long missing_samples;
+
+    /** Number of tasks processed by pipeline.
+     *
+     * Tasks are control operations like adding endpoints and querying
+     * metrics. Pipeline is shared by all slots.
+     */
+    unsigned long long task_count;
+
+    /** Number of tasks processed between frames.
+     *
+     * These tasks were processed by the thread that reads or writes frames,
+     * which delays audio processing.
+     */
+    unsigned long long in_frame_task_count;
+
+    /** Number of task processing preemptions.
+     *
+     * Defines how much times task processing was interrupted because
+     * a frame should be processed.
+     */
+    unsigned long long preemption_count;
+} roc_receiver_ext_metrics;
+
 /** Sender metrics.
  *
  * Holds sender-side metrics that are not specific to connection.
@@ -80,6 +160,85 @@ typedef struct roc_sender_metrics {
     unsigned int connection_count;
 } roc_sender_metrics;
 
+/** Extended sender metrics.
+ *
+ * Holds additional sender-side metrics that are not specific to connection.
+ * Retrieved using \ref roc_sender_query_ext() and \ref roc_sender_encoder_query_ext().
+ *
+ * Before querying, \c struct_size should be set to \c sizeof(roc_sender_ext_metrics).
+ * New fields may be appended to this struct in future versions; the library fills
+ * only the fields that fit into \c struct_size, so applications built against older
+ * headers remain compatible with newer library.
+ */
+typedef struct roc_sender_ext_metrics {
+    /** Size of this struct, in bytes.
+     *
+     * Should be set by the user before querying metrics.
+     */
+    size_t struct_size;
+
+    /** Current number of source packets per FEC block.
+     *
+     * Zero if FEC is disabled. If \c fec_block_adaptation is enabled in
+     * sender config, may change over time.
+     */
+    unsigned int fec_block_source_packets;
+
+    /** Current number of repair packets per FEC block.
+     *
+     * Zero if FEC is disabled. If \c fec_block_adaptation is enabled in
+     * sender config, may change over time.
+     */
+    unsigned int fec_block_repair_packets;
+
+    /** Loss ratio used to select FEC block size.
+     *
+     * Smoothed fraction of packets lost, estimated from receiver reports.
+     * Zero if \c fec_block_adaptation is disabled in sender config.
+     */
+    float fec_loss_ratio;
+
+    /** Average delay added to packets by pacing, in nanoseconds.
+     *
+     * Zero if \c packet_pacing is disabled in sender config.
+     */
+    unsigned long long pacing_delay;
+
+    /** Maximum delay added to packets by pacing, in nanoseconds.
+     *
+     * Zero if \c packet_pacing is disabled in sender config.
+     */
+    unsigned long long pacing_max_delay;
+
+    /** Maximum number of packets produced at once and spread by pacing.
+     *
+     * Defines size of bursts that would be sent without pacing.
+     * Zero if \c packet_pacing is disabled in sender config.
+     */
+    unsigned int pacing_max_burst;
+
+    /** Number of tasks processed by pipeline.
+     *
+     * Tasks are control operations like adding endpoints and querying
+     * metrics. Pipeline is shared by all slots.
+     */
+    unsigned long long task_count;
+
+    /** Number of tasks processed between frames.
+     *
+     * These tasks were processed by the thread that reads or writes frames,
+     * which delays audio processing.
+     */
+    unsigned long long in_frame_task_count;
+
+    /** Number of task processing preemptions.
+     *
+     * Defines how much times task processing was interrupted because
+     * a frame should be processed.
+     */
+    unsigned long long preemption_count;
+} roc_sender_ext_metrics;
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -169,6 +169,29 @@ ROC_API int roc_receiver_decoder_query(roc_receiver_decoder* decoder,
                                        roc_receiver_metrics* decoder_metrics,
                                        roc_connection_metrics* conn_metrics);
 
+/** Query extended decoder metrics.
+ *
+ * Reads extended metrics of the decoder as a whole into provided struct.
+ *
+ * Before the call, \c struct_size field of \p ext_metrics should be set to
+ * \c sizeof(roc_receiver_ext_metrics). The function fills only those fields
+ * that fit into \c struct_size.
+ *
+ * **Parameters**
+ *  - \p decoder should point to an opened decoder
+ *  - \p ext_metrics defines a struct where to write extended metrics
+ *
+ * **Returns**
+ *  - returns zero if the metrics were successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of the provided struct;
+ *    it may be safely deallocated after the function returns
+ */
+ROC_API int roc_receiver_decoder_query_ext(roc_receiver_decoder* decoder,
+                                           roc_receiver_ext_metrics* ext_metrics);
+
 /** Write packet to decoder.
  *
  * Adds encoded packet to the interface queue.
@@ -295,6 +295,32 @@ ROC_API int roc_sender_query(roc_sender* sender,
                              roc_connection_metrics* conn_metrics,
                              size_t* conn_metrics_count);
 
+/** Query extended sender slot metrics.
+ *
+ * Reads extended metrics of the slot as a whole into provided struct.
+ *
+ * Before the call, \c struct_size field of \p ext_metrics should be set to
+ * \c sizeof(roc_sender_ext_metrics). The function fills only those fields
+ * that fit into \c struct_size.
+ *
+ * **Parameters**
+ *  - \p sender should point to an opened sender
+ *  - \p slot specifies the sender slot (if in doubt, use \c ROC_SLOT_DEFAULT)
+ *  - \p ext_metrics defines a struct where to write extended slot metrics
+ *
+ * **Returns**
+ *  - returns zero if the metrics were successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value if the slot does not exist
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of the provided struct;
+ *    it may be safely deallocated after the function returns
+ */
+ROC_API int roc_sender_query_ext(roc_sender* sender,
+                                 roc_slot slot,
+                                 roc_sender_ext_metrics* ext_metrics);
+
 /** Delete sender slot.
  *
  * Disconnects, unbinds, and removes all slot interfaces and removes the slot.
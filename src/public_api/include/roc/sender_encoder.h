@@ -169,6 +169,29 @@ ROC_API int roc_sender_encoder_query(roc_sender_encoder* encoder,
                                      roc_sender_metrics* encoder_metrics,
                                      roc_connection_metrics* conn_metrics);
 
+/** Query extended encoder metrics.
+ *
+ * Reads extended metrics of the encoder as a whole into provided struct.
+ *
+ * Before the call, \c struct_size field of \p ext_metrics should be set to
+ * \c sizeof(roc_sender_ext_metrics). The function fills only those fields
+ * that fit into \c struct_size.
+ *
+ * **Parameters**
+ *  - \p encoder should point to an opened encoder
+ *  - \p ext_metrics defines a struct where to write extended metrics
+ *
+ * **Returns**
+ *  - returns zero if the metrics were successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of the provided struct;
+ *    it may be safely deallocated after the function returns
+ */
+ROC_API int roc_sender_encoder_query_ext(roc_sender_encoder* encoder,
+                                         roc_sender_ext_metrics* ext_metrics);
+
 /** Write frame to encoder.
  *
  * Encodes samples to into network packets and enqueues them to internal queues of
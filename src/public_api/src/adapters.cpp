@@ -107,6 +107,7 @@ bool sender_config_from_user(node::Context& context,
     out.enable_auto_cts = true;
 
     out.enable_interleaving = in.packet_interleaving;
+    out.enable_pacing = in.packet_pacing;
 
     if (!fec_encoding_from_user(out.fec_encoder.scheme, in.fec_encoding)) {
         roc_log(LogError,
@@ -120,6 +121,9 @@ bool sender_config_from_user(node::Context& context,
         out.fec_writer.n_repair_packets = in.fec_block_repair_packets;
     }
 
+    out.enable_adaptive_fec = in.fec_block_adaptation;
+    out.fec_writer.enable_repair_pacing = in.fec_repair_pacing;
+
     if (!clock_source_from_user(out.enable_timing, in.clock_source)) {
         roc_log(LogError,
                 "bad configuration: invalid roc_sender_config.clock_source:"
@@ -448,6 +452,10 @@ bool resampler_backend_from_user(audio::ResamplerBackend& out, roc_resampler_bac
     case ROC_RESAMPLER_BACKEND_SPEEXDEC:
         out = audio::ResamplerBackend_SpeexDec;
         return true;
+
+    case ROC_RESAMPLER_BACKEND_POLYPHASE:
+        out = audio::ResamplerBackend_Polyphase;
+        return true;
     }
 
     return false;
@@ -483,6 +491,10 @@ bool packet_encoding_from_user(unsigned& out_pt, roc_packet_encoding in) {
     case ROC_PACKET_ENCODING_AVP_L16_STEREO:
         out_pt = rtp::PayloadType_L16_Stereo;
         return true;
+
+    case ROC_PACKET_ENCODING_OPUS_STEREO:
+        out_pt = rtp::PayloadType_Opus_Stereo;
+        return true;
     }
 
     out_pt = in;
@@ -614,6 +626,29 @@ void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_met
     out.connection_count = (unsigned)slot_metrics.num_participants;
 }
 
+ROC_ATTR_NO_SANITIZE_UB
+void receiver_slot_ext_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
+                                       void* slot_arg) {
+    roc_receiver_ext_metrics& out = *(roc_receiver_ext_metrics*)slot_arg;
+
+    roc_receiver_ext_metrics ext;
+    memset(&ext, 0, sizeof(ext));
+
+    ext.struct_size = out.struct_size;
+    ext.queued_packets = (unsigned long long)slot_metrics.queued_packets;
+    ext.late_packets = (unsigned long long)slot_metrics.depacketizer.late_packets;
+    ext.recovered_packets = (unsigned long long)slot_metrics.fec.restored_packets;
+    ext.decoded_samples = (unsigned long long)slot_metrics.depacketizer.decoded_samples;
+    ext.missing_samples = (unsigned long long)slot_metrics.depacketizer.missing_samples;
+    ext.task_count = (unsigned long long)slot_metrics.pipeline.task_processed_total;
+    ext.in_frame_task_count =
+        (unsigned long long)slot_metrics.pipeline.task_processed_in_frame;
+    ext.preemption_count = (unsigned long long)slot_metrics.pipeline.preemptions;
+
+    // User may be built against older header with smaller struct.
+    memcpy(&out, &ext, std::min(out.struct_size, sizeof(ext)));
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 void receiver_participant_metrics_to_user(
     const pipeline::ReceiverParticipantMetrics& party_metrics,
@@ -638,6 +673,30 @@ void sender_slot_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics
     out.connection_count = (unsigned)slot_metrics.num_participants;
 }
 
+ROC_ATTR_NO_SANITIZE_UB
+void sender_slot_ext_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics,
+                                     void* slot_arg) {
+    roc_sender_ext_metrics& out = *(roc_sender_ext_metrics*)slot_arg;
+
+    roc_sender_ext_metrics ext;
+    memset(&ext, 0, sizeof(ext));
+
+    ext.struct_size = out.struct_size;
+    ext.fec_block_source_packets = (unsigned)slot_metrics.fec.n_source_packets;
+    ext.fec_block_repair_packets = (unsigned)slot_metrics.fec.n_repair_packets;
+    ext.fec_loss_ratio = slot_metrics.fec.loss_ratio;
+    ext.pacing_delay = (unsigned long long)slot_metrics.pacer.mean_delay;
+    ext.pacing_max_delay = (unsigned long long)slot_metrics.pacer.max_delay;
+    ext.pacing_max_burst = (unsigned)slot_metrics.pacer.max_burst;
+    ext.task_count = (unsigned long long)slot_metrics.pipeline.task_processed_total;
+    ext.in_frame_task_count =
+        (unsigned long long)slot_metrics.pipeline.task_processed_in_frame;
+    ext.preemption_count = (unsigned long long)slot_metrics.pipeline.preemptions;
+
+    // User may be built against older header with smaller struct.
+    memcpy(&out, &ext, std::min(out.struct_size, sizeof(ext)));
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 void sender_participant_metrics_to_user(
     const pipeline::SenderParticipantMetrics& party_metrics,
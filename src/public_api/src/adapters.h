@@ -63,6 +63,8 @@ bool proto_to_user(roc_protocol& out, address::Protocol in);
 
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg);
+void receiver_slot_ext_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
+                                       void* slot_arg);
 void receiver_participant_metrics_to_user(
     const pipeline::ReceiverParticipantMetrics& party_metrics,
     size_t party_index,
@@ -70,6 +72,8 @@ void receiver_participant_metrics_to_user(
 
 void sender_slot_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics,
                                  void* slot_arg);
+void sender_slot_ext_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics,
+                                     void* slot_arg);
 void sender_participant_metrics_to_user(
     const pipeline::SenderParticipantMetrics& party_metrics,
     size_t party_index,
@@ -176,6 +176,40 @@ int roc_receiver_query(roc_receiver* receiver,
     return 0;
 }
 
+int roc_receiver_query_ext(roc_receiver* receiver,
+                           roc_slot slot,
+                           roc_receiver_ext_metrics* ext_metrics) {
+    if (!receiver) {
+        roc_log(LogError,
+                "roc_receiver_query_ext(): invalid arguments: receiver is null");
+        return -1;
+    }
+
+    if (!ext_metrics) {
+        roc_log(LogError,
+                "roc_receiver_query_ext(): invalid arguments: ext_metrics is null");
+        return -1;
+    }
+
+    if (ext_metrics->struct_size < sizeof(ext_metrics->struct_size)) {
+        roc_log(LogError,
+                "roc_receiver_query_ext(): invalid arguments:"
+                " ext_metrics struct_size is too small");
+        return -1;
+    }
+
+    node::Receiver* imp_receiver = (node::Receiver*)receiver;
+
+    if (!imp_receiver->get_metrics(slot, api::receiver_slot_ext_metrics_to_user,
+                                   ext_metrics, api::receiver_participant_metrics_to_user,
+                                   NULL, NULL)) {
+        roc_log(LogError, "roc_receiver_query_ext(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
 int roc_receiver_read(roc_receiver* receiver, roc_frame* frame) {
     if (!receiver) {
         roc_log(LogError, "roc_receiver_read(): invalid arguments: receiver is null");
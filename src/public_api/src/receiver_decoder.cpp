@@ -137,6 +137,39 @@ int roc_receiver_decoder_query(roc_receiver_decoder* decoder,
     return 0;
 }
 
+int roc_receiver_decoder_query_ext(roc_receiver_decoder* decoder,
+                                   roc_receiver_ext_metrics* ext_metrics) {
+    if (!decoder) {
+        roc_log(LogError,
+                "roc_receiver_decoder_query_ext(): invalid arguments: decoder is null");
+        return -1;
+    }
+
+    if (!ext_metrics) {
+        roc_log(LogError,
+                "roc_receiver_decoder_query_ext(): invalid arguments:"
+                " ext_metrics is null");
+        return -1;
+    }
+
+    if (ext_metrics->struct_size < sizeof(ext_metrics->struct_size)) {
+        roc_log(LogError,
+                "roc_receiver_decoder_query_ext(): invalid arguments:"
+                " ext_metrics struct_size is too small");
+        return -1;
+    }
+
+    node::ReceiverDecoder* imp_decoder = (node::ReceiverDecoder*)decoder;
+
+    if (!imp_decoder->get_metrics(api::receiver_slot_ext_metrics_to_user, ext_metrics,
+                                  api::receiver_participant_metrics_to_user, NULL)) {
+        roc_log(LogError, "roc_receiver_decoder_query_ext(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
 int roc_receiver_decoder_push_packet(roc_receiver_decoder* decoder,
                                      roc_interface iface,
                                      const roc_packet* packet) {
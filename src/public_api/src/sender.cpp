@@ -159,6 +159,38 @@ int roc_sender_query(roc_sender* sender,
     return 0;
 }
 
+int roc_sender_query_ext(roc_sender* sender,
+                         roc_slot slot,
+                         roc_sender_ext_metrics* ext_metrics) {
+    if (!sender) {
+        roc_log(LogError, "roc_sender_query_ext(): invalid arguments: sender is null");
+        return -1;
+    }
+
+    if (!ext_metrics) {
+        roc_log(LogError,
+                "roc_sender_query_ext(): invalid arguments: ext_metrics is null");
+        return -1;
+    }
+
+    if (ext_metrics->struct_size < sizeof(ext_metrics->struct_size)) {
+        roc_log(LogError,
+                "roc_sender_query_ext(): invalid arguments:"
+                " ext_metrics struct_size is too small");
+        return -1;
+    }
+
+    node::Sender* imp_sender = (node::Sender*)sender;
+
+    if (!imp_sender->get_metrics(slot, api::sender_slot_ext_metrics_to_user, ext_metrics,
+                                 api::sender_participant_metrics_to_user, NULL, NULL)) {
+        roc_log(LogError, "roc_sender_query_ext(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
 int roc_sender_unlink(roc_sender* sender, roc_slot slot) {
     if (!sender) {
         roc_log(LogError, "roc_sender_unlink(): invalid arguments: sender is null");
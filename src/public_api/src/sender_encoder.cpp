@@ -134,6 +134,38 @@ int roc_sender_encoder_query(roc_sender_encoder* encoder,
     return 0;
 }
 
+int roc_sender_encoder_query_ext(roc_sender_encoder* encoder,
+                                 roc_sender_ext_metrics* ext_metrics) {
+    if (!encoder) {
+        roc_log(LogError,
+                "roc_sender_encoder_query_ext(): invalid arguments: encoder is null");
+        return -1;
+    }
+
+    if (!ext_metrics) {
+        roc_log(LogError,
+                "roc_sender_encoder_query_ext(): invalid arguments: ext_metrics is null");
+        return -1;
+    }
+
+    if (ext_metrics->struct_size < sizeof(ext_metrics->struct_size)) {
+        roc_log(LogError,
+                "roc_sender_encoder_query_ext(): invalid arguments:"
+                " ext_metrics struct_size is too small");
+        return -1;
+    }
+
+    node::SenderEncoder* imp_encoder = (node::SenderEncoder*)encoder;
+
+    if (!imp_encoder->get_metrics(api::sender_slot_ext_metrics_to_user, ext_metrics,
+                                  api::sender_participant_metrics_to_user, NULL)) {
+        roc_log(LogError, "roc_sender_encoder_query_ext(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
 int roc_sender_encoder_push_frame(roc_sender_encoder* encoder, const roc_frame* frame) {
     if (!encoder) {
         roc_log(LogError,
@@ -439,6 +439,44 @@ TEST(receiver, bad_args) {
         CHECK(roc_endpoint_deallocate(source_endpoint) == 0);
         LONGS_EQUAL(0, roc_receiver_close(receiver));
     }
+    { // query_ext
+        roc_receiver* receiver = NULL;
+        CHECK(roc_receiver_open(context, &receiver_config, &receiver) == 0);
+
+        roc_endpoint* source_endpoint = NULL;
+        CHECK(roc_endpoint_allocate(&source_endpoint) == 0);
+        CHECK(roc_endpoint_set_uri(source_endpoint, "rtp://127.0.0.1:0") == 0);
+
+        CHECK(roc_receiver_bind(receiver, ROC_SLOT_DEFAULT, ROC_INTERFACE_AUDIO_SOURCE,
+                                source_endpoint)
+              == 0);
+
+        roc_receiver_ext_metrics ext_metrics;
+        memset(&ext_metrics, 0, sizeof(ext_metrics));
+
+        // bad
+        ext_metrics.struct_size = sizeof(ext_metrics);
+        CHECK(roc_receiver_query_ext(NULL, ROC_SLOT_DEFAULT, &ext_metrics) == -1);
+        CHECK(roc_receiver_query_ext(receiver, 999, &ext_metrics) == -1);
+        CHECK(roc_receiver_query_ext(receiver, ROC_SLOT_DEFAULT, NULL) == -1);
+        ext_metrics.struct_size = 0;
+        CHECK(roc_receiver_query_ext(receiver, ROC_SLOT_DEFAULT, &ext_metrics) == -1);
+
+        // good
+        ext_metrics.struct_size = sizeof(ext_metrics);
+        CHECK(roc_receiver_query_ext(receiver, ROC_SLOT_DEFAULT, &ext_metrics) == 0);
+        UNSIGNED_LONGS_EQUAL(sizeof(ext_metrics), ext_metrics.struct_size);
+
+        // struct from older header, fields beyond struct_size are not touched
+        ext_metrics.struct_size = sizeof(size_t);
+        ext_metrics.task_count = 12345;
+        CHECK(roc_receiver_query_ext(receiver, ROC_SLOT_DEFAULT, &ext_metrics) == 0);
+        UNSIGNED_LONGS_EQUAL(sizeof(size_t), ext_metrics.struct_size);
+        UNSIGNED_LONGS_EQUAL(12345, ext_metrics.task_count);
+
+        CHECK(roc_endpoint_deallocate(source_endpoint) == 0);
+        LONGS_EQUAL(0, roc_receiver_close(receiver));
+    }
     { // unlink
         roc_receiver* receiver = NULL;
         CHECK(roc_receiver_open(context, &receiver_config, &receiver) == 0);
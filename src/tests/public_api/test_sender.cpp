@@ -419,6 +419,37 @@ TEST(sender, bad_args) {
         CHECK(roc_endpoint_deallocate(source_endpoint) == 0);
         LONGS_EQUAL(0, roc_sender_close(sender));
     }
+    { // query_ext
+        roc_sender* sender = NULL;
+        CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
+
+        roc_endpoint* source_endpoint = NULL;
+        CHECK(roc_endpoint_allocate(&source_endpoint) == 0);
+        CHECK(roc_endpoint_set_uri(source_endpoint, "rtp://127.0.0.1:111") == 0);
+
+        CHECK(roc_sender_connect(sender, ROC_SLOT_DEFAULT, ROC_INTERFACE_AUDIO_SOURCE,
+                                 source_endpoint)
+              == 0);
+
+        roc_sender_ext_metrics ext_metrics;
+        memset(&ext_metrics, 0, sizeof(ext_metrics));
+
+        // bad
+        ext_metrics.struct_size = sizeof(ext_metrics);
+        CHECK(roc_sender_query_ext(NULL, ROC_SLOT_DEFAULT, &ext_metrics) == -1);
+        CHECK(roc_sender_query_ext(sender, 999, &ext_metrics) == -1);
+        CHECK(roc_sender_query_ext(sender, ROC_SLOT_DEFAULT, NULL) == -1);
+        ext_metrics.struct_size = 0;
+        CHECK(roc_sender_query_ext(sender, ROC_SLOT_DEFAULT, &ext_metrics) == -1);
+
+        // good
+        ext_metrics.struct_size = sizeof(ext_metrics);
+        CHECK(roc_sender_query_ext(sender, ROC_SLOT_DEFAULT, &ext_metrics) == 0);
+        UNSIGNED_LONGS_EQUAL(sizeof(ext_metrics), ext_metrics.struct_size);
+
+        CHECK(roc_endpoint_deallocate(source_endpoint) == 0);
+        LONGS_EQUAL(0, roc_sender_close(sender));
+    }
     { // unlink
         roc_sender* sender = NULL;
         CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
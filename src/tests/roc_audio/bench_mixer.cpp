@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/mixer.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// FrameSize is in samples per channel.
+enum { SampleRate = 48000, NumCh = 2, FrameSize = 480, MaxInputs = 64 };
+
+const SampleSpec sample_spec(SampleRate,
+                             Sample_RawFormat,
+                             ChanLayout_Surround,
+                             ChanOrder_Smpte,
+                             ChanMask_Surround_Stereo);
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, FrameSize * NumCh * sizeof(sample_t));
+
+// Produces frames with the same pre-generated samples.
+class BenchReader : public IFrameReader {
+public:
+    BenchReader() {
+        for (size_t n = 0; n < FrameSize * NumCh; n++) {
+            samples_[n] = (sample_t)core::fast_random_range(0, 200) / 1000.f - 0.1f;
+        }
+    }
+
+    virtual bool read(Frame& frame) {
+        roc_panic_if(frame.num_raw_samples() > FrameSize * NumCh);
+
+        memcpy(frame.raw_samples(), samples_, frame.num_raw_samples() * sizeof(sample_t));
+
+        frame.set_flags(Frame::FlagNotBlank);
+        frame.set_duration(frame.num_raw_samples() / NumCh);
+
+        return true;
+    }
+
+private:
+    sample_t samples_[FrameSize * NumCh];
+};
+
+// Measures how much time it takes to mix one frame from given number of inputs.
+void BM_Mixer(benchmark::State& state) {
+    const size_t num_inputs = (size_t)state.range(0);
+    roc_panic_if(num_inputs > MaxInputs);
+
+    Mixer mixer(frame_factory, sample_spec, false);
+    roc_panic_if(!mixer.is_valid());
+
+    BenchReader* readers[MaxInputs];
+
+    for (size_t n = 0; n < num_inputs; n++) {
+        readers[n] = new (arena) BenchReader;
+        mixer.add_input(*readers[n]);
+    }
+
+    sample_t samples[FrameSize * NumCh];
+    size_t num_samples = 0;
+
+    while (state.KeepRunning()) {
+        Frame frame(samples, FrameSize * NumCh);
+        mixer.read(frame);
+        benchmark::DoNotOptimize(samples);
+        num_samples += FrameSize;
+    }
+
+    for (size_t n = 0; n < num_inputs; n++) {
+        mixer.remove_input(*readers[n]);
+        arena.destroy_object(*readers[n]);
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_samples, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Mixer)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
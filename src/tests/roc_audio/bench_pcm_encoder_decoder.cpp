@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/pcm_decoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// FrameSize is in samples per channel.
+enum { SampleRate = 44100, FrameSize = 480, MaxChans = 2 };
+
+struct BenchConfig {
+    PcmFormat format;
+    ChannelMask channels;
+};
+
+const BenchConfig bench_configs[] = {
+    { PcmFormat_SInt16_Be, ChanMask_Surround_Mono },
+    { PcmFormat_SInt16_Be, ChanMask_Surround_Stereo },
+    { PcmFormat_SInt24_Be, ChanMask_Surround_Mono },
+    { PcmFormat_SInt24_Be, ChanMask_Surround_Stereo },
+    // Not covered by specialized mapping functions.
+    { PcmFormat_SInt20_Be, ChanMask_Surround_Stereo },
+};
+
+SampleSpec make_spec(const BenchConfig& bench_config) {
+    return SampleSpec(SampleRate, bench_config.format, ChanLayout_Surround,
+                      ChanOrder_Smpte, bench_config.channels);
+}
+
+void fill_samples(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        samples[n] = (sample_t)core::fast_random_range(0, 2000) / 1000.f - 1.f;
+    }
+}
+
+// Measures how much time it takes to encode one frame.
+// Argument is an index in bench_configs.
+void BM_PcmEncoder(benchmark::State& state) {
+    const SampleSpec spec = make_spec(bench_configs[state.range(0)]);
+
+    PcmEncoder encoder(spec);
+
+    sample_t samples[FrameSize * MaxChans];
+    fill_samples(samples, FrameSize * spec.num_channels());
+
+    uint8_t payload[FrameSize * MaxChans * 4];
+    const size_t payload_size = encoder.encoded_byte_count(FrameSize);
+    roc_panic_if(payload_size > sizeof(payload));
+
+    size_t num_samples = 0;
+
+    while (state.KeepRunning()) {
+        encoder.begin(payload, payload_size);
+        encoder.write(samples, FrameSize);
+        encoder.end();
+
+        benchmark::DoNotOptimize(payload);
+        num_samples += FrameSize;
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_samples, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_PcmEncoder)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures how much time it takes to decode one frame.
+// Argument is an index in bench_configs.
+void BM_PcmDecoder(benchmark::State& state) {
+    const SampleSpec spec = make_spec(bench_configs[state.range(0)]);
+
+    PcmEncoder encoder(spec);
+    PcmDecoder decoder(spec);
+
+    sample_t samples[FrameSize * MaxChans];
+    fill_samples(samples, FrameSize * spec.num_channels());
+
+    uint8_t payload[FrameSize * MaxChans * 4];
+    const size_t payload_size = encoder.encoded_byte_count(FrameSize);
+    roc_panic_if(payload_size > sizeof(payload));
+
+    encoder.begin(payload, payload_size);
+    encoder.write(samples, FrameSize);
+    encoder.end();
+
+    size_t num_samples = 0;
+
+    while (state.KeepRunning()) {
+        decoder.begin(0, payload, payload_size);
+        decoder.read(samples, FrameSize);
+        decoder.end();
+
+        benchmark::DoNotOptimize(samples);
+        num_samples += FrameSize;
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_samples, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_PcmDecoder)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
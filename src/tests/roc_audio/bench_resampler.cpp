@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/window_kernel.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/shared_ptr.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// OutFrameSize is in samples per channel.
+enum { InRate = 44100, OutRate = 48000, OutFrameSize = 240, MaxFrameSize = 16384 };
+
+// Number of taps in window, close to the one of medium profile of builtin resampler.
+enum { WindowTaps = 72, MaxWindowCh = 8 };
+
+// Small deviation from nominal rate, like the one applied by FreqEstimator.
+const float Scaling = 1.0001f;
+
+struct BenchConfig {
+    ResamplerBackend backend;
+    ResamplerProfile profile;
+    size_t num_ch;
+};
+
+const BenchConfig bench_configs[] = {
+    { ResamplerBackend_Builtin, ResamplerProfile_Low, 1 },
+    { ResamplerBackend_Builtin, ResamplerProfile_Low, 2 },
+    { ResamplerBackend_Builtin, ResamplerProfile_Low, 6 },
+    { ResamplerBackend_Builtin, ResamplerProfile_Medium, 1 },
+    { ResamplerBackend_Builtin, ResamplerProfile_Medium, 2 },
+    { ResamplerBackend_Builtin, ResamplerProfile_Medium, 6 },
+    { ResamplerBackend_Builtin, ResamplerProfile_High, 1 },
+    { ResamplerBackend_Builtin, ResamplerProfile_High, 2 },
+    { ResamplerBackend_Builtin, ResamplerProfile_High, 6 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Low, 1 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Low, 2 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Low, 6 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Medium, 1 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Medium, 2 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_Medium, 6 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_High, 1 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_High, 2 },
+    { ResamplerBackend_Polyphase, ResamplerProfile_High, 6 },
+    { ResamplerBackend_Speex, ResamplerProfile_Medium, 2 },
+    { ResamplerBackend_SpeexDec, ResamplerProfile_Medium, 2 },
+};
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, MaxFrameSize * sizeof(sample_t));
+
+void fill_input(IResampler& resampler) {
+    const core::Slice<sample_t>& buff = resampler.begin_push_input();
+    for (size_t n = 0; n < buff.size(); n++) {
+        buff.data()[n] = (sample_t)core::fast_random_range(0, 2000) / 1000.f - 1.f;
+    }
+    resampler.end_push_input();
+}
+
+// Measures how much time it takes to produce one output frame.
+// Argument is an index in bench_configs.
+void BM_Resampler(benchmark::State& state) {
+    const BenchConfig& bench_config = bench_configs[state.range(0)];
+
+    const ResamplerBackend backend = bench_config.backend;
+    const ResamplerProfile profile = bench_config.profile;
+    const size_t num_ch = bench_config.num_ch;
+
+    if (!ResamplerMap::instance().is_supported(backend)) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    const SampleSpec in_spec(InRate, Sample_RawFormat, ChanLayout_Surround,
+                             ChanOrder_Smpte, (ChannelMask(1) << num_ch) - 1);
+    const SampleSpec out_spec(OutRate, Sample_RawFormat, ChanLayout_Surround,
+                              ChanOrder_Smpte, (ChannelMask(1) << num_ch) - 1);
+
+    ResamplerConfig config;
+    config.backend = backend;
+    config.profile = profile;
+
+    core::SharedPtr<IResampler> resampler = ResamplerMap::instance().new_resampler(
+        arena, frame_factory, config, in_spec, out_spec);
+    roc_panic_if(!resampler || !resampler->is_valid());
+    roc_panic_if(!resampler->set_scaling(InRate, OutRate, Scaling));
+
+    sample_t output[OutFrameSize * ChanPos_Max];
+    const size_t out_size = OutFrameSize * num_ch;
+
+    size_t num_samples = 0;
+
+    while (state.KeepRunning()) {
+        size_t out_pos = 0;
+        while (out_pos < out_size) {
+            const size_t n_popped =
+                resampler->pop_output(output + out_pos, out_size - out_pos);
+            out_pos += n_popped;
+            if (out_pos < out_size) {
+                fill_input(*resampler);
+            }
+        }
+        benchmark::DoNotOptimize(output);
+        num_samples += OutFrameSize;
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_samples, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Resampler)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures how much time it takes to apply window to one output sample.
+// First argument is an index of window kernel, second is number of channels.
+void BM_WindowKernel(benchmark::State& state) {
+    WindowKernel kernels[MaxWindowKernels];
+    get_window_kernels(kernels);
+
+    const WindowKernel& kernel = kernels[state.range(0)];
+    const size_t num_ch = (size_t)state.range(1);
+
+    sample_t input[WindowTaps * MaxWindowCh];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(input); n++) {
+        input[n] = (sample_t)core::fast_random_range(0, 2000) / 1000.f - 1.f;
+    }
+
+    sample_t weights[WindowTaps];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(weights); n++) {
+        weights[n] = (sample_t)core::fast_random_range(0, 2000) / 1000.f - 1.f;
+    }
+
+    sample_t output[MaxWindowCh] = {};
+
+    while (state.KeepRunning()) {
+        kernel.func(output, input, weights, WindowTaps, num_ch);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetLabel(kernel.name);
+}
+
+void window_kernel_args(benchmark::internal::Benchmark* b) {
+    WindowKernel kernels[MaxWindowKernels];
+    const size_t n_kernels = get_window_kernels(kernels);
+
+    const size_t ch_list[] = { 1, 2, 6 };
+
+    for (size_t nk = 0; nk < n_kernels; nk++) {
+        for (size_t nc = 0; nc < ROC_ARRAY_SIZE(ch_list); nc++) {
+            b->ArgPair((int)nk, (int)ch_list[nc]);
+        }
+    }
+}
+
+BENCHMARK(BM_WindowKernel)->Apply(window_kernel_args);
+
+} // namespace
+} // namespace audio
+} // namespace roc
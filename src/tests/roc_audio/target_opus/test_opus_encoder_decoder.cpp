@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_audio/packetizer.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/identity.h"
+#include "roc_rtp/sequencer.h"
+
+#include <math.h>
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    SampleRate = 48000,
+    NumCh = 2,
+
+    // 20 ms
+    FrameSamples = 960,
+    // 2.5 ms
+    MinFrameSamples = 120,
+
+    NumFrames = 20,
+    WarmupFrames = 5,
+
+    MaxBufSize = 4000,
+
+    PayloadType = 100
+};
+
+const double SineFreq = 1000;
+const double SineAmplitude = 0.5;
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBufSize);
+
+rtp::Composer rtp_composer(NULL);
+
+SampleSpec make_frame_spec() {
+    return SampleSpec(SampleRate, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte,
+                      ChanMask_Surround_Stereo);
+}
+
+SampleSpec make_packet_spec() {
+    SampleSpec spec;
+    spec.set_sample_rate(SampleRate);
+    spec.set_sample_format(SampleFormat_Opus);
+    spec.set_channel_set(
+        ChannelSet(ChanLayout_Surround, ChanOrder_Smpte, ChanMask_Surround_Stereo));
+    return spec;
+}
+
+void make_sine(sample_t* samples, size_t n_samples, size_t offset) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const double t = double(offset + n) / SampleRate;
+        const sample_t s = sample_t(SineAmplitude * sin(2 * M_PI * SineFreq * t));
+        for (size_t c = 0; c < NumCh; c++) {
+            samples[n * NumCh + c] = s;
+        }
+    }
+}
+
+double rms(const sample_t* samples, size_t n_samples) {
+    double sum = 0;
+    for (size_t n = 0; n < n_samples * NumCh; n++) {
+        sum += double(samples[n]) * double(samples[n]);
+    }
+    return sqrt(sum / double(n_samples * NumCh));
+}
+
+// Encode NumFrames frames of sine wave.
+void encode_frames(OpusEncoder& encoder,
+                   uint8_t frames[NumFrames][MaxBufSize],
+                   size_t frame_sizes[NumFrames]) {
+    const size_t max_frame_size = encoder.encoded_byte_count(FrameSamples);
+    CHECK(max_frame_size <= MaxBufSize);
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        sample_t samples[FrameSamples * NumCh];
+        make_sine(samples, FrameSamples, nf * FrameSamples);
+
+        encoder.begin(frames[nf], max_frame_size);
+        UNSIGNED_LONGS_EQUAL(FrameSamples, encoder.write(samples, FrameSamples));
+
+        frame_sizes[nf] = encoder.end();
+        CHECK(frame_sizes[nf] > 0);
+        CHECK(frame_sizes[nf] <= max_frame_size);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(opus_encoder_decoder) {};
+
+TEST(opus_encoder_decoder, encoded_sample_count) {
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    // rounded down to supported duration
+    UNSIGNED_LONGS_EQUAL(240, encoder.encoded_sample_count(SampleRate * 7 / 1000));
+    UNSIGNED_LONGS_EQUAL(960, encoder.encoded_sample_count(SampleRate * 25 / 1000));
+    UNSIGNED_LONGS_EQUAL(2880, encoder.encoded_sample_count(SampleRate * 100 / 1000));
+
+    // rounded up to minimum duration
+    UNSIGNED_LONGS_EQUAL(MinFrameSamples, encoder.encoded_sample_count(1));
+    UNSIGNED_LONGS_EQUAL(MinFrameSamples,
+                         encoder.encoded_sample_count(SampleRate * 1 / 1000));
+
+    // supported durations are kept as is
+    UNSIGNED_LONGS_EQUAL(FrameSamples, encoder.encoded_sample_count(FrameSamples));
+}
+
+TEST(opus_encoder_decoder, unsupported_duration) {
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    uint8_t frame[MaxBufSize];
+    sample_t samples[FrameSamples * NumCh];
+    make_sine(samples, FrameSamples, 0);
+
+    // partial frame is not padded, it's rejected
+    encoder.begin(frame, encoder.encoded_byte_count(FrameSamples));
+    UNSIGNED_LONGS_EQUAL(FrameSamples - 10, encoder.write(samples, FrameSamples - 10));
+    UNSIGNED_LONGS_EQUAL(0, encoder.end());
+
+    // encoder is still usable
+    encoder.begin(frame, encoder.encoded_byte_count(FrameSamples));
+    UNSIGNED_LONGS_EQUAL(FrameSamples, encoder.write(samples, FrameSamples));
+    CHECK(encoder.end() > 0);
+}
+
+TEST(opus_encoder_decoder, encode_decode) {
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    OpusDecoder decoder(arena, make_packet_spec());
+    CHECK(decoder.is_valid());
+
+    uint8_t frames[NumFrames][MaxBufSize];
+    size_t frame_sizes[NumFrames];
+    encode_frames(encoder, frames, frame_sizes);
+
+    sample_t input[FrameSamples * NumCh];
+    make_sine(input, FrameSamples, 0);
+    const double input_rms = rms(input, FrameSamples);
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        const packet::stream_timestamp_t pos =
+            (packet::stream_timestamp_t)(nf * FrameSamples);
+
+        UNSIGNED_LONGS_EQUAL(FrameSamples,
+                             decoder.decoded_sample_count(frames[nf], frame_sizes[nf]));
+
+        decoder.begin(pos, frames[nf], frame_sizes[nf]);
+
+        UNSIGNED_LONGS_EQUAL(pos, decoder.position());
+        UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.available());
+
+        sample_t output[FrameSamples * NumCh] = {};
+        UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.read(output, FrameSamples));
+
+        UNSIGNED_LONGS_EQUAL(pos + FrameSamples, decoder.position());
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+        decoder.end();
+
+        // lossy codec, so compare signal level instead of samples
+        if (nf >= WarmupFrames) {
+            DOUBLES_EQUAL(input_rms, rms(output, FrameSamples), input_rms * 0.2);
+        }
+    }
+}
+
+TEST(opus_encoder_decoder, conceal_plc) {
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    OpusDecoder decoder(arena, make_packet_spec());
+    CHECK(decoder.is_valid());
+
+    uint8_t frames[NumFrames][MaxBufSize];
+    size_t frame_sizes[NumFrames];
+    encode_frames(encoder, frames, frame_sizes);
+
+    for (size_t nf = 0; nf < WarmupFrames; nf++) {
+        decoder.begin((packet::stream_timestamp_t)(nf * FrameSamples), frames[nf],
+                      frame_sizes[nf]);
+
+        sample_t output[FrameSamples * NumCh];
+        UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.read(output, FrameSamples));
+
+        decoder.end();
+    }
+
+    // no next frame, so packet loss concealment is used
+    sample_t output[FrameSamples * NumCh] = {};
+    UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.conceal(output, FrameSamples));
+    CHECK(rms(output, FrameSamples) > 0.01);
+
+    // only multiples of minimum frame duration can be concealed,
+    // the rest is filled with zeros
+    enum { Partial = MinFrameSamples * 2 + 10 };
+
+    sample_t partial[Partial * NumCh];
+    for (size_t n = 0; n < Partial * NumCh; n++) {
+        partial[n] = 1;
+    }
+    UNSIGNED_LONGS_EQUAL(MinFrameSamples * 2, decoder.conceal(partial, Partial));
+
+    for (size_t n = MinFrameSamples * 2 * NumCh; n < Partial * NumCh; n++) {
+        DOUBLES_EQUAL(0.0, (double)partial[n], 0.0);
+    }
+}
+
+TEST(opus_encoder_decoder, conceal_fec) {
+    enum { LostFrame = WarmupFrames };
+
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    OpusDecoder decoder(arena, make_packet_spec());
+    CHECK(decoder.is_valid());
+
+    uint8_t frames[NumFrames][MaxBufSize];
+    size_t frame_sizes[NumFrames];
+    encode_frames(encoder, frames, frame_sizes);
+
+    sample_t output[FrameSamples * NumCh];
+
+    for (size_t nf = 0; nf < LostFrame; nf++) {
+        decoder.begin((packet::stream_timestamp_t)(nf * FrameSamples), frames[nf],
+                      frame_sizes[nf]);
+        UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.read(output, FrameSamples));
+        decoder.end();
+    }
+
+    // frame is lost, next frame is already available
+    const packet::stream_timestamp_t next_pos =
+        (packet::stream_timestamp_t)((LostFrame + 1) * FrameSamples);
+
+    decoder.begin(next_pos, frames[LostFrame + 1], frame_sizes[LostFrame + 1]);
+
+    // gap is restored from next frame
+    UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.conceal(output, FrameSamples));
+    CHECK(rms(output, FrameSamples) > 0.01);
+
+    // next frame is not affected
+    UNSIGNED_LONGS_EQUAL(next_pos, decoder.position());
+    UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.available());
+
+    UNSIGNED_LONGS_EQUAL(FrameSamples, decoder.read(output, FrameSamples));
+    CHECK(rms(output, FrameSamples) > 0.01);
+
+    decoder.end();
+}
+
+TEST(opus_encoder_decoder, packetizer_rounding) {
+    enum { NumPackets = 10, PacketSamples = 240 };
+
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    OpusDecoder decoder(arena, make_packet_spec());
+    CHECK(decoder.is_valid());
+
+    packet::Queue packet_queue;
+
+    rtp::Identity identity;
+    rtp::Sequencer sequencer(identity, PayloadType);
+
+    // 7 ms is rounded down to 5 ms
+    Packetizer packetizer(packet_queue, rtp_composer, sequencer, encoder, packet_factory,
+                          7 * core::Millisecond, make_frame_spec());
+    CHECK(packetizer.is_valid());
+
+    sample_t samples[PacketSamples * NumPackets * NumCh];
+    make_sine(samples, PacketSamples * NumPackets, 0);
+
+    Frame frame(samples, ROC_ARRAY_SIZE(samples));
+    packetizer.write(frame);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, packet_queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, packet_queue.read(pp));
+        CHECK(pp);
+
+        UNSIGNED_LONGS_EQUAL(PacketSamples, pp->rtp()->duration);
+
+        decoder.begin(pp->rtp()->stream_timestamp, pp->rtp()->payload.data(),
+                      pp->rtp()->payload.size());
+        UNSIGNED_LONGS_EQUAL(pp->rtp()->duration, decoder.available());
+        decoder.end();
+    }
+}
+
+TEST(opus_encoder_decoder, packetizer_flush) {
+    enum { PacketSamples = 480, Written = 300 };
+
+    OpusEncoder encoder(arena, make_packet_spec());
+    CHECK(encoder.is_valid());
+
+    OpusDecoder decoder(arena, make_packet_spec());
+    CHECK(decoder.is_valid());
+
+    packet::Queue packet_queue;
+
+    rtp::Identity identity;
+    rtp::Sequencer sequencer(identity, PayloadType);
+
+    Packetizer packetizer(packet_queue, rtp_composer, sequencer, encoder, packet_factory,
+                          10 * core::Millisecond, make_frame_spec());
+    CHECK(packetizer.is_valid());
+
+    sample_t samples[Written * NumCh];
+    make_sine(samples, Written, 0);
+
+    Frame frame(samples, ROC_ARRAY_SIZE(samples));
+    packetizer.write(frame);
+
+    UNSIGNED_LONGS_EQUAL(0, packet_queue.size());
+
+    packetizer.flush();
+
+    UNSIGNED_LONGS_EQUAL(1, packet_queue.size());
+
+    packet::PacketPtr pp;
+    LONGS_EQUAL(status::StatusOK, packet_queue.read(pp));
+    CHECK(pp);
+
+    // partial packet is padded with silence, and its duration
+    // matches encoded duration
+    UNSIGNED_LONGS_EQUAL(PacketSamples, pp->rtp()->duration);
+
+    decoder.begin(pp->rtp()->stream_timestamp, pp->rtp()->payload.data(),
+                  pp->rtp()->payload.size());
+    UNSIGNED_LONGS_EQUAL(pp->rtp()->duration, decoder.available());
+
+    sample_t output[PacketSamples * NumCh];
+    UNSIGNED_LONGS_EQUAL(PacketSamples, decoder.read(output, PacketSamples));
+
+    decoder.end();
+}
+
+} // namespace audio
+} // namespace roc
@@ -52,6 +52,27 @@ FrameFactory frame_factory(arena, MaxBufSize * sizeof(sample_t));
 
 rtp::Composer rtp_composer(NULL);
 
+// Decoder that replaces lost samples with a constant value.
+class ConcealingDecoder : public PcmDecoder {
+public:
+    ConcealingDecoder(const SampleSpec& sample_spec, sample_t value)
+        : PcmDecoder(sample_spec)
+        , n_chans_(sample_spec.num_channels())
+        , value_(value) {
+    }
+
+    virtual size_t conceal(sample_t* samples, size_t n_samples) {
+        for (size_t n = 0; n < n_samples * n_chans_; n++) {
+            samples[n] = value_;
+        }
+        return n_samples;
+    }
+
+private:
+    const size_t n_chans_;
+    const sample_t value_;
+};
+
 packet::PacketPtr new_packet(IFrameEncoder& encoder,
                              packet::stream_timestamp_t ts,
                              sample_t value,
@@ -766,5 +787,149 @@ TEST(depacketizer, read_after_error) {
     }
 }
 
+TEST(depacketizer, metrics) {
+    PcmEncoder encoder(packet_spec);
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, false);
+    CHECK(dp.is_valid());
+
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().decoded_samples);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().missing_samples);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().late_packets);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().concealed_samples);
+
+    // zeros before first packet are not counted as missing
+    expect_output(dp, SamplesPerPacket, 0.00f, 0);
+
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
+
+    expect_output(dp, SamplesPerPacket, 0.11f, Now);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, dp.metrics().decoded_samples);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().missing_samples);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().late_packets);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().concealed_samples);
+
+    // late packet is dropped, lost packet is replaced with zeros
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.22f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, SamplesPerPacket * 2, 0.33f,
+                                       Now + NsPerPacket * 2)));
+
+    expect_output(dp, SamplesPerPacket, 0.00f, Now + NsPerPacket);
+    expect_output(dp, SamplesPerPacket, 0.33f, Now + NsPerPacket * 2);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 2, dp.metrics().decoded_samples);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, dp.metrics().missing_samples);
+    UNSIGNED_LONGS_EQUAL(1, dp.metrics().late_packets);
+    UNSIGNED_LONGS_EQUAL(0, dp.metrics().concealed_samples);
+}
+
+TEST(depacketizer, gaps) {
+    PcmEncoder encoder(packet_spec);
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, false);
+    CHECK(dp.is_valid());
+
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, SamplesPerPacket * 2, 0.22f,
+                                       Now + NsPerPacket * 2)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, SamplesPerPacket * 4, 0.33f,
+                                       Now + NsPerPacket * 4)));
+
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket * 5);
+    Frame frame(buf.data(), buf.size());
+    CHECK(dp.read(frame));
+
+    // every lost packet is reported as gap
+    UNSIGNED_LONGS_EQUAL(2, frame.num_gaps());
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, frame.gap_offset(0));
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, frame.gap_length(0));
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 3, frame.gap_offset(1));
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, frame.gap_length(1));
+
+    // zeros in the end of stream are reported as well
+    CHECK(dp.read(frame));
+
+    UNSIGNED_LONGS_EQUAL(1, frame.num_gaps());
+    UNSIGNED_LONGS_EQUAL(0, frame.gap_offset(0));
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 5, frame.gap_length(0));
+}
+
+TEST(depacketizer, gaps_before_first_packet) {
+    PcmEncoder encoder(packet_spec);
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, false);
+    CHECK(dp.is_valid());
+
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+    Frame frame(buf.data(), buf.size());
+
+    // samples before first packet were not lost
+    CHECK(dp.read(frame));
+    UNSIGNED_LONGS_EQUAL(0, frame.num_gaps());
+
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
+
+    CHECK(dp.read(frame));
+    UNSIGNED_LONGS_EQUAL(0, frame.num_gaps());
+}
+
+TEST(depacketizer, gaps_concealed_by_decoder) {
+    PcmEncoder encoder(packet_spec);
+    ConcealingDecoder decoder(packet_spec, 0.99f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, false);
+    CHECK(dp.is_valid());
+
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, SamplesPerPacket * 2, 0.33f,
+                                       Now + NsPerPacket * 2)));
+
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket * 3);
+    Frame frame(buf.data(), buf.size());
+    CHECK(dp.read(frame));
+
+    // samples restored by decoder are not reported as gaps
+    UNSIGNED_LONGS_EQUAL(Frame::FlagNotBlank | Frame::FlagNotComplete, frame.flags());
+    UNSIGNED_LONGS_EQUAL(0, frame.num_gaps());
+}
+
+TEST(depacketizer, conceal) {
+    PcmEncoder encoder(packet_spec);
+    ConcealingDecoder decoder(packet_spec, 0.99f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, false);
+    CHECK(dp.is_valid());
+
+    // samples before first packet are not concealed
+    expect_output(dp, SamplesPerPacket, 0.00f, 0);
+
+    LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, SamplesPerPacket * 2, 0.33f,
+                                       Now + NsPerPacket * 2)));
+
+    // lost packet is concealed by decoder
+    expect_output(dp, SamplesPerPacket, 0.11f, Now);
+    expect_output(dp, SamplesPerPacket, 0.99f, Now + NsPerPacket);
+    expect_output(dp, SamplesPerPacket, 0.33f, Now + NsPerPacket * 2);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 2, dp.metrics().decoded_samples);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, dp.metrics().missing_samples);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, dp.metrics().concealed_samples);
+}
+
 } // namespace audio
 } // namespace roc
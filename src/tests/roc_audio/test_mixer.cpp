@@ -204,6 +204,41 @@ TEST(mixer, flags) {
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, many_readers) {
+    enum { NumReaders = 10 };
+
+    test::MockReader readers[NumReaders];
+
+    Mixer mixer(frame_factory, sample_spec, true);
+    CHECK(mixer.is_valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    // Number of readers is not a multiple of batch size.
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add_samples(BufSz, 0.01f * (n + 1));
+    }
+    expect_output(mixer, BufSz, 0.55f);
+
+    // Intermediate sum exceeds maximum, but final doesn't.
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add_samples(BufSz, n % 2 == 0 ? 0.9f : -0.8f);
+    }
+    expect_output(mixer, BufSz, 0.5f);
+
+    // Final sum exceeds maximum.
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add_samples(BufSz, -0.2f);
+    }
+    expect_output(mixer, BufSz, -1.0f);
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
 TEST(mixer, timestamps_one_reader) {
     // BufSz samples per second
     const SampleSpec sample_spec(BufSz, Sample_RawFormat, ChanLayout_Surround,
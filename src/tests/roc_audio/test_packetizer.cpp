@@ -170,6 +170,49 @@ private:
     core::nanoseconds_t capture_ts_;
 };
 
+// Encoder that supports only frames which are multiple of fixed quantum.
+class QuantizedEncoder : public IFrameEncoder {
+public:
+    enum { Quantum = 50 };
+
+    QuantizedEncoder()
+        : pcm_encoder_(packet_spec)
+        , frame_pos_(0) {
+    }
+
+    virtual size_t encoded_byte_count(size_t num_samples) const {
+        return pcm_encoder_.encoded_byte_count(num_samples);
+    }
+
+    virtual size_t encoded_sample_count(size_t num_samples) const {
+        if (num_samples < Quantum) {
+            return Quantum;
+        }
+        return num_samples / Quantum * Quantum;
+    }
+
+    virtual void begin(void* frame_data, size_t frame_size) {
+        pcm_encoder_.begin(frame_data, frame_size);
+        frame_pos_ = 0;
+    }
+
+    virtual size_t write(const sample_t* samples, size_t n_samples) {
+        const size_t n_written = pcm_encoder_.write(samples, n_samples);
+        frame_pos_ += n_written;
+        return n_written;
+    }
+
+    virtual size_t end() {
+        // packetizer should never end frame of unsupported size
+        UNSIGNED_LONGS_EQUAL(encoded_sample_count(frame_pos_), frame_pos_);
+        return pcm_encoder_.end();
+    }
+
+private:
+    PcmEncoder pcm_encoder_;
+    size_t frame_pos_;
+};
+
 } // namespace
 
 TEST_GROUP(packetizer) {};
@@ -322,6 +365,87 @@ TEST(packetizer, flush) {
     }
 }
 
+TEST(packetizer, frame_size_rounding) {
+    enum {
+        NumPackets = 5,
+        RequestedSamples = SamplesPerPacket + QuantizedEncoder::Quantum - 20
+    };
+
+    QuantizedEncoder encoder;
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue packet_queue;
+
+    rtp::Identity identity;
+    rtp::Sequencer sequencer(identity, PayloadType);
+    Packetizer packetizer(packet_queue, rtp_composer, sequencer, encoder, packet_factory,
+                          RequestedSamples * core::Second / SampleRate, frame_spec);
+    CHECK(packetizer.is_valid());
+
+    FrameMaker frame_maker;
+    PacketChecker packet_checker(decoder);
+
+    // packet length is rounded down to supported one
+    frame_maker.write(packetizer, SamplesPerPacket * NumPackets);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, packet_queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet_checker.read(packet_queue, SamplesPerPacket);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, packet_queue.size());
+}
+
+TEST(packetizer, flush_rounding) {
+    enum { Written = SamplesPerPacket - QuantizedEncoder::Quantum - 20 };
+
+    QuantizedEncoder encoder;
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue packet_queue;
+
+    rtp::Identity identity;
+    rtp::Sequencer sequencer(identity, PayloadType);
+    Packetizer packetizer(packet_queue, rtp_composer, sequencer, encoder, packet_factory,
+                          PacketDuration, frame_spec);
+    CHECK(packetizer.is_valid());
+
+    FrameMaker frame_maker;
+
+    frame_maker.write(packetizer, Written);
+    UNSIGNED_LONGS_EQUAL(0, packet_queue.size());
+
+    packetizer.flush();
+    UNSIGNED_LONGS_EQUAL(1, packet_queue.size());
+
+    packet::PacketPtr pp;
+    LONGS_EQUAL(status::StatusOK, packet_queue.read(pp));
+    CHECK(pp);
+
+    // encoder can't encode partial packet, so it's padded with silence,
+    // and packet duration matches encoded duration
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, pp->rtp()->duration);
+
+    decoder.begin(pp->rtp()->stream_timestamp, pp->rtp()->payload.data(),
+                  pp->rtp()->payload.size());
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, decoder.available());
+
+    sample_t samples[SamplesPerPacket * NumCh] = {};
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, decoder.read(samples, SamplesPerPacket));
+
+    decoder.end();
+
+    uint8_t value = 0;
+    for (size_t n = 0; n < SamplesPerPacket; n++) {
+        for (size_t c = 0; c < NumCh; c++) {
+            const sample_t expected = n < Written ? nth_sample(value++) : 0;
+            DOUBLES_EQUAL((double)expected, (double)samples[n * NumCh + c], Epsilon);
+        }
+    }
+}
+
 TEST(packetizer, timestamp_zero_cts) {
     enum {
         NumFrames = 10,
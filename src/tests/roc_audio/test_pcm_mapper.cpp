@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include "roc_audio/pcm_mapper.h"
+#include "roc_core/fast_random.h"
 #include "roc_core/log.h"
 #include "roc_core/macro_helpers.h"
 #include "roc_core/print_memory.h"
@@ -1037,5 +1038,71 @@ TEST(pcm_mapper, le_to_be) {
     compare(expected_output, actual_output, NumOutputBytes);
 }
 
+// Check that specialized mapping functions used for common byte-aligned
+// format pairs produce exactly the same output as generic functions.
+TEST(pcm_mapper, fast_path_vs_generic) {
+    enum { NumSamples = 1000 };
+
+    const PcmFormat int_formats[] = {
+        PcmFormat_SInt16, PcmFormat_SInt16_Be, PcmFormat_SInt16_Le,
+        PcmFormat_SInt24, PcmFormat_SInt24_Be, PcmFormat_SInt24_Le,
+    };
+
+    for (size_t n_fmt = 0; n_fmt < ROC_ARRAY_SIZE(int_formats); n_fmt++) {
+        for (int dir = 0; dir < 2; dir++) {
+            const PcmFormat in_fmt = dir == 0 ? int_formats[n_fmt] : PcmFormat_Float32;
+            const PcmFormat out_fmt = dir == 0 ? PcmFormat_Float32 : int_formats[n_fmt];
+
+            PcmMapper mapper(in_fmt, out_fmt);
+
+            float input[NumSamples];
+            if (in_fmt == PcmFormat_Float32) {
+                // Include values that need clipping.
+                for (size_t n = 0; n < NumSamples; n++) {
+                    input[n] =
+                        (float)core::fast_random_range(0, 2400) / 1000.0f - 1.2f;
+                }
+                input[0] = -1.0f;
+                input[1] = 1.0f;
+                input[2] = 0.0f;
+            } else {
+                uint8_t* input_bytes = (uint8_t*)input;
+                for (size_t n = 0; n < sizeof(input); n++) {
+                    input_bytes[n] = (uint8_t)core::fast_random_range(0, 255);
+                }
+            }
+
+            const size_t in_bytes = mapper.input_byte_count(NumSamples);
+            const size_t out_bytes = mapper.output_byte_count(NumSamples);
+
+            float actual_output[NumSamples] = {};
+            float expected_output[NumSamples] = {};
+
+            size_t in_off = 0;
+            size_t out_off = 0;
+
+            UNSIGNED_LONGS_EQUAL(NumSamples,
+                                 mapper.map(input, in_bytes, in_off, actual_output,
+                                            out_bytes, out_off, NumSamples));
+
+            UNSIGNED_LONGS_EQUAL(in_bytes * 8, in_off);
+            UNSIGNED_LONGS_EQUAL(out_bytes * 8, out_off);
+
+            size_t generic_in_off = 0;
+            size_t generic_out_off = 0;
+
+            pcm_format_mapfn(in_fmt, out_fmt)(
+                (const uint8_t*)input, generic_in_off, (uint8_t*)expected_output,
+                generic_out_off, NumSamples);
+
+            UNSIGNED_LONGS_EQUAL(in_off, generic_in_off);
+            UNSIGNED_LONGS_EQUAL(out_off, generic_out_off);
+
+            compare((const uint8_t*)expected_output, (const uint8_t*)actual_output,
+                    out_bytes);
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/plc_reader.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/slice.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    MaxBufSize = 1000,
+
+    NumCh = 2,
+    ChMask = 0x3,
+
+    SampleRate = 8000,
+    SamplesPerFrame = 80,
+
+    // 200 Hz
+    SignalPeriod = 40,
+
+    // History is 2 * max pitch period
+    WarmupFrames = 3
+};
+
+const double Pi = 3.14159265358979323846;
+
+const SampleSpec sample_spec(
+    SampleRate, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte, ChMask);
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, MaxBufSize * sizeof(sample_t));
+
+sample_t signal_value(size_t pos, size_t ch) {
+    return sample_t(sin(2 * Pi * double(pos) / SignalPeriod) * (ch == 0 ? 0.5 : 0.25));
+}
+
+// Generates sine, and zeroes given range of next frame as if packets were lost,
+// or as if signal itself had silence.
+class MockReader : public IFrameReader, public core::NonCopyable<> {
+public:
+    MockReader()
+        : pos_(0)
+        , lost_from_(0)
+        , lost_to_(0)
+        , silent_from_(0)
+        , silent_to_(0) {
+    }
+
+    void lose(size_t from, size_t to) {
+        lost_from_ = from;
+        lost_to_ = to;
+    }
+
+    void silence(size_t from, size_t to) {
+        silent_from_ = from;
+        silent_to_ = to;
+    }
+
+    virtual bool read(Frame& frame) {
+        const size_t n_samples = frame.num_raw_samples() / NumCh;
+
+        unsigned flags = 0;
+
+        for (size_t n = 0; n < n_samples; n++) {
+            const bool lost = n >= lost_from_ && n < lost_to_;
+            const bool silent = n >= silent_from_ && n < silent_to_;
+            for (size_t ch = 0; ch < NumCh; ch++) {
+                frame.raw_samples()[n * NumCh + ch] =
+                    lost || silent ? 0 : signal_value(pos_ + n, ch);
+            }
+            flags |= lost ? Frame::FlagNotComplete : Frame::FlagNotBlank;
+        }
+
+        frame.set_flags(flags);
+        frame.set_duration((packet::stream_timestamp_t)n_samples);
+
+        frame.clear_gaps();
+        CHECK(frame.add_gap(lost_from_, lost_to_ - lost_from_));
+
+        pos_ += n_samples;
+        lost_from_ = lost_to_ = 0;
+        silent_from_ = silent_to_ = 0;
+
+        return true;
+    }
+
+private:
+    size_t pos_;
+    size_t lost_from_;
+    size_t lost_to_;
+    size_t silent_from_;
+    size_t silent_to_;
+};
+
+PlcConfig make_config() {
+    PlcConfig config;
+    config.min_pitch_period = 2500 * core::Microsecond;
+    config.max_pitch_period = 10 * core::Millisecond;
+    config.fade_duration = 2500 * core::Microsecond;
+    config.max_duration = 60 * core::Millisecond;
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(plc_reader) {
+    core::Slice<sample_t> buf;
+
+    void setup() {
+        buf = frame_factory.new_raw_buffer();
+        buf.reslice(0, SamplesPerFrame * NumCh);
+    }
+
+    void read_frame(IFrameReader & reader, size_t& frame_pos) {
+        Frame frame(buf.data(), buf.size());
+        CHECK(reader.read(frame));
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame * NumCh, frame.num_raw_samples());
+
+        frame_pos += SamplesPerFrame;
+    }
+
+    void expect_signal(size_t frame_pos, size_t from, size_t to, double epsilon) {
+        for (size_t n = from; n < to; n++) {
+            for (size_t ch = 0; ch < NumCh; ch++) {
+                DOUBLES_EQUAL((double)signal_value(frame_pos + n, ch),
+                              (double)buf.data()[n * NumCh + ch], epsilon);
+            }
+        }
+    }
+
+    void expect_zeros(size_t from, size_t to) {
+        for (size_t n = from * NumCh; n < to * NumCh; n++) {
+            DOUBLES_EQUAL(0.0, (double)buf.data()[n], 0);
+        }
+    }
+};
+
+TEST(plc_reader, passthrough) {
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    for (size_t n = 0; n < 10; n++) {
+        const size_t frame_pos = pos;
+        read_frame(plc_reader, pos);
+        expect_signal(frame_pos, 0, SamplesPerFrame, 0);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(0, plc_reader.metrics().concealed_samples);
+}
+
+TEST(plc_reader, no_history) {
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    // Not enough history to conceal, zeros are kept.
+    mock_reader.lose(0, SamplesPerFrame);
+    read_frame(plc_reader, pos);
+    expect_zeros(0, SamplesPerFrame);
+
+    UNSIGNED_LONGS_EQUAL(0, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(0, plc_reader.metrics().concealed_samples);
+}
+
+TEST(plc_reader, conceal_frame) {
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    for (size_t n = 0; n < WarmupFrames; n++) {
+        read_frame(plc_reader, pos);
+    }
+
+    // Periodic signal is restored by repeating its period.
+    mock_reader.lose(0, SamplesPerFrame);
+    size_t frame_pos = pos;
+    read_frame(plc_reader, pos);
+    expect_signal(frame_pos, 0, SamplesPerFrame, 0.001);
+
+    // Real signal is cross-faded with concealed one.
+    frame_pos = pos;
+    read_frame(plc_reader, pos);
+    expect_signal(frame_pos, 0, SamplesPerFrame, 0.001);
+
+    UNSIGNED_LONGS_EQUAL(1, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, plc_reader.metrics().concealed_samples);
+    CHECK(plc_reader.metrics().conceal_time >= 0);
+    CHECK(plc_reader.metrics().max_conceal_time <= plc_reader.metrics().conceal_time);
+}
+
+TEST(plc_reader, conceal_partial) {
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    for (size_t n = 0; n < WarmupFrames; n++) {
+        read_frame(plc_reader, pos);
+    }
+
+    // Gap in the middle of frame.
+    mock_reader.lose(20, 60);
+    const size_t frame_pos = pos;
+    read_frame(plc_reader, pos);
+    expect_signal(frame_pos, 0, SamplesPerFrame, 0.001);
+
+    UNSIGNED_LONGS_EQUAL(1, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(40, plc_reader.metrics().concealed_samples);
+}
+
+TEST(plc_reader, silence_not_concealed) {
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    for (size_t n = 0; n < WarmupFrames; n++) {
+        read_frame(plc_reader, pos);
+    }
+
+    // Silence in signal is kept, even in incomplete frame.
+    mock_reader.silence(0, 40);
+    mock_reader.lose(70, 75);
+    size_t frame_pos = pos;
+    read_frame(plc_reader, pos);
+    expect_zeros(0, 40);
+    expect_signal(frame_pos, 40, 70, 0);
+
+    UNSIGNED_LONGS_EQUAL(1, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(5, plc_reader.metrics().concealed_samples);
+
+    // Silence right after gap is kept too, after cross-fade (20 samples).
+    mock_reader.lose(0, 20);
+    mock_reader.silence(20, SamplesPerFrame);
+    read_frame(plc_reader, pos);
+    expect_zeros(40, SamplesPerFrame);
+
+    UNSIGNED_LONGS_EQUAL(2, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(25, plc_reader.metrics().concealed_samples);
+}
+
+TEST(plc_reader, long_gap) {
+    enum { GapFrames = 10 };
+
+    MockReader mock_reader;
+    PlcReader plc_reader(mock_reader, sample_spec, make_config(), arena);
+    CHECK(plc_reader.is_valid());
+
+    size_t pos = 0;
+
+    for (size_t n = 0; n < WarmupFrames; n++) {
+        read_frame(plc_reader, pos);
+    }
+
+    for (size_t n = 0; n < GapFrames; n++) {
+        mock_reader.lose(0, SamplesPerFrame);
+        read_frame(plc_reader, pos);
+    }
+
+    // After max duration, concealed signal fades out to silence.
+    expect_zeros(0, SamplesPerFrame);
+
+    // 60ms
+    UNSIGNED_LONGS_EQUAL(6, plc_reader.metrics().concealed_frames);
+    UNSIGNED_LONGS_EQUAL(480, plc_reader.metrics().concealed_samples);
+}
+
+} // namespace audio
+} // namespace roc
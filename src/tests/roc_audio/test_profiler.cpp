@@ -128,5 +128,25 @@ TEST(profiler, test_moving_average) {
     }
 }
 
+TEST(profiler, test_frame_time) {
+    Profiler profiler(arena, sample_spec,
+                      ProfilerConfig(10 * core::Second, 10 * core::Millisecond));
+
+    // First frame triggers report, which resets frame time stats.
+    profiler.add_frame(10, 100 * core::Millisecond);
+
+    for (int n = 1; n <= 5; n++) {
+        profiler.add_frame(10, n * core::Millisecond);
+    }
+
+    // Times are 1, 2, 3, 4, 5 ms.
+    DOUBLES_EQUAL(3.0, (double)profiler.get_frame_time_avg() / core::Millisecond,
+                  EpsilionThreshold);
+    DOUBLES_EQUAL(sqrt(2.5), (double)profiler.get_frame_time_stddev() / core::Millisecond,
+                  EpsilionThreshold);
+    DOUBLES_EQUAL(5.0, (double)profiler.get_frame_time_max() / core::Millisecond,
+                  EpsilionThreshold);
+}
+
 } // namespace audio
 } // namespace roc
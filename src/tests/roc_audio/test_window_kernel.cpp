@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/window_kernel.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+const double Epsilon = 0.0001;
+
+enum { MaxTaps = 131, MaxChans = 8 };
+
+sample_t random_sample() {
+    return (sample_t)core::fast_random_range(0, 2000) / 1000.f - 1.f;
+}
+
+} // namespace
+
+TEST_GROUP(window_kernel) {};
+
+TEST(window_kernel, scalar_first) {
+    WindowKernel kernels[MaxWindowKernels];
+    const size_t n_kernels = get_window_kernels(kernels);
+
+    CHECK(n_kernels >= 1);
+    CHECK(n_kernels <= MaxWindowKernels);
+
+    STRCMP_EQUAL("scalar", kernels[0].name);
+    CHECK(kernels[0].func == window_kernel_scalar);
+}
+
+TEST(window_kernel, scalar_accumulate) {
+    const sample_t in[] = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f };
+    const sample_t weights[] = { 1.0f, 2.0f, -1.0f };
+
+    sample_t out[] = { 1.0f, -1.0f };
+
+    window_kernel_scalar(out, in, weights, 3, 2);
+
+    DOUBLES_EQUAL(1.0 + 0.1 + 0.6 - 0.5, (double)out[0], Epsilon);
+    DOUBLES_EQUAL(-1.0 + 0.2 + 0.8 - 0.6, (double)out[1], Epsilon);
+}
+
+TEST(window_kernel, same_as_scalar) {
+    const size_t ch_list[] = { 1, 2, 3, 4, 6, 8 };
+    const size_t taps_list[] = { 0, 1, 3, 7, 8, 17, 64, MaxTaps };
+
+    WindowKernel kernels[MaxWindowKernels];
+    const size_t n_kernels = get_window_kernels(kernels);
+
+    sample_t in[MaxTaps * MaxChans];
+    sample_t weights[MaxTaps];
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(in); n++) {
+        in[n] = random_sample();
+    }
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(weights); n++) {
+        weights[n] = random_sample();
+    }
+
+    for (size_t nk = 1; nk < n_kernels; nk++) {
+        for (size_t nc = 0; nc < ROC_ARRAY_SIZE(ch_list); nc++) {
+            for (size_t nt = 0; nt < ROC_ARRAY_SIZE(taps_list); nt++) {
+                const size_t num_ch = ch_list[nc];
+                const size_t n_taps = taps_list[nt];
+
+                sample_t expected[MaxChans];
+                sample_t actual[MaxChans];
+
+                for (size_t ch = 0; ch < num_ch; ch++) {
+                    expected[ch] = actual[ch] = random_sample();
+                }
+
+                window_kernel_scalar(expected, in, weights, n_taps, num_ch);
+                kernels[nk].func(actual, in, weights, n_taps, num_ch);
+
+                for (size_t ch = 0; ch < num_ch; ch++) {
+                    DOUBLES_EQUAL((double)expected[ch], (double)actual[ch], Epsilon);
+                }
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -8,15 +8,23 @@
 
 #include <benchmark/benchmark.h>
 
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/mutex.h"
+#include "roc_core/spsc_ring_buffer.h"
 #include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
 namespace {
 
-enum { BatchSize = 10000, NumIterations = 5000000, NumThreads = 16 };
+enum {
+    BatchSize = 10000,
+    NumIterations = 5000000,
+    NumThreads = 16,
+    RingBufferSize = 1024
+};
 
 #if defined(ROC_BENCHMARK_USE_ACCESSORS)
 inline int get_thread_index(const benchmark::State& state) {
@@ -189,6 +197,105 @@ BENCHMARK_REGISTER_F(BM_MpscQueue, PopFront)
     ->Iterations(NumIterations)
     ->Unit(benchmark::kMicrosecond);
 
+// Same as PopFront and TryPopFront with one push thread, but using bounded
+// lock-free SPSC ring buffer instead of MPSC queue.
+class BM_SpscRingBuffer : public benchmark::Fixture {
+public:
+    BM_SpscRingBuffer()
+        : objs_(NULL) {
+    }
+
+    virtual void SetUp(const benchmark::State&) {
+        objs_ = new Object[NumIterations];
+    }
+
+    virtual void TearDown(const benchmark::State&) {
+        delete[] objs_;
+        objs_ = NULL;
+    }
+
+protected:
+    Object* objs_;
+};
+
+class SpscPushThread : public core::Thread {
+public:
+    SpscPushThread(SpscRingBuffer<Object*>& ring, Object* objs)
+        : ring_(ring)
+        , objs_(objs)
+        , stop_(0) {
+    }
+
+    void stop() {
+        stop_ = 1;
+    }
+
+private:
+    virtual void run() {
+        for (int i = 0; i < NumIterations; i++) {
+            // Ring buffer is bounded, spin until reader frees space.
+            while (!ring_.push_back(&objs_[i])) {
+                if (stop_) {
+                    return;
+                }
+            }
+        }
+    }
+
+    SpscRingBuffer<Object*>& ring_;
+    Object* objs_;
+    Atomic<int> stop_;
+};
+
+BENCHMARK_DEFINE_F(BM_SpscRingBuffer, TryPopFront)(benchmark::State& state) {
+    HeapArena arena;
+    SpscRingBuffer<Object*> ring(arena, RingBufferSize);
+    roc_panic_if(!ring.is_valid());
+
+    SpscPushThread push_thread(ring, objs_);
+    (void)push_thread.start();
+
+    Object* obj = NULL;
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            ring.pop_front(obj);
+        }
+    }
+
+    push_thread.stop();
+    push_thread.join();
+}
+
+BENCHMARK_REGISTER_F(BM_SpscRingBuffer, TryPopFront)
+    ->Iterations(NumIterations)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(BM_SpscRingBuffer, PopFront)(benchmark::State& state) {
+    HeapArena arena;
+    SpscRingBuffer<Object*> ring(arena, RingBufferSize);
+    roc_panic_if(!ring.is_valid());
+
+    SpscPushThread push_thread(ring, objs_);
+    (void)push_thread.start();
+
+    Object* obj = NULL;
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            while (!ring.pop_front(obj)) {
+            }
+        }
+    }
+
+    push_thread.stop();
+    push_thread.join();
+}
+
+BENCHMARK_REGISTER_F(BM_SpscRingBuffer, PopFront)
+    ->Iterations(NumIterations)
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 } // namespace core
 } // namespace roc
@@ -480,6 +480,174 @@ TEST(slab_pool, embedded_capacity_reuse) {
     LONGS_EQUAL(0, arena.num_allocations());
 }
 
+TEST(slab_pool, reclaim) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        LONGS_EQUAL(0, pool.reclaim());
+
+        void* pointers[1 + 2 + 4] = {};
+
+        for (int n = 0; n < 1 + 2 + 4; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(3, arena.num_allocations());
+        LONGS_EQUAL(1 + 2 + 4, pool.num_used_slots());
+
+        const size_t n_slab_bytes = pool.num_slab_bytes();
+        CHECK(n_slab_bytes >= (1 + 2 + 4) * pool.allocation_size());
+
+        // all slabs are in use
+        LONGS_EQUAL(0, pool.reclaim());
+        LONGS_EQUAL(3, arena.num_allocations());
+
+        for (int n = 0; n < 1 + 2 + 4; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        LONGS_EQUAL(0, pool.num_used_slots());
+        LONGS_EQUAL(n_slab_bytes, pool.num_slab_bytes());
+
+        // all slabs are free
+        LONGS_EQUAL(n_slab_bytes, pool.reclaim());
+        LONGS_EQUAL(0, arena.num_allocations());
+        LONGS_EQUAL(0, pool.num_slab_bytes());
+
+        // pool is still usable
+        void* memory = pool.allocate();
+        CHECK(memory);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+
+        pool.deallocate(memory);
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, reclaim_partial) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        void* pointers[1 + 2 + 4] = {};
+
+        for (int n = 0; n < 1 + 2 + 4; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(3, arena.num_allocations());
+
+        // free first and second slabs, and one slot of third slab
+        for (int n = 0; n < 1 + 2 + 1; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        CHECK(pool.reclaim() > 0);
+        LONGS_EQUAL(1, arena.num_allocations());
+        LONGS_EQUAL(3, pool.num_used_slots());
+
+        // free slot of third slab is still used
+        void* memory = pool.allocate();
+        CHECK(memory);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+
+        pool.deallocate(memory);
+
+        for (int n = 1 + 2 + 1; n < 1 + 2 + 4; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        CHECK(pool.reclaim() > 0);
+        LONGS_EQUAL(0, arena.num_allocations());
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, reclaim_slab_size) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        void* pointers[1 + 2 + 4 + 8] = {};
+
+        for (int n = 0; n < 1 + 2 + 4 + 8; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(4, arena.num_allocations());
+
+        for (int n = 0; n < 1 + 2 + 4 + 8; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        CHECK(pool.reclaim() > 0);
+        LONGS_EQUAL(0, arena.num_allocations());
+
+        // next slab has minimum size again
+        const size_t prev_allocated_bytes = arena.cumulative_allocated_bytes;
+
+        void* memory = pool.allocate();
+        CHECK(memory);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        CHECK(arena.cumulative_allocated_bytes - prev_allocated_bytes
+              < sizeof(TestObject) * 2);
+
+        pool.deallocate(memory);
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, reclaim_embedded_capacity) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject, 5> pool("test", arena);
+
+        void* pointers[10] = {};
+
+        for (int n = 0; n < 10; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(1, arena.num_allocations());
+
+        for (int n = 0; n < 10; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        // embedded slots are kept
+        CHECK(pool.reclaim() > 0);
+        LONGS_EQUAL(0, arena.num_allocations());
+
+        for (int n = 0; n < 5; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(0, arena.num_allocations());
+
+        for (int n = 0; n < 5; n++) {
+            pool.deallocate(pointers[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
 TEST(slab_pool, guard_object) {
     TestArena arena;
     SlabPool<TestObject, 1> pool("test", arena);
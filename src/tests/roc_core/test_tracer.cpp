@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/temp_file.h"
+#include "roc_core/thread.h"
+#include "roc_core/tracer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { RingSize = 100, MaxFileSize = 64 * 1024 };
+
+class TraceThread : public Thread {
+public:
+    TraceThread(size_t n_events)
+        : n_events_(n_events) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_events_; n++) {
+            TraceScope trace("thread_stage");
+        }
+    }
+
+    const size_t n_events_;
+};
+
+// Records events with begin timestamps 1us, 2us, and so on.
+class NumberedTraceThread : public Thread {
+public:
+    NumberedTraceThread(size_t n_events)
+        : n_events_(n_events) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_events_; n++) {
+            Tracer::instance().add_event("numbered_stage",
+                                         (nanoseconds_t)(n + 1) * Microsecond, 1);
+        }
+    }
+
+    const size_t n_events_;
+};
+
+void read_file(const char* path, char* buf) {
+    FILE* fp = fopen(path, "r");
+    CHECK(fp);
+
+    const size_t size = fread(buf, 1, MaxFileSize - 1, fp);
+    buf[size] = '\0';
+
+    fclose(fp);
+}
+
+size_t count_substr(const char* str, const char* substr) {
+    size_t count = 0;
+    while ((str = strstr(str, substr))) {
+        count++;
+        str++;
+    }
+    return count;
+}
+
+char file_buf[MaxFileSize];
+
+} // namespace
+
+TEST_GROUP(tracer) {
+    void setup() {
+        // Drain events left from previous tests.
+        TempFile file("trace.json");
+        CHECK(Tracer::instance().dump(file.path()));
+    }
+
+    void teardown() {
+        Tracer::instance().disable();
+    }
+};
+
+TEST(tracer, disabled) {
+    CHECK(!Tracer::instance().is_enabled());
+
+    for (int n = 0; n < 10; n++) {
+        TraceScope trace("stage");
+    }
+
+    TempFile file("trace.json");
+    CHECK(Tracer::instance().dump(file.path()));
+
+    read_file(file.path(), file_buf);
+
+    CHECK(strstr(file_buf, "\"traceEvents\":["));
+    UNSIGNED_LONGS_EQUAL(0, count_substr(file_buf, "\"ph\":\"X\""));
+}
+
+TEST(tracer, enabled) {
+    Tracer::instance().enable(RingSize);
+    CHECK(Tracer::instance().is_enabled());
+
+    for (int n = 0; n < 3; n++) {
+        TraceScope trace1("stage1");
+        TraceScope trace2("stage2");
+    }
+
+    Tracer::instance().add_event("stage3", 12345678, 1234);
+
+    {
+        TempFile file("trace.json");
+        CHECK(Tracer::instance().dump(file.path()));
+
+        read_file(file.path(), file_buf);
+
+        UNSIGNED_LONGS_EQUAL(7, count_substr(file_buf, "\"ph\":\"X\""));
+        UNSIGNED_LONGS_EQUAL(3, count_substr(file_buf, "\"name\":\"stage1\""));
+        UNSIGNED_LONGS_EQUAL(3, count_substr(file_buf, "\"name\":\"stage2\""));
+        UNSIGNED_LONGS_EQUAL(1, count_substr(file_buf, "\"name\":\"stage3\""));
+
+        // Timestamps are in microseconds.
+        CHECK(strstr(file_buf, "\"ts\":12345.678,\"dur\":1.234}"));
+    }
+
+    {
+        // Events were removed by previous dump.
+        TempFile file("trace.json");
+        CHECK(Tracer::instance().dump(file.path()));
+
+        read_file(file.path(), file_buf);
+
+        UNSIGNED_LONGS_EQUAL(0, count_substr(file_buf, "\"ph\":\"X\""));
+    }
+}
+
+TEST(tracer, threads) {
+    enum { NumThreads = 3, NumEvents = 10 };
+
+    Tracer::instance().enable(RingSize);
+
+    TraceThread* threads[NumThreads];
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n] = new TraceThread(NumEvents);
+        CHECK(threads[n]->start());
+    }
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+
+    TempFile file("trace.json");
+    CHECK(Tracer::instance().dump(file.path()));
+
+    read_file(file.path(), file_buf);
+
+    UNSIGNED_LONGS_EQUAL(NumThreads * NumEvents,
+                         count_substr(file_buf, "\"name\":\"thread_stage\""));
+}
+
+TEST(tracer, slot_reuse) {
+    enum { NumThreads = Tracer::MaxThreads * 3, NumEvents = 2 };
+
+    // Slots of exited threads are reused, so total number of threads
+    // may exceed MaxThreads. Threads run one by one and may share the
+    // same ring, so it should fit events of all threads.
+    Tracer::instance().enable(NumThreads * NumEvents);
+
+    const size_t n_dropped = Tracer::instance().num_dropped();
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        TraceThread thread(NumEvents);
+        CHECK(thread.start());
+        thread.join();
+    }
+
+    TempFile file("trace.json");
+    CHECK(Tracer::instance().dump(file.path()));
+
+    read_file(file.path(), file_buf);
+
+    UNSIGNED_LONGS_EQUAL(NumThreads * NumEvents,
+                         count_substr(file_buf, "\"name\":\"thread_stage\""));
+    UNSIGNED_LONGS_EQUAL(n_dropped, Tracer::instance().num_dropped());
+}
+
+TEST(tracer, overflow) {
+    enum { SmallRingSize = 4, NumEvents = 1000 };
+
+    // Ring size is applied to rings allocated after this call.
+    // Slots of exited threads are reused though, so the thread can get
+    // a ring of one of the previous threads, which is larger, but still
+    // smaller than the number of events. When ring is full, oldest events
+    // are overwritten and counted as dropped.
+    Tracer::instance().enable(SmallRingSize);
+
+    const size_t n_dropped = Tracer::instance().num_dropped();
+
+    TraceThread thread(NumEvents);
+    CHECK(thread.start());
+    thread.join();
+
+    TempFile file("trace.json");
+    CHECK(Tracer::instance().dump(file.path()));
+
+    read_file(file.path(), file_buf);
+
+    const size_t n_dumped = count_substr(file_buf, "\"name\":\"thread_stage\"");
+
+    CHECK(n_dumped >= SmallRingSize);
+    CHECK(n_dumped <= RingSize);
+
+    UNSIGNED_LONGS_EQUAL(NumEvents,
+                         n_dumped + Tracer::instance().num_dropped() - n_dropped);
+}
+
+TEST(tracer, overflow_keeps_newest) {
+    enum { SmallRingSize = 4, NumEvents = 1000 };
+
+    Tracer::instance().enable(SmallRingSize);
+
+    NumberedTraceThread thread(NumEvents);
+    CHECK(thread.start());
+    thread.join();
+
+    TempFile file("trace.json");
+    CHECK(Tracer::instance().dump(file.path()));
+
+    read_file(file.path(), file_buf);
+
+    // oldest events are overwritten, newest are kept
+    UNSIGNED_LONGS_EQUAL(0, count_substr(file_buf, "\"ts\":1.000,"));
+    UNSIGNED_LONGS_EQUAL(1, count_substr(file_buf, "\"ts\":1000.000,"));
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/array.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// PayloadSize corresponds to 5ms of 44100Hz 16-bit stereo.
+enum { MaxPayloadSize = 2048, PayloadSize = 882 };
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxPayloadSize);
+
+struct BenchConfig {
+    packet::FecScheme scheme;
+    size_t n_source;
+    size_t n_repair;
+};
+
+const BenchConfig bench_configs[] = {
+    { packet::FEC_ReedSolomon_M8, 10, 5 },
+    { packet::FEC_ReedSolomon_M8, 20, 10 },
+    { packet::FEC_ReedSolomon_M8, 40, 20 },
+    { packet::FEC_ReedSolomon_M8, 100, 50 },
+    { packet::FEC_LDPC_Staircase, 10, 5 },
+    { packet::FEC_LDPC_Staircase, 20, 10 },
+    { packet::FEC_LDPC_Staircase, 40, 20 },
+    { packet::FEC_LDPC_Staircase, 100, 50 },
+};
+
+void fill_random(uint8_t* buf, size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        buf[n] = (uint8_t)core::fast_random_range(0, 255);
+    }
+}
+
+class BenchBlock {
+public:
+    BenchBlock(const BenchConfig& config)
+        : buffers_(arena) {
+        roc_panic_if(!buffers_.resize(config.n_source + config.n_repair));
+
+        for (size_t n = 0; n < buffers_.size(); n++) {
+            buffers_[n] = packet_factory.new_packet_buffer();
+            roc_panic_if(!buffers_[n]);
+            buffers_[n].reslice(0, PayloadSize);
+            fill_random(buffers_[n].data(), PayloadSize);
+        }
+    }
+
+    size_t size() const {
+        return buffers_.size();
+    }
+
+    const core::Slice<uint8_t>& operator[](size_t n) const {
+        return buffers_[n];
+    }
+
+private:
+    core::Array<core::Slice<uint8_t> > buffers_;
+};
+
+void encode_block(IBlockEncoder& encoder,
+                  const BenchConfig& config,
+                  const BenchBlock& block) {
+    roc_panic_if(!encoder.begin(config.n_source, config.n_repair, PayloadSize));
+
+    for (size_t n = 0; n < block.size(); n++) {
+        encoder.set(n, block[n]);
+    }
+
+    encoder.fill();
+    encoder.end();
+}
+
+// Measures how much time it takes to produce repair packets for one block.
+// Rate is in source bytes per second.
+// Argument is an index in bench_configs.
+void BM_BlockEncoder(benchmark::State& state) {
+    const BenchConfig& config = bench_configs[state.range(0)];
+
+    if (!CodecMap::instance().is_supported(config.scheme)) {
+        state.SkipWithError("fec scheme not supported");
+        return;
+    }
+
+    CodecConfig codec_config;
+    codec_config.scheme = config.scheme;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!encoder);
+
+    BenchBlock block(config);
+
+    size_t num_bytes = 0;
+
+    while (state.KeepRunning()) {
+        encode_block(*encoder, config, block);
+        num_bytes += config.n_source * PayloadSize;
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_bytes, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_BlockEncoder)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures how much time it takes to restore one block, when as many source
+// packets are lost as there are repair packets, which is the worst case.
+// Rate is in source bytes per second.
+// Argument is an index in bench_configs.
+void BM_BlockDecoder(benchmark::State& state) {
+    const BenchConfig& config = bench_configs[state.range(0)];
+
+    if (!CodecMap::instance().is_supported(config.scheme)) {
+        state.SkipWithError("fec scheme not supported");
+        return;
+    }
+
+    CodecConfig codec_config;
+    codec_config.scheme = config.scheme;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!decoder);
+
+    BenchBlock block(config);
+    encode_block(*encoder, config, block);
+
+    size_t num_bytes = 0;
+
+    while (state.KeepRunning()) {
+        roc_panic_if(!decoder->begin(config.n_source, config.n_repair, PayloadSize));
+
+        for (size_t n = config.n_repair; n < block.size(); n++) {
+            decoder->set(n, block[n]);
+        }
+
+        for (size_t n = 0; n < config.n_source; n++) {
+            core::Slice<uint8_t> buffer = decoder->repair(n);
+            benchmark::DoNotOptimize(buffer);
+        }
+
+        decoder->end();
+
+        num_bytes += config.n_source * PayloadSize;
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_bytes, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_BlockDecoder)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// PayloadSize corresponds to 5ms of 44100Hz 16-bit stereo.
+enum {
+    MaxBufSize = 2048,
+    PayloadSize = 882,
+    NumSourcePackets = 20,
+    NumRepairPackets = 10,
+    LossPercent = 5
+};
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBufSize);
+
+rtp::EncodingMap encoding_map(arena);
+
+rtp::Composer rtp_composer(NULL);
+Composer<RS8M_PayloadID, Source, Footer> source_composer(&rtp_composer);
+Composer<RS8M_PayloadID, Repair, Header> repair_composer(NULL);
+
+rtp::Parser rtp_parser(encoding_map, NULL);
+Parser<RS8M_PayloadID, Source, Footer> source_parser(&rtp_parser);
+Parser<RS8M_PayloadID, Repair, Header> repair_parser(NULL);
+
+struct BenchConfig {
+    // Latency in packets, i.e. how many packets after a packet was sent
+    // it should be played.
+    size_t latency;
+    bool pacing;
+};
+
+const BenchConfig bench_configs[] = {
+    { 10, false }, { 15, false }, { 20, false }, { 30, false }, { 40, false },
+    { 10, true },  { 15, true },  { 20, true },  { 30, true },  { 40, true },
+};
+
+// Imitates network: randomly drops packets, and delivers the rest to source
+// and repair queues without delay.
+class LossyNetwork : public packet::IWriter {
+public:
+    LossyNetwork()
+        : loss_percent_(LossPercent) {
+    }
+
+    packet::IReader& source_reader() {
+        return source_queue_;
+    }
+
+    packet::IReader& repair_reader() {
+        return repair_queue_;
+    }
+
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& pp) {
+        if (core::fast_random_range(1, 100) <= loss_percent_) {
+            return status::StatusOK;
+        }
+
+        if (pp->flags() & packet::Packet::FlagAudio) {
+            return source_queue_.write(reparse_(source_parser, pp));
+        } else {
+            return repair_queue_.write(reparse_(repair_parser, pp));
+        }
+    }
+
+private:
+    packet::PacketPtr reparse_(packet::IParser& parser, const packet::PacketPtr& old_pp) {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        roc_panic_if(!parser.parse(*pp, old_pp->buffer()));
+        pp->set_buffer(old_pp->buffer());
+
+        return pp;
+    }
+
+    const uint32_t loss_percent_;
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+};
+
+packet::PacketPtr make_packet(packet::seqnum_t sn) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    roc_panic_if(!pp);
+
+    core::Slice<uint8_t> buffer = packet_factory.new_packet_buffer();
+    roc_panic_if(!buffer);
+
+    roc_panic_if(
+        !source_composer.prepare(*pp, buffer, PayloadSize - sizeof(rtp::Header)));
+
+    pp->set_buffer(buffer);
+    pp->add_flags(packet::Packet::FlagAudio | packet::Packet::FlagPrepared);
+
+    pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+    pp->rtp()->seqnum = sn;
+
+    return pp;
+}
+
+// Measures how many packets are still lost after FEC repair depending on
+// latency, i.e. on how long receiver can wait for a packet before it should
+// be played. Every iteration, one source packet is written to the sender,
+// and the receiver plays packet that was written "latency" iterations ago.
+// Reports percent of packets that were not played because they were lost
+// or restored too late, and percent of packets that were played restored.
+// Argument is an index in bench_configs.
+void BM_ReaderLatencyVsLoss(benchmark::State& state) {
+    const BenchConfig& config = bench_configs[state.range(0)];
+
+    if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8)) {
+        state.SkipWithError("fec scheme not supported");
+        return;
+    }
+
+    CodecConfig codec_config;
+    codec_config.scheme = packet::FEC_ReedSolomon_M8;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!decoder);
+
+    WriterConfig writer_config;
+    writer_config.n_source_packets = NumSourcePackets;
+    writer_config.n_repair_packets = NumRepairPackets;
+    writer_config.enable_repair_pacing = config.pacing;
+
+    LossyNetwork network;
+
+    Writer writer(writer_config, codec_config.scheme, *encoder, network,
+                  source_composer, repair_composer, packet_factory, arena);
+    roc_panic_if(!writer.is_valid());
+
+    Reader reader(ReaderConfig(), codec_config.scheme, *decoder,
+                  network.source_reader(), network.repair_reader(), rtp_parser,
+                  packet_factory, arena);
+    roc_panic_if(!reader.is_valid());
+
+    packet::seqnum_t wr_sn = 0;
+    packet::seqnum_t play_sn = 0;
+
+    // Packet read from reader ahead of its play time.
+    packet::PacketPtr next_pp;
+
+    size_t n_played = 0, n_lost = 0, n_restored = 0;
+
+    while (state.KeepRunning()) {
+        roc_panic_if(writer.write(make_packet(wr_sn++)) != status::StatusOK);
+
+        if (packet::seqnum_diff(wr_sn, play_sn) <= (packet::seqnum_diff_t)config.latency) {
+            continue;
+        }
+
+        while (!next_pp || packet::seqnum_diff(next_pp->rtp()->seqnum, play_sn) < 0) {
+            next_pp = NULL;
+            if (reader.read(next_pp) != status::StatusOK) {
+                break;
+            }
+        }
+
+        if (next_pp && next_pp->rtp()->seqnum == play_sn) {
+            if (next_pp->has_flags(packet::Packet::FlagRestored)) {
+                n_restored++;
+            }
+            n_played++;
+            next_pp = NULL;
+        } else {
+            n_lost++;
+        }
+
+        play_sn++;
+    }
+
+    roc_panic_if(!reader.is_alive());
+
+    if (n_played + n_lost > 0) {
+        state.counters["lost_percent"] = 100. * (double)n_lost / double(n_played + n_lost);
+        state.counters["restored_percent"] =
+            100. * (double)n_restored / double(n_played + n_lost);
+    }
+}
+
+BENCHMARK(BM_ReaderLatencyVsLoss)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
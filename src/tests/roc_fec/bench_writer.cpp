@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/time.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// PayloadSize corresponds to 5ms of 44100Hz 16-bit stereo.
+enum { MaxBufSize = 2048, PayloadSize = 882 };
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBufSize);
+
+rtp::Composer rtp_composer(NULL);
+Composer<RS8M_PayloadID, Source, Footer> source_composer(&rtp_composer);
+Composer<RS8M_PayloadID, Repair, Header> repair_composer(NULL);
+
+struct BenchConfig {
+    size_t n_source;
+    size_t n_repair;
+    bool pacing;
+};
+
+const BenchConfig bench_configs[] = {
+    { 20, 10, false },
+    { 20, 10, true },
+    { 40, 20, false },
+    { 40, 20, true },
+    { 100, 50, false },
+    { 100, 50, true },
+};
+
+class NullWriter : public packet::IWriter {
+public:
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr&) {
+        return status::StatusOK;
+    }
+};
+
+packet::PacketPtr make_packet(packet::seqnum_t sn) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    roc_panic_if(!pp);
+
+    core::Slice<uint8_t> buffer = packet_factory.new_packet_buffer();
+    roc_panic_if(!buffer);
+
+    roc_panic_if(
+        !source_composer.prepare(*pp, buffer, PayloadSize - sizeof(rtp::Header)));
+
+    pp->set_buffer(buffer);
+    pp->add_flags(packet::Packet::FlagAudio | packet::Packet::FlagPrepared);
+
+    pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+    pp->rtp()->seqnum = sn;
+
+    return pp;
+}
+
+// Measures how much time it takes to write one source packet, together with
+// repair packets that are written after it. Reports average, standard
+// deviation, and maximum time of a single write, which show how repair
+// packet generation is distributed over source packets.
+// Argument is an index in bench_configs.
+void BM_WriterPacketTime(benchmark::State& state) {
+    const BenchConfig& config = bench_configs[state.range(0)];
+
+    if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8)) {
+        state.SkipWithError("fec scheme not supported");
+        return;
+    }
+
+    CodecConfig codec_config;
+    codec_config.scheme = packet::FEC_ReedSolomon_M8;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+    roc_panic_if(!encoder);
+
+    WriterConfig writer_config;
+    writer_config.n_source_packets = config.n_source;
+    writer_config.n_repair_packets = config.n_repair;
+    writer_config.enable_repair_pacing = config.pacing;
+
+    NullWriter null_writer;
+
+    Writer writer(writer_config, codec_config.scheme, *encoder, null_writer,
+                  source_composer, repair_composer, packet_factory, arena);
+    roc_panic_if(!writer.is_valid());
+
+    packet::seqnum_t sn = 0;
+
+    double n_writes = 0, sum = 0, sum2 = 0;
+    core::nanoseconds_t max_time = 0;
+
+    while (state.KeepRunning()) {
+        packet::PacketPtr pp = make_packet(sn++);
+
+        const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+
+        roc_panic_if(writer.write(pp) != status::StatusOK);
+
+        const core::nanoseconds_t elapsed =
+            core::timestamp(core::ClockMonotonic) - start;
+
+        n_writes += 1;
+        sum += (double)elapsed;
+        sum2 += (double)elapsed * (double)elapsed;
+        max_time = std::max(max_time, elapsed);
+    }
+
+    if (n_writes > 0) {
+        const double avg = sum / n_writes;
+
+        state.counters["avg_ns"] = avg;
+        state.counters["stddev_ns"] = sqrt(std::max(0., sum2 / n_writes - avg * avg));
+        state.counters["max_ns"] = (double)max_time;
+    }
+}
+
+BENCHMARK(BM_WriterPacketTime)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
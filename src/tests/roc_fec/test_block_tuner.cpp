@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_fec/block_tuner.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxBuffSize = 500, DefaultMaxBlockLength = 255 };
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBuffSize);
+
+rtp::Composer rtp_composer(NULL);
+Composer<RS8M_PayloadID, Source, Footer> source_composer(&rtp_composer);
+Composer<RS8M_PayloadID, Repair, Header> repair_composer(NULL);
+
+class MockEncoder : public IBlockEncoder {
+public:
+    explicit MockEncoder(size_t max_block_length)
+        : max_block_length_(max_block_length) {
+    }
+
+    virtual size_t alignment() const {
+        return 8;
+    }
+
+    virtual size_t max_block_length() const {
+        return max_block_length_;
+    }
+
+    virtual bool begin(size_t, size_t, size_t) {
+        return true;
+    }
+
+    virtual void set(size_t, const core::Slice<uint8_t>&) {
+    }
+
+    virtual void fill() {
+    }
+
+    virtual void fill_repair(size_t) {
+    }
+
+    virtual void end() {
+    }
+
+private:
+    const size_t max_block_length_;
+};
+
+} // namespace
+
+TEST_GROUP(block_tuner) {
+    BlockTunerConfig tuner_config;
+    WriterConfig writer_config;
+
+    void setup() {
+        tuner_config.min_source_packets = 6;
+        tuner_config.max_source_packets = 18;
+        tuner_config.min_repair_packets = 1;
+        tuner_config.max_repair_packets = 10;
+        tuner_config.redundancy = 2;
+        tuner_config.loss_decay = 0.25f;
+
+        writer_config.n_source_packets = 18;
+        writer_config.n_repair_packets = 10;
+    }
+};
+
+TEST(block_tuner, initial) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    DOUBLES_EQUAL(0, tuner.metrics().loss_ratio, 0);
+    UNSIGNED_LONGS_EQUAL(18, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_repair_packets);
+    UNSIGNED_LONGS_EQUAL(0, tuner.metrics().n_resizes);
+}
+
+TEST(block_tuner, no_loss) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    for (int n = 0; n < 10; n++) {
+        tuner.update_loss(0);
+
+        // Longest block with minimum repair packets.
+        UNSIGNED_LONGS_EQUAL(18, tuner.metrics().n_source_packets);
+        UNSIGNED_LONGS_EQUAL(1, tuner.metrics().n_repair_packets);
+        UNSIGNED_LONGS_EQUAL(1, tuner.metrics().n_resizes);
+    }
+}
+
+TEST(block_tuner, moderate_loss) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    tuner.update_loss(0.1f);
+
+    // Repair packets should cover 20% of block, block length is kept.
+    UNSIGNED_LONGS_EQUAL(18, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(5, tuner.metrics().n_repair_packets);
+}
+
+TEST(block_tuner, high_loss) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    tuner.update_loss(0.25f);
+
+    // Repair packets should cover 50% of block, which is possible only if
+    // block is shortened.
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_repair_packets);
+
+    tuner.update_loss(0.9f);
+
+    // Loss can't be covered, use highest repair ratio.
+    UNSIGNED_LONGS_EQUAL(6, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_repair_packets);
+}
+
+TEST(block_tuner, loss_decay) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    tuner.update_loss(0.25f);
+
+    DOUBLES_EQUAL(0.25, tuner.metrics().loss_ratio, 0.0001);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_repair_packets);
+
+    size_t prev_sblen = tuner.metrics().n_source_packets;
+    size_t prev_rblen = tuner.metrics().n_repair_packets;
+    float prev_loss = tuner.metrics().loss_ratio;
+
+    for (int n = 0; n < 50; n++) {
+        tuner.update_loss(0);
+
+        // Loss estimate decreases smoothly, block grows and repair
+        // packets are reduced step by step.
+        CHECK(tuner.metrics().loss_ratio < prev_loss);
+        CHECK(tuner.metrics().loss_ratio > 0);
+        CHECK(tuner.metrics().n_source_packets >= prev_sblen);
+        CHECK(tuner.metrics().n_repair_packets <= prev_rblen);
+
+        prev_sblen = tuner.metrics().n_source_packets;
+        prev_rblen = tuner.metrics().n_repair_packets;
+        prev_loss = tuner.metrics().loss_ratio;
+    }
+
+    UNSIGNED_LONGS_EQUAL(18, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(1, tuner.metrics().n_repair_packets);
+
+    // Loss estimate grows immediately.
+    tuner.update_loss(0.25f);
+
+    DOUBLES_EQUAL(0.25, tuner.metrics().loss_ratio, 0.0001);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_source_packets);
+    UNSIGNED_LONGS_EQUAL(10, tuner.metrics().n_repair_packets);
+}
+
+TEST(block_tuner, max_block_length) {
+    enum { MaxBlockLength = 12 };
+
+    writer_config.n_source_packets = 6;
+    writer_config.n_repair_packets = 6;
+
+    MockEncoder encoder(MaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    BlockTuner tuner(tuner_config, writer_config, writer, encoder.max_block_length());
+    CHECK(tuner.is_valid());
+
+    const float losses[] = { 0, 0.05f, 0.1f, 0.2f, 0.3f, 0.5f, 0.9f, 0 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(losses); n++) {
+        tuner.update_loss(losses[n]);
+
+        CHECK(tuner.metrics().n_source_packets >= tuner_config.min_source_packets);
+        CHECK(tuner.metrics().n_repair_packets >= tuner_config.min_repair_packets);
+        CHECK(tuner.metrics().n_repair_packets <= tuner_config.max_repair_packets);
+        CHECK(tuner.metrics().n_source_packets + tuner.metrics().n_repair_packets
+              <= MaxBlockLength);
+    }
+}
+
+TEST(block_tuner, invalid_config) {
+    MockEncoder encoder(DefaultMaxBlockLength);
+    packet::Queue queue;
+    Writer writer(writer_config, packet::FEC_ReedSolomon_M8, encoder, queue,
+                  source_composer, repair_composer, packet_factory, arena);
+    CHECK(writer.is_valid());
+
+    { // min > max
+        BlockTunerConfig config = tuner_config;
+        config.min_source_packets = 20;
+
+        BlockTuner tuner(config, writer_config, writer, encoder.max_block_length());
+        CHECK(!tuner.is_valid());
+    }
+    { // zero source packets
+        BlockTunerConfig config = tuner_config;
+        config.min_source_packets = 0;
+
+        BlockTuner tuner(config, writer_config, writer, encoder.max_block_length());
+        CHECK(!tuner.is_valid());
+    }
+    { // minimum block exceeds encoder limit
+        BlockTuner tuner(tuner_config, writer_config, writer, 5);
+        CHECK(!tuner.is_valid());
+    }
+    { // bad decay
+        BlockTunerConfig config = tuner_config;
+        config.loss_decay = 0;
+
+        BlockTuner tuner(config, writer_config, writer, encoder.max_block_length());
+        CHECK(!tuner.is_valid());
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -74,6 +74,43 @@ private:
     status::StatusCode code_;
 };
 
+class CountingDecoder : public IBlockDecoder {
+public:
+    explicit CountingDecoder(IBlockDecoder& decoder)
+        : decoder_(decoder)
+        , n_begin_(0) {
+    }
+
+    size_t n_begin() const {
+        return n_begin_;
+    }
+
+    virtual size_t max_block_length() const {
+        return decoder_.max_block_length();
+    }
+
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size) {
+        n_begin_++;
+        return decoder_.begin(sblen, rblen, payload_size);
+    }
+
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer) {
+        decoder_.set(index, buffer);
+    }
+
+    virtual core::Slice<uint8_t> repair(size_t index) {
+        return decoder_.repair(index);
+    }
+
+    virtual void end() {
+        decoder_.end();
+    }
+
+private:
+    IBlockDecoder& decoder_;
+    size_t n_begin_;
+};
+
 } // namespace
 
 TEST_GROUP(writer_reader) {
@@ -313,6 +350,9 @@ TEST(writer_reader, 1_loss) {
             check_audio_packet(p, i);
             check_restored(p, i == 11);
         }
+
+        UNSIGNED_LONGS_EQUAL(NumSourcePackets, reader.metrics().read_packets);
+        UNSIGNED_LONGS_EQUAL(1, reader.metrics().restored_packets);
     }
 }
 
@@ -849,15 +889,16 @@ TEST(writer_reader, repair_packets_before_source_packets) {
             UNSIGNED_LONGS_EQUAL(status::StatusOK, reader.read(p));
             CHECK(p);
 
-            // All packets should be restored.
+            // First packet should be restored, the rest were restored too,
+            // but replaced with source packets before they were read.
             check_audio_packet(p, rd_sn);
-            check_restored(p, true);
+            check_restored(p, i == 0);
 
             rd_sn++;
 
             if (i == 0) {
                 // Deliver source packets from second block.
-                // These packets should be dropped.
+                // First packet should be dropped.
                 dispatcher.push_stocks();
             }
         }
@@ -1054,6 +1095,79 @@ TEST(writer_reader, multiple_repair_attempts) {
     }
 }
 
+TEST(writer_reader, early_repair_once_per_block) {
+    // 1. Lose one packet in first block and hold fec packets.
+    // 2. Read packets before loss, delivering one fec packet before each read.
+    // 3. Check that decoding was not rerun on every new fec packet.
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_decoder(codec_config, packet_factory, arena), arena);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        CountingDecoder counting_decoder(*decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory, arena);
+
+        Reader reader(reader_config, codec_config.scheme, counting_decoder,
+                      dispatcher.source_reader(), dispatcher.repair_reader(), rtp_parser,
+                      packet_factory, arena);
+
+        CHECK(writer.is_valid());
+        CHECK(reader.is_valid());
+
+        enum { LostPacket = 5 };
+
+        fill_all_packets(0);
+
+        dispatcher.lose(LostPacket);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+        }
+        dispatcher.push_source_stock(NumSourcePackets - 1);
+
+        for (size_t i = 0; i < LostPacket; ++i) {
+            dispatcher.push_repair_stock(1);
+
+            packet::PacketPtr p;
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, reader.read(p));
+            CHECK(p);
+            check_audio_packet(p, i);
+            check_restored(p, false);
+        }
+
+        dispatcher.push_stocks();
+
+        for (size_t i = LostPacket; i < NumSourcePackets; ++i) {
+            packet::PacketPtr p;
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, reader.read(p));
+            CHECK(p);
+            check_audio_packet(p, i);
+            check_restored(p, i == LostPacket);
+        }
+
+        // At most one early attempt when block became decodable, and one
+        // more when reading reached the loss, if it was not restored early.
+        CHECK(counting_decoder.n_begin() >= 1);
+        CHECK(counting_decoder.n_begin() <= 2);
+        if (codec_config.scheme == packet::FEC_ReedSolomon_M8) {
+            UNSIGNED_LONGS_EQUAL(1, counting_decoder.n_begin());
+        }
+    }
+}
+
 TEST(writer_reader, drop_outdated_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
         codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
@@ -2068,6 +2182,145 @@ TEST(writer_reader, writer_resize_blocks) {
     }
 }
 
+TEST(writer_reader, writer_repair_pacing) {
+    enum { NumBlocks = 4 };
+
+    writer_config.enable_repair_pacing = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+        CHECK(encoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory, arena);
+
+        CHECK(writer.is_valid());
+
+        packet::blknum_t fec_sbn = 0;
+
+        for (size_t block_num = 0; block_num < NumBlocks; ++block_num) {
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                UNSIGNED_LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+
+                // Repair packets of previous block are spread evenly.
+                const size_t n_repair = block_num == 0
+                    ? 0
+                    : (NumRepairPackets * (i + 1) + NumSourcePackets - 1)
+                        / NumSourcePackets;
+
+                UNSIGNED_LONGS_EQUAL(i + 1, dispatcher.source_size());
+                UNSIGNED_LONGS_EQUAL(n_repair, dispatcher.repair_size());
+            }
+
+            dispatcher.push_stocks();
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                packet::PacketPtr p;
+                UNSIGNED_LONGS_EQUAL(status::StatusOK,
+                                     dispatcher.source_reader().read(p));
+                CHECK(p);
+                check_audio_packet(p, NumSourcePackets * block_num + i);
+
+                if (block_num == 0 && i == 0) {
+                    fec_sbn = p->fec()->source_block_number;
+                }
+                UNSIGNED_LONGS_EQUAL(packet::blknum_t(fec_sbn + block_num),
+                                     p->fec()->source_block_number);
+            }
+
+            const size_t n_repair = dispatcher.repair_size();
+            UNSIGNED_LONGS_EQUAL(block_num == 0 ? 0 : NumRepairPackets, n_repair);
+
+            for (size_t i = 0; i < n_repair; ++i) {
+                packet::PacketPtr p;
+                UNSIGNED_LONGS_EQUAL(status::StatusOK,
+                                     dispatcher.repair_reader().read(p));
+                CHECK(p);
+
+                const packet::FEC* fec = p->fec();
+                CHECK(fec);
+
+                UNSIGNED_LONGS_EQUAL(packet::blknum_t(fec_sbn + block_num - 1),
+                                     fec->source_block_number);
+                UNSIGNED_LONGS_EQUAL(NumSourcePackets + i, fec->encoding_symbol_id);
+            }
+
+            dispatcher.reset();
+        }
+    }
+}
+
+TEST(writer_reader, writer_repair_pacing_1_loss) {
+    writer_config.enable_repair_pacing = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, packet_factory, arena), arena);
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_decoder(codec_config, packet_factory, arena), arena);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory, arena);
+
+        Reader reader(reader_config, codec_config.scheme, *decoder,
+                      dispatcher.source_reader(), dispatcher.repair_reader(), rtp_parser,
+                      packet_factory, arena);
+
+        CHECK(writer.is_valid());
+        CHECK(reader.is_valid());
+
+        // First block, without repair packets.
+        fill_all_packets(0);
+
+        dispatcher.lose(11);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+        }
+
+        dispatcher.clear_losses();
+
+        // Second block, with repair packets for first block.
+        fill_all_packets(NumSourcePackets);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+        }
+
+        dispatcher.push_stocks();
+
+        UNSIGNED_LONGS_EQUAL(NumSourcePackets * 2 - 1, dispatcher.source_size());
+        UNSIGNED_LONGS_EQUAL(NumRepairPackets, dispatcher.repair_size());
+
+        for (size_t i = 0; i < NumSourcePackets * 2; ++i) {
+            packet::PacketPtr p;
+            UNSIGNED_LONGS_EQUAL(status::StatusOK, reader.read(p));
+            CHECK(p);
+            check_audio_packet(p, i);
+            check_restored(p, i == 11);
+        }
+    }
+}
+
 TEST(writer_reader, resize_block_begin) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
         codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
@@ -2639,20 +2892,11 @@ TEST(writer_reader, error_reader_decode_packet) {
         // deliver second block
         dispatcher.push_stocks();
 
-        // read second block packets before loss
-        for (size_t i = 0; i < 10; ++i) {
-            packet::PacketPtr p;
-            UNSIGNED_LONGS_EQUAL(status::StatusOK, reader.read(p));
-            CHECK(p);
-            check_audio_packet(p, BlockSize1 + i);
-            check_restored(p, false);
-        }
-
         // configure arena to return errors
         mock_arena.set_fail(true);
 
-        // reader should get an error from arena when trying
-        // to repair lost packet and shut down
+        // reader should get an error from arena when trying to repair lost
+        // packet, which happens as soon as the block is received, and shut down
         packet::PacketPtr pp;
         UNSIGNED_LONGS_EQUAL(status::StatusNoData, reader.read(pp));
         CHECK(!pp);
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_netio/network_loop.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+namespace {
+
+// BurstSize is the number of packets written before waiting for them to be received.
+enum { BurstSize = 64, PayloadSize = 200, BufferSize = 2000 };
+
+const core::nanoseconds_t BurstTimeout = core::Second;
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    buffer_pool("buffer_pool", arena, sizeof(core::Buffer) + BufferSize);
+
+packet::PacketFactory packet_factory(packet_pool, buffer_pool);
+
+// Counts received packets and wakes up waiter when expected number is reached.
+class CountingWriter : public packet::IWriter {
+public:
+    CountingWriter()
+        : count_(0)
+        , expected_(0) {
+    }
+
+    void expect(int n_packets) {
+        count_ = 0;
+        expected_ = n_packets;
+    }
+
+    bool wait() {
+        return sem_.timed_wait(core::timestamp(core::ClockUnix) + BurstTimeout);
+    }
+
+    virtual status::StatusCode write(const packet::PacketPtr&) {
+        if (++count_ == expected_) {
+            sem_.post();
+        }
+        return status::StatusOK;
+    }
+
+private:
+    core::Atomic<int> count_;
+    core::Atomic<int> expected_;
+    core::Semaphore sem_;
+};
+
+UdpConfig make_config(size_t batch_size, bool enable_offload) {
+    UdpConfig config;
+    roc_panic_if(
+        !config.bind_address.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+    config.batch_size = batch_size;
+    config.enable_gso = enable_offload;
+    config.enable_gro = enable_offload;
+    // Non-blocking writes bypass the network thread, disable them to measure
+    // the sending path of the port itself.
+    config.enable_non_blocking = false;
+    return config;
+}
+
+packet::PacketPtr make_packet(const UdpConfig& tx_config, const UdpConfig& rx_config) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    roc_panic_if(!pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = tx_config.bind_address;
+    pp->udp()->dst_addr = rx_config.bind_address;
+
+    core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+    roc_panic_if(!buf);
+    buf.reslice(0, PayloadSize);
+    memset(buf.data(), 0, PayloadSize);
+
+    pp->set_buffer(buf);
+
+    return pp;
+}
+
+void bench_udp_loopback(benchmark::State& state, bool enable_offload) {
+    UdpConfig tx_config = make_config((size_t)state.range(0), enable_offload);
+    UdpConfig rx_config = make_config((size_t)state.range(0), enable_offload);
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    roc_panic_if(!tx_loop.is_valid());
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    roc_panic_if(!rx_loop.is_valid());
+
+    CountingWriter rx_writer;
+
+    NetworkLoop::Tasks::AddUdpPort add_rx(rx_config);
+    roc_panic_if(!rx_loop.schedule_and_wait(add_rx));
+    NetworkLoop::Tasks::StartUdpRecv start_rx(add_rx.get_handle(), rx_writer);
+    roc_panic_if(!rx_loop.schedule_and_wait(start_rx));
+
+    NetworkLoop::Tasks::AddUdpPort add_tx(tx_config);
+    roc_panic_if(!tx_loop.schedule_and_wait(add_tx));
+    NetworkLoop::Tasks::StartUdpSend start_tx(add_tx.get_handle());
+    roc_panic_if(!tx_loop.schedule_and_wait(start_tx));
+
+    packet::IWriter& tx_writer = start_tx.get_outbound_writer();
+
+    packet::PacketPtr packets[BurstSize];
+    for (size_t n = 0; n < BurstSize; n++) {
+        packets[n] = make_packet(tx_config, rx_config);
+    }
+
+    size_t num_packets = 0;
+
+    while (state.KeepRunning()) {
+        rx_writer.expect(BurstSize);
+
+        for (size_t n = 0; n < BurstSize; n++) {
+            roc_panic_if(tx_writer.write(packets[n]) != status::StatusOK);
+        }
+
+        if (!rx_writer.wait()) {
+            state.SkipWithError("packets were lost");
+            break;
+        }
+
+        num_packets += BurstSize;
+    }
+
+    NetworkLoop::Tasks::RemovePort remove_tx(add_tx.get_handle());
+    roc_panic_if(!tx_loop.schedule_and_wait(remove_tx));
+
+    NetworkLoop::Tasks::RemovePort remove_rx(add_rx.get_handle());
+    roc_panic_if(!rx_loop.schedule_and_wait(remove_rx));
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_packets, benchmark::Counter::kIsRate);
+}
+
+// Measures how much time it takes to send burst of packets from one port
+// to another via loopback interface and receive them.
+// Argument is the batch size of both ports, zero means no batching.
+void BM_UdpLoopback(benchmark::State& state) {
+    bench_udp_loopback(state, false);
+}
+
+BENCHMARK(BM_UdpLoopback)
+    ->Arg(0)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Same, but with segmentation and receive offload (GSO and GRO) enabled.
+void BM_UdpLoopback_Offload(benchmark::State& state) {
+    bench_udp_loopback(state, true);
+}
+
+BENCHMARK(BM_UdpLoopback_Offload)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace netio
+} // namespace roc
@@ -11,6 +11,7 @@
 #include "roc_address/socket_addr.h"
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/time.h"
 #include "roc_netio/network_loop.h"
@@ -22,7 +23,7 @@ namespace netio {
 
 namespace {
 
-enum { NumIterations = 10, NumPackets = 7, BufferSize = 125 };
+enum { NumIterations = 10, NumPackets = 7, BatchSize = 3, BufferSize = 125 };
 
 core::HeapArena arena;
 
@@ -276,6 +277,185 @@ TEST(udp_io, one_sender_one_receiver_separate_loops) {
     }
 }
 
+TEST(udp_io, one_sender_one_receiver_batching) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    tx_config.batch_size = BatchSize;
+    tx_config.enable_non_blocking = false;
+    rx_config.batch_size = BatchSize;
+
+    NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+    CHECK(net_loop.is_valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            LONGS_EQUAL(status::StatusOK,
+                        tx_writer->write(new_packet(tx_config, rx_config, p)));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, rx_queue.read(pp));
+            check_packet(pp, tx_config, rx_config, p, i);
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_batching_sender_only) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    tx_config.batch_size = BatchSize;
+    tx_config.enable_non_blocking = false;
+
+    NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+    CHECK(net_loop.is_valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            LONGS_EQUAL(status::StatusOK,
+                        tx_writer->write(new_packet(tx_config, rx_config, p)));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, rx_queue.read(pp));
+            check_packet(pp, tx_config, rx_config, p, i);
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_batching_receiver_only) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    rx_config.batch_size = BatchSize;
+
+    NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+    CHECK(net_loop.is_valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            LONGS_EQUAL(status::StatusOK,
+                        tx_writer->write(new_packet(tx_config, rx_config, p)));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, rx_queue.read(pp));
+            check_packet(pp, tx_config, rx_config, p, i);
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_batching_offload) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    tx_config.batch_size = BatchSize;
+    tx_config.enable_non_blocking = false;
+    tx_config.enable_gso = true;
+    rx_config.batch_size = BatchSize;
+    rx_config.enable_gro = true;
+
+    NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+    CHECK(net_loop.is_valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            LONGS_EQUAL(status::StatusOK,
+                        tx_writer->write(new_packet(tx_config, rx_config, p)));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, rx_queue.read(pp));
+            check_packet(pp, tx_config, rx_config, p, i);
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_paced) {
+    enum { Batching = (1 << 0), NonBlocking = (1 << 1) };
+
+    const int modes[] = { 0, NonBlocking, Batching };
+
+    const core::nanoseconds_t PacingInterval = 2 * core::Millisecond;
+
+    for (size_t n_mode = 0; n_mode < ROC_ARRAY_SIZE(modes); n_mode++) {
+        packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+        UdpConfig tx_config = make_udp_config();
+        UdpConfig rx_config = make_udp_config();
+
+        tx_config.enable_non_blocking = (modes[n_mode] & NonBlocking);
+        if (modes[n_mode] & Batching) {
+            tx_config.batch_size = BatchSize;
+        }
+
+        NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+        CHECK(net_loop.is_valid());
+
+        packet::IWriter* tx_writer = NULL;
+        CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+        CHECK(tx_writer);
+
+        CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+        for (int i = 0; i < NumIterations; i++) {
+            packet::PacketPtr packets[NumPackets];
+
+            const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+
+            for (int p = 0; p < NumPackets; p++) {
+                packets[p] = new_packet(tx_config, rx_config, p);
+                packets[p]->udp()->send_timestamp = start + PacingInterval * p;
+            }
+
+            LONGS_EQUAL(status::StatusOK, tx_writer->write_batch(packets, NumPackets));
+
+            for (int p = 0; p < NumPackets; p++) {
+                packet::PacketPtr pp;
+                LONGS_EQUAL(status::StatusOK, rx_queue.read(pp));
+                check_packet(pp, tx_config, rx_config, p, i);
+
+                // packet is not sent before its send time
+                CHECK(core::timestamp(core::ClockMonotonic)
+                      >= start + PacingInterval * p);
+            }
+        }
+    }
+}
+
 TEST(udp_io, one_sender_many_receivers) {
     packet::ConcurrentQueue rx_queue1(packet::ConcurrentQueue::Blocking);
     packet::ConcurrentQueue rx_queue2(packet::ConcurrentQueue::Blocking);
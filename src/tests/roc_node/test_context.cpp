@@ -18,6 +18,8 @@ namespace node {
 
 namespace {
 
+enum { NumBuffers = 10 };
+
 core::HeapArena arena;
 
 } // namespace
@@ -50,5 +52,30 @@ TEST(context, reference_counting) {
     CHECK(context.getref() == 0);
 }
 
+TEST(context, memory_limit) {
+    ContextConfig context_config;
+    Context context(context_config, arena);
+
+    const size_t buffer_size = context.packet_buffer_pool().allocation_size();
+
+    context_config.max_memory = buffer_size * NumBuffers;
+    Context limited_context(context_config, arena);
+
+    void* buffers[NumBuffers] = {};
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        buffers[n] = limited_context.packet_buffer_pool().allocate();
+        CHECK(buffers[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(buffer_size * NumBuffers, limited_context.memory_usage());
+
+    CHECK(!limited_context.packet_buffer_pool().allocate());
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        limited_context.packet_buffer_pool().deallocate(buffers[n]);
+    }
+}
+
 } // namespace node
 } // namespace roc
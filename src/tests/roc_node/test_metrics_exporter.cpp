@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_address/parse_socket_addr.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/string_buffer.h"
+#include "roc_core/time.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_node/context.h"
+#include "roc_node/metrics_exporter.h"
+#include "roc_node/receiver.h"
+#include "roc_node/sender.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+enum { DefaultSlot = 0, MaxResponseSize = 64 * 1024 };
+
+const core::nanoseconds_t Timeout = 10 * core::Second;
+
+core::HeapArena arena;
+
+void parse_uri(address::EndpointUri& uri, const char* str) {
+    CHECK(address::parse_endpoint_uri(str, address::EndpointUri::Subset_Full, uri));
+    CHECK(uri.verify(address::EndpointUri::Subset_Full));
+}
+
+// Send HTTP request to exporter and read response until server closes connection.
+void http_get(const address::SocketAddr& server_addr, char* response) {
+    netio::SocketHandle sock = netio::SocketInvalid;
+    CHECK(netio::socket_create(server_addr.family(), netio::SocketType_Tcp, sock));
+
+    bool connected = false;
+    CHECK(netio::socket_begin_connect(sock, server_addr, connected));
+
+    const char* request = "GET /metrics HTTP/1.0\r\nHost: localhost\r\n\r\n";
+    size_t request_pos = 0;
+    size_t response_size = 0;
+
+    const core::nanoseconds_t deadline =
+        core::timestamp(core::ClockMonotonic) + Timeout;
+
+    while (request_pos < strlen(request)) {
+        CHECK(core::timestamp(core::ClockMonotonic) < deadline);
+
+        const ssize_t ret = netio::socket_try_send(sock, request + request_pos,
+                                                   strlen(request) - request_pos);
+        if (ret == netio::SockErr_WouldBlock) {
+            core::sleep_for(core::ClockMonotonic, core::Millisecond);
+            continue;
+        }
+        CHECK(ret >= 0);
+        request_pos += (size_t)ret;
+    }
+
+    for (;;) {
+        CHECK(core::timestamp(core::ClockMonotonic) < deadline);
+
+        const ssize_t ret = netio::socket_try_recv(sock, response + response_size,
+                                                   MaxResponseSize - 1 - response_size);
+        if (ret == netio::SockErr_WouldBlock) {
+            core::sleep_for(core::ClockMonotonic, core::Millisecond);
+            continue;
+        }
+        if (ret == netio::SockErr_StreamEnd) {
+            break;
+        }
+        CHECK(ret >= 0);
+        response_size += (size_t)ret;
+    }
+
+    response[response_size] = '\0';
+
+    CHECK(netio::socket_close(sock));
+}
+
+char response_buf[MaxResponseSize];
+
+} // namespace
+
+TEST_GROUP(metrics_exporter) {
+    ContextConfig context_config;
+    MetricsExporterConfig exporter_config;
+};
+
+TEST(metrics_exporter, receiver) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    pipeline::ReceiverSourceConfig receiver_config;
+    Receiver receiver(context, receiver_config);
+    CHECK(receiver.is_valid());
+
+    address::EndpointUri source_endp(arena);
+    parse_uri(source_endp, "rtp://127.0.0.1:0");
+    CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+    MetricsExporter exporter(exporter_config, context, receiver);
+    CHECK(exporter.update());
+
+    core::StringBuffer text(arena);
+    CHECK(exporter.get_text(text));
+
+    CHECK(strstr(text.c_str(), "# TYPE roc_pipeline_tasks_total counter\n"));
+    CHECK(strstr(text.c_str(), "\nroc_pipeline_tasks_total "));
+    CHECK(strstr(text.c_str(), "# TYPE roc_receiver_connections gauge\n"));
+    CHECK(strstr(text.c_str(), "\nroc_receiver_connections{slot=\"0\"} 0\n"));
+    CHECK(strstr(text.c_str(), "# TYPE roc_receiver_late_packets_total counter\n"));
+    CHECK(strstr(text.c_str(), "\nroc_receiver_late_packets_total{slot=\"0\"} 0\n"));
+}
+
+TEST(metrics_exporter, sender) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    pipeline::SenderSinkConfig sender_config;
+    Sender sender(context, sender_config);
+    CHECK(sender.is_valid());
+
+    address::EndpointUri source_endp(arena);
+    parse_uri(source_endp, "rtp://127.0.0.1:123");
+    CHECK(sender.connect(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+    MetricsExporter exporter(exporter_config, context, sender);
+    CHECK(exporter.update());
+
+    core::StringBuffer text(arena);
+    CHECK(exporter.get_text(text));
+
+    CHECK(strstr(text.c_str(), "# TYPE roc_pipeline_tasks_total counter\n"));
+    CHECK(strstr(text.c_str(), "# TYPE roc_sender_connections gauge\n"));
+    CHECK(strstr(text.c_str(), "\nroc_sender_connections{slot=\"0\"} 0\n"));
+    CHECK(strstr(text.c_str(), "# TYPE roc_sender_rtt_seconds gauge\n"));
+}
+
+TEST(metrics_exporter, no_slot) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    pipeline::ReceiverSourceConfig receiver_config;
+    Receiver receiver(context, receiver_config);
+    CHECK(receiver.is_valid());
+
+    MetricsExporter exporter(exporter_config, context, receiver);
+    CHECK(!exporter.update());
+
+    address::SocketAddr server_addr;
+    CHECK(address::parse_socket_addr("127.0.0.1", 0, server_addr));
+    CHECK(!exporter.start(server_addr));
+}
+
+TEST(metrics_exporter, http) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    pipeline::ReceiverSourceConfig receiver_config;
+    Receiver receiver(context, receiver_config);
+    CHECK(receiver.is_valid());
+
+    address::EndpointUri source_endp(arena);
+    parse_uri(source_endp, "rtp://127.0.0.1:0");
+    CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+    MetricsExporter exporter(exporter_config, context, receiver);
+
+    address::SocketAddr server_addr;
+    CHECK(address::parse_socket_addr("127.0.0.1", 0, server_addr));
+    CHECK(exporter.start(server_addr));
+    CHECK(server_addr.port() != 0);
+
+    for (int n = 0; n < 3; n++) {
+        http_get(server_addr, response_buf);
+
+        CHECK(strncmp(response_buf, "HTTP/1.0 200 OK\r\n", 17) == 0);
+        CHECK(strstr(response_buf, "\r\nContent-Type: text/plain; version=0.0.4"));
+
+        const char* body = strstr(response_buf, "\r\n\r\n");
+        CHECK(body);
+        body += 4;
+
+        CHECK(strstr(body, "roc_receiver_connections{slot=\"0\"} 0\n"));
+    }
+
+    exporter.stop();
+}
+
+} // namespace node
+} // namespace roc
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_node/context.h"
+#include "roc_node/shared_pools.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+enum { NumBuffers = 10 };
+
+core::HeapArena arena;
+
+} // namespace
+
+TEST_GROUP(shared_pools) {};
+
+TEST(shared_pools, share_between_contexts) {
+    SharedPoolsConfig pools_config;
+    SharedPools pools(pools_config, arena);
+
+    ContextConfig context_config;
+    Context context1(context_config, pools, arena);
+    Context context2(context_config, pools, arena);
+
+    CHECK(context1.is_valid());
+    CHECK(context2.is_valid());
+
+    const size_t buffer_size = context1.packet_buffer_pool().allocation_size();
+
+    void* buffer1 = context1.packet_buffer_pool().allocate();
+    CHECK(buffer1);
+
+    void* buffer2 = context2.packet_buffer_pool().allocate();
+    CHECK(buffer2);
+
+    UNSIGNED_LONGS_EQUAL(buffer_size, context1.memory_usage());
+    UNSIGNED_LONGS_EQUAL(buffer_size, context2.memory_usage());
+    UNSIGNED_LONGS_EQUAL(buffer_size * 2, pools.metrics().used_bytes);
+    CHECK(pools.metrics().allocated_bytes >= buffer_size * 2);
+
+    context1.packet_buffer_pool().deallocate(buffer1);
+    context2.packet_buffer_pool().deallocate(buffer2);
+
+    UNSIGNED_LONGS_EQUAL(0, context1.memory_usage());
+    UNSIGNED_LONGS_EQUAL(0, context2.memory_usage());
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().used_bytes);
+}
+
+TEST(shared_pools, context_limit) {
+    SharedPoolsConfig pools_config;
+    SharedPools pools(pools_config, arena);
+
+    const size_t buffer_size = pools.packet_buffer_pool().allocation_size();
+
+    ContextConfig context_config;
+    context_config.max_memory = buffer_size * NumBuffers;
+
+    Context context1(context_config, pools, arena);
+    Context context2(context_config, pools, arena);
+
+    CHECK(context1.is_valid());
+    CHECK(context2.is_valid());
+
+    void* buffers[NumBuffers] = {};
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        buffers[n] = context1.packet_buffer_pool().allocate();
+        CHECK(buffers[n]);
+    }
+
+    // first context reached its limit
+    CHECK(!context1.packet_buffer_pool().allocate());
+
+    // second context is not affected
+    void* buffer = context2.packet_buffer_pool().allocate();
+    CHECK(buffer);
+
+    context2.packet_buffer_pool().deallocate(buffer);
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        context1.packet_buffer_pool().deallocate(buffers[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().used_bytes);
+}
+
+TEST(shared_pools, shared_limit) {
+    SharedPoolsConfig pools_config;
+
+    size_t buffer_size = 0;
+    {
+        SharedPools pools(pools_config, arena);
+        buffer_size = pools.packet_buffer_pool().allocation_size();
+    }
+
+    pools_config.max_memory = buffer_size * NumBuffers;
+    SharedPools pools(pools_config, arena);
+
+    ContextConfig context_config;
+    Context context1(context_config, pools, arena);
+    Context context2(context_config, pools, arena);
+
+    void* buffers[NumBuffers] = {};
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        Context& context = n % 2 == 0 ? context1 : context2;
+        buffers[n] = context.packet_buffer_pool().allocate();
+        CHECK(buffers[n]);
+    }
+
+    // both contexts are limited by shared limit
+    CHECK(!context1.packet_buffer_pool().allocate());
+    CHECK(!context2.packet_buffer_pool().allocate());
+
+    // memory is available again after other context releases it
+    context2.packet_buffer_pool().deallocate(buffers[1]);
+
+    buffers[1] = context1.packet_buffer_pool().allocate();
+    CHECK(buffers[1]);
+
+    UNSIGNED_LONGS_EQUAL(buffer_size * (NumBuffers / 2 + 1), context1.memory_usage());
+    UNSIGNED_LONGS_EQUAL(buffer_size * (NumBuffers / 2 - 1), context2.memory_usage());
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        Context& context = n % 2 == 0 || n == 1 ? context1 : context2;
+        context.packet_buffer_pool().deallocate(buffers[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().used_bytes);
+}
+
+TEST(shared_pools, reclaim) {
+    SharedPoolsConfig pools_config;
+    SharedPools pools(pools_config, arena);
+
+    ContextConfig context_config;
+    Context context(context_config, pools, arena);
+
+    void* buffers[NumBuffers] = {};
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        buffers[n] = context.frame_buffer_pool().allocate();
+        CHECK(buffers[n]);
+    }
+
+    // all slabs are used
+    UNSIGNED_LONGS_EQUAL(0, pools.reclaim());
+
+    for (size_t n = 0; n < NumBuffers; n++) {
+        context.frame_buffer_pool().deallocate(buffers[n]);
+    }
+
+    const size_t allocated_bytes = pools.metrics().allocated_bytes;
+    CHECK(allocated_bytes > 0);
+
+    // all slabs are free
+    UNSIGNED_LONGS_EQUAL(allocated_bytes, pools.reclaim());
+
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().used_bytes);
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().allocated_bytes);
+    UNSIGNED_LONGS_EQUAL(allocated_bytes, pools.metrics().reclaimed_bytes);
+}
+
+TEST(shared_pools, reclaim_on_context_close) {
+    SharedPoolsConfig pools_config;
+    SharedPools pools(pools_config, arena);
+
+    {
+        ContextConfig context_config;
+        Context context(context_config, pools, arena);
+
+        void* buffer = context.frame_buffer_pool().allocate();
+        CHECK(buffer);
+
+        context.frame_buffer_pool().deallocate(buffer);
+
+        CHECK(pools.metrics().allocated_bytes > 0);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pools.metrics().allocated_bytes);
+    CHECK(pools.metrics().reclaimed_bytes > 0);
+}
+
+TEST(shared_pools, sizes_exceed_limits) {
+    SharedPoolsConfig pools_config;
+    SharedPools pools(pools_config, arena);
+
+    {
+        ContextConfig context_config;
+        context_config.max_packet_size = pools_config.max_packet_size + 1;
+
+        Context context(context_config, pools, arena);
+        CHECK(!context.is_valid());
+    }
+
+    {
+        ContextConfig context_config;
+        context_config.max_frame_size = pools_config.max_frame_size + 1;
+
+        Context context(context_config, pools, arena);
+        CHECK(!context.is_valid());
+    }
+}
+
+} // namespace node
+} // namespace roc
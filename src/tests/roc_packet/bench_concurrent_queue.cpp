@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/optional.h"
+#include "roc_core/panic.h"
+#include "roc_core/thread.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// One thread writes packets, like network thread, and another thread reads
+// them in batches, like pipeline thread.
+enum { NumPackets = 1024, ReadBatch = 64, NumIterations = 2000000, MaxBufSize = 100 };
+
+enum QueueKind { Queue_Mpsc, Queue_Spsc };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+class WriterThread : public core::Thread {
+public:
+    WriterThread(ConcurrentQueue& queue, core::Atomic<int>& n_read)
+        : queue_(queue)
+        , n_read_(n_read) {
+        for (size_t n = 0; n < NumPackets; n++) {
+            packets_[n] = packet_factory.new_packet();
+            roc_panic_if(!packets_[n]);
+        }
+    }
+
+private:
+    virtual void run() {
+        for (int n = 0; n < NumIterations; n++) {
+            // Packets are reused cyclically, wait until packet is not in queue.
+            while (n - n_read_ >= NumPackets - ReadBatch) {
+            }
+
+            // SPSC queue is bounded, retry until reader frees space.
+            while (queue_.write(packets_[n % NumPackets]) != status::StatusOK) {
+            }
+        }
+    }
+
+    ConcurrentQueue& queue_;
+    core::Atomic<int>& n_read_;
+    PacketPtr packets_[NumPackets];
+};
+
+void BM_ConcurrentQueue(benchmark::State& state) {
+    const QueueKind kind = (QueueKind)state.range(0);
+    const ConcurrentQueue::Mode mode = (ConcurrentQueue::Mode)state.range(1);
+
+    core::Optional<ConcurrentQueue> queue;
+    if (kind == Queue_Spsc) {
+        queue.reset(new (queue) ConcurrentQueue(mode, arena, NumPackets));
+    } else {
+        queue.reset(new (queue) ConcurrentQueue(mode));
+    }
+    roc_panic_if(!queue->is_valid());
+
+    core::Atomic<int> n_read(0);
+
+    WriterThread writer(*queue, n_read);
+    (void)writer.start();
+
+    PacketPtr packets[ReadBatch];
+
+    while (state.KeepRunningBatch(ReadBatch)) {
+        for (size_t n = 0; n < ReadBatch;) {
+            size_t n_packets = 0;
+            if (queue->read_batch(packets, ReadBatch - n, n_packets)
+                == status::StatusOK) {
+                n += n_packets;
+                n_read += (int)n_packets;
+            }
+        }
+    }
+
+    writer.join();
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ConcurrentQueue)
+    ->ArgPair(Queue_Mpsc, ConcurrentQueue::NonBlocking)
+    ->ArgPair(Queue_Spsc, ConcurrentQueue::NonBlocking)
+    ->ArgPair(Queue_Mpsc, ConcurrentQueue::Blocking)
+    ->ArgPair(Queue_Spsc, ConcurrentQueue::Blocking)
+    ->Iterations(NumIterations)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/router.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// Packets are written through router to concurrent queue, like packets received
+// by network thread, and then read from queue, like pipeline thread does.
+enum { MaxBatchSize = 64, MaxBufSize = 100 };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+struct BenchPackets {
+    BenchPackets() {
+        for (size_t n = 0; n < MaxBatchSize; n++) {
+            packets[n] = packet_factory.new_packet();
+            roc_panic_if(!packets[n]);
+            packets[n]->add_flags(Packet::FlagUDP | Packet::FlagRTP | Packet::FlagAudio);
+            packets[n]->rtp()->source_id = 1;
+        }
+    }
+
+    PacketPtr packets[MaxBatchSize];
+    PacketPtr read_packets[MaxBatchSize];
+};
+
+void BM_PacketBatching_PerPacket(benchmark::State& state) {
+    const size_t batch_size = (size_t)state.range(0);
+
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+    Router router(arena);
+    roc_panic_if(!router.add_route(queue, Packet::FlagAudio));
+
+    BenchPackets bp;
+
+    while (state.KeepRunningBatch((int64_t)batch_size)) {
+        for (size_t n = 0; n < batch_size; n++) {
+            roc_panic_if(router.write(bp.packets[n]) != status::StatusOK);
+        }
+        for (size_t n = 0; n < batch_size; n++) {
+            roc_panic_if(queue.read(bp.read_packets[n]) != status::StatusOK);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PacketBatching_Batch(benchmark::State& state) {
+    const size_t batch_size = (size_t)state.range(0);
+
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+    Router router(arena);
+    roc_panic_if(!router.add_route(queue, Packet::FlagAudio));
+
+    BenchPackets bp;
+
+    while (state.KeepRunningBatch((int64_t)batch_size)) {
+        roc_panic_if(router.write_batch(bp.packets, batch_size) != status::StatusOK);
+
+        size_t n_packets = 0;
+        roc_panic_if(queue.read_batch(bp.read_packets, batch_size, n_packets)
+                     != status::StatusOK);
+        roc_panic_if(n_packets != batch_size);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PacketBatching_PerPacket)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(MaxBatchSize)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PacketBatching_Batch)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(MaxBatchSize)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/seqnum_queue.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// NumPackets should be a power of two that is larger than queue depth plus
+// reordering distance, so that packets can be reused cyclically.
+enum { NumPackets = 16384, MaxBufSize = 100 };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+struct BenchConfig {
+    // Number of packets in queue.
+    size_t depth;
+    // Percentage of packets that are delivered out of order.
+    unsigned reorder_percent;
+};
+
+const BenchConfig bench_configs[] = {
+    { 64, 0 },
+    { 64, 10 },
+    { 64, 50 },
+    { 512, 0 },
+    { 512, 10 },
+    { 512, 50 },
+    { 4096, 0 },
+    { 4096, 10 },
+    { 4096, 50 },
+};
+
+class BenchStream {
+public:
+    explicit BenchStream(const BenchConfig& config)
+        : pos_(0) {
+        for (size_t n = 0; n < NumPackets; n++) {
+            packets_[n] = packet_factory.new_packet();
+            roc_panic_if(!packets_[n]);
+            packets_[n]->add_flags(Packet::FlagRTP);
+            order_[n] = (seqnum_t)n;
+        }
+
+        // Move some packets forward by up to half of queue depth.
+        const size_t max_distance = config.depth / 2;
+        for (size_t n = 0; n < NumPackets - max_distance; n++) {
+            if (core::fast_random_range(1, 100) <= config.reorder_percent) {
+                const size_t m = n + core::fast_random_range(1, (uint32_t)max_distance);
+                const seqnum_t tmp = order_[n];
+                order_[n] = order_[m];
+                order_[m] = tmp;
+            }
+        }
+    }
+
+    const PacketPtr& next() {
+        const size_t base = pos_ - pos_ % NumPackets;
+        const seqnum_t sn = seqnum_t(base + order_[pos_ % NumPackets]);
+        pos_++;
+
+        const PacketPtr& pp = packets_[sn % NumPackets];
+        pp->rtp()->seqnum = sn;
+        return pp;
+    }
+
+private:
+    size_t pos_;
+    PacketPtr packets_[NumPackets];
+    seqnum_t order_[NumPackets];
+};
+
+void bench_queue(benchmark::State& state, ISortedQueue& queue) {
+    const BenchConfig& config = bench_configs[state.range(0)];
+
+    BenchStream* stream = new (arena) BenchStream(config);
+
+    for (size_t n = 0; n < config.depth; n++) {
+        roc_panic_if(queue.write(stream->next()) != status::StatusOK);
+    }
+
+    size_t num_packets = 0;
+
+    while (state.KeepRunning()) {
+        roc_panic_if(queue.write(stream->next()) != status::StatusOK);
+
+        PacketPtr pp;
+        roc_panic_if(queue.read(pp) != status::StatusOK);
+        benchmark::DoNotOptimize(pp);
+
+        num_packets++;
+    }
+
+    arena.destroy_object(*stream);
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_packets, benchmark::Counter::kIsRate);
+}
+
+// Measures how much time it takes to write and read one packet when given
+// number of packets is kept in queue and part of packets arrive out of order.
+// Argument is an index in bench_configs.
+void BM_SortedQueue(benchmark::State& state) {
+    SortedQueue queue(0);
+    bench_queue(state, queue);
+}
+
+BENCHMARK(BM_SortedQueue)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kNanosecond);
+
+// Same for queue indexed by seqnum.
+void BM_SeqnumQueue(benchmark::State& state) {
+    SeqnumQueue queue(0, arena);
+    roc_panic_if(!queue.is_valid());
+    bench_queue(state, queue);
+}
+
+BENCHMARK(BM_SeqnumQueue)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
@@ -154,5 +154,152 @@ TEST(concurrent_queue, nonblocking_queue_read_empty) {
     }
 }
 
+TEST(concurrent_queue, blocking_queue_write_batch_read_batch) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+        }
+
+        LONGS_EQUAL(status::StatusOK,
+                    queue.write_batch(packets, ROC_ARRAY_SIZE(packets)));
+
+        // first batch is limited by max_packets
+        PacketPtr read_packets[ROC_ARRAY_SIZE(packets)];
+        size_t n_packets = 0;
+        LONGS_EQUAL(status::StatusOK, queue.read_batch(read_packets, 4, n_packets));
+        UNSIGNED_LONGS_EQUAL(4, n_packets);
+
+        // second batch is limited by queue size, and doesn't block
+        LONGS_EQUAL(status::StatusOK,
+                    queue.read_batch(read_packets + 4, ROC_ARRAY_SIZE(read_packets),
+                                     n_packets));
+        UNSIGNED_LONGS_EQUAL(6, n_packets);
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            CHECK(read_packets[j] == packets[j]);
+        }
+    }
+}
+
+TEST(concurrent_queue, nonblocking_queue_write_batch_read_batch) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+        }
+
+        LONGS_EQUAL(status::StatusOK,
+                    queue.write_batch(packets, ROC_ARRAY_SIZE(packets)));
+
+        PacketPtr read_packets[ROC_ARRAY_SIZE(packets) + 1];
+        size_t n_packets = 0;
+        LONGS_EQUAL(status::StatusOK,
+                    queue.read_batch(read_packets, ROC_ARRAY_SIZE(read_packets),
+                                     n_packets));
+        UNSIGNED_LONGS_EQUAL(ROC_ARRAY_SIZE(packets), n_packets);
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            CHECK(read_packets[j] == packets[j]);
+        }
+
+        LONGS_EQUAL(status::StatusNoData,
+                    queue.read_batch(read_packets, ROC_ARRAY_SIZE(read_packets),
+                                     n_packets));
+        UNSIGNED_LONGS_EQUAL(0, n_packets);
+    }
+}
+
+TEST(concurrent_queue, spsc_blocking_queue_write_many_read_many) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking, arena, 10);
+    CHECK(queue.is_valid());
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+            LONGS_EQUAL(status::StatusOK, queue.write(packets[j]));
+        }
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, queue.read(pp));
+            CHECK(pp == packets[j]);
+        }
+    }
+}
+
+TEST(concurrent_queue, spsc_blocking_queue_read_empty) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking, arena, 10);
+    CHECK(queue.is_valid());
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr wp = new_packet();
+
+        TestWriter writer(queue, wp);
+        CHECK(writer.start());
+
+        PacketPtr rp;
+        LONGS_EQUAL(status::StatusOK, queue.read(rp));
+        CHECK(wp == rp);
+
+        writer.join();
+    }
+}
+
+TEST(concurrent_queue, spsc_nonblocking_queue_read_empty) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking, arena, 10);
+    CHECK(queue.is_valid());
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr wp = new_packet();
+        LONGS_EQUAL(status::StatusOK, queue.write(wp));
+
+        PacketPtr rp;
+        LONGS_EQUAL(status::StatusOK, queue.read(rp));
+        CHECK(wp == rp);
+
+        PacketPtr pp;
+        LONGS_EQUAL(status::StatusNoData, queue.read(pp));
+        CHECK(!pp);
+    }
+}
+
+TEST(concurrent_queue, spsc_queue_full) {
+    enum { Capacity = 5 };
+
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking, arena, Capacity);
+    CHECK(queue.is_valid());
+
+    PacketPtr packets[Capacity + 3];
+
+    for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+        packets[j] = new_packet();
+    }
+
+    LONGS_EQUAL(status::StatusNoSpace,
+                queue.write_batch(packets, ROC_ARRAY_SIZE(packets)));
+
+    PacketPtr read_packets[ROC_ARRAY_SIZE(packets)];
+    size_t n_packets = 0;
+    LONGS_EQUAL(status::StatusOK,
+                queue.read_batch(read_packets, ROC_ARRAY_SIZE(read_packets), n_packets));
+    UNSIGNED_LONGS_EQUAL(Capacity, n_packets);
+
+    for (size_t j = 0; j < Capacity; j++) {
+        CHECK(read_packets[j] == packets[j]);
+    }
+
+    // there is space again
+    LONGS_EQUAL(status::StatusOK, queue.write(packets[Capacity]));
+}
+
 } // namespace packet
 } // namespace roc
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/time.h"
+#include "roc_packet/pacer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { SampleRate = 1000, NumSamples = 10, NumPackets = 8, MaxBufSize = 100 };
+
+const core::nanoseconds_t PacketDuration = NumSamples * core::Second / SampleRate;
+
+const audio::SampleSpec sample_spec(SampleRate,
+                                    audio::Sample_RawFormat,
+                                    audio::ChanLayout_Surround,
+                                    audio::ChanOrder_Smpte,
+                                    audio::ChanMask_Surround_Stereo);
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+PacketPtr new_audio_packet(seqnum_t sn, stream_timestamp_t sts, size_t duration) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP | Packet::FlagAudio);
+    packet->rtp()->seqnum = sn;
+    packet->rtp()->stream_timestamp = sts;
+    packet->rtp()->duration = (stream_timestamp_t)duration;
+
+    return packet;
+}
+
+PacketPtr new_repair_packet() {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRepair);
+
+    return packet;
+}
+
+core::nanoseconds_t send_ts(const PacketPtr& packet) {
+    CHECK(packet->udp());
+    return packet->udp()->send_timestamp;
+}
+
+void expect_output(Queue& queue, const PacketPtr* packets, size_t n_packets) {
+    UNSIGNED_LONGS_EQUAL(n_packets, queue.size());
+
+    for (size_t n = 0; n < n_packets; n++) {
+        PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, queue.read(pp));
+        CHECK(pp == packets[n]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(pacer) {};
+
+TEST(pacer, spread_by_stream_timestamp) {
+    Queue queue;
+    Pacer pacer(queue, PacerConfig(), sample_spec, arena);
+    CHECK(pacer.is_valid());
+
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_audio_packet(seqnum_t(n), stream_timestamp_t(n * NumSamples),
+                                      NumSamples);
+    }
+
+    const core::nanoseconds_t before = core::timestamp(core::ClockMonotonic);
+    LONGS_EQUAL(status::StatusOK, pacer.write_batch(packets, NumPackets / 2));
+    const core::nanoseconds_t after = core::timestamp(core::ClockMonotonic);
+
+    // first packet is sent immediately and establishes time base
+    CHECK(send_ts(packets[0]) >= before);
+    CHECK(send_ts(packets[0]) <= after);
+
+    for (size_t n = NumPackets / 2; n < NumPackets; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(packets[n]));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(packets[n]->has_flags(Packet::FlagUDP));
+        LONGLONGS_EQUAL(send_ts(packets[0]) + PacketDuration * (core::nanoseconds_t)n,
+                        send_ts(packets[n]));
+    }
+
+    expect_output(queue, packets, NumPackets);
+}
+
+TEST(pacer, spread_repair_packets) {
+    enum { NumSource = 2, NumRepair = 3, NumTotal = NumSource + NumRepair };
+
+    Queue queue;
+    Pacer pacer(queue, PacerConfig(), sample_spec, arena);
+    CHECK(pacer.is_valid());
+
+    PacketPtr packets[NumTotal];
+    for (size_t n = 0; n < NumSource; n++) {
+        packets[n] = new_audio_packet(seqnum_t(n), stream_timestamp_t(n * NumSamples),
+                                      NumSamples);
+    }
+    for (size_t n = NumSource; n < NumTotal; n++) {
+        packets[n] = new_repair_packet();
+    }
+
+    LONGS_EQUAL(status::StatusOK, pacer.write_batch(packets, NumTotal));
+
+    const core::nanoseconds_t last_source_ts = send_ts(packets[NumSource - 1]);
+
+    LONGLONGS_EQUAL(send_ts(packets[0]) + PacketDuration, last_source_ts);
+
+    // repair packets are spread across one packet duration after last source packet
+    for (size_t n = 0; n < NumRepair; n++) {
+        LONGLONGS_EQUAL(last_source_ts
+                            + PacketDuration * (core::nanoseconds_t)(n + 1)
+                                / (NumRepair + 1),
+                        send_ts(packets[NumSource + n]));
+    }
+
+    expect_output(queue, packets, NumTotal);
+
+    // next source packet follows repair packets
+    PacketPtr next = new_audio_packet(NumSource, NumSource * NumSamples, NumSamples);
+    LONGS_EQUAL(status::StatusOK, pacer.write(next));
+
+    LONGLONGS_EQUAL(last_source_ts + PacketDuration, send_ts(next));
+    CHECK(send_ts(next) > send_ts(packets[NumTotal - 1]));
+
+    expect_output(queue, &next, 1);
+}
+
+TEST(pacer, reset_when_ahead) {
+    PacerConfig config;
+    config.max_delay = PacketDuration * 3;
+
+    Queue queue;
+    Pacer pacer(queue, config, sample_spec, arena);
+    CHECK(pacer.is_valid());
+
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_audio_packet(seqnum_t(n), stream_timestamp_t(n * NumSamples),
+                                      NumSamples);
+    }
+
+    const core::nanoseconds_t before = core::timestamp(core::ClockMonotonic);
+    LONGS_EQUAL(status::StatusOK, pacer.write_batch(packets, NumPackets));
+    const core::nanoseconds_t after = core::timestamp(core::ClockMonotonic);
+
+    // packets never delayed more than max_delay, and never reordered
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(send_ts(packets[n]) >= before);
+        CHECK(send_ts(packets[n]) <= after + config.max_delay);
+
+        if (n > 0) {
+            CHECK(send_ts(packets[n]) >= send_ts(packets[n - 1]));
+        }
+    }
+}
+
+TEST(pacer, reset_when_behind) {
+    Queue queue;
+    Pacer pacer(queue, PacerConfig(), sample_spec, arena);
+    CHECK(pacer.is_valid());
+
+    PacketPtr first = new_audio_packet(0, 0, NumSamples);
+    LONGS_EQUAL(status::StatusOK, pacer.write(first));
+
+    core::sleep_for(core::ClockMonotonic, PacketDuration * 2);
+
+    // written after its stream time
+    PacketPtr second = new_audio_packet(1, NumSamples, NumSamples);
+
+    const core::nanoseconds_t before = core::timestamp(core::ClockMonotonic);
+    LONGS_EQUAL(status::StatusOK, pacer.write(second));
+    const core::nanoseconds_t after = core::timestamp(core::ClockMonotonic);
+
+    CHECK(send_ts(second) >= before);
+    CHECK(send_ts(second) <= after);
+
+    // following packets are scheduled relative to new time base
+    PacketPtr third = new_audio_packet(2, NumSamples * 2, NumSamples);
+    LONGS_EQUAL(status::StatusOK, pacer.write(third));
+
+    LONGLONGS_EQUAL(send_ts(second) + PacketDuration, send_ts(third));
+}
+
+TEST(pacer, metrics) {
+    enum { NumFrames = 3, PacketsPerFrame = 4 };
+
+    Queue queue;
+    Pacer pacer(queue, PacerConfig(), sample_spec, arena);
+    CHECK(pacer.is_valid());
+
+    LONGLONGS_EQUAL(0, pacer.metrics().max_delay);
+    UNSIGNED_LONGS_EQUAL(0, pacer.metrics().max_burst);
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        PacketPtr packets[PacketsPerFrame];
+        for (size_t np = 0; np < PacketsPerFrame; np++) {
+            const size_t n = nf * PacketsPerFrame + np;
+            packets[np] = new_audio_packet(
+                seqnum_t(n), stream_timestamp_t(n * NumSamples), NumSamples);
+        }
+
+        LONGS_EQUAL(status::StatusOK, pacer.write_batch(packets, PacketsPerFrame));
+
+        // let all packets of the frame to be sent, and then some more, so that
+        // next frame is written behind its stream time
+        core::sleep_for(core::ClockMonotonic, PacketDuration * PacketsPerFrame * 2);
+    }
+
+    const PacerMetrics metrics = pacer.metrics();
+
+    // every frame is written at once and spread across frame duration
+    LONGLONGS_EQUAL(PacketDuration * (PacketsPerFrame - 1), metrics.max_delay);
+    DOUBLES_EQUAL((double)PacketDuration * (PacketsPerFrame - 1) / 2,
+                  (double)metrics.mean_delay, (double)core::Microsecond);
+
+    // last burst is not complete yet
+    UNSIGNED_LONGS_EQUAL(PacketsPerFrame, metrics.max_burst);
+    DOUBLES_EQUAL((double)PacketsPerFrame, (double)metrics.mean_burst, 0.0001);
+}
+
+} // namespace packet
+} // namespace roc
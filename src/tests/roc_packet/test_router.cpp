@@ -9,6 +9,7 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/queue.h"
 #include "roc_packet/router.h"
@@ -131,6 +132,43 @@ TEST(router, two_routes) {
     LONGS_EQUAL(0, queue_r.size());
 }
 
+TEST(router, write_batch) {
+    Router router(arena);
+
+    Queue queue_a;
+    Queue queue_r;
+    CHECK(router.add_route(queue_a, Packet::FlagAudio));
+    CHECK(router.add_route(queue_r, Packet::FlagRepair));
+
+    PacketPtr wp[6] = {
+        new_rtp_packet(11, Packet::FlagAudio), new_rtp_packet(11, Packet::FlagAudio),
+        new_fec_packet(Packet::FlagRepair),    new_rtp_packet(22, Packet::FlagAudio),
+        new_rtp_packet(11, Packet::FlagAudio), new_fec_packet(Packet::FlagRepair),
+    };
+
+    LONGS_EQUAL(status::StatusOK, router.write_batch(wp, ROC_ARRAY_SIZE(wp)));
+
+    // packet from another source is dropped
+    LONGS_EQUAL(1, wp[3]->getref());
+
+    LONGS_EQUAL(3, queue_a.size());
+    LONGS_EQUAL(2, queue_r.size());
+
+    const size_t exp_a[] = { 0, 1, 4 };
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(exp_a); n++) {
+        PacketPtr rp;
+        LONGS_EQUAL(status::StatusOK, queue_a.read(rp));
+        CHECK(rp == wp[exp_a[n]]);
+    }
+
+    const size_t exp_r[] = { 2, 5 };
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(exp_r); n++) {
+        PacketPtr rp;
+        LONGS_EQUAL(status::StatusOK, queue_r.read(rp));
+        CHECK(rp == wp[exp_r[n]]);
+    }
+}
+
 TEST(router, two_routes_two_sources) {
     Router router(arena);
 
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_packet/queue.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_pipeline/sender_sink.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// Every frame written to sender is split into many small packets, which are
+// delivered to receiver and then read back as one frame.
+enum {
+    SampleRate = 44100,
+    NumChans = 2,
+
+    SamplesPerPacket = 40,
+    SamplesPerFrame = 400,
+    PacketsPerFrame = SamplesPerFrame / SamplesPerPacket,
+
+    LatencyFrames = 4,
+
+    MaxPacketSize = 2000,
+    MaxFrameSize = SamplesPerFrame * NumChans * 2
+};
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    packet_buffer_pool("packet_buffer_pool", arena, sizeof(core::Buffer) + MaxPacketSize);
+core::SlabPool<core::Buffer>
+    frame_buffer_pool("frame_buffer_pool",
+                      arena,
+                      sizeof(core::Buffer) + MaxFrameSize * sizeof(audio::sample_t));
+
+packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
+
+rtp::EncodingMap encoding_map(arena);
+
+const audio::SampleSpec sample_spec(SampleRate,
+                                    audio::Sample_RawFormat,
+                                    audio::ChanLayout_Surround,
+                                    audio::ChanOrder_Smpte,
+                                    audio::ChanMask_Surround_Stereo);
+
+address::SocketAddr make_address(int port) {
+    address::SocketAddr addr;
+    roc_panic_if(!addr.set_host_port(address::Family_IPv4, "127.0.0.1", port));
+    return addr;
+}
+
+SenderSinkConfig make_sender_config() {
+    SenderSinkConfig config;
+
+    config.input_sample_spec = sample_spec;
+    config.payload_type = rtp::PayloadType_L16_Stereo;
+    config.packet_length = SamplesPerPacket * core::Second / SampleRate;
+    config.enable_interleaving = false;
+    config.enable_timing = false;
+
+    return config;
+}
+
+ReceiverSourceConfig make_receiver_config() {
+    ReceiverSourceConfig config;
+
+    config.common.output_sample_spec = sample_spec;
+    config.common.enable_timing = false;
+
+    config.session_defaults.latency.target_latency =
+        LatencyFrames * SamplesPerFrame * core::Second / SampleRate;
+
+    return config;
+}
+
+// Sender and receiver connected by loopback.
+class BenchLoopback {
+public:
+    BenchLoopback()
+        : sender_(make_sender_config(),
+                  encoding_map,
+                  packet_pool,
+                  packet_buffer_pool,
+                  frame_buffer_pool,
+                  arena)
+        , receiver_(make_receiver_config(),
+                    encoding_map,
+                    packet_pool,
+                    packet_buffer_pool,
+                    frame_buffer_pool,
+                    arena)
+        , receiver_writer_(NULL)
+        , src_addr_(make_address(10000))
+        , dst_addr_(make_address(20000))
+        , current_time_(core::Second) {
+        roc_panic_if(!sender_.is_valid());
+        roc_panic_if(!receiver_.is_valid());
+
+        SenderSlot* sender_slot = sender_.create_slot(SenderSlotConfig());
+        roc_panic_if(!sender_slot);
+        roc_panic_if(!sender_slot->add_endpoint(address::Iface_AudioSource,
+                                                address::Proto_RTP, dst_addr_,
+                                                sender_queue_));
+
+        ReceiverSlot* receiver_slot = receiver_.create_slot(ReceiverSlotConfig());
+        roc_panic_if(!receiver_slot);
+        ReceiverEndpoint* receiver_endpoint = receiver_slot->add_endpoint(
+            address::Iface_AudioSource, address::Proto_RTP, dst_addr_, NULL);
+        roc_panic_if(!receiver_endpoint);
+        receiver_writer_ = &receiver_endpoint->inbound_writer();
+
+        for (size_t n = 0; n < SamplesPerFrame * NumChans; n++) {
+            samples_[n] = audio::sample_t(n % 100) / 100.f - 0.5f;
+        }
+    }
+
+    // Write frame to sender and collect produced packets.
+    void send_frame() {
+        audio::Frame frame(samples_, SamplesPerFrame * NumChans);
+        frame.set_duration(SamplesPerFrame);
+
+        sender_.write(frame);
+        sender_.refresh(current_time_);
+
+        n_packets_ = 0;
+
+        packet::PacketPtr pp;
+        while (sender_queue_.read(pp) == status::StatusOK) {
+            roc_panic_if(n_packets_ == PacketsPerFrame);
+            packets_[n_packets_++] = copy_packet_(pp);
+        }
+    }
+
+    // Deliver collected packets to receiver one by one.
+    void deliver_per_packet() {
+        for (size_t n = 0; n < n_packets_; n++) {
+            roc_panic_if(receiver_writer_->write(packets_[n]) != status::StatusOK);
+        }
+    }
+
+    // Deliver collected packets to receiver in one batch.
+    void deliver_batch() {
+        roc_panic_if(receiver_writer_->write_batch(packets_, n_packets_)
+                     != status::StatusOK);
+    }
+
+    // Read frame from receiver.
+    void receive_frame() {
+        receiver_.refresh(current_time_);
+
+        audio::Frame frame(samples_, SamplesPerFrame * NumChans);
+        roc_panic_if(!receiver_.read(frame));
+
+        current_time_ += sample_spec.samples_per_chan_2_ns(SamplesPerFrame);
+    }
+
+    size_t num_packets() const {
+        return n_packets_;
+    }
+
+    size_t num_sessions() const {
+        return receiver_.num_sessions();
+    }
+
+private:
+    // Receiver should see packet without meta-information, as if it
+    // was delivered over network.
+    packet::PacketPtr copy_packet_(const packet::PacketPtr& pa) {
+        packet::PacketPtr pb = packet_factory.new_packet();
+        roc_panic_if(!pb);
+
+        pb->add_flags(packet::Packet::FlagUDP);
+        pb->udp()->src_addr = src_addr_;
+        pb->udp()->dst_addr = dst_addr_;
+        pb->set_buffer(pa->buffer());
+
+        return pb;
+    }
+
+    SenderSink sender_;
+    ReceiverSource receiver_;
+
+    packet::Queue sender_queue_;
+    packet::IWriter* receiver_writer_;
+
+    address::SocketAddr src_addr_;
+    address::SocketAddr dst_addr_;
+
+    packet::PacketPtr packets_[PacketsPerFrame];
+    size_t n_packets_;
+
+    core::nanoseconds_t current_time_;
+
+    audio::sample_t samples_[SamplesPerFrame * NumChans];
+};
+
+void bench_loopback(benchmark::State& state, bool batch) {
+    BenchLoopback loopback;
+
+    size_t num_packets = 0;
+
+    for (size_t nf = 0; nf < LatencyFrames; nf++) {
+        loopback.send_frame();
+        loopback.deliver_per_packet();
+    }
+
+    while (state.KeepRunning()) {
+        loopback.send_frame();
+
+        if (batch) {
+            loopback.deliver_batch();
+        } else {
+            loopback.deliver_per_packet();
+        }
+
+        loopback.receive_frame();
+
+        num_packets += loopback.num_packets();
+    }
+
+    if (loopback.num_sessions() != 1) {
+        state.SkipWithError("session was terminated");
+    }
+
+    state.counters["packets"] =
+        benchmark::Counter((double)num_packets, benchmark::Counter::kIsRate);
+}
+
+// Measures packets/sec through SenderSink -> ReceiverSource loopback, when
+// packets are delivered to receiver endpoint one by one.
+void BM_LoopbackSink2Source_PerPacket(benchmark::State& state) {
+    bench_loopback(state, false);
+}
+
+BENCHMARK(BM_LoopbackSink2Source_PerPacket)->Unit(benchmark::kMicrosecond);
+
+// Same, but packets produced from one frame are delivered to receiver
+// endpoint in one batch, like network thread does after recvmmsg().
+void BM_LoopbackSink2Source_Batch(benchmark::State& state) {
+    bench_loopback(state, true);
+}
+
+BENCHMARK(BM_LoopbackSink2Source_Batch)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
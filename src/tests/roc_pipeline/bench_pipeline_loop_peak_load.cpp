@@ -43,9 +43,10 @@ namespace {
 // Benchmarks
 // ----------
 //
-// Bench_NoTasks         - frames without tasks
-// Bench_NoPreciseSched  - frames and tasks, precise task scheduling is disabled
-// Bench_Normal          - frames and tasks, precise task scheduling is enabled
+// Bench_NoTasks           - frames without tasks
+// Bench_NoPreciseSched    - frames and tasks, precise task scheduling is disabled
+// Bench_Normal            - frames and tasks, precise task scheduling is enabled
+// Bench_AdaptiveSubframes - same as above, with adaptive sub-frame size
 //
 // The first benchmark gives us an idea how the unloaded pipeline operates and
 // what are its normal frame processing timings.
@@ -65,6 +66,14 @@ namespace {
 //    cancellations (sc)
 //  - task processing time (t_avg t_p95) is slightly increased
 //
+// The fourth benchmark enables adaptive sub-frame size. Instead of splitting
+// frames into sub-frames of fixed duration, sub-frame size is selected from
+// measured processing cost and pending tasks. Compare number of sub-frames (sf)
+// and delay after frame processing (fa_avg, fa_p95) with the third benchmark:
+// each sub-frame has fixed overhead (SubframeOverhead), so fewer sub-frames
+// means less total processing time, while task processing delay (t_avg, t_p95)
+// is bounded by config.max_subframe_processing.
+//
 // --------------
 // Output columns
 // --------------
@@ -96,6 +105,8 @@ namespace {
 //
 // ss          -  number of time when schedule_task_processing() was called
 // sc          -  number of time when cancek_task_processing() was called
+//
+// sf          -  average number of sub-frames per frame
 
 enum {
     SampleRate = 1000000, // 1 sample = 1 us (for convenience)
@@ -108,6 +119,9 @@ enum {
 // computation time of a frame
 const core::nanoseconds_t FrameProcessingDuration = 3 * core::Millisecond;
 
+// additional computation time of every sub-frame
+const core::nanoseconds_t SubframeOverhead = 50 * core::Microsecond;
+
 // computation time of a task
 const core::nanoseconds_t MinTaskProcessingDuration = 5 * core::Microsecond;
 const core::nanoseconds_t MaxTaskProcessingDuration = 15 * core::Microsecond;
@@ -279,7 +293,9 @@ public:
                                          Chans))
         , stats_(stats)
         , control_queue_(control_queue)
-        , control_task_(*this) {
+        , control_task_(*this)
+        , n_subframes_(0)
+        , n_frames_(0) {
     }
 
     ~TestPipeline() {
@@ -296,7 +312,7 @@ public:
     }
 
     void export_counters(benchmark::State& state) {
-        PipelineLoop::Stats st = get_stats_ref();
+        PipelineLoop::Stats st = get_stats();
 
         state.counters["tp_plc"] =
             round_digits(double(st.task_processed_in_place) / st.task_processed_total, 3);
@@ -308,9 +324,14 @@ public:
 
         state.counters["ss"] = st.scheduler_calls;
         state.counters["sc"] = st.scheduler_cancellations;
+
+        state.counters["sf"] = round_digits(double(n_subframes_) / n_frames_, 3);
     }
 
-    using PipelineLoop::process_subframes_and_tasks;
+    bool process_subframes_and_tasks(audio::Frame& frame) {
+        n_frames_++;
+        return PipelineLoop::process_subframes_and_tasks(frame);
+    }
 
 private:
     struct BackgroundProcessingTask : ctl::ControlTask {
@@ -330,9 +351,13 @@ private:
         return 0;
     }
 
-    virtual bool process_subframe_imp(audio::Frame&) {
+    virtual bool process_subframe_imp(audio::Frame& frame) {
         stats_.frame_processing_started();
-        busy_wait(FrameProcessingDuration);
+        n_subframes_++;
+        // processing time is proportional to sub-frame duration
+        busy_wait(FrameProcessingDuration * (core::nanoseconds_t)frame.duration()
+                      / FrameSize
+                  + SubframeOverhead);
         stats_.frame_processing_finished();
         return true;
     }
@@ -362,6 +387,9 @@ private:
 
     ctl::ControlTaskQueue& control_queue_;
     BackgroundProcessingTask control_task_;
+
+    size_t n_subframes_;
+    size_t n_frames_;
 };
 
 class TaskThread : public core::Thread, private IPipelineTaskCompleter {
@@ -418,6 +446,7 @@ public:
         audio::sample_t data[FrameSize];
 
         audio::Frame frame(data, FrameSize);
+        frame.set_duration(FrameSize);
 
         while (state_.KeepRunning()) {
             ticker.wait(ts);
@@ -519,6 +548,37 @@ BENCHMARK(BM_PipelinePeakLoad_PreciseSchedOn)
     ->UseRealTime()
     ->Unit(benchmark::kMicrosecond);
 
+void BM_PipelinePeakLoad_AdaptiveSubframes(benchmark::State& state) {
+    ctl::ControlTaskQueue control_queue;
+
+    DelayStats stats;
+
+    PipelineLoopConfig config;
+    config.enable_precise_task_scheduling = true;
+    config.enable_adaptive_subframes = true;
+
+    TestPipeline pipeline(config, control_queue, stats);
+
+    TaskThread task_thr(pipeline);
+
+    FrameWriter frame_wr(pipeline, stats, state);
+
+    (void)task_thr.start();
+
+    frame_wr.run();
+
+    task_thr.stop();
+    task_thr.join();
+
+    stats.export_counters(state);
+    pipeline.export_counters(state);
+}
+
+BENCHMARK(BM_PipelinePeakLoad_AdaptiveSubframes)
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 } // namespace pipeline
 } // namespace roc
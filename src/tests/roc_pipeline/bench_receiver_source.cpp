@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_core/array.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// Packets and frames have the same duration (10ms), but different rates,
+// so that every session has a resampler in its pipeline.
+enum {
+    PacketRate = 44100,
+    OutputRate = 48000,
+    NumChans = 2,
+
+    SamplesPerPacket = 441,
+    SamplesPerFrame = 480,
+
+    LatencyPackets = 4,
+
+    MaxPacketSize = 2000,
+    MaxFrameSize = SamplesPerFrame * NumChans * 2
+};
+
+const core::nanoseconds_t FrameDuration = 10 * core::Millisecond;
+
+struct BenchConfig {
+    // Number of sessions.
+    size_t num_sessions;
+    // Number of shards or session threads, depending on benchmark.
+    size_t num_threads;
+};
+
+const BenchConfig bench_configs[] = {
+    { 16, 0 },
+    { 16, 2 },
+    { 16, 4 },
+    { 64, 0 },
+    { 64, 2 },
+    { 64, 4 },
+    { 64, 8 },
+};
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    packet_buffer_pool("packet_buffer_pool", arena, sizeof(core::Buffer) + MaxPacketSize);
+core::SlabPool<core::Buffer>
+    frame_buffer_pool("frame_buffer_pool",
+                      arena,
+                      sizeof(core::Buffer) + MaxFrameSize * sizeof(audio::sample_t));
+
+packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
+
+rtp::EncodingMap encoding_map(arena);
+
+address::SocketAddr make_address(int port) {
+    address::SocketAddr addr;
+    roc_panic_if(!addr.set_host_port(address::Family_IPv4, "127.0.0.1", port));
+    return addr;
+}
+
+// Produces RTP packets of one session and writes them to receiver endpoint.
+class BenchSender {
+public:
+    BenchSender(packet::IWriter& writer,
+                size_t index,
+                const address::SocketAddr& dst_addr)
+        : writer_(writer)
+        , composer_(NULL)
+        , encoder_(audio::SampleSpec(PacketRate,
+                                     audio::PcmFormat_SInt16_Be,
+                                     audio::ChanLayout_Surround,
+                                     audio::ChanOrder_Smpte,
+                                     audio::ChanMask_Surround_Stereo))
+        , src_addr_(make_address(int(10000 + index)))
+        , dst_addr_(dst_addr)
+        , source_id_(packet::stream_source_t(index + 1))
+        , seqnum_(0)
+        , timestamp_(0) {
+        for (size_t n = 0; n < SamplesPerPacket * NumChans; n++) {
+            samples_[n] = audio::sample_t(n % 100) / 100.f - 0.5f;
+        }
+    }
+
+    void write_packet() {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        pp->add_flags(packet::Packet::FlagAudio);
+
+        core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+        roc_panic_if(!buf);
+
+        roc_panic_if(!composer_.prepare(*pp, buf,
+                                        encoder_.encoded_byte_count(SamplesPerPacket)));
+        pp->set_buffer(buf);
+
+        pp->rtp()->source_id = source_id_;
+        pp->rtp()->seqnum = seqnum_++;
+        pp->rtp()->stream_timestamp = timestamp_;
+        pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+
+        timestamp_ += SamplesPerPacket;
+
+        encoder_.begin(pp->rtp()->payload.data(), pp->rtp()->payload.size());
+        encoder_.write(samples_, SamplesPerPacket);
+        encoder_.end();
+
+        roc_panic_if(!composer_.compose(*pp));
+
+        // Receiver should see packet without meta-information, as if it
+        // was delivered over network.
+        packet::PacketPtr rp = packet_factory.new_packet();
+        roc_panic_if(!rp);
+
+        rp->add_flags(packet::Packet::FlagUDP);
+        rp->udp()->src_addr = src_addr_;
+        rp->udp()->dst_addr = dst_addr_;
+        rp->set_buffer(pp->buffer());
+
+        roc_panic_if(writer_.write(rp) != status::StatusOK);
+    }
+
+private:
+    packet::IWriter& writer_;
+
+    rtp::Composer composer_;
+    audio::PcmEncoder encoder_;
+
+    address::SocketAddr src_addr_;
+    address::SocketAddr dst_addr_;
+
+    packet::stream_source_t source_id_;
+    packet::seqnum_t seqnum_;
+    packet::stream_timestamp_t timestamp_;
+
+    audio::sample_t samples_[SamplesPerPacket * NumChans];
+};
+
+ReceiverSourceConfig make_config() {
+    ReceiverSourceConfig config;
+
+    config.common.output_sample_spec =
+        audio::SampleSpec(OutputRate, audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                          audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo);
+
+    config.session_defaults.latency.target_latency = LatencyPackets * FrameDuration;
+
+    return config;
+}
+
+void bench_receiver_source(benchmark::State& state,
+                           ReceiverSource& receiver,
+                           core::Array<BenchSender*>& senders) {
+    const size_t num_sessions = senders.size();
+
+    for (size_t np = 0; np < LatencyPackets; np++) {
+        for (size_t n = 0; n < num_sessions; n++) {
+            senders[n]->write_packet();
+        }
+    }
+
+    audio::sample_t samples[SamplesPerFrame * NumChans];
+    core::nanoseconds_t current_time = core::Second;
+
+    size_t num_frames = 0;
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < num_sessions; n++) {
+            senders[n]->write_packet();
+        }
+
+        receiver.refresh(current_time);
+
+        audio::Frame frame(samples, SamplesPerFrame * NumChans);
+        roc_panic_if(!receiver.read(frame));
+
+        current_time += FrameDuration;
+        num_frames++;
+    }
+
+    if (receiver.num_sessions() != num_sessions) {
+        state.SkipWithError("sessions were terminated");
+    }
+
+    for (size_t n = 0; n < num_sessions; n++) {
+        arena.destroy_object(*senders[n]);
+    }
+
+    state.counters["rate"] =
+        benchmark::Counter((double)num_frames, benchmark::Counter::kIsRate);
+}
+
+// Measures how much time it takes to receive one frame from many sessions,
+// each in its own slot, when slots are distributed between shards.
+// Every iteration, one packet is written to every session, and one frame is
+// read from receiver.
+// Argument is an index in bench_configs, zero threads means no sharding.
+void BM_ReceiverSource_Shards(benchmark::State& state) {
+    const BenchConfig& bench_config = bench_configs[state.range(0)];
+
+    ReceiverSourceConfig config = make_config();
+    config.num_shards = bench_config.num_threads;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    roc_panic_if(!receiver.is_valid());
+
+    core::Array<BenchSender*> senders(arena);
+    roc_panic_if(!senders.grow(bench_config.num_sessions));
+
+    for (size_t n = 0; n < bench_config.num_sessions; n++) {
+        const address::SocketAddr dst_addr = make_address(int(20000 + n));
+
+        ReceiverSlot* slot = receiver.create_slot(ReceiverSlotConfig());
+        roc_panic_if(!slot);
+
+        ReceiverEndpoint* endpoint = slot->add_endpoint(
+            address::Iface_AudioSource, address::Proto_RTP, dst_addr, NULL);
+        roc_panic_if(!endpoint);
+
+        roc_panic_if(!senders.push_back(
+            new (arena) BenchSender(endpoint->inbound_writer(), n, dst_addr)));
+    }
+
+    bench_receiver_source(state, receiver, senders);
+}
+
+BENCHMARK(BM_ReceiverSource_Shards)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Same, but all sessions are in one slot, and are read in parallel
+// by session threads of that slot.
+// Argument is an index in bench_configs, zero threads means sequential reading.
+void BM_ReceiverSource_SessionThreads(benchmark::State& state) {
+    const BenchConfig& bench_config = bench_configs[state.range(0)];
+
+    ReceiverSourceConfig config = make_config();
+    config.num_session_threads = bench_config.num_threads;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    roc_panic_if(!receiver.is_valid());
+
+    const address::SocketAddr dst_addr = make_address(20000);
+
+    ReceiverSlot* slot = receiver.create_slot(ReceiverSlotConfig());
+    roc_panic_if(!slot);
+
+    ReceiverEndpoint* endpoint = slot->add_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP, dst_addr, NULL);
+    roc_panic_if(!endpoint);
+
+    core::Array<BenchSender*> senders(arena);
+    roc_panic_if(!senders.grow(bench_config.num_sessions));
+
+    for (size_t n = 0; n < bench_config.num_sessions; n++) {
+        roc_panic_if(!senders.push_back(
+            new (arena) BenchSender(endpoint->inbound_writer(), n, dst_addr)));
+    }
+
+    bench_receiver_source(state, receiver, senders);
+}
+
+BENCHMARK(BM_ReceiverSource_SessionThreads)
+    ->DenseRange(0, ROC_ARRAY_SIZE(bench_configs) - 1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
@@ -98,7 +98,10 @@ enum {
     FlagRTCP = (1 << 6),
 
     // enable capture timestamps
-    FlagCTS = (1 << 7)
+    FlagCTS = (1 << 7),
+
+    // enable FEC repair packet pacing on sender
+    FlagRepairPacing = (1 << 8)
 };
 
 core::HeapArena arena;
@@ -136,6 +139,8 @@ public:
         , n_source_(0)
         , n_repair_(0)
         , n_control_(0)
+        , repair_run_(0)
+        , max_repair_run_(0)
         , flags_(flags)
         , counter_(0) {
     }
@@ -152,6 +157,11 @@ public:
         return n_control_;
     }
 
+    // max number of repair packets sent in a row, without source packets
+    size_t max_repair_run() const {
+        return max_repair_run_;
+    }
+
     void deliver_from(packet::IReader& reader) {
         for (;;) {
             packet::PacketPtr pp;
@@ -161,6 +171,13 @@ public:
                 break;
             }
 
+            if (pp->flags() & packet::Packet::FlagRepair) {
+                repair_run_++;
+                max_repair_run_ = std::max(max_repair_run_, repair_run_);
+            } else if (pp->flags() & packet::Packet::FlagAudio) {
+                repair_run_ = 0;
+            }
+
             if ((flags_ & FlagLosses)
                 && counter_++ % (SourcePackets + RepairPackets) == 1) {
                 continue;
@@ -231,10 +248,21 @@ private:
     size_t n_repair_;
     size_t n_control_;
 
+    size_t repair_run_;
+    size_t max_repair_run_;
+
     int flags_;
     size_t counter_;
 };
 
+size_t select_latency(int flags) {
+    if (flags & FlagRepairPacing) {
+        // repair packets of a block are sent together with next block
+        return Latency * 2;
+    }
+    return Latency;
+}
+
 SenderSinkConfig make_sender_config(int flags,
                                     audio::ChannelMask frame_channels,
                                     audio::ChannelMask packet_channels) {
@@ -268,6 +296,7 @@ SenderSinkConfig make_sender_config(int flags,
 
     config.fec_writer.n_source_packets = SourcePackets;
     config.fec_writer.n_repair_packets = RepairPackets;
+    config.fec_writer.enable_repair_pacing = (flags & FlagRepairPacing);
 
     config.enable_interleaving = (flags & FlagInterleaving);
     config.enable_timing = false;
@@ -282,7 +311,8 @@ SenderSinkConfig make_sender_config(int flags,
     return config;
 }
 
-ReceiverSourceConfig make_receiver_config(audio::ChannelMask frame_channels,
+ReceiverSourceConfig make_receiver_config(int flags,
+                                          audio::ChannelMask frame_channels,
                                           audio::ChannelMask packet_channels) {
     ReceiverSourceConfig config;
 
@@ -300,7 +330,8 @@ ReceiverSourceConfig make_receiver_config(audio::ChannelMask frame_channels,
 
     config.session_defaults.latency.tuner_backend = audio::LatencyTunerBackend_Niq;
     config.session_defaults.latency.tuner_profile = audio::LatencyTunerProfile_Intact;
-    config.session_defaults.latency.target_latency = Latency * core::Second / SampleRate;
+    config.session_defaults.latency.target_latency =
+        (core::nanoseconds_t)select_latency(flags) * core::Second / SampleRate;
     config.session_defaults.watchdog.no_playback_timeout =
         Timeout * core::Second / SampleRate;
 
@@ -466,7 +497,7 @@ void send_receive(int flags,
     }
 
     ReceiverSourceConfig receiver_config =
-        make_receiver_config(frame_channels, packet_channels);
+        make_receiver_config(flags, frame_channels, packet_channels);
 
     ReceiverSource receiver(receiver_config, encoding_map, packet_pool,
                             packet_buffer_pool, frame_buffer_pool, arena);
@@ -530,7 +561,7 @@ void send_receive(int flags,
 
         proxy.deliver_from(sender_outbound_queue);
 
-        if (nf > Latency / SamplesPerFrame) {
+        if (nf > select_latency(flags) / SamplesPerFrame) {
             core::nanoseconds_t recv_base_cts = -1;
             if (flags & FlagCTS) {
                 recv_base_cts = send_base_cts;
@@ -549,7 +580,8 @@ void send_receive(int flags,
 
             reverse_proxy.deliver_from(receiver_outbound_queue);
 
-            if (num_sessions == 1 && nf > (Latency + Warmup) / SamplesPerFrame) {
+            if (num_sessions == 1
+                && nf > (select_latency(flags) + Warmup) / SamplesPerFrame) {
                 check_metrics(*receiver_slot, *sender_slot, flags);
             }
         }
@@ -567,6 +599,16 @@ void send_receive(int flags,
         CHECK(proxy.n_repair() == 0);
     }
 
+    if (flags & FlagRepairPacing) {
+        // repair packets are interleaved with source packets instead of
+        // being sent in bursts at the end of each block
+        CHECK(proxy.max_repair_run() > 0);
+        CHECK(proxy.max_repair_run() < RepairPackets);
+    } else if ((flags & (FlagReedSolomon | FlagLDPC)) != 0
+               && (flags & FlagInterleaving) == 0) {
+        UNSIGNED_LONGS_EQUAL(RepairPackets, proxy.max_repair_run());
+    }
+
     if ((flags & FlagRTCP) != 0) {
         CHECK(proxy.n_control() > 0);
     } else {
@@ -622,6 +664,23 @@ TEST(loopback_sink_2_source, fec_loss) {
     }
 }
 
+TEST(loopback_sink_2_source, fec_repair_pacing) {
+    enum { Chans = Chans_Stereo, NumSess = 1 };
+
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagRepairPacing, NumSess, Chans, Chans);
+    }
+}
+
+TEST(loopback_sink_2_source, fec_repair_pacing_loss) {
+    enum { Chans = Chans_Stereo, NumSess = 1 };
+
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagRepairPacing | FlagLosses, NumSess, Chans,
+                     Chans);
+    }
+}
+
 TEST(loopback_sink_2_source, fec_drop_source) {
     enum { Chans = Chans_Stereo, NumSess = 0 };
 
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/mock_source.h"
+
+#include "roc_core/array.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_pipeline/parallel_transcoder.h"
+#include "roc_pipeline/transcoder_sink.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxBufSize = 1000,
+
+    InputRate = 44100,
+    OutputRate = 48000,
+
+    SamplesPerFrame = 441,
+    ManyFrames = 100
+};
+
+const core::nanoseconds_t FrameLength = 10 * core::Millisecond;
+
+const audio::ChannelMask Chans_Mono = audio::ChanMask_Surround_Mono;
+const audio::ChannelMask Chans_Stereo = audio::ChanMask_Surround_Stereo;
+
+core::HeapArena arena;
+
+core::SlabPool<core::Buffer> buffer_pool("frame_buffer_pool",
+                                         arena,
+                                         sizeof(core::Buffer)
+                                             + MaxBufSize * sizeof(audio::sample_t));
+
+// Collects all written samples.
+class SampleCollector : public audio::IFrameWriter {
+public:
+    SampleCollector()
+        : samples(arena) {
+    }
+
+    virtual void write(audio::Frame& frame) {
+        for (size_t n = 0; n < frame.num_raw_samples(); n++) {
+            CHECK(samples.push_back(frame.raw_samples()[n]));
+        }
+    }
+
+    core::Array<audio::sample_t> samples;
+};
+
+} // namespace
+
+TEST_GROUP(parallel_transcoder) {
+    audio::SampleSpec input_sample_spec;
+    audio::SampleSpec output_sample_spec;
+
+    TranscoderConfig make_config() {
+        TranscoderConfig config;
+
+        config.input_sample_spec = input_sample_spec;
+        config.output_sample_spec = output_sample_spec;
+
+        return config;
+    }
+
+    ParallelTranscoderConfig make_parallel_config(size_t num_threads) {
+        ParallelTranscoderConfig config;
+
+        config.num_threads = num_threads;
+        config.chunk_length = 50 * core::Millisecond;
+        config.chunk_overlap = 20 * core::Millisecond;
+
+        return config;
+    }
+
+    void init(int input_sample_rate, audio::ChannelMask input_channels,
+              int output_sample_rate, audio::ChannelMask output_channels) {
+        input_sample_spec.set_sample_rate((size_t)input_sample_rate);
+        input_sample_spec.set_sample_format(audio::SampleFormat_Pcm);
+        input_sample_spec.set_pcm_format(audio::Sample_RawFormat);
+        input_sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+        input_sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+        input_sample_spec.channel_set().set_mask(input_channels);
+
+        output_sample_spec.set_sample_rate((size_t)output_sample_rate);
+        output_sample_spec.set_sample_format(audio::SampleFormat_Pcm);
+        output_sample_spec.set_pcm_format(audio::Sample_RawFormat);
+        output_sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+        output_sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+        output_sample_spec.channel_set().set_mask(output_channels);
+    }
+
+    void transcode(const TranscoderConfig& config,
+                   size_t num_threads,
+                   size_t num_samples,
+                   SampleCollector& collector) {
+        test::MockSource mock_source;
+        mock_source.add(num_samples, input_sample_spec);
+
+        ParallelTranscoder transcoder(config, make_parallel_config(num_threads),
+                                      FrameLength, buffer_pool, arena);
+        CHECK(transcoder.is_valid());
+
+        CHECK(transcoder.run(mock_source, &collector));
+
+        UNSIGNED_LONGS_EQUAL(0, mock_source.num_remaining());
+    }
+};
+
+TEST(parallel_transcoder, null) {
+    init(InputRate, Chans_Stereo, OutputRate, Chans_Stereo);
+
+    test::MockSource mock_source;
+    mock_source.add(ManyFrames * SamplesPerFrame, input_sample_spec);
+
+    ParallelTranscoder transcoder(make_config(), make_parallel_config(4), FrameLength,
+                                  buffer_pool, arena);
+    CHECK(transcoder.is_valid());
+
+    CHECK(transcoder.run(mock_source, NULL));
+
+    UNSIGNED_LONGS_EQUAL(0, mock_source.num_remaining());
+}
+
+TEST(parallel_transcoder, empty) {
+    init(InputRate, Chans_Stereo, OutputRate, Chans_Stereo);
+
+    SampleCollector collector;
+    transcode(make_config(), 4, 0, collector);
+
+    UNSIGNED_LONGS_EQUAL(0, collector.samples.size());
+}
+
+TEST(parallel_transcoder, channel_mapping) {
+    enum { NumSamples = ManyFrames * SamplesPerFrame };
+
+    init(InputRate, Chans_Mono, InputRate, Chans_Stereo);
+
+    SampleCollector collector;
+    transcode(make_config(), 4, NumSamples, collector);
+
+    UNSIGNED_LONGS_EQUAL(NumSamples * 2, collector.samples.size());
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        DOUBLES_EQUAL((double)test::nth_sample((uint8_t)n),
+                      (double)collector.samples[n * 2], 0.0001);
+        DOUBLES_EQUAL((double)test::nth_sample((uint8_t)n),
+                      (double)collector.samples[n * 2 + 1], 0.0001);
+    }
+}
+
+TEST(parallel_transcoder, resampling_deterministic) {
+    enum { NumSamples = ManyFrames * SamplesPerFrame };
+
+    init(InputRate, Chans_Stereo, OutputRate, Chans_Mono);
+
+    SampleCollector expected;
+    transcode(make_config(), 1, NumSamples, expected);
+
+    UNSIGNED_LONGS_EQUAL((size_t)NumSamples * OutputRate / InputRate,
+                         expected.samples.size());
+
+    // Result doesn't depend on number of threads.
+    for (size_t num_threads = 2; num_threads <= 5; num_threads++) {
+        SampleCollector actual;
+        transcode(make_config(), num_threads, NumSamples, actual);
+
+        UNSIGNED_LONGS_EQUAL(expected.samples.size(), actual.samples.size());
+
+        for (size_t n = 0; n < expected.samples.size(); n++) {
+            CHECK(expected.samples[n] == actual.samples[n]);
+        }
+    }
+}
+
+TEST(parallel_transcoder, resampling_same_as_sequential) {
+    enum { NumSamples = ManyFrames * SamplesPerFrame };
+
+    init(InputRate, Chans_Stereo, OutputRate, Chans_Stereo);
+
+    TranscoderConfig config = make_config();
+    config.resampler.backend = audio::ResamplerBackend_Builtin;
+
+    SampleCollector parallel;
+    transcode(config, 3, NumSamples, parallel);
+
+    SampleCollector sequential;
+
+    {
+        test::MockSource mock_source;
+        mock_source.add(NumSamples, input_sample_spec);
+
+        TranscoderSink transcoder(config, &sequential, buffer_pool, arena);
+        CHECK(transcoder.is_valid());
+
+        audio::sample_t samples[SamplesPerFrame * 2];
+
+        for (size_t nf = 0; nf < ManyFrames; nf++) {
+            audio::Frame frame(samples, SamplesPerFrame * 2);
+            CHECK(mock_source.read(frame));
+            transcoder.write(frame);
+        }
+    }
+
+    // Sequential transcoder keeps tail buffered in resampler.
+    CHECK(sequential.samples.size() > parallel.samples.size() / 2);
+    CHECK(sequential.samples.size() <= parallel.samples.size());
+
+    // Chunk boundaries are not visible in output. Results are not bit-exact,
+    // because builtin resampler accumulates fixed-point position error, which
+    // is reset at every chunk.
+    for (size_t n = 0; n < sequential.samples.size(); n++) {
+        DOUBLES_EQUAL((double)sequential.samples[n], (double)parallel.samples[n], 0.01);
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -64,6 +64,7 @@ public:
         , frame_allow_counter_(999999)
         , task_allow_counter_(999999)
         , time_(StartTime)
+        , time_per_sample_(0)
         , tid_(DefaultThread)
         , exp_frame_val_(0)
         , exp_frame_sz_(0)
@@ -81,6 +82,12 @@ public:
         time_ = t;
     }
 
+    // advance time during frame processing, proportionally to frame size
+    void set_time_per_sample(core::nanoseconds_t t) {
+        core::Mutex::Lock lock(mutex_);
+        time_per_sample_ = t;
+    }
+
     void set_tid(uint64_t t) {
         core::Mutex::Lock lock(mutex_);
         tid_ = t;
@@ -142,42 +149,42 @@ public:
     size_t num_processed_tasks() const {
         core::Mutex::Lock lock(mutex_);
         UNSIGNED_LONGS_EQUAL(n_processed_tasks_,
-                             (size_t)get_stats_ref().task_processed_total);
+                             (size_t)get_stats().task_processed_total);
         return n_processed_tasks_;
     }
 
     size_t num_tasks_processed_in_sched() const {
         core::Mutex::Lock lock(mutex_);
-        return (size_t)get_stats_ref().task_processed_in_place;
+        return (size_t)get_stats().task_processed_in_place;
     }
 
     size_t num_tasks_processed_in_frame() const {
         core::Mutex::Lock lock(mutex_);
-        return (size_t)get_stats_ref().task_processed_in_frame;
+        return (size_t)get_stats().task_processed_in_frame;
     }
 
     size_t num_tasks_processed_in_proc() const {
         core::Mutex::Lock lock(mutex_);
-        return size_t(get_stats_ref().task_processed_total
-                      - get_stats_ref().task_processed_in_frame
-                      - get_stats_ref().task_processed_in_place);
+        return size_t(get_stats().task_processed_total
+                      - get_stats().task_processed_in_frame
+                      - get_stats().task_processed_in_place);
     }
 
     size_t num_preemptions() const {
         core::Mutex::Lock lock(mutex_);
-        return (size_t)get_stats_ref().preemptions;
+        return (size_t)get_stats().preemptions;
     }
 
     size_t num_sched_calls() const {
         core::Mutex::Lock lock(mutex_);
-        UNSIGNED_LONGS_EQUAL(n_sched_calls_, (size_t)get_stats_ref().scheduler_calls);
+        UNSIGNED_LONGS_EQUAL(n_sched_calls_, (size_t)get_stats().scheduler_calls);
         return n_sched_calls_;
     }
 
     size_t num_sched_cancellations() const {
         core::Mutex::Lock lock(mutex_);
         UNSIGNED_LONGS_EQUAL(n_sched_cancellations_,
-                             (size_t)get_stats_ref().scheduler_cancellations);
+                             (size_t)get_stats().scheduler_cancellations);
         return n_sched_cancellations_;
     }
 
@@ -230,6 +237,7 @@ private:
         }
         roc_panic_if(frame.flags() != exp_frame_flags_);
         roc_panic_if(frame.capture_timestamp() != exp_frame_cts_);
+        time_ += time_per_sample_ * (core::nanoseconds_t)frame.num_raw_samples();
         n_processed_frames_++;
         return true;
     }
@@ -284,6 +292,7 @@ private:
     int task_allow_counter_;
 
     core::nanoseconds_t time_;
+    core::nanoseconds_t time_per_sample_;
     uint64_t tid_;
 
     audio::sample_t exp_frame_val_;
@@ -2355,5 +2364,100 @@ TEST(pipeline_loop, forward_flags_and_cts_large_frame) {
     UNSIGNED_LONGS_EQUAL(2, pipeline.num_processed_frames());
 }
 
+TEST(pipeline_loop, adaptive_subframes_expensive_frame) {
+    config.enable_adaptive_subframes = true;
+    config.max_subframe_processing = core::Millisecond;
+
+    TestPipeline pipeline(config);
+
+    pipeline.set_time(StartTime);
+    // 1ms of processing per 4000 samples
+    pipeline.set_time_per_sample(250 * core::Nanosecond);
+
+    audio::Frame frame(samples, MaxFrameSize * 2);
+    fill_frame(frame, 0.1f, 0, MaxFrameSize * 2);
+
+    { // processing cost is unknown, fixed size is used
+        audio::Frame small_frame(samples, MaxFrameSize);
+
+        pipeline.expect_frame(0.1f, MaxFrameSize);
+        CHECK(pipeline.process_subframes_and_tasks(small_frame));
+
+        UNSIGNED_LONGS_EQUAL(1, pipeline.num_processed_frames());
+    }
+
+    { // sub-frame size is selected from processing cost
+        pipeline.expect_frame(0.1f, MinFrameSize);
+        CHECK(pipeline.process_subframes_and_tasks(frame));
+
+        UNSIGNED_LONGS_EQUAL(4, pipeline.num_processed_frames());
+    }
+}
+
+TEST(pipeline_loop, adaptive_subframes_cheap_frame) {
+    config.enable_adaptive_subframes = true;
+    config.max_subframe_processing = core::Millisecond;
+
+    TestPipeline pipeline(config);
+
+    pipeline.set_time(StartTime);
+    // 1ms of processing per 20000 samples
+    pipeline.set_time_per_sample(50 * core::Nanosecond);
+
+    audio::Frame frame(samples, MaxFrameSize * 2);
+    fill_frame(frame, 0.1f, 0, MaxFrameSize * 2);
+
+    { // processing cost is unknown, fixed size is used
+        audio::Frame small_frame(samples, MaxFrameSize);
+
+        pipeline.expect_frame(0.1f, MaxFrameSize);
+        CHECK(pipeline.process_subframes_and_tasks(small_frame));
+
+        UNSIGNED_LONGS_EQUAL(1, pipeline.num_processed_frames());
+    }
+
+    { // frame is cheap enough to be processed without splitting
+        pipeline.expect_frame(0.1f, MaxFrameSize * 2);
+        CHECK(pipeline.process_subframes_and_tasks(frame));
+
+        UNSIGNED_LONGS_EQUAL(2, pipeline.num_processed_frames());
+    }
+}
+
+TEST(pipeline_loop, adaptive_subframes_zero_cost) {
+    enum { NumIters = 500 };
+
+    config.enable_adaptive_subframes = true;
+    config.max_subframe_processing = core::Millisecond;
+
+    TestPipeline pipeline(config);
+
+    pipeline.set_time(StartTime);
+    pipeline.set_time_per_sample(core::Nanosecond);
+
+    audio::Frame frame(samples, MaxFrameSize * 2);
+    fill_frame(frame, 0.1f, 0, MaxFrameSize * 2);
+
+    { // processing cost is unknown, fixed size is used
+        audio::Frame small_frame(samples, MaxFrameSize);
+
+        pipeline.expect_frame(0.1f, MaxFrameSize);
+        CHECK(pipeline.process_subframes_and_tasks(small_frame));
+
+        UNSIGNED_LONGS_EQUAL(1, pipeline.num_processed_frames());
+    }
+
+    // processing takes no time, and cost estimate decays towards zero
+    pipeline.set_time_per_sample(0);
+
+    for (size_t n = 0; n < NumIters; n++) {
+        // frame is still processed without splitting
+        pipeline.expect_frame(0.1f, MaxFrameSize * 2);
+        CHECK(pipeline.process_subframes_and_tasks(frame));
+
+        UNSIGNED_LONGS_EQUAL(n + 2, pipeline.num_processed_frames());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -91,5 +91,43 @@ TEST(receiver_endpoint, no_memory) {
     }
 }
 
+TEST(receiver_endpoint, inbound_queue_overflow) {
+    enum { NumPackets = 10000 };
+
+    audio::Mixer mixer(frame_factory, DefaultSampleSpec, false);
+
+    StateTracker state_tracker;
+    ReceiverSourceConfig source_config;
+    ReceiverSlotConfig slot_config;
+    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
+                                       encoding_map, packet_factory, frame_factory,
+                                       arena);
+
+    ReceiverEndpoint endpoint(address::Proto_RTP, state_tracker, session_group,
+                              encoding_map, address::SocketAddr(), NULL, arena);
+    CHECK(endpoint.is_valid());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+
+        core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+        CHECK(buf);
+        buf.reslice(0, 0);
+        pp->set_buffer(buf);
+
+        LONGS_EQUAL(status::StatusOK, endpoint.inbound_writer().write(pp));
+    }
+
+    // Inbound queue is bounded, packets that didn't fit are dropped
+    // and not counted as pending.
+    CHECK(state_tracker.num_pending_packets() > 0);
+    CHECK(state_tracker.num_pending_packets() < NumPackets);
+
+    LONGS_EQUAL(status::StatusOK, endpoint.pull_packets(0));
+
+    UNSIGNED_LONGS_EQUAL(0, state_tracker.num_pending_packets());
+}
+
 } // namespace pipeline
 } // namespace roc
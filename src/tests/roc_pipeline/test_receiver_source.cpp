@@ -15,6 +15,7 @@
 
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/time.h"
@@ -302,6 +303,127 @@ TEST(receiver_source, one_session_long_run) {
     }
 }
 
+// Check that when packet and output specs match and latency tuning is
+// disabled, payload is decoded directly into output frame, with and
+// without session threads.
+TEST(receiver_source, one_session_zero_copy) {
+    enum {
+        Rate = SampleRate,
+        Chans = Chans_Stereo,
+        NumFrames = ManyPackets * FramesPerPacket
+    };
+
+    init(Rate, Chans, Rate, Chans);
+
+    for (size_t num_threads = 0; num_threads <= 1; num_threads++) {
+        ReceiverSourceConfig config = make_default_config();
+        config.num_session_threads = num_threads;
+
+        ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                                frame_buffer_pool, arena);
+        CHECK(receiver.is_valid());
+
+        ReceiverSlot* slot = create_slot(receiver);
+        CHECK(slot);
+
+        packet::IWriter* endpoint1_writer = create_transport_endpoint(
+            slot, address::Iface_AudioSource, proto1, dst_addr1);
+        CHECK(endpoint1_writer);
+
+        test::FrameReader frame_reader(receiver, frame_factory);
+
+        test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                         packet_factory, src_id1, src_addr1, dst_addr1,
+                                         PayloadType_Ch2);
+
+        packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                    packet_sample_spec);
+
+        audio::CopyCounter::instance().set_enabled(true);
+        audio::CopyCounter::instance().reset();
+
+        for (size_t np = 0; np < ManyPackets; np++) {
+            for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+                UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+            }
+
+            packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+
+        audio::CopyCounter& counter = audio::CopyCounter::instance();
+
+        UNSIGNED_LONGS_EQUAL(NumFrames, counter.num_copies(audio::CopyStage_Depacketizer));
+        UNSIGNED_LONGS_EQUAL(NumFrames * SamplesPerFrame * 2,
+                             counter.num_samples(audio::CopyStage_Depacketizer));
+
+        for (int stage = 0; stage < audio::CopyStage_Max; stage++) {
+            if (stage != audio::CopyStage_Depacketizer) {
+                UNSIGNED_LONGS_EQUAL(0, counter.num_copies((audio::CopyStage)stage));
+            }
+        }
+
+        counter.set_enabled(false);
+    }
+}
+
+// Check that channel mapping adds exactly one copy per frame.
+TEST(receiver_source, one_session_channel_mapping_copies) {
+    enum {
+        Rate = SampleRate,
+        OutputChans = Chans_Mono,
+        PacketChans = Chans_Stereo,
+        NumFrames = ManyPackets * FramesPerPacket
+    };
+
+    init(Rate, OutputChans, Rate, PacketChans);
+
+    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                packet_sample_spec);
+
+    audio::CopyCounter::instance().set_enabled(true);
+    audio::CopyCounter::instance().reset();
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+    }
+
+    audio::CopyCounter& counter = audio::CopyCounter::instance();
+
+    UNSIGNED_LONGS_EQUAL(NumFrames, counter.num_copies(audio::CopyStage_ChannelMapper));
+    UNSIGNED_LONGS_EQUAL(NumFrames * SamplesPerFrame,
+                         counter.num_samples(audio::CopyStage_ChannelMapper));
+
+    UNSIGNED_LONGS_EQUAL(0, counter.num_copies(audio::CopyStage_Resampler));
+    UNSIGNED_LONGS_EQUAL(0, counter.num_copies(audio::CopyStage_Mixer));
+
+    counter.set_enabled(false);
+}
+
 // Check how receiver accumulates packets in jitter buffer
 // before starting playback.
 TEST(receiver_source, initial_latency) {
@@ -721,6 +843,59 @@ TEST(receiver_source, two_sessions_synchronous) {
     }
 }
 
+TEST(receiver_source, three_sessions_session_threads) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, NumThreads = 2 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.num_session_threads = NumThreads;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer3(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, 333, test::new_address(13),
+                                      dst_addr1, PayloadType_Ch2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 3, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(3, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+}
+
 TEST(receiver_source, two_sessions_overlapping) {
     enum { Rate = SampleRate, Chans = Chans_Stereo };
 
@@ -829,6 +1004,78 @@ TEST(receiver_source, two_sessions_two_endpoints) {
     }
 }
 
+TEST(receiver_source, two_sessions_two_shards) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, NumShards = 2 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.num_shards = NumShards;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot1 = create_slot(receiver);
+    CHECK(slot1);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot1, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSlot* slot2 = create_slot(receiver);
+    CHECK(slot2);
+
+    packet::IWriter* endpoint2_writer =
+        create_transport_endpoint(slot2, address::Iface_AudioSource, proto2, dst_addr2);
+    CHECK(endpoint2_writer);
+
+    // Third slot is left without sessions.
+    ReceiverSlot* slot3 = create_slot(receiver);
+    CHECK(slot3);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint2_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr2,
+                                      PayloadType_Ch2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 2, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    receiver.delete_slot(slot3);
+    receiver.delete_slot(slot1);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+}
+
 TEST(receiver_source, two_sessions_same_address_same_stream) {
     enum { Rate = SampleRate, Chans = Chans_Stereo };
 
@@ -1103,6 +1350,54 @@ TEST(receiver_source, seqnum_reorder) {
     }
 }
 
+TEST(receiver_source, seqnum_reorder_seqnum_queue) {
+    enum {
+        Rate = SampleRate,
+        Chans = Chans_Stereo,
+        ReorderWindow = Latency / SamplesPerPacket
+    };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.session_defaults.enable_seqnum_queue = true;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    size_t pos = 0;
+
+    for (size_t ni = 0; ni < ManyPackets / ReorderWindow; ni++) {
+        if (pos >= Latency / SamplesPerPacket) {
+            for (size_t nf = 0; nf < ReorderWindow * FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+            }
+        }
+
+        for (ssize_t np = ReorderWindow - 1; np >= 0; np--) {
+            packet_writer.shift_to(pos + size_t(np), SamplesPerPacket);
+            packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+
+        pos += ReorderWindow;
+    }
+}
+
 TEST(receiver_source, seqnum_late) {
     enum { Rate = SampleRate, Chans = Chans_Stereo, DelayedPackets = 5 };
 
@@ -2213,6 +2508,61 @@ TEST(receiver_source, metrics_participants) {
     }
 }
 
+// Check that slot counters include sessions which were already removed.
+TEST(receiver_source, metrics_removed_sessions) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                packet_sample_spec);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+        }
+    }
+
+    ReceiverSlotMetrics live_metrics;
+    slot->get_metrics(live_metrics, NULL, NULL);
+
+    UNSIGNED_LONGS_EQUAL(1, live_metrics.num_participants);
+    CHECK(live_metrics.depacketizer.decoded_samples > 0);
+
+    while (receiver.num_sessions() != 0) {
+        receiver.refresh(frame_reader.refresh_ts());
+        frame_reader.read_zero_samples(SamplesPerFrame, output_sample_spec);
+    }
+
+    ReceiverSlotMetrics removed_metrics;
+    slot->get_metrics(removed_metrics, NULL, NULL);
+
+    UNSIGNED_LONGS_EQUAL(0, removed_metrics.num_participants);
+    CHECK(removed_metrics.depacketizer.decoded_samples
+          >= live_metrics.depacketizer.decoded_samples);
+    CHECK(removed_metrics.depacketizer.missing_samples
+          >= live_metrics.depacketizer.missing_samples);
+    UNSIGNED_LONGS_EQUAL(0, removed_metrics.queued_packets);
+}
+
 // Check how receiver returns metrics if provided buffer for metrics
 // is smaller than needed.
 TEST(receiver_source, metrics_truncation) {
@@ -292,6 +292,71 @@ TEST(sender_sink, frame_size_large) {
     packet_reader.read_eof();
 }
 
+// Packets produced from one large frame are spread in time.
+TEST(sender_sink, pacing) {
+    enum {
+        Rate = SampleRate,
+        Chans = Chans_Stereo,
+        SamplesPerLargeFrame = SamplesPerPacket * 4,
+        PacketsPerLargeFrame = SamplesPerLargeFrame / SamplesPerPacket
+    };
+
+    init(Rate, Chans, Rate, Chans);
+
+    packet::Queue queue;
+
+    SenderSinkConfig config = make_config();
+    config.enable_pacing = true;
+
+    SenderSink sender(config, encoding_map, packet_pool, packet_buffer_pool,
+                      frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderSlot* slot = create_slot(sender);
+    CHECK(slot);
+    create_transport_endpoint(slot, address::Iface_AudioSource, proto, dst_addr1, queue);
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    const core::nanoseconds_t before = core::timestamp(core::ClockMonotonic);
+
+    frame_writer.write_samples(SamplesPerLargeFrame, input_sample_spec);
+    sender.refresh(frame_writer.refresh_ts());
+
+    const core::nanoseconds_t after = core::timestamp(core::ClockMonotonic);
+
+    const core::nanoseconds_t packet_duration =
+        packet_sample_spec.samples_per_chan_2_ns(SamplesPerPacket);
+
+    UNSIGNED_LONGS_EQUAL(PacketsPerLargeFrame, queue.size());
+
+    core::nanoseconds_t first_ts = 0;
+
+    for (size_t np = 0; np < PacketsPerLargeFrame; np++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, queue.read(pp));
+        CHECK(pp->udp());
+
+        if (np == 0) {
+            first_ts = pp->udp()->send_timestamp;
+            CHECK(first_ts >= before);
+            CHECK(first_ts <= after);
+        }
+
+        DOUBLES_EQUAL((double)(first_ts + packet_duration * (core::nanoseconds_t)np),
+                      (double)pp->udp()->send_timestamp, (double)core::Microsecond);
+    }
+
+    SenderSlotMetrics slot_metrics;
+    slot->get_metrics(slot_metrics, NULL, NULL);
+
+    // packets are written to pacer one by one, so the delay is slightly smaller
+    // than the position of the last packet in frame
+    CHECK(slot_metrics.pacer.max_delay
+          <= packet_duration * (PacketsPerLargeFrame - 1));
+    CHECK(slot_metrics.pacer.max_delay > packet_duration * (PacketsPerLargeFrame - 2));
+}
+
 // Frames written to sender are stereo, packets are mono.
 TEST(sender_sink, channel_mapping_stereo_to_mono) {
     enum { Rate = SampleRate, InputChans = Chans_Stereo, PacketChans = Chans_Mono };
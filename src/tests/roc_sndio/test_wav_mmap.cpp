@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/wav_mmap_sink.h"
+#include "roc_sndio/wav_mmap_source.h"
+#include "roc_sndio/wav_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    FrameSize = 500,
+    NumFrames = 300,
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumChans = 2
+};
+
+core::HeapArena arena;
+
+audio::sample_t sample_value(size_t n) {
+    return audio::sample_t(int(n % 2000) - 1000) / 1000.0f;
+}
+
+Config make_sink_config() {
+    Config config;
+    config.sample_spec =
+        audio::SampleSpec(SampleRate, audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                          audio::ChanOrder_Smpte, ChMask);
+    return config;
+}
+
+void write_file(const char* path, size_t n_frames) {
+    WavMmapSink sink(arena, make_sink_config());
+    CHECK(sink.is_valid());
+    CHECK(sink.open(path));
+
+    audio::sample_t samples[FrameSize];
+    size_t pos = 0;
+
+    for (size_t n = 0; n < n_frames; n++) {
+        for (size_t i = 0; i < FrameSize; i++) {
+            samples[i] = sample_value(pos++);
+        }
+        audio::Frame frame(samples, FrameSize);
+        sink.write(frame);
+    }
+}
+
+void check_read(ISource& source, size_t n_frames) {
+    UNSIGNED_LONGS_EQUAL(SampleRate, source.sample_spec().sample_rate());
+    UNSIGNED_LONGS_EQUAL(NumChans, source.sample_spec().num_channels());
+
+    audio::sample_t samples[FrameSize];
+    size_t pos = 0;
+
+    for (size_t n = 0; n < n_frames; n++) {
+        audio::Frame frame(samples, FrameSize);
+        CHECK(source.read(frame));
+
+        for (size_t i = 0; i < FrameSize; i++) {
+            DOUBLES_EQUAL((double)sample_value(pos++), (double)samples[i], 0.0001);
+        }
+    }
+
+    audio::Frame frame(samples, FrameSize);
+    CHECK(!source.read(frame));
+}
+
+} // namespace
+
+TEST_GROUP(wav_mmap) {};
+
+TEST(wav_mmap, write_read_mmap) {
+    core::TempFile file("test.wav");
+    write_file(file.path(), NumFrames);
+
+    WavMmapSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    check_read(source, NumFrames);
+
+    // restart from the beginning
+    CHECK(source.restart());
+    check_read(source, NumFrames);
+}
+
+TEST(wav_mmap, write_read_stdio) {
+    core::TempFile file("test.wav");
+    write_file(file.path(), NumFrames);
+
+    // file written by mmap sink is readable by dr_wav
+    WavSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    check_read(source, NumFrames);
+}
+
+TEST(wav_mmap, read_sint16) {
+    core::TempFile file("test.wav");
+
+    {
+        drwav_data_format format;
+        format.container = drwav_container_riff;
+        format.format = DR_WAVE_FORMAT_PCM;
+        format.channels = NumChans;
+        format.sampleRate = SampleRate;
+        format.bitsPerSample = 16;
+
+        drwav wav;
+        CHECK(drwav_init_file_write(&wav, file.path(), &format, NULL));
+
+        int16_t samples[FrameSize];
+        for (size_t n = 0; n < NumFrames; n++) {
+            for (size_t i = 0; i < FrameSize; i++) {
+                samples[i] = int16_t(sample_value(n * FrameSize + i) * 32767);
+            }
+            UNSIGNED_LONGS_EQUAL(FrameSize / NumChans,
+                                 drwav_write_pcm_frames(&wav, FrameSize / NumChans,
+                                                        samples));
+        }
+
+        CHECK(drwav_uninit(&wav) == DRWAV_SUCCESS);
+    }
+
+    WavMmapSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    check_read(source, NumFrames);
+}
+
+TEST(wav_mmap, partial_frame) {
+    core::TempFile file("test.wav");
+    write_file(file.path(), 1);
+
+    WavMmapSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    // last frame is padded with zeros
+    audio::sample_t samples[FrameSize * 2];
+    audio::Frame frame(samples, FrameSize * 2);
+    CHECK(source.read(frame));
+
+    for (size_t i = 0; i < FrameSize * 2; i++) {
+        DOUBLES_EQUAL(i < FrameSize ? (double)sample_value(i) : 0.0, (double)samples[i],
+                      0.0001);
+    }
+
+    CHECK(!source.read(frame));
+}
+
+TEST(wav_mmap, not_wav) {
+    core::TempFile file("test.wav");
+
+    FILE* fp = fopen(file.path(), "w");
+    CHECK(fp);
+    fputs("not a wav file", fp);
+    fclose(fp);
+
+    WavMmapSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(!source.open(file.path()));
+}
+
+} // namespace sndio
+} // namespace roc
@@ -12,6 +12,7 @@
 #include "roc_core/log.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_pipeline/parallel_transcoder.h"
 #include "roc_pipeline/transcoder_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/backend_map.h"
@@ -144,6 +145,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speexdec:
         transcoder_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        transcoder_config.resampler.backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -164,11 +168,38 @@ int main(int argc, char** argv) {
 
     transcoder_config.enable_profiling = args.profiling_flag;
 
+    pipeline::ParallelTranscoderConfig parallel_config;
+
+    if (args.jobs_given) {
+        if (args.jobs_arg < 0) {
+            roc_log(LogError, "invalid --jobs: should be >= 0");
+            return 1;
+        }
+        parallel_config.num_threads = (size_t)args.jobs_arg;
+    }
+
+    if (args.chunk_len_given) {
+        if (!args.jobs_given) {
+            roc_log(LogError, "--chunk-len can be used only with --jobs");
+            return 1;
+        }
+        if (!core::parse_duration(args.chunk_len_arg, parallel_config.chunk_length)) {
+            roc_log(LogError, "invalid --chunk-len: bad format");
+            return 1;
+        }
+        if (parallel_config.chunk_length <= 0) {
+            roc_log(LogError, "invalid --chunk-len: should be > 0");
+            return 1;
+        }
+    }
+
     audio::IFrameWriter* output_writer = NULL;
 
     sndio::Config sink_config;
     sink_config.sample_spec = transcoder_config.output_sample_spec;
     sink_config.frame_length = source_config.frame_length;
+    // Output is bounded by input, so it's safe to use faster mmap sinks.
+    sink_config.enable_mmap_sink = true;
 
     address::IoUri output_uri(arena);
     if (args.output_given) {
@@ -204,6 +235,20 @@ int main(int argc, char** argv) {
         output_writer = output_sink.get();
     }
 
+    if (args.jobs_given) {
+        pipeline::ParallelTranscoder transcoder(transcoder_config, parallel_config,
+                                                source_config.frame_length,
+                                                frame_buffer_pool, arena);
+        if (!transcoder.is_valid()) {
+            roc_log(LogError, "can't create parallel transcoder");
+            return 1;
+        }
+
+        const bool ok = transcoder.run(*input_source, output_writer);
+
+        return ok ? 0 : 1;
+    }
+
     pipeline::TranscoderSink transcoder(transcoder_config, output_writer,
                                         frame_buffer_pool, arena);
     if (!transcoder.is_valid()) {
@@ -8,16 +8,20 @@
 
 #include "roc_address/endpoint_uri.h"
 #include "roc_address/io_uri.h"
+#include "roc_address/parse_socket_addr.h"
 #include "roc_address/print_supported.h"
 #include "roc_address/protocol_map.h"
+#include "roc_audio/copy_counter.h"
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/time.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/network_loop.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_exporter.h"
 #include "roc_node/receiver.h"
 #include "roc_pipeline/receiver_source.h"
 #include "roc_pipeline/transcoder_source.h"
@@ -30,6 +34,13 @@
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of trace events recorded per thread.
+enum { TraceRingSize = 65536 };
+
+} // namespace
+
 int main(int argc, char** argv) {
     core::HeapArena::set_guards(core::HeapArena_DefaultGuards
                                 | core::HeapArena_LeakGuard);
@@ -202,6 +213,10 @@ int main(int argc, char** argv) {
         receiver_config.session_defaults.resampler.backend =
             audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -223,6 +238,7 @@ int main(int argc, char** argv) {
     }
 
     receiver_config.session_defaults.enable_beeping = args.beep_flag;
+    receiver_config.session_defaults.enable_plc = args.plc_flag;
     receiver_config.common.enable_profiling = args.profiling_flag;
 
     node::ContextConfig context_config;
@@ -527,7 +543,64 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    core::ScopedPtr<node::MetricsExporter> metrics_exporter;
+
+    if (args.metrics_port_given) {
+        if (args.metrics_port_arg < 0 || args.metrics_port_arg > 65535) {
+            roc_log(LogError, "invalid --metrics-port: should be in range [0; 65535]");
+            return 1;
+        }
+
+        address::SocketAddr metrics_address;
+        if (!address::parse_socket_addr(args.metrics_host_arg, args.metrics_port_arg,
+                                        metrics_address)) {
+            roc_log(LogError, "invalid --metrics-host: %s", args.metrics_host_arg);
+            return 1;
+        }
+
+        node::MetricsExporterConfig metrics_config;
+        metrics_config.num_slots = (size_t)args.source_given;
+
+        metrics_exporter.reset(new (context.arena()) node::MetricsExporter(
+                                   metrics_config, context, receiver),
+                               context.arena());
+        if (!metrics_exporter || !metrics_exporter->start(metrics_address)) {
+            roc_log(LogError, "can't start metrics exporter");
+            return 1;
+        }
+    }
+
+    if (args.trace_given) {
+        core::Tracer::instance().enable(TraceRingSize);
+    }
+
+    if (args.copy_stats_flag) {
+        audio::CopyCounter::instance().set_enabled(true);
+    }
+
     const bool ok = pump.run();
 
+    if (args.copy_stats_flag) {
+        audio::CopyCounter::instance().set_enabled(false);
+
+        for (int n = 0; n < audio::CopyStage_Max; n++) {
+            const audio::CopyStage stage = (audio::CopyStage)n;
+
+            roc_log(LogInfo, "copy stats: stage=%s n_copies=%lu n_samples=%lu",
+                    audio::copy_stage_to_str(stage),
+                    (unsigned long)audio::CopyCounter::instance().num_copies(stage),
+                    (unsigned long)audio::CopyCounter::instance().num_samples(stage));
+        }
+    }
+
+    if (args.trace_given) {
+        core::Tracer::instance().disable();
+
+        if (!core::Tracer::instance().dump(args.trace_arg)) {
+            roc_log(LogError, "can't write --trace file: %s", args.trace_arg);
+            return 1;
+        }
+    }
+
     return ok ? 0 : 1;
 }
@@ -8,6 +8,7 @@
 
 #include "roc_address/endpoint_uri.h"
 #include "roc_address/io_uri.h"
+#include "roc_address/parse_socket_addr.h"
 #include "roc_address/print_supported.h"
 #include "roc_address/protocol_map.h"
 #include "roc_core/crash_handler.h"
@@ -16,8 +17,10 @@
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/time.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/network_loop.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_exporter.h"
 #include "roc_node/sender.h"
 #include "roc_pipeline/sender_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
@@ -29,6 +32,13 @@
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of trace events recorded per thread.
+enum { TraceRingSize = 65536 };
+
+} // namespace
+
 int main(int argc, char** argv) {
     core::HeapArena::set_guards(core::HeapArena_DefaultGuards
                                 | core::HeapArena_LeakGuard);
@@ -152,6 +162,26 @@ int main(int argc, char** argv) {
         sender_config.fec_writer.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    if (args.adaptive_fec_flag) {
+        if (sender_config.fec_encoder.scheme == packet::FEC_None) {
+            roc_log(LogError, "--adaptive-fec can't be used when fec is disabled");
+            return 1;
+        }
+        if (!args.control_given) {
+            roc_log(LogError, "--adaptive-fec requires --control endpoint");
+            return 1;
+        }
+        sender_config.enable_adaptive_fec = true;
+    }
+
+    if (args.fec_pacing_flag) {
+        if (sender_config.fec_encoder.scheme == packet::FEC_None) {
+            roc_log(LogError, "--fec-pacing can't be used when fec is disabled");
+            return 1;
+        }
+        sender_config.fec_writer.enable_repair_pacing = true;
+    }
+
     if (args.target_latency_given) {
         if (!core::parse_duration(args.target_latency_arg,
                                   sender_config.latency.target_latency)) {
@@ -211,6 +241,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speexdec:
         sender_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        sender_config.resampler.backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -230,6 +263,7 @@ int main(int argc, char** argv) {
     }
 
     sender_config.enable_interleaving = args.interleaving_flag;
+    sender_config.enable_pacing = args.pacing_flag;
     sender_config.enable_profiling = args.profiling_flag;
 
     node::ContextConfig context_config;
@@ -440,7 +474,47 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    core::ScopedPtr<node::MetricsExporter> metrics_exporter;
+
+    if (args.metrics_port_given) {
+        if (args.metrics_port_arg < 0 || args.metrics_port_arg > 65535) {
+            roc_log(LogError, "invalid --metrics-port: should be in range [0; 65535]");
+            return 1;
+        }
+
+        address::SocketAddr metrics_address;
+        if (!address::parse_socket_addr(args.metrics_host_arg, args.metrics_port_arg,
+                                        metrics_address)) {
+            roc_log(LogError, "invalid --metrics-host: %s", args.metrics_host_arg);
+            return 1;
+        }
+
+        node::MetricsExporterConfig metrics_config;
+        metrics_config.num_slots = (size_t)args.source_given;
+
+        metrics_exporter.reset(new (context.arena()) node::MetricsExporter(
+                                   metrics_config, context, sender),
+                               context.arena());
+        if (!metrics_exporter || !metrics_exporter->start(metrics_address)) {
+            roc_log(LogError, "can't start metrics exporter");
+            return 1;
+        }
+    }
+
+    if (args.trace_given) {
+        core::Tracer::instance().enable(TraceRingSize);
+    }
+
     const bool ok = pump.run();
 
+    if (args.trace_given) {
+        core::Tracer::instance().disable();
+
+        if (!core::Tracer::instance().dump(args.trace_arg)) {
+            roc_log(LogError, "can't write --trace file: %s", args.trace_arg);
+            return 1;
+        }
+    }
+
     return ok ? 0 : 1;
 }